@@ -0,0 +1,209 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/align/differentialsolver.h"
+
+#include <QtTest>
+
+#include <QObject>
+#include <QRandomGenerator>
+
+#include <cmath>
+
+class TestDifferentialSolver : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestDifferentialSolver();
+
+        /** @short Destructor */
+        ~TestDifferentialSolver() override = default;
+
+    private slots:
+        void solveTest_data();
+        void solveTest();
+        void scaleChangeTest();
+};
+
+#include "testdifferentialsolver.moc"
+
+namespace
+{
+constexpr int WIDTH  = 1280;
+constexpr int HEIGHT = 960;
+constexpr double DEG = M_PI / 180.0;
+
+// CD matrix of a solution, in degrees per pixel, as FITSData::injectWCS() writes it
+void cdMatrix(const Ekos::DifferentialSolver::Solution &solution, double cd[2][2])
+{
+    const double cdelt1 = (solution.eastToTheRight ? solution.pixscale : -solution.pixscale) / 3600.0;
+    const double cdelt2 = solution.pixscale / 3600.0;
+    const double rotation = (360.0 - solution.orientation) * DEG;
+    cd[0][0] = cdelt1 * std::cos(rotation);
+    cd[0][1] = -cdelt2 * std::sin(rotation);
+    cd[1][0] = cdelt1 * std::sin(rotation);
+    cd[1][1] = cdelt2 * std::cos(rotation);
+}
+
+// Sky position of a pixel, with the tangent point at the center of the image
+void pixelToSky(const Ekos::DifferentialSolver::Solution &solution, const QPointF &pixel, double &ra, double &dec)
+{
+    double cd[2][2];
+    cdMatrix(solution, cd);
+    const double dx  = pixel.x() - WIDTH / 2.0;
+    const double dy  = pixel.y() - HEIGHT / 2.0;
+    const double xi  = (cd[0][0] * dx + cd[0][1] * dy) * DEG;
+    const double eta = (cd[1][0] * dx + cd[1][1] * dy) * DEG;
+
+    const double dec0 = solution.dec * DEG;
+    const double den  = std::cos(dec0) - eta * std::sin(dec0);
+    ra  = std::fmod(solution.ra + std::atan2(xi, den) / DEG + 360.0, 360.0);
+    dec = std::atan2(std::sin(dec0) + eta * std::cos(dec0), std::hypot(xi, den)) / DEG;
+}
+
+// Inverse of pixelToSky()
+QPointF skyToPixel(const Ekos::DifferentialSolver::Solution &solution, double ra, double dec)
+{
+    const double dec0 = solution.dec * DEG;
+    const double dra  = (ra - solution.ra) * DEG;
+    const double cosc = std::sin(dec0) * std::sin(dec * DEG) + std::cos(dec0) * std::cos(dec * DEG) * std::cos(dra);
+    const double xi   = std::cos(dec * DEG) * std::sin(dra) / cosc / DEG;
+    const double eta  = (std::cos(dec0) * std::sin(dec * DEG) - std::sin(dec0) * std::cos(dec * DEG) * std::cos(dra)) / cosc / DEG;
+
+    double cd[2][2];
+    cdMatrix(solution, cd);
+    const double det = cd[0][0] * cd[1][1] - cd[0][1] * cd[1][0];
+    return QPointF(WIDTH / 2.0 + (cd[1][1] * xi - cd[0][1] * eta) / det,
+                   HEIGHT / 2.0 + (cd[0][0] * eta - cd[1][0] * xi) / det);
+}
+
+bool inFrame(const QPointF &p)
+{
+    return p.x() >= 0 && p.y() >= 0 && p.x() < WIDTH && p.y() < HEIGHT;
+}
+
+// Stars of two images of the same sky field, brightest first. The positions of the new image are off by up
+// to a tenth of a pixel, as detected centroids would be.
+void makeFields(const Ekos::DifferentialSolver::Solution &reference, const Ekos::DifferentialSolver::Solution &image,
+                QVector<QPointF> &referenceStars, QVector<QPointF> &imageStars)
+{
+    QRandomGenerator random(42);
+    referenceStars.clear();
+    imageStars.clear();
+    for (int i = 0; i < 80; i++)
+    {
+        const QPointF star(random.generateDouble() * WIDTH, random.generateDouble() * HEIGHT);
+        referenceStars.append(star);
+
+        double ra, dec;
+        pixelToSky(reference, star, ra, dec);
+        const QPointF jitter((random.generateDouble() - 0.5) * 0.2, (random.generateDouble() - 0.5) * 0.2);
+        const QPointF p = skyToPixel(image, ra, dec) + jitter;
+        if (inFrame(p))
+            imageStars.append(p);
+    }
+}
+}
+
+TestDifferentialSolver::TestDifferentialSolver() : QObject()
+{
+}
+
+void TestDifferentialSolver::solveTest_data()
+{
+    QTest::addColumn<double>("RA");
+    QTest::addColumn<double>("DEC");
+    QTest::addColumn<double>("ORIENTATION");
+    QTest::addColumn<bool>("EAST_TO_THE_RIGHT");
+    // Offset of the new image on the sky in arcminutes, and its rotation in degrees
+    QTest::addColumn<double>("OFFSET_RA");
+    QTest::addColumn<double>("OFFSET_DEC");
+    QTest::addColumn<double>("ROTATION");
+
+    QTest::newRow("shift") << 120.0 << 30.0 << 20.0 << false << 3.0 << -2.0 << 0.0;
+    QTest::newRow("shift and rotation") << 120.0 << 30.0 << 20.0 << false << -2.5 << 1.5 << 0.5;
+    QTest::newRow("mirrored") << 250.0 << -15.0 << -135.0 << true << 2.0 << 2.0 << -0.4;
+    QTest::newRow("mirrored near the pole") << 359.9 << 80.0 << 178.0 << true << 4.0 << -1.0 << 0.6;
+}
+
+void TestDifferentialSolver::solveTest()
+{
+    QFETCH(double, RA);
+    QFETCH(double, DEC);
+    QFETCH(double, ORIENTATION);
+    QFETCH(bool, EAST_TO_THE_RIGHT);
+    QFETCH(double, OFFSET_RA);
+    QFETCH(double, OFFSET_DEC);
+    QFETCH(double, ROTATION);
+
+    Ekos::DifferentialSolver::Solution reference;
+    reference.ra             = RA;
+    reference.dec            = DEC;
+    reference.orientation    = ORIENTATION;
+    reference.pixscale       = 2.0;
+    reference.eastToTheRight = EAST_TO_THE_RIGHT;
+
+    Ekos::DifferentialSolver::Solution expected = reference;
+    expected.ra          = std::fmod(RA + OFFSET_RA / 60.0 / std::cos(DEC * DEG) + 360.0, 360.0);
+    expected.dec         = DEC + OFFSET_DEC / 60.0;
+    expected.orientation = std::remainder(ORIENTATION + ROTATION, 360.0);
+
+    QVector<QPointF> referenceStars, imageStars;
+    makeFields(reference, expected, referenceStars, imageStars);
+    QVERIFY(imageStars.size() > 50);
+
+    Ekos::DifferentialSolver solver;
+    QVERIFY(!solver.hasReference());
+    solver.setReference(referenceStars, WIDTH, HEIGHT, reference);
+    QVERIFY(solver.hasReference());
+
+    Ekos::DifferentialSolver::Solution solution;
+    QVERIFY(solver.solve(imageStars, WIDTH, HEIGHT, solution));
+
+    // Within an arcsecond on the sky, a hundredth of a degree in orientation
+    QVERIFY2(std::fabs(std::remainder(solution.ra - expected.ra, 360.0)) * std::cos(DEC * DEG) < 1 / 3600.0,
+             qPrintable(QString("RA %1 expected %2").arg(solution.ra, 0, 'f', 6).arg(expected.ra, 0, 'f', 6)));
+    QVERIFY2(std::fabs(solution.dec - expected.dec) < 1 / 3600.0,
+             qPrintable(QString("DEC %1 expected %2").arg(solution.dec, 0, 'f', 6).arg(expected.dec, 0, 'f', 6)));
+    QVERIFY2(std::fabs(std::remainder(solution.orientation - expected.orientation, 360.0)) < 0.01,
+             qPrintable(QString("Orientation %1 expected %2").arg(solution.orientation).arg(expected.orientation)));
+    QVERIFY2(std::fabs(solution.pixscale - expected.pixscale) < 0.002,
+             qPrintable(QString("Pixel scale %1 expected %2").arg(solution.pixscale).arg(expected.pixscale)));
+    QCOMPARE(solution.eastToTheRight, EAST_TO_THE_RIGHT);
+    QVERIFY(solution.matches >= 30);
+    QVERIFY(solution.rms < 0.2);
+
+    // Nothing to match once the reference is cleared
+    solver.clearReference();
+    QVERIFY(!solver.solve(imageStars, WIDTH, HEIGHT, solution));
+}
+
+void TestDifferentialSolver::scaleChangeTest()
+{
+    // A different binning is not a rigid motion of the field, the full solver has to run.
+    Ekos::DifferentialSolver::Solution reference;
+    reference.ra       = 80.0;
+    reference.dec      = 20.0;
+    reference.pixscale = 2.0;
+
+    Ekos::DifferentialSolver::Solution binned = reference;
+    binned.pixscale = 4.0;
+
+    QVector<QPointF> referenceStars, imageStars;
+    makeFields(reference, binned, referenceStars, imageStars);
+
+    Ekos::DifferentialSolver solver;
+    solver.setReference(referenceStars, WIDTH, HEIGHT, reference);
+    Ekos::DifferentialSolver::Solution solution;
+    QVERIFY(!solver.solve(imageStars, WIDTH, HEIGHT, solution));
+
+    // Nor is an image of a different size
+    QVERIFY(!solver.solve(referenceStars, WIDTH / 2, HEIGHT / 2, solution));
+}
+
+QTEST_GUILESS_MAIN(TestDifferentialSolver)
@@ -0,0 +1,157 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains unit tests for the index of the .analyze log files.
+ */
+
+#include "ekos/analyze/analyze.h"
+
+#include <QtTest>
+
+#include <QObject>
+#include <QTemporaryDir>
+
+#include <cmath>
+
+class TestAnalyzeLog : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestAnalyzeLog();
+
+        /** @short Destructor */
+        ~TestAnalyzeLog() override = default;
+
+    private slots:
+        void initTestCase();
+        void indexTest();
+
+    private:
+        // Reads a log file the way "Read from File" does, the index is written once it is read.
+        void loadFromFile(Ekos::Analyze &analyze, const QString &filename);
+};
+
+// This include must go after the class declaration.
+#include "testanalyzelog.moc"
+
+namespace
+{
+// A short session: guiding with a few mount and temperature samples, and two captures
+void writeLog(const QString &filename)
+{
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream out(&file);
+    out << "#KStars version 3.6.0. Analyze log version 1.0.\n\n";
+    out << "AnalyzeStartTime,2026-10-18 21:00:00.000,CEST\n";
+    out << "GuideState,1.000,Guiding\n";
+    for (int i = 0; i < 300; i++)
+    {
+        const double time = 2 + i * 2.0;
+        out << QString("GuideStats,%1,%2,%3,%4,%5,%6,%7,%8\n")
+            .arg(time, 0, 'f', 3)
+            .arg(std::sin(i / 10.0), 0, 'f', 3).arg(std::cos(i / 7.0) * 0.5, 0, 'f', 3)
+            .arg(i % 40).arg(-(i % 30))
+            .arg(20.0 + i % 5, 0, 'f', 3).arg(1000.0 + i, 0, 'f', 3).arg(10 + i % 3);
+        if (i % 50 == 0)
+        {
+            out << QString("MountCoords,%1,%2,%3,%4,%5,0,%6\n").arg(time + 0.5, 0, 'f', 3)
+                .arg(100 + i / 100.0, 0, 'f', 4).arg(45.0, 0, 'f', 4).arg(120 + i / 10.0, 0, 'f', 4)
+                .arg(50 - i / 20.0, 0, 'f', 4).arg(1 + i / 1000.0, 0, 'f', 4);
+            out << QString("Temperature,%1,%2\n").arg(time + 0.7, 0, 'f', 3).arg(12 - i / 100.0, 0, 'f', 3);
+        }
+    }
+    out << "CaptureStarting,100.000,60.000,Red\n";
+    out << "CaptureComplete,160.000,60.000,Red,2.150,/tmp/red.fits,120,800,0.40\n";
+    out << "CaptureStarting,170.000,60.000,Green\n";
+    out << "CaptureComplete,230.000,60.000,Green,2.450,/tmp/green.fits,110,820,0.45\n";
+    out << "GuideState,601.000,Idle\n";
+}
+
+bool sameValue(double a, double b)
+{
+    return (qIsNaN(a) && qIsNaN(b)) || a == b;
+}
+}
+
+TestAnalyzeLog::TestAnalyzeLog() : QObject()
+{
+}
+
+void TestAnalyzeLog::initTestCase()
+{
+    // The index goes in the cache directory.
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestAnalyzeLog::loadFromFile(Ekos::Analyze &analyze, const QString &filename)
+{
+    analyze.reset();
+    QVERIFY(!analyze.readLogIndex(filename));
+    analyze.reset();
+    analyze.loadLogFile(filename);
+
+    // The last chunk and the end of the file are queued to the main thread by the reader.
+    QTRY_VERIFY_WITH_TIMEOUT(analyze.m_LogReader.isFinished(), 10000);
+    QCoreApplication::processEvents();
+}
+
+void TestAnalyzeLog::indexTest()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = dir.filePath("session.analyze");
+    writeLog(filename);
+
+    Ekos::Analyze analyze;
+    loadFromFile(analyze, filename);
+
+    const QVector<Ekos::DecimatedSeries> fromFile = analyze.m_StatsSeries;
+    const double maxXFromFile = analyze.maxXValue;
+    QCOMPARE(maxXFromFile, 601.0);
+    int samples = 0;
+    for (const auto &series : fromFile)
+        samples += series.size();
+    QVERIFY(samples > 300);
+    const int timelineItems = analyze.timelinePlot->itemCount();
+    QVERIFY(timelineItems > 0);
+
+    // Read again, from the index.
+    analyze.reset();
+    QVERIFY(analyze.readLogIndex(filename));
+    QCOMPARE(analyze.maxXValue, maxXFromFile);
+    QCOMPARE(analyze.m_StatsSeries.size(), fromFile.size());
+    for (int i = 0; i < fromFile.size(); i++)
+    {
+        const auto &expected = fromFile[i];
+        const auto &series = analyze.m_StatsSeries[i];
+        QCOMPARE(series.size(), expected.size());
+        for (int j = 0; j < expected.size(); j++)
+        {
+            QCOMPARE(series.key(j), expected.key(j));
+            QVERIFY2(sameValue(series.value(j), expected.value(j)),
+                     qPrintable(QString("Graph %1 sample %2: %3 expected %4")
+                                .arg(i).arg(j).arg(series.value(j)).arg(expected.value(j))));
+        }
+    }
+
+    // The sessions of the timeline come back from the event lines.
+    QCOMPARE(analyze.timelinePlot->itemCount(), timelineItems);
+
+    // The index is dropped once the log changes.
+    {
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::Append | QIODevice::Text));
+        file.write("GuideState,602.000,Guiding\n");
+    }
+    analyze.reset();
+    QVERIFY(!analyze.readLogIndex(filename));
+}
+
+QTEST_MAIN(TestAnalyzeLog)
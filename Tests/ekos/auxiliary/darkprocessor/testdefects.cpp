@@ -28,6 +28,7 @@ class TestDefects : public QObject
 
     private slots:
         void basicTest();
+        void bitmapTest();
 };
 
 #include "testdefects.moc"
@@ -96,4 +97,59 @@ void TestDefects::basicTest()
     }
 }
 
+void TestDefects::bitmapTest()
+{
+    const QString filename = "../Tests/ekos/auxiliary/darkprocessor/hotpixels.fits";
+    if (!QFileInfo::exists(filename))
+        QSKIP(QString("Failed to locate file %1, skipping test.").arg(filename).toLatin1());
+
+    QSharedPointer<FITSData> darkData;
+    darkData.reset(new FITSData());
+    QFuture<bool> result = darkData->loadFromFile(filename);
+    result.waitForFinished();
+
+    if (result.result() == false)
+        QSKIP("Failed to load image, skipping test.");
+
+    QSharedPointer<DefectMap> map;
+    map.reset(new DefectMap());
+    map->setDarkData(darkData);
+
+    // The bitmap must flag exactly the pixels within the thresholds, whichever way the thresholds move.
+    auto verifyBitmap = [&map]()
+    {
+        uint32_t flagged = 0;
+        for (uint32_t y = 0; y < map->bitmapHeight(); y++)
+            for (uint32_t x = 0; x < map->bitmapWidth(); x++)
+                flagged += map->isDefective(x, y) ? 1 : 0;
+
+        const uint32_t expected = (map->hotEnabled() ? map->hotCount() : 0) + (map->coldEnabled() ? map->coldCount() : 0);
+        QCOMPARE(flagged, expected);
+
+        for (auto onePixel = map->hotThreshold(); onePixel != map->hotPixels().cend(); ++onePixel)
+            QVERIFY(map->isDefective(onePixel->x, onePixel->y));
+        for (auto onePixel = map->coldPixels().cbegin(); onePixel != map->coldThreshold(); ++onePixel)
+            QVERIFY(map->isDefective(onePixel->x, onePixel->y));
+    };
+
+    verifyBitmap();
+
+    for (int aggressiveness : {100, 10, 60, 100, 0})
+    {
+        map->setProperty("HotPixelAggressiveness", aggressiveness);
+        map->setProperty("ColdPixelAggressiveness", aggressiveness);
+        map->filterPixels();
+        verifyBitmap();
+    }
+
+    map->setHotEnabled(false);
+    verifyBitmap();
+    map->setHotEnabled(true);
+    verifyBitmap();
+
+    // Pixels outside the map are never defective.
+    QVERIFY(!map->isDefective(map->bitmapWidth(), 0));
+    QVERIFY(!map->isDefective(0, map->bitmapHeight()));
+}
+
 QTEST_GUILESS_MAIN(TestDefects)
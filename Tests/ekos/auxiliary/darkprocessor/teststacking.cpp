@@ -0,0 +1,120 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QtTest>
+#include <memory>
+
+#include <QObject>
+#include "fitsviewer/fitsdata.h"
+#include "ekos/auxiliary/darkstacker.h"
+
+class TestStacking : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestStacking();
+        ~TestStacking() override = default;
+
+    private slots:
+        void initTestCase();
+        void stackTest_data();
+        void stackTest();
+
+    private:
+        QSharedPointer<FITSData> m_Frame;
+        QByteArray m_Original;
+};
+
+#include "teststacking.moc"
+
+Q_DECLARE_METATYPE(Ekos::DarkStacker::Algorithm);
+
+TestStacking::TestStacking() : QObject()
+{
+}
+
+void TestStacking::initTestCase()
+{
+    const QString filename = "../Tests/ekos/auxiliary/darkprocessor/hotpixels.fits";
+    if (!QFileInfo::exists(filename))
+        QSKIP(QString("Failed to locate file %1, skipping test.").arg(filename).toLatin1());
+
+    m_Frame.reset(new FITSData());
+    QFuture<bool> result = m_Frame->loadFromFile(filename);
+    result.waitForFinished();
+    if (result.result() == false)
+        QSKIP("Failed to load image, skipping test.");
+    if (m_Frame->dataType() != TBYTE)
+        QSKIP("Test image is expected to be 8 bits, skipping test.");
+
+    m_Original = QByteArray(reinterpret_cast<const char *>(m_Frame->getImageBuffer()), m_Frame->samplesPerChannel());
+}
+
+void TestStacking::stackTest_data()
+{
+    QTest::addColumn<Ekos::DarkStacker::Algorithm>("ALGORITHM");
+    QTest::addColumn<double>("KAPPA");
+    QTest::addColumn<int>("OUTLIER_RESULT");
+    QTest::addColumn<int>("REJECTED");
+
+    // Pixels are base+30, base+32, base+34, base+36, base+38, base+40 in the six frames, except the outlier
+    // pixel, with a base of 0, which is 250 in the third frame: 30, 32, 250, 36, 38, 40.
+    // Elsewhere every algorithm gives base+35, nothing is rejected with these deviations.
+    QTest::newRow("AVERAGE") << Ekos::DarkStacker::STACK_AVERAGE << 3.0 << 71 << 0;
+    QTest::newRow("MEDIAN") << Ekos::DarkStacker::STACK_MEDIAN << 3.0 << 37 << 0;
+    // The outlier is rejected, the mean of the others is 35.2.
+    QTest::newRow("SIGMA_CLIP") << Ekos::DarkStacker::STACK_SIGMA_CLIP << 2.0 << 35 << 1;
+    QTest::newRow("WINSORIZED") << Ekos::DarkStacker::STACK_WINSORIZED_SIGMA_CLIP << 3.0 << 35 << 1;
+}
+
+void TestStacking::stackTest()
+{
+    QFETCH(Ekos::DarkStacker::Algorithm, ALGORITHM);
+    QFETCH(double, KAPPA);
+    QFETCH(int, OUTLIER_RESULT);
+    QFETCH(int, REJECTED);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    const int samples = m_Original.size();
+    auto base = [](int index)
+    {
+        return index % 50;
+    };
+
+    Ekos::DarkStacker stacker(directory.path());
+    uint8_t *buffer = m_Frame->getWritableImageBuffer();
+    constexpr int outlierIndex = 5050;
+    QCOMPARE(base(outlierIndex), 0);
+    for (int i = 0; i < 6; i++)
+    {
+        for (int j = 0; j < samples; j++)
+            buffer[j] = static_cast<uint8_t>(base(j) + 30 + 2 * i);
+        // Simulate a cosmic ray in the third frame.
+        if (i == 2)
+            buffer[outlierIndex] = 250;
+        QVERIFY(stacker.addFrame(m_Frame));
+    }
+    QCOMPARE(stacker.frameCount(), 6);
+    memcpy(buffer, m_Original.constData(), samples);
+
+    QSharedPointer<FITSData> master(new FITSData(m_Frame));
+    memset(master->getWritableImageBuffer(), 0, samples);
+    QVERIFY2(stacker.stack(master, ALGORITHM, KAPPA), stacker.lastError().toLatin1());
+
+    const uint8_t *stacked = master->getImageBuffer();
+    for (int j = 0; j < samples; j++)
+    {
+        const int expected = j == outlierIndex ? OUTLIER_RESULT : base(j) + 35;
+        if (stacked[j] != expected)
+            QFAIL(QString("Pixel %1 is %2 instead of %3").arg(j).arg(stacked[j]).arg(expected).toLatin1());
+    }
+    QCOMPARE(stacker.rejectedCount(), static_cast<qint64>(REJECTED));
+}
+
+QTEST_GUILESS_MAIN(TestStacking)
@@ -0,0 +1,203 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains unit tests for the decimated storage of the samples of the time graphs.
+ */
+
+#include "ekos/auxiliary/decimatedseries.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+#include <cmath>
+#include <limits>
+
+class TestDecimatedSeries : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestDecimatedSeries();
+
+        /** @short Destructor */
+        ~TestDecimatedSeries() override = default;
+
+    private slots:
+        void levelOrderTest();
+        void gapTest();
+        void outOfOrderTest();
+        void capacityTest();
+        void saveLoadTest();
+};
+
+// This include must go after the class declaration.
+#include "testdecimatedseries.moc"
+
+namespace
+{
+// Keys of the points filled in a graph, checking that they are in time order
+bool inOrder(const QCPGraphDataContainer &data)
+{
+    double last = -std::numeric_limits<double>::infinity();
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it)
+    {
+        if (it->key < last)
+            return false;
+        last = it->key;
+    }
+    return true;
+}
+}
+
+TestDecimatedSeries::TestDecimatedSeries() : QObject()
+{
+}
+
+void TestDecimatedSeries::levelOrderTest()
+{
+    // 1003 samples, so that every level has points not yet decimated into the next one
+    Ekos::DecimatedSeries series;
+    for (int i = 0; i < 1003; i++)
+        series.append(i, i == 777 ? 10.0 : std::sin(i / 20.0));
+    QCOMPARE(series.size(), 1003);
+
+    QCPGraphDataContainer data;
+    series.fill(&data, 0, 1002, 50);
+    QVERIFY(data.size() < 200);
+    QVERIFY(inOrder(data));
+
+    // The points of the coarse level come first, then the latest samples of the finer levels, down to the
+    // samples not decimated yet.
+    QVERIFY(data.size() > 3);
+    auto tail = data.constEnd() - 3;
+    for (int i = 1000; i < 1003; i++, tail++)
+        QCOMPARE(tail->key, static_cast<double>(i));
+
+    // The peak survives the decimation.
+    double peak = 0;
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it)
+        peak = std::max(peak, it->value);
+    QCOMPARE(peak, 10.0);
+
+    // All the samples when they fit.
+    series.fill(&data, 0, 1002, 2000);
+    QCOMPARE(data.size(), 1003);
+    QVERIFY(inOrder(data));
+}
+
+void TestDecimatedSeries::gapTest()
+{
+    Ekos::DecimatedSeries series;
+    for (int i = 0; i < 1000; i++)
+        series.append(i, i == 500 ? qQNaN() : 1.0 + i % 3);
+
+    QCPGraphDataContainer data;
+    series.fill(&data, 0, 999, 20);
+    QVERIFY(data.size() < 100);
+
+    bool gap = false;
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it)
+        gap |= qIsNaN(it->value) && it->key == 500;
+    QVERIFY(gap);
+
+    // NaN values do not count in the range.
+    bool found = false;
+    const QCPRange range = series.valueRange(&found);
+    QVERIFY(found);
+    QCOMPARE(range.lower, 1.0);
+    QCOMPARE(range.upper, 3.0);
+}
+
+void TestDecimatedSeries::outOfOrderTest()
+{
+    Ekos::DecimatedSeries series;
+    for (int i = 0; i < 100; i++)
+    {
+        if (i != 50)
+            series.append(i, i);
+    }
+    series.append(50, -5);
+    QCOMPARE(series.size(), 100);
+    for (int i = 0; i < 100; i++)
+        QCOMPARE(series.key(i), static_cast<double>(i));
+    QCOMPARE(series.value(50), -5.0);
+
+    QCPGraphDataContainer data;
+    series.fill(&data, 0, 99, 10);
+    QVERIFY(inOrder(data));
+
+    bool found = false;
+    QCOMPARE(series.valueRange(&found).lower, -5.0);
+
+    QCOMPARE(series.findBegin(50), 49);
+    QCOMPARE(series.findEnd(50), 52);
+}
+
+void TestDecimatedSeries::capacityTest()
+{
+    constexpr int capacity = 100;
+    Ekos::DecimatedSeries series(capacity);
+    for (int i = 0; i < 1000; i++)
+        series.append(i, i);
+
+    QVERIFY(series.size() >= capacity);
+    QVERIFY(series.size() <= capacity + capacity / 8);
+    QCOMPARE(series.key(series.size() - 1), 999.0);
+
+    // The range follows the samples that are kept.
+    bool found = false;
+    const QCPRange range = series.valueRange(&found);
+    QVERIFY(found);
+    QCOMPARE(range.lower, series.value(0));
+    QCOMPARE(range.upper, 999.0);
+
+    QCPGraphDataContainer data;
+    series.fill(&data, 0, 999, 20);
+    QVERIFY(inOrder(data));
+    QCOMPARE(data.constBegin()->key, series.key(0));
+}
+
+void TestDecimatedSeries::saveLoadTest()
+{
+    Ekos::DecimatedSeries series;
+    for (int i = 0; i < 300; i++)
+        series.append(i * 0.5, i % 50 == 0 ? qQNaN() : std::cos(i / 10.0));
+
+    QByteArray buffer;
+    {
+        QDataStream stream(&buffer, QIODevice::WriteOnly);
+        series.save(stream);
+    }
+
+    Ekos::DecimatedSeries loaded;
+    loaded.append(-1, 100);
+    QDataStream stream(buffer);
+    QVERIFY(loaded.load(stream));
+
+    QCOMPARE(loaded.size(), series.size());
+    for (int i = 0; i < series.size(); i++)
+    {
+        QCOMPARE(loaded.key(i), series.key(i));
+        if (qIsNaN(series.value(i)))
+            QVERIFY(qIsNaN(loaded.value(i)));
+        else
+            QCOMPARE(loaded.value(i), series.value(i));
+    }
+
+    bool found = false, loadedFound = false;
+    QCOMPARE(loaded.valueRange(&loadedFound).lower, series.valueRange(&found).lower);
+    QCOMPARE(loaded.valueRange(&loadedFound).upper, series.valueRange(&found).upper);
+    QCOMPARE(loadedFound, found);
+
+    // A truncated stream is rejected.
+    QDataStream truncated(buffer.left(buffer.size() / 2));
+    QVERIFY(!loaded.load(truncated));
+}
+
+QTEST_GUILESS_MAIN(TestDecimatedSeries)
@@ -138,6 +138,132 @@ void TestFitsData::testBahtinovFocusHFR()
 #endif
 }
 
+void TestFitsData::testHFRMap_data()
+{
+    QTest::addColumn<int>("STARS_PER_CELL");
+
+    // Enough stars to process the cells in parallel or not.
+    QTest::newRow("SERIAL") << 5;
+    QTest::newRow("PARALLEL") << 300;
+}
+
+void TestFitsData::testHFRMap()
+{
+    QFETCH(int, STARS_PER_CELL);
+
+    // 300x300 frame, stars get worse from left to right: HFR 2, 2.5 and 3 in the 3 columns.
+    QList<Edge *> stars;
+    for (int row = 0; row < 3; ++row)
+        for (int column = 0; column < 3; ++column)
+            for (int i = 0; i < STARS_PER_CELL; ++i)
+            {
+                Edge *star = new Edge();
+                star->x = column * 100 + 10 + (i % 80);
+                star->y = row * 100 + 10 + (i % 70);
+                star->HFR = 2 + 0.5 * column;
+                star->ellipticity = 0;
+                stars.append(star);
+            }
+
+    FITSHFRMap map;
+    map.compute(stars, 300, 300);
+    QVERIFY(map.isValid());
+    QCOMPARE(map.columns(), 3);
+    QCOMPARE(map.rows(), 3);
+    QCOMPARE(map.cell(2, 1).region, QRect(200, 100, 100, 100));
+    QCOMPARE(map.cell(2, 1).stars, STARS_PER_CELL);
+    QCOMPARE(map.cell(0, 0).hfr, 2.0);
+    QCOMPARE(map.cell(2, 2).hfr, 3.0);
+    QCOMPARE(map.cell(1, 0).fwhm, 5.0);
+    QCOMPARE(map.cell(1, 0).eccentricity, 0.0);
+    QCOMPARE(map.hfr(), 2.5);
+    QCOMPARE(map.tiltX(), 1.0);
+    QCOMPARE(map.tiltY(), 0.0);
+    QCOMPARE(map.tilt(), 40.0);
+    QCOMPARE(map.offAxis(), 0.0);
+    QCOMPARE(map.toVariantMap()["cells"].toList().size(), 9);
+
+    // Without stars in a corner, there is no tilt but the other cells are still valid.
+    stars.erase(std::remove_if(stars.begin(), stars.end(), [](Edge * star)
+    {
+        const bool topLeft = star->x < 100 && star->y < 100;
+        if (topLeft)
+            delete star;
+        return topLeft;
+    }), stars.end());
+    map.compute(stars, 300, 300);
+    QVERIFY(map.isValid());
+    QVERIFY(!map.cell(0, 0).isValid());
+    QCOMPARE(map.cell(0, 0).stars, 0);
+    QCOMPARE(map.cell(0, 1).hfr, 2.0);
+    QCOMPARE(map.tilt(), -1.0);
+
+    qDeleteAll(stars);
+}
+
+void TestFitsData::testWCSBatch()
+{
+#if defined(HAVE_WCSLIB)
+    FITSData data(FITS_NORMAL);
+    QFuture<bool> worker = data.loadFromFile("ngc4535-autofocus1.fits");
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 60000);
+    QVERIFY(worker.result());
+    // 1 arcsec per pixel, the field crosses RA 0.
+    data.injectWCS(30, 0.05, 45, 1.0, true);
+    QVERIFY(data.checkForWCS());
+
+    // Batched conversions are the same as one point at a time
+    QVector<QPointF> pixels;
+    for (int i = 0; i < 20; i++)
+        pixels.append(QPointF(i * data.width() / 20.0 + 0.5, i * data.height() / 20.0 + 0.25));
+    QVector<SkyPoint> coords;
+    QVector<bool> valid;
+    QVERIFY(data.pixelToWCS(pixels, coords, valid));
+    QCOMPARE(coords.size(), pixels.size());
+
+    QVector<QPointF> roundTrip;
+    QVector<bool> roundTripValid;
+    QVERIFY(data.wcsToPixel(coords, roundTrip, roundTripValid));
+    for (int i = 0; i < pixels.size(); i++)
+    {
+        QVERIFY(valid[i] && roundTripValid[i]);
+        SkyPoint single;
+        QVERIFY(data.pixelToWCS(pixels[i], single));
+        QCOMPARE(coords[i].ra0().Degrees(), single.ra0().Degrees());
+        QCOMPARE(coords[i].dec0().Degrees(), single.dec0().Degrees());
+        QVERIFY(std::fabs(roundTrip[i].x() - pixels[i].x()) < 1e-6);
+        QVERIFY(std::fabs(roundTrip[i].y() - pixels[i].y()) < 1e-6);
+
+        // Interpolated coordinates are within a tenth of an arcsecond
+        SkyPoint interpolated;
+        QVERIFY(data.pixelToWCSInterpolated(pixels[i], interpolated));
+        QVERIFY(interpolated.angularDistanceTo(&single).Degrees() * 3600 < 0.1);
+    }
+
+#if !defined(KSTARS_LITE)
+    // Sampled bounds are the same as the bounds of every edge pixel
+    double minRA, maxRA, minDec, maxDec;
+    QVERIFY(data.findWCSBounds(minRA, maxRA, minDec, maxDec));
+    QVector<QPointF> edge;
+    for (int y = 0; y < data.height(); y++)
+        edge << QPointF(0, y) << QPointF(data.width() - 1, y);
+    for (int x = 1; x < data.width() - 1; x++)
+        edge << QPointF(x, 0) << QPointF(x, data.height() - 1);
+    QVERIFY(data.pixelToWCS(edge, coords, valid));
+    double expectedMinDec = 1000, expectedMaxDec = -1000;
+    for (const auto &coord : coords)
+    {
+        expectedMinDec = std::min(expectedMinDec, coord.dec0().Degrees());
+        expectedMaxDec = std::max(expectedMaxDec, coord.dec0().Degrees());
+    }
+    QVERIFY(std::fabs(minDec - expectedMinDec) * 3600 < 0.1);
+    QVERIFY(std::fabs(maxDec - expectedMaxDec) * 3600 < 0.1);
+#endif
+#else
+    QSKIP("WCS support is not available");
+#endif
+}
+
 void TestFitsData::initGenericDataFixture()
 {
 #if QT_VERSION < 0x050900
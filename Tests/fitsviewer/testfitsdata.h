@@ -52,6 +52,11 @@ class TestFitsData : public QObject
         void testBahtinovFocusHFR_data();
         void testBahtinovFocusHFR();
 
+        void testHFRMap_data();
+        void testHFRMap();
+
+        void testWCSBatch();
+
         void testParallelSolvers();
     private:
         void startGuideDetect(const QString &filename);
@@ -30,6 +30,7 @@ class TestFocus : public QObject
         void L1PHyperbolaTest();
         void L1PParabolaTest();
         void L1PQuadraticTest();
+        void robustCurveFitTest();
 };
 
 #include "testfocus.moc"
@@ -52,11 +53,12 @@ FocusAlgorithmInterface::FocusParams makeParams()
     const int backlash = 0;
     const Ekos::CurveFitting::CurveFit curveFit = Ekos::CurveFitting::FOCUS_QUADRATIC;
     const bool useWeights = false;
+    const bool robustFit = false;
     const FocusAlgorithmInterface::FocusParams params(
         maxTravel, initialStepSize, startPosition, minPositionAllowed,
         maxPositionAllowed, maxIterations, focusTolerance, filterName,
         temperature, initialOutwardSteps, focusAlgorithm, backlash,
-        curveFit, useWeights);
+        curveFit, useWeights, robustFit);
 
     return params;
 }
@@ -77,11 +79,12 @@ FocusAlgorithmInterface::FocusParams makeL1PHyperbolaParams()
     const int backlash = 300;
     const Ekos::CurveFitting::CurveFit curveFit = Ekos::CurveFitting::FOCUS_HYPERBOLA;
     const bool useWeights = true;
+    const bool robustFit = false;
     const FocusAlgorithmInterface::FocusParams params(
         maxTravel, initialStepSize, startPosition, minPositionAllowed,
         maxPositionAllowed, maxIterations, focusTolerance, filterName,
         temperature, initialOutwardSteps, focusAlgorithm, backlash,
-        curveFit, useWeights);
+        curveFit, useWeights, robustFit);
 
     return params;
 }
@@ -102,11 +105,12 @@ FocusAlgorithmInterface::FocusParams makeL1PParabolaParams()
     const int backlash = 200;
     const Ekos::CurveFitting::CurveFit curveFit = Ekos::CurveFitting::FOCUS_PARABOLA;
     const bool useWeights = false;
+    const bool robustFit = false;
     const FocusAlgorithmInterface::FocusParams params(
         maxTravel, initialStepSize, startPosition, minPositionAllowed,
         maxPositionAllowed, maxIterations, focusTolerance, filterName,
         temperature, initialOutwardSteps, focusAlgorithm, backlash,
-        curveFit, useWeights);
+        curveFit, useWeights, robustFit);
 
     return params;
 }
@@ -127,11 +131,12 @@ FocusAlgorithmInterface::FocusParams makeL1PQuadraticParams()
     const int backlash = 0;
     const Ekos::CurveFitting::CurveFit curveFit = Ekos::CurveFitting::FOCUS_QUADRATIC;
     const bool useWeights = false;
+    const bool robustFit = false;
     const FocusAlgorithmInterface::FocusParams params(
         maxTravel, initialStepSize, startPosition, minPositionAllowed,
         maxPositionAllowed, maxIterations, focusTolerance, filterName,
         temperature, initialOutwardSteps, focusAlgorithm, backlash,
-        curveFit, useWeights);
+        curveFit, useWeights, robustFit);
 
     return params;
 }
@@ -820,4 +825,41 @@ void TestFocus::L1PQuadraticTest()
     QCOMPARE(focuser->doneReason(), "Solution found.");
 }
 
+void TestFocus::robustCurveFitTest()
+{
+    // Parabola y = a + b * (x - c)^2 with a = 2, b = 1e-5, c = 10000
+    const double a = 2.0, b = 1e-5, c = 10000.0;
+    QVector<int> positions;
+    QVector<double> hfrs, sigmas;
+    for (int x = 9000; x <= 11000; x += 200)
+    {
+        positions.push_back(x);
+        hfrs.push_back(a + b * (x - c) * (x - c));
+        sigmas.push_back(1.0);
+    }
+
+    double minPos = 0, minVal = 0;
+    Ekos::CurveFitting curveFit;
+
+    // Exact data, the fit should recover the minimum. Fitting twice reuses the solver workspace.
+    for (int i = 0; i < 2; ++i)
+    {
+        curveFit.fitCurve(positions, hfrs, sigmas, Ekos::CurveFitting::FOCUS_PARABOLA, false);
+        QVERIFY(curveFit.findMin(c, 0, 20000, &minPos, &minVal, Ekos::CurveFitting::FOCUS_PARABOLA));
+        QVERIFY(fabs(minPos - c) < 1);
+        QVERIFY(fabs(minVal - a) < 0.01);
+    }
+
+    // Spoil one datapoint, e.g. a cloud passing during that exposure.
+    hfrs[3] += 5.0;
+    curveFit.fitCurve(positions, hfrs, sigmas, Ekos::CurveFitting::FOCUS_PARABOLA, false);
+    QVERIFY(curveFit.findMin(c, 0, 20000, &minPos, &minVal, Ekos::CurveFitting::FOCUS_PARABOLA));
+    const double plainError = fabs(minPos - c);
+
+    curveFit.fitCurve(positions, hfrs, sigmas, Ekos::CurveFitting::FOCUS_PARABOLA, false, true);
+    QVERIFY(curveFit.findMin(c, 0, 20000, &minPos, &minVal, Ekos::CurveFitting::FOCUS_PARABOLA));
+    const double robustError = fabs(minPos - c);
+    QVERIFY(robustError < plainError);
+}
+
 QTEST_GUILESS_MAIN(TestFocus)
@@ -0,0 +1,139 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/guide/internalguide/guidelatency.h"
+#include "auxiliary/monotonicclock.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+class TestGuideLatency : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestGuideLatency();
+
+        /** @short Destructor */
+        ~TestGuideLatency() override = default;
+
+    private slots:
+        void stageTest();
+        void incompleteFrameTest();
+        void zeroPulseCycleTest();
+        void histogramTest();
+};
+
+#include "testguidelatency.moc"
+
+TestGuideLatency::TestGuideLatency() : QObject()
+{
+}
+
+namespace
+{
+// Marks all the events of a frame, each one the given number of microseconds after the previous one.
+void runFrame(GuideLatency &latency, const QVector<qint64> &deltas)
+{
+    latency.startFrame(0);
+    qint64 time = MonotonicClock::timestamp();
+    latency.mark(GuideLatency::EXPOSURE_END, time);
+    for (int event = GuideLatency::BLOB_RECEIVED; event < GuideLatency::EVENT_COUNT; ++event)
+    {
+        time += deltas[event - 1];
+        latency.mark(static_cast<GuideLatency::Event>(event), time);
+    }
+}
+}
+
+void TestGuideLatency::stageTest()
+{
+    GuideLatency latency;
+    runFrame(latency, {100000, 20000, 1000, 5000, 200, 300});
+    QVERIFY(latency.completeFrame());
+
+    QCOMPARE(latency.lastDuration(GuideLatency::DOWNLOAD), 100.0);
+    QCOMPARE(latency.lastDuration(GuideLatency::LOAD), 20.0);
+    QCOMPARE(latency.lastDuration(GuideLatency::DISPATCH), 1.0);
+    QCOMPARE(latency.lastDuration(GuideLatency::DETECTION), 5.0);
+    QCOMPARE(latency.lastDuration(GuideLatency::DRIFT), 0.2);
+    QCOMPARE(latency.lastDuration(GuideLatency::PULSE), 0.3);
+    QCOMPARE(latency.lastDuration(GuideLatency::TOTAL), 126.5);
+    QCOMPARE(latency.histogram(GuideLatency::TOTAL).count(), 1);
+}
+
+void TestGuideLatency::incompleteFrameTest()
+{
+    GuideLatency latency;
+
+    // No star detected, e.g. the star was lost.
+    latency.startFrame(0);
+    latency.mark(GuideLatency::BLOB_RECEIVED);
+    latency.mark(GuideLatency::IMAGE_LOADED);
+    latency.mark(GuideLatency::PROCESSING_STARTED);
+    latency.mark(GuideLatency::PULSE_EMITTED);
+    QVERIFY(!latency.completeFrame());
+    QCOMPARE(latency.histogram(GuideLatency::TOTAL).count(), 0);
+
+    // The estimated exposure end is clamped to the BLOB arrival.
+    latency.startFrame(10);
+    for (int event = GuideLatency::BLOB_RECEIVED; event < GuideLatency::EVENT_COUNT; ++event)
+        latency.mark(static_cast<GuideLatency::Event>(event));
+    QVERIFY(latency.completeFrame());
+    QCOMPARE(latency.lastDuration(GuideLatency::DOWNLOAD), 0.0);
+}
+
+void TestGuideLatency::zeroPulseCycleTest()
+{
+    // When no pulse is needed, the guider requests the next frame right away, which starts a new latency
+    // frame. The cycle is recorded only if it is completed before that request.
+    GuideLatency latency;
+    for (int i = 0; i < 3; ++i)
+    {
+        runFrame(latency, {100000, 20000, 1000, 5000, 200, 0});
+        QVERIFY(latency.completeFrame());
+        latency.startFrame(1);
+    }
+    QCOMPARE(latency.histogram(GuideLatency::TOTAL).count(), 3);
+    QCOMPARE(latency.lastDuration(GuideLatency::PULSE), 0.0);
+    QCOMPARE(latency.lastDuration(GuideLatency::TOTAL), 126.2);
+
+    // Completing after the next frame started drops the cycle.
+    runFrame(latency, {100000, 20000, 1000, 5000, 200, 0});
+    latency.startFrame(1);
+    QVERIFY(!latency.completeFrame());
+    QCOMPARE(latency.histogram(GuideLatency::TOTAL).count(), 3);
+}
+
+void TestGuideLatency::histogramTest()
+{
+    GuideLatency::RollingHistogram histogram(4);
+    for (const double value : {0.5, 3.0, 30.0, 300.0, 6000.0})
+        histogram.add(value);
+
+    // The oldest sample was dropped.
+    QCOMPARE(histogram.count(), 4);
+    QCOMPARE(histogram.last(), 6000.0);
+    QCOMPARE(histogram.max(), 6000.0);
+    QCOMPARE(histogram.percentile(0.5), 300.0);
+    QCOMPARE(histogram.mean(), (3.0 + 30.0 + 300.0 + 6000.0) / 4);
+
+    const QVector<int> bins = histogram.bins();
+    QCOMPARE(bins.size(), GuideLatency::RollingHistogram::binEdges().size() + 1);
+    QCOMPARE(bins[0], 0);
+    QCOMPARE(bins[2], 1);
+    QCOMPARE(bins[5], 1);
+    QCOMPARE(bins[8], 1);
+    QCOMPARE(bins.last(), 1);
+
+    histogram.clear();
+    QCOMPARE(histogram.count(), 0);
+    QCOMPARE(histogram.percentile(0.5), 0.0);
+}
+
+QTEST_GUILESS_MAIN(TestGuideLatency)
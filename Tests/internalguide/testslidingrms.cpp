@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/auxiliary/rmsfilter.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+class TestSlidingRms : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestSlidingRms();
+
+        /** @short Destructor */
+        ~TestSlidingRms() override = default;
+
+    private slots:
+        void partialWindowTest();
+        void slidingTest();
+        void resetTest();
+};
+
+#include "testslidingrms.moc"
+
+TestSlidingRms::TestSlidingRms() : QObject()
+{
+}
+
+void TestSlidingRms::partialWindowTest()
+{
+    Ekos::SlidingRms rms(4);
+    QCOMPARE(rms.count(), 0);
+    QCOMPARE(rms.rms(), 0.0);
+
+    rms.newSample(3, 4);
+    QCOMPARE(rms.count(), 1);
+    QCOMPARE(rms.rmsX(), 3.0);
+    QCOMPARE(rms.rmsY(), 4.0);
+    QCOMPARE(rms.rms(), 5.0);
+
+    rms.newSample(-1, 0);
+    QCOMPARE(rms.count(), 2);
+    QCOMPARE(rms.rmsX(), std::sqrt(5.0));
+    QCOMPARE(rms.rmsY(), std::sqrt(8.0));
+}
+
+void TestSlidingRms::slidingTest()
+{
+    // Compare with the RMS recomputed over the last samples, across several wraps of the window.
+    constexpr int window = 5;
+    Ekos::SlidingRms rms(window);
+    QVector<QPointF> samples;
+    for (int i = 0; i < 23; i++)
+    {
+        const QPointF sample(std::sin(i) * 2.5, std::cos(i * 0.7) - 0.3);
+        samples.append(sample);
+        rms.newSample(sample.x(), sample.y());
+
+        double sumX = 0, sumY = 0;
+        const int first = std::max(0, samples.size() - window);
+        for (int j = first; j < samples.size(); j++)
+        {
+            sumX += samples[j].x() * samples[j].x();
+            sumY += samples[j].y() * samples[j].y();
+        }
+        const int count = samples.size() - first;
+        QCOMPARE(rms.count(), count);
+        QVERIFY(qAbs(rms.rmsX() - std::sqrt(sumX / count)) < 1e-12);
+        QVERIFY(qAbs(rms.rmsY() - std::sqrt(sumY / count)) < 1e-12);
+        QVERIFY(qAbs(rms.rms() - std::sqrt((sumX + sumY) / count)) < 1e-12);
+    }
+}
+
+void TestSlidingRms::resetTest()
+{
+    Ekos::SlidingRms rms(3);
+    rms.newSample(10, 10);
+    rms.newSample(10, 10);
+    rms.reset();
+    QCOMPARE(rms.count(), 0);
+    QCOMPARE(rms.rms(), 0.0);
+
+    rms.newSample(1, 0);
+    QCOMPARE(rms.rmsX(), 1.0);
+    QCOMPARE(rms.rmsY(), 0.0);
+}
+
+QTEST_GUILESS_MAIN(TestSlidingRms)
@@ -0,0 +1,143 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains unit tests for the star centroid used to follow the polar alignment star.
+ */
+
+#include "ekos/guide/internalguide/guidealgorithms.h"
+
+#include <QtTest>
+
+#include <QObject>
+#include <QRandomGenerator>
+
+#include <cmath>
+
+class TestStarCentroid : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestStarCentroid();
+
+        /** @short Destructor */
+        ~TestStarCentroid() override = default;
+
+    private slots:
+        void neighbourTest_data();
+        void neighbourTest();
+        void edgeTest();
+        void noStarTest();
+};
+
+// This include must go after the class declaration.
+#include "teststarcentroid.moc"
+
+namespace
+{
+constexpr int WIDTH  = 200;
+constexpr int HEIGHT = 150;
+constexpr int SEARCH_RADIUS = 32;
+constexpr int REFINE_RADIUS = 12;
+
+struct Star
+{
+    QPointF position;
+    double amplitude;
+};
+
+// 16 bits image of gaussian stars over a noisy background
+QSharedPointer<FITSData> makeImage(const QVector<Star> &stars)
+{
+    QSharedPointer<FITSData> image(new FITSData(FITS_NORMAL));
+    auto stats = image->getStatistics();
+    stats.width = WIDTH;
+    stats.height = HEIGHT;
+    stats.dataType = TUSHORT;
+    stats.bytesPerPixel = sizeof(uint16_t);
+    stats.samples_per_channel = WIDTH * HEIGHT;
+    stats.channels = 1;
+    image->restoreStatistics(stats);
+
+    QRandomGenerator random(7);
+    auto buffer = new uint16_t[WIDTH * HEIGHT];
+    for (int j = 0; j < HEIGHT; ++j)
+    {
+        for (int i = 0; i < WIDTH; ++i)
+        {
+            double value = 1000 + (random.generateDouble() - 0.5) * 80;
+            for (const auto &star : stars)
+            {
+                const double dx = i - star.position.x();
+                const double dy = j - star.position.y();
+                value += star.amplitude * std::exp(-(dx * dx + dy * dy) / 8.0);
+            }
+            buffer[j * WIDTH + i] = static_cast<uint16_t>(std::min(value, 65535.0));
+        }
+    }
+    image->setImageBuffer(reinterpret_cast<uint8_t *>(buffer));
+    return image;
+}
+}
+
+TestStarCentroid::TestStarCentroid() : QObject()
+{
+}
+
+void TestStarCentroid::neighbourTest_data()
+{
+    // Position of a brighter neighbour, within the search box but outside of the refinement box of the star
+    QTest::addColumn<QPointF>("NEIGHBOUR");
+
+    QTest::newRow("no neighbour") << QPointF(-100, -100);
+    QTest::newRow("right") << QPointF(122.0, 80.0);
+    QTest::newRow("above") << QPointF(95.5, 48.0);
+    QTest::newRow("diagonal") << QPointF(78.0, 90.5);
+}
+
+void TestStarCentroid::neighbourTest()
+{
+    QFETCH(QPointF, NEIGHBOUR);
+
+    // The star moved by a few pixels since the last frame, the neighbour is much brighter.
+    const QPointF star(100.3, 70.6);
+    auto image = makeImage({{star, 3000}, {NEIGHBOUR, 20000}});
+
+    QPointF centroid;
+    QVERIFY(GuideAlgorithms::findStarCentroid(image, QPointF(103, 68), SEARCH_RADIUS, REFINE_RADIUS, &centroid));
+    QVERIFY2(std::hypot(centroid.x() - star.x(), centroid.y() - star.y()) < 0.1,
+             qPrintable(QString("Centroid (%1, %2)").arg(centroid.x()).arg(centroid.y())));
+}
+
+void TestStarCentroid::edgeTest()
+{
+    // The boxes are clipped to the image.
+    const QPointF star(5.2, 4.7);
+    auto image = makeImage({{star, 5000}});
+
+    QPointF centroid;
+    QVERIFY(GuideAlgorithms::findStarCentroid(image, QPointF(6, 6), SEARCH_RADIUS, REFINE_RADIUS, &centroid));
+    QVERIFY(std::hypot(centroid.x() - star.x(), centroid.y() - star.y()) < 0.1);
+}
+
+void TestStarCentroid::noStarTest()
+{
+    // Noise alone, or a star outside of the search box, is not a star.
+    QPointF centroid;
+    auto image = makeImage({});
+    QVERIFY(!GuideAlgorithms::findStarCentroid(image, QPointF(100, 70), SEARCH_RADIUS, REFINE_RADIUS, &centroid));
+
+    image = makeImage({{QPointF(160, 70), 20000}});
+    QVERIFY(!GuideAlgorithms::findStarCentroid(image, QPointF(100, 70), SEARCH_RADIUS, REFINE_RADIUS, &centroid));
+
+    // Nor is an empty image.
+    QVERIFY(!GuideAlgorithms::findStarCentroid(QSharedPointer<FITSData>(), QPointF(100, 70), SEARCH_RADIUS, REFINE_RADIUS,
+            &centroid));
+}
+
+QTEST_GUILESS_MAIN(TestStarCentroid)
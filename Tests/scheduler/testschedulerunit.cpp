@@ -41,6 +41,7 @@ class TestSchedulerUnit : public QObject
         void setupJobTest_data();
         void setupJobTest();
         void loadSequenceQueueTest();
+        void sequenceSummaryTest();
         void estimateJobTimeTest();
         void calculateJobScoreTest();
         void evaluateJobsTest();
@@ -391,6 +392,43 @@ void TestSchedulerUnit::loadSequenceQueueTest()
     compareCaptureSequence(details9Filters, jobs);
 }
 
+// Test Ekos::SequenceSummary, the cached sequence description used by the scheduler.
+// It must describe the same jobs and signatures as loadSequenceQueue(), and be parsed only once.
+void TestSchedulerUnit::sequenceSummaryTest()
+{
+    SchedulerJob schedJob(nullptr);
+    schedJob.setName("Job1");
+
+    QList<Ekos::SequenceJob *> jobs;
+    bool hasAutoFocus = false;
+    QVERIFY(Scheduler::loadSequenceQueue(seqFile9Filters, &schedJob, jobs, hasAutoFocus, nullptr));
+
+    Ekos::SequenceSummary::clearCache();
+    Ekos::SequenceSummary::Ptr summary = Ekos::SequenceSummary::load(seqFile9Filters, "Job1");
+    QVERIFY(!summary.isNull());
+    QCOMPARE(summary->jobs().size(), jobs.size());
+    QCOMPARE(summary->hasAutoFocus(), hasAutoFocus);
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        const auto &job = summary->jobs()[i];
+        QCOMPARE(job.filter, jobs[i]->getCoreProperty(SequenceJob::SJ_Filter).toString());
+        QCOMPARE(job.count, jobs[i]->getCoreProperty(SequenceJob::SJ_Count).toInt());
+        QCOMPARE(job.exposure, jobs[i]->getCoreProperty(SequenceJob::SJ_Exposure).toDouble());
+        QCOMPARE(job.frameType, jobs[i]->getFrameType());
+        QCOMPARE(job.signature, jobs[i]->getSignature());
+    }
+    qDeleteAll(jobs);
+
+    // An unchanged file is not parsed again
+    QVERIFY(Ekos::SequenceSummary::load(seqFile9Filters, "Job1") == summary);
+    // The signatures depend on the target
+    QVERIFY(Ekos::SequenceSummary::load(seqFile9Filters, "Job2") != summary);
+    // A missing file is an error
+    QString error;
+    QVERIFY(Ekos::SequenceSummary::load("/nonexistent/sequence.esq", "Job1", &error).isNull());
+    QVERIFY(!error.isEmpty());
+}
+
 namespace
 {
 // This utility computes the sum of time taken for all exposures in a capture sequence.
@@ -0,0 +1,110 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains unit tests for the sampling of the separations in KSConjunctBatch.
+ */
+
+#include <QObject>
+#include <QtTest>
+
+#include <cmath>
+
+#include "ksconjunctbatch.h"
+
+class TestKSConjunctBatch : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestKSConjunctBatch();
+
+        /** @short Destructor */
+        ~TestKSConjunctBatch() override = default;
+
+    private slots:
+        void skipBoundaryTest_data();
+        void skipBoundaryTest();
+        void farPairTest();
+};
+
+// This include must go after the class declaration.
+#include "testksconjunctbatch.moc"
+
+namespace
+{
+// Samples the separation of a pair passing at minDistance degrees at step center, moving rate degrees per step,
+// as KSConjunctBatch does. Returns the steps at which a minimum was detected.
+QVector<int> sampleApproach(double center, double minDistance, double rate, double maxSeparation, int steps)
+{
+    QVector<int> detections;
+    KSConjunctBatch::Samples samples;
+    for (int k = 0; k < steps; ++k)
+    {
+        if (samples.nextStep > k)
+            continue;
+        const double distance = std::hypot(minDistance, rate * (k - center));
+        if (KSConjunctBatch::addSample(samples, k, distance, rate, maxSeparation, steps))
+            detections.append(k);
+    }
+    return detections;
+}
+}
+
+TestKSConjunctBatch::TestKSConjunctBatch() : QObject()
+{
+}
+
+void TestKSConjunctBatch::skipBoundaryTest_data()
+{
+    QTest::addColumn<double>("RATE");
+    QTest::addColumn<double>("MIN_DISTANCE");
+
+    // The pair moves over several times the maximum separation in a step, e.g. the Moon on a 6 hours grid,
+    // so the approach often lands on the first steps sampled after a skip.
+    QTest::newRow("rate 3, central") << 3.0 << 0.0;
+    QTest::newRow("rate 4, grazing") << 4.0 << 0.95;
+    QTest::newRow("rate 8, half") << 8.0 << 0.5;
+    QTest::newRow("rate 8, grazing") << 8.0 << 0.95;
+}
+
+void TestKSConjunctBatch::skipBoundaryTest()
+{
+    QFETCH(double, RATE);
+    QFETCH(double, MIN_DISTANCE);
+
+    // Move the approach across several steps, so that it falls at every position relative to the skips.
+    constexpr double maxSeparation = 1.0;
+    for (int i = 0; i < 400; ++i)
+    {
+        const double center = 20 + i * 0.01;
+        const QVector<int> detections = sampleApproach(center, MIN_DISTANCE, RATE, maxSeparation, 100);
+
+        // The approach must be bracketed by the 3 samples of one detection.
+        bool bracketed = false;
+        for (const int k : detections)
+            bracketed |= k - 2 <= center && center <= k;
+        QVERIFY2(bracketed, qPrintable(QString("Approach at step %1 missed").arg(center)));
+    }
+}
+
+void TestKSConjunctBatch::farPairTest()
+{
+    // A pair that always stays apart is sampled rarely and never detected.
+    KSConjunctBatch::Samples samples;
+    int sampled = 0;
+    for (int k = 0; k < 1000; ++k)
+    {
+        if (samples.nextStep > k)
+            continue;
+        sampled++;
+        QVERIFY(!KSConjunctBatch::addSample(samples, k, 90.0 + std::sin(k / 50.0), 0.5, 1.0, 1000));
+    }
+    QVERIFY(sampled < 10);
+}
+
+QTEST_GUILESS_MAIN(TestKSConjunctBatch)
@@ -29,6 +29,14 @@
 
 KSUserDB::~KSUserDB()
 {
+    m_Statements.clear();
+    if (m_UserDB.isOpen())
+    {
+        // Move the write-ahead log into the database file before it is copied.
+        QSqlQuery query(m_UserDB);
+        if (!query.exec("PRAGMA wal_checkpoint(TRUNCATE)"))
+            qCWarning(KSTARS) << query.lastError();
+    }
     m_UserDB.close();
 
     // Backup
@@ -306,8 +314,9 @@ bool KSUserDB::Initialize()
             qCWarning(KSTARS) << query.lastError();
     }
 
+    // Opened again with the journal settings, it then stays open.
     m_UserDB.close();
-    return true;
+    return OpenDB();
 }
 
 QSqlError KSUserDB::LastError()
@@ -316,6 +325,71 @@ QSqlError KSUserDB::LastError()
     return m_UserDB.lastError();
 }
 
+bool KSUserDB::OpenDB()
+{
+    if (m_UserDB.isOpen())
+        return true;
+
+    // Statements prepared on a closed connection were finalized.
+    m_Statements.clear();
+    if (!m_UserDB.open())
+    {
+        qCCritical(KSTARS) << "Failed opening user database" << LastError();
+        return false;
+    }
+
+    // With a write-ahead log, a write appends to the log instead of rewriting pages of the database and
+    // readers do not block writers. NORMAL synchronous mode only syncs at checkpoints, which is safe with WAL.
+    QSqlQuery query(m_UserDB);
+    if (!query.exec("PRAGMA journal_mode=WAL"))
+        qCWarning(KSTARS) << query.lastError();
+    if (!query.exec("PRAGMA synchronous=NORMAL"))
+        qCWarning(KSTARS) << query.lastError();
+    return true;
+}
+
+QSharedPointer<QSqlQuery> KSUserDB::ExecPrepared(const QString &statement, const QVariantList &values)
+{
+    if (!OpenDB())
+        return QSharedPointer<QSqlQuery>();
+
+    // The connection can be closed and opened again through QSqlDatabase::database("userdb"),
+    // which finalizes the statements. A failing statement is then prepared again once.
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        QSharedPointer<QSqlQuery> query = m_Statements.value(statement);
+        if (query.isNull())
+        {
+            query.reset(new QSqlQuery(m_UserDB));
+            query->setForwardOnly(true);
+            if (!query->prepare(statement))
+            {
+                qCWarning(KSTARS) << statement << query->lastError().text();
+                return QSharedPointer<QSqlQuery>();
+            }
+            m_Statements.insert(statement, query);
+        }
+
+        for (int i = 0; i < values.size(); i++)
+            query->bindValue(i, values[i]);
+        if (query->exec())
+            return query;
+
+        if (attempt > 0)
+            qCWarning(KSTARS) << statement << query->lastError().text();
+        m_Statements.remove(statement);
+    }
+    return QSharedPointer<QSqlQuery>();
+}
+
+QVariantMap KSUserDB::RecordToMap(const QSqlRecord &record)
+{
+    QVariantMap recordMap;
+    for (int j = 0; j < record.count(); j++)
+        recordMap[record.fieldName(j)] = record.value(j);
+    return recordMap;
+}
+
 bool KSUserDB::FirstRun()
 {
     if (!RebuildDB())
@@ -563,7 +637,7 @@ bool KSUserDB::RebuildDB()
 */
 void KSUserDB::AddObserver(const QString &name, const QString &surname, const QString &contact)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
     users.setFilter("Name LIKE \'" + name + "\' AND Surname LIKE \'" + surname + "\'");
@@ -587,13 +661,11 @@ void KSUserDB::AddObserver(const QString &name, const QString &surname, const QS
         users.setData(users.index(row, 3), contact);
         users.submitAll();
     }
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::FindObserver(const QString &name, const QString &surname)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
     users.setFilter("Name LIKE \'" + name + "\' AND Surname LIKE \'" + surname + "\'");
@@ -602,14 +674,13 @@ bool KSUserDB::FindObserver(const QString &name, const QString &surname)
     int observer_count = users.rowCount();
 
     users.clear();
-    m_UserDB.close();
     return (observer_count > 0);
 }
 
 // TODO(spacetime): This method is currently unused.
 bool KSUserDB::DeleteObserver(const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
     users.setFilter("id = \'" + id + "\'");
@@ -621,18 +692,17 @@ bool KSUserDB::DeleteObserver(const QString &id)
     int observer_count = users.rowCount();
 
     users.clear();
-    m_UserDB.close();
     return (observer_count > 0);
 }
 QSqlDatabase KSUserDB::GetDatabase()
 {
-    m_UserDB.open();
+    OpenDB();
     return m_UserDB;
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
 {
-    m_UserDB.open();
+    OpenDB();
     observer_list.clear();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
@@ -650,7 +720,6 @@ void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
     }
 
     users.clear();
-    m_UserDB.close();
 }
 #endif
 
@@ -662,7 +731,7 @@ void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
  */
 void KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel darkframe(nullptr, m_UserDB);
     darkframe.setTable("darkframe");
     darkframe.select();
@@ -676,8 +745,7 @@ void KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
 
     darkframe.insertRecord(-1, record);
     darkframe.submitAll();
-
-    m_UserDB.close();
+    m_DarkFramesLoaded = false;
 }
 
 /**
@@ -686,7 +754,7 @@ void KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
  */
 void KSUserDB::UpdateDarkFrame(const QVariantMap &oneFrame)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel darkframe(nullptr, m_UserDB);
     darkframe.setTable("darkframe");
     darkframe.setFilter(QString("id=%1").arg(oneFrame["id"].toInt()));
@@ -698,7 +766,7 @@ void KSUserDB::UpdateDarkFrame(const QVariantMap &oneFrame)
 
     darkframe.setRecord(0, record);
     darkframe.submitAll();
-    m_UserDB.close();
+    m_DarkFramesLoaded = false;
 }
 
 /**
@@ -707,7 +775,7 @@ void KSUserDB::UpdateDarkFrame(const QVariantMap &oneFrame)
  */
 void KSUserDB::DeleteDarkFrame(const QString &filename)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel darkframe(nullptr, m_UserDB);
     darkframe.setTable("darkframe");
     darkframe.setFilter("filename = \'" + filename + "\'");
@@ -716,30 +784,25 @@ void KSUserDB::DeleteDarkFrame(const QString &filename)
 
     darkframe.removeRows(0, 1);
     darkframe.submitAll();
-
-    m_UserDB.close();
+    m_DarkFramesLoaded = false;
 }
 
-void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
+void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames, bool reload)
 {
-    darkFrames.clear();
-
-    m_UserDB.open();
-    QSqlTableModel darkframe(nullptr, m_UserDB);
-    darkframe.setTable("darkframe");
-    darkframe.select();
-
-    for (int i = 0; i < darkframe.rowCount(); ++i)
+    if (reload || !m_DarkFramesLoaded)
     {
-        QVariantMap recordMap;
-        QSqlRecord record = darkframe.record(i);
-        for (int j = 0; j < record.count(); j++)
-            recordMap[record.fieldName(j)] = record.value(j);
-
-        darkFrames.append(recordMap);
+        m_DarkFrames.clear();
+        auto query = ExecPrepared("SELECT * FROM darkframe");
+        if (query)
+        {
+            while (query->next())
+                m_DarkFrames.append(RecordToMap(query->record()));
+            query->finish();
+            m_DarkFramesLoaded = true;
+        }
     }
 
-    m_UserDB.close();
+    darkFrames = m_DarkFrames;
 }
 
 
@@ -747,7 +810,7 @@ void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 
 void KSUserDB::AddEffectiveFOV(const QVariantMap &oneFOV)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel effectivefov(nullptr, m_UserDB);
     effectivefov.setTable("effectivefov");
     effectivefov.select();
@@ -763,13 +826,11 @@ void KSUserDB::AddEffectiveFOV(const QVariantMap &oneFOV)
     effectivefov.insertRecord(-1, record);
 
     effectivefov.submitAll();
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::DeleteEffectiveFOV(const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel effectivefov(nullptr, m_UserDB);
     effectivefov.setTable("effectivefov");
     effectivefov.setFilter("id = \'" + id + "\'");
@@ -779,8 +840,6 @@ bool KSUserDB::DeleteEffectiveFOV(const QString &id)
     effectivefov.removeRows(0, 1);
     effectivefov.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -788,7 +847,7 @@ void KSUserDB::GetAllEffectiveFOVs(QList<QVariantMap> &effectiveFOVs)
 {
     effectiveFOVs.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel effectivefov(nullptr, m_UserDB);
     effectivefov.setTable("effectivefov");
     effectivefov.select();
@@ -802,15 +861,13 @@ void KSUserDB::GetAllEffectiveFOVs(QList<QVariantMap> &effectiveFOVs)
 
         effectiveFOVs.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 /* Optical Trains Section */
 
 void KSUserDB::AddOpticalTrain(const QVariantMap &oneTrain)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel opticalTrain(nullptr, m_UserDB);
     opticalTrain.setTable("opticaltrains");
     opticalTrain.select();
@@ -827,13 +884,12 @@ void KSUserDB::AddOpticalTrain(const QVariantMap &oneTrain)
 
     if (!opticalTrain.submitAll())
         qCWarning(KSTARS) << opticalTrain.lastError();
-
-    m_UserDB.close();
+    m_OpticalTrainsLoaded = false;
 }
 
 void KSUserDB::UpdateOpticalTrain(const QVariantMap &oneTrain, int id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel opticalTrain(nullptr, m_UserDB);
     opticalTrain.setTable("opticaltrains");
     opticalTrain.setFilter(QString("id=%1").arg(id));
@@ -848,13 +904,12 @@ void KSUserDB::UpdateOpticalTrain(const QVariantMap &oneTrain, int id)
 
     if (!opticalTrain.submitAll())
         qCWarning(KSTARS) << opticalTrain.lastError();
-
-    m_UserDB.close();
+    m_OpticalTrainsLoaded = false;
 }
 
 void KSUserDB::DeleteOpticalTrain(int id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel opticalTrain(nullptr, m_UserDB);
     opticalTrain.setTable("opticaltrains");
     opticalTrain.setFilter(QString("id=%1").arg(id));
@@ -863,38 +918,38 @@ void KSUserDB::DeleteOpticalTrain(int id)
 
     opticalTrain.removeRows(0, 1);
     opticalTrain.submitAll();
-
-    m_UserDB.close();
+    m_OpticalTrainsLoaded = false;
 }
 
 void KSUserDB::GetOpticalTrains(uint32_t profileID, QList<QVariantMap> &opticalTrains)
 {
     opticalTrains.clear();
 
-    m_UserDB.open();
-    QSqlTableModel opticalTrain(nullptr, m_UserDB);
-    opticalTrain.setTable("opticaltrains");
-    opticalTrain.setFilter(QString("profile=%1").arg(profileID));
-    opticalTrain.select();
-
-    for (int i = 0; i < opticalTrain.rowCount(); ++i)
+    if (!m_OpticalTrainsLoaded)
     {
-        QVariantMap recordMap;
-        QSqlRecord record = opticalTrain.record(i);
-        for (int j = 0; j < record.count(); j++)
-            recordMap[record.fieldName(j)] = record.value(j);
-
-        opticalTrains.append(recordMap);
+        m_OpticalTrains.clear();
+        auto query = ExecPrepared("SELECT * FROM opticaltrains");
+        if (query)
+        {
+            while (query->next())
+                m_OpticalTrains.append(RecordToMap(query->record()));
+            query->finish();
+            m_OpticalTrainsLoaded = true;
+        }
     }
 
-    m_UserDB.close();
+    for (const auto &oneTrain : m_OpticalTrains)
+    {
+        if (oneTrain["profile"].toUInt() == profileID)
+            opticalTrains.append(oneTrain);
+    }
 }
 
 /* Driver Alias Section */
 
 bool KSUserDB::AddCustomDriver(const QVariantMap &oneDriver)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel CustomDriver(nullptr, m_UserDB);
     CustomDriver.setTable("customdrivers");
     CustomDriver.select();
@@ -913,14 +968,12 @@ bool KSUserDB::AddCustomDriver(const QVariantMap &oneDriver)
 
     rc = CustomDriver.submitAll();
 
-    m_UserDB.close();
-
     return rc;
 }
 
 bool KSUserDB::DeleteCustomDriver(const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel CustomDriver(nullptr, m_UserDB);
     CustomDriver.setTable("customdrivers");
     CustomDriver.setFilter("id = \'" + id + "\'");
@@ -930,8 +983,6 @@ bool KSUserDB::DeleteCustomDriver(const QString &id)
     CustomDriver.removeRows(0, 1);
     CustomDriver.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -939,7 +990,7 @@ void KSUserDB::GetAllCustomDrivers(QList<QVariantMap> &CustomDrivers)
 {
     CustomDrivers.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel CustomDriver(nullptr, m_UserDB);
     CustomDriver.setTable("customdrivers");
     CustomDriver.select();
@@ -953,15 +1004,13 @@ void KSUserDB::GetAllCustomDrivers(QList<QVariantMap> &CustomDrivers)
 
         CustomDrivers.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 /* HiPS Section */
 
 void KSUserDB::AddHIPSSource(const QMap<QString, QString> &oneSource)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel HIPSSource(nullptr, m_UserDB);
     HIPSSource.setTable("hips");
     HIPSSource.select();
@@ -974,13 +1023,11 @@ void KSUserDB::AddHIPSSource(const QMap<QString, QString> &oneSource)
     HIPSSource.insertRecord(-1, record);
 
     HIPSSource.submitAll();
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::DeleteHIPSSource(const QString &ID)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel HIPSSource(nullptr, m_UserDB);
     HIPSSource.setTable("hips");
     HIPSSource.setFilter("ID = \'" + ID + "\'");
@@ -990,8 +1037,6 @@ bool KSUserDB::DeleteHIPSSource(const QString &ID)
     HIPSSource.removeRows(0, 1);
     HIPSSource.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -999,7 +1044,7 @@ void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 {
     HIPSSources.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel HIPSSource(nullptr, m_UserDB);
     HIPSSource.setTable("hips");
     HIPSSource.select();
@@ -1013,8 +1058,6 @@ void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 
         HIPSSources.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 
@@ -1022,7 +1065,7 @@ void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 
 void KSUserDB::AddDSLRInfo(const QMap<QString, QVariant> &oneInfo)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel DSLRInfo(nullptr, m_UserDB);
     DSLRInfo.setTable("dslr");
     DSLRInfo.select();
@@ -1035,13 +1078,11 @@ void KSUserDB::AddDSLRInfo(const QMap<QString, QVariant> &oneInfo)
     DSLRInfo.insertRecord(-1, record);
 
     DSLRInfo.submitAll();
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::DeleteAllDSLRInfo()
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel DSLRInfo(nullptr, m_UserDB);
     DSLRInfo.setTable("dslr");
     DSLRInfo.select();
@@ -1049,14 +1090,12 @@ bool KSUserDB::DeleteAllDSLRInfo()
     DSLRInfo.removeRows(0, DSLRInfo.rowCount());
     DSLRInfo.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
 bool KSUserDB::DeleteDSLRInfo(const QString &model)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel DSLRInfo(nullptr, m_UserDB);
     DSLRInfo.setTable("dslr");
     DSLRInfo.setFilter("model = \'" + model + "\'");
@@ -1066,8 +1105,6 @@ bool KSUserDB::DeleteDSLRInfo(const QString &model)
     DSLRInfo.removeRows(0, 1);
     DSLRInfo.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -1075,7 +1112,7 @@ void KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 {
     DSLRInfos.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel DSLRInfo(nullptr, m_UserDB);
     DSLRInfo.setTable("dslr");
     DSLRInfo.select();
@@ -1089,8 +1126,6 @@ void KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 
         DSLRInfos.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 /*
@@ -1099,7 +1134,7 @@ void KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 
 void KSUserDB::DeleteAllFlags()
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel flags(nullptr, m_UserDB);
     flags.setEditStrategy(QSqlTableModel::OnManualSubmit);
     flags.setTable("flags");
@@ -1109,13 +1144,12 @@ void KSUserDB::DeleteAllFlags()
     flags.submitAll();
 
     flags.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddFlag(const QString &ra, const QString &dec, const QString &epoch, const QString &image_name,
                        const QString &label, const QString &labelColor)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel flags(nullptr, m_UserDB);
     flags.setTable("flags");
 
@@ -1130,14 +1164,13 @@ void KSUserDB::AddFlag(const QString &ra, const QString &dec, const QString &epo
     flags.submitAll();
 
     flags.clear();
-    m_UserDB.close();
 }
 
 QList<QStringList> KSUserDB::GetAllFlags()
 {
     QList<QStringList> flagList;
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel flags(nullptr, m_UserDB);
     flags.setTable("flags");
     flags.select();
@@ -1163,7 +1196,6 @@ QList<QStringList> KSUserDB::GetAllFlags()
     }
 
     flags.clear();
-    m_UserDB.close();
     return flagList;
 }
 
@@ -1172,7 +1204,7 @@ QList<QStringList> KSUserDB::GetAllFlags()
  */
 void KSUserDB::DeleteEquipment(const QString &type, const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable(type);
     equip.setFilter("id = " + id);
@@ -1182,12 +1214,11 @@ void KSUserDB::DeleteEquipment(const QString &type, const QString &id)
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::DeleteAllEquipment(const QString &type)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setEditStrategy(QSqlTableModel::OnManualSubmit);
     equip.setTable(type);
@@ -1197,7 +1228,6 @@ void KSUserDB::DeleteAllEquipment(const QString &type)
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 /*
@@ -1206,7 +1236,7 @@ void KSUserDB::DeleteAllEquipment(const QString &type)
 void KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &type, const double &aperture,
                         const double &focalLength)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("telescope");
 
@@ -1223,13 +1253,12 @@ void KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
         qCWarning(KSTARS) << equip.lastError().text();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &type,
                         const double &aperture, const double &focalLength, const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("telescope");
     equip.setFilter("id = " + id);
@@ -1246,15 +1275,13 @@ void KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
         equip.setRecord(0, record);
         equip.submitAll();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 {
     scope_list.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("telescope");
     equip.select();
@@ -1273,7 +1300,6 @@ void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 /*
@@ -1282,7 +1308,7 @@ void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("eyepiece");
 
@@ -1296,13 +1322,12 @@ void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit, const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("eyepiece");
     equip.setFilter("id = " + id);
@@ -1319,15 +1344,13 @@ void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
         equip.setRecord(0, record);
         equip.submitAll();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
 {
     eyepiece_list.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("eyepiece");
     equip.select();
@@ -1347,7 +1370,6 @@ void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 /*
@@ -1355,7 +1377,7 @@ void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
  */
 void KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("lens");
 
@@ -1367,12 +1389,11 @@ void KSUserDB::AddLens(const QString &vendor, const QString &model, const double
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor, const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("lens");
     equip.setFilter("id = " + id);
@@ -1386,15 +1407,13 @@ void KSUserDB::AddLens(const QString &vendor, const QString &model, const double
         record.setValue(3, factor);
         equip.submitAll();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 {
     lens_list.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("lens");
     equip.select();
@@ -1411,7 +1430,6 @@ void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 /*
@@ -1420,7 +1438,7 @@ void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QString &type, const QString &color,
                          int offset, double exposure, bool useAutoFocus, const QString &lockedFilter, int absFocusPos)
 {
-    if (m_UserDB.open())
+    if (OpenDB())
     {
         QSqlTableModel equip(nullptr, m_UserDB);
         equip.setTable("filter");
@@ -1455,7 +1473,6 @@ void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QStr
             qCritical() << "AddFilter:" << equip.lastError();
 
         equip.clear();
-        m_UserDB.close();
     }
     else qCritical() << "Failed opening database connection to add filters.";
 }
@@ -1463,7 +1480,7 @@ void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QStr
 void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QString &type, const QString &color,
                          int offset, double exposure, bool useAutoFocus, const QString &lockedFilter, int absFocusPos, const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("filter");
     equip.setFilter("id = " + id);
@@ -1485,13 +1502,11 @@ void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QStr
         if (equip.submitAll() == false)
             qCritical() << "AddFilter:" << equip.lastError();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllFilters(QList<OAL::Filter *> &filter_list)
 {
-    m_UserDB.open();
+    OpenDB();
     filter_list.clear();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("filter");
@@ -1516,7 +1531,6 @@ void KSUserDB::GetAllFilters(QList<OAL::Filter *> &filter_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 #if 0
@@ -1922,7 +1936,7 @@ QList<ArtificialHorizonEntity *> KSUserDB::GetAllHorizons()
 {
     QList<ArtificialHorizonEntity *> horizonList;
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel regions(nullptr, m_UserDB);
     regions.setTable("horizons");
     regions.select();
@@ -1968,13 +1982,13 @@ QList<ArtificialHorizonEntity *> KSUserDB::GetAllHorizons()
     }
 
     regions.clear();
-    m_UserDB.close();
     return horizonList;
 }
 
 void KSUserDB::DeleteAllHorizons()
 {
-    m_UserDB.open();
+    OpenDB();
+    m_UserDB.transaction();
     QSqlTableModel regions(nullptr, m_UserDB);
     regions.setEditStrategy(QSqlTableModel::OnManualSubmit);
     regions.setTable("horizons");
@@ -1994,12 +2008,15 @@ void KSUserDB::DeleteAllHorizons()
     regions.submitAll();
 
     regions.clear();
-    m_UserDB.close();
+    if (!m_UserDB.commit())
+        qCWarning(KSTARS) << LastError();
 }
 
 void KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
 {
-    m_UserDB.open();
+    OpenDB();
+    // A single transaction, otherwise each point is synced to storage on its own.
+    m_UserDB.transaction();
     QSqlTableModel regions(nullptr, m_UserDB);
     regions.setTable("horizons");
 
@@ -2020,31 +2037,28 @@ void KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
     QSqlQuery query(m_UserDB);
     query.exec(tableQuery);
 
-    QSqlTableModel points(nullptr, m_UserDB);
-
-    points.setTable(tableName);
-
     SkyList *skyList = horizon->list()->points();
 
+    QVariantList azimuths, altitudes;
     for (const auto &item : *skyList)
     {
-        points.select();
-        QSqlRecord rec(points.record());
-
-        rec.setValue("Az", item->az().Degrees());
-        rec.setValue("Alt", item->alt().Degrees());
-        points.insertRecord(-1, rec);
+        azimuths << item->az().Degrees();
+        altitudes << item->alt().Degrees();
     }
 
-    points.submitAll();
-    points.clear();
+    query.prepare(QString("INSERT INTO %1 (Az, Alt) VALUES (?, ?)").arg(tableName));
+    query.addBindValue(azimuths);
+    query.addBindValue(altitudes);
+    if (!query.execBatch())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
-    m_UserDB.close();
+    if (!m_UserDB.commit())
+        qCWarning(KSTARS) << LastError();
 }
 
 int KSUserDB::AddProfile(const QString &name)
 {
-    m_UserDB.open();
+    OpenDB();
     int id = -1;
 
     QSqlQuery query(m_UserDB);
@@ -2055,14 +2069,12 @@ int KSUserDB::AddProfile(const QString &name)
     else
         id = query.lastInsertId().toInt();
 
-    m_UserDB.close();
-
     return id;
 }
 
 bool KSUserDB::DeleteProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    m_UserDB.open();
+    OpenDB();
 
     QSqlQuery query(m_UserDB);
     bool rc;
@@ -2072,14 +2084,12 @@ bool KSUserDB::DeleteProfile(const QSharedPointer<ProfileInfo> &pi)
     if (rc == false)
         qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
-    m_UserDB.close();
-
     return rc;
 }
 
 bool KSUserDB::PurgeProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    m_UserDB.open();
+    OpenDB();
 
     QSqlQuery query(m_UserDB);
     bool rc;
@@ -2097,18 +2107,21 @@ bool KSUserDB::PurgeProfile(const QSharedPointer<ProfileInfo> &pi)
     rc = query.exec("DELETE FROM opticaltrains WHERE profile=" + QString::number(pi->id));
     if (rc == false)
         qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
-
-    m_UserDB.close();
+    m_OpticalTrainsLoaded = false;
 
     return rc;
 }
 
 void KSUserDB::SaveProfile(const QSharedPointer<ProfileInfo> &pi)
 {
+    // All the updates are written at once on commit
+    OpenDB();
+    m_UserDB.transaction();
+
     // Remove all drivers
     DeleteProfileDrivers(pi);
 
-    m_UserDB.open();
+    OpenDB();
     QSqlQuery query(m_UserDB);
 
     // Clear data
@@ -2198,20 +2211,20 @@ void KSUserDB::SaveProfile(const QSharedPointer<ProfileInfo> &pi)
     /*if (pi->customDrivers.isEmpty() == false && !query.exec(QString("INSERT INTO custom_driver (drivers, profile) VALUES('%1',%2)").arg(pi->customDrivers).arg(pi->id)))
         qDebug()  << query.lastQuery() << query.lastError().text();*/
 
-    m_UserDB.close();
+    if (!m_UserDB.commit())
+        qCWarning(KSTARS) << LastError();
 }
 
 void KSUserDB::GetAllProfiles(QList<QSharedPointer<ProfileInfo>> &profiles)
 {
     profiles.clear();
-    m_UserDB.open();
-    QSqlTableModel profile(nullptr, m_UserDB);
-    profile.setTable("profile");
-    profile.select();
+    auto profile = ExecPrepared("SELECT * FROM profile");
+    if (!profile)
+        return;
 
-    for (int i = 0; i < profile.rowCount(); ++i)
+    while (profile->next())
     {
-        QSqlRecord record = profile.record(i);
+        QSqlRecord record = profile->record();
 
         int id       = record.value("id").toInt();
         QString name = record.value("name").toString();
@@ -2248,30 +2261,24 @@ void KSUserDB::GetAllProfiles(QList<QSharedPointer<ProfileInfo>> &profiles)
         profiles.append(std::move(pi));
     }
 
-    m_UserDB.close();
+    profile->finish();
 }
 
 void KSUserDB::GetProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 {
-    m_UserDB.open();
-
-    QSqlTableModel driver(nullptr, m_UserDB);
-    driver.setTable("driver");
-    driver.setFilter("profile=" + QString::number(pi->id));
-    if (driver.select() == false)
-        qCWarning(KSTARS) << "Driver select error:" << driver.lastError().text();
+    auto driver = ExecPrepared("SELECT label, role FROM driver WHERE profile=?", {pi->id});
+    if (!driver)
+        return;
 
-    for (int i = 0; i < driver.rowCount(); ++i)
+    while (driver->next())
     {
-        QSqlRecord record = driver.record(i);
-        QString label     = record.value("label").toString();
-        QString role      = record.value("role").toString();
+        QString label = driver->value(0).toString();
+        QString role  = driver->value(1).toString();
 
         pi->drivers[role] = label;
     }
 
-    driver.clear();
-    m_UserDB.close();
+    driver->finish();
 }
 
 /*void KSUserDB::GetProfileCustomDrivers(ProfileInfo* pi)
@@ -2292,7 +2299,7 @@ void KSUserDB::GetProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 
 void KSUserDB::DeleteProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 {
-    m_UserDB.open();
+    OpenDB();
 
     QSqlQuery query(m_UserDB);
 
@@ -2301,8 +2308,6 @@ void KSUserDB::DeleteProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 
     if (!query.exec("DELETE FROM driver WHERE profile=" + QString::number(pi->id)))
         qCWarning(KSTARS) << query.executedQuery() << query.lastError().text();
-
-    m_UserDB.close();
 }
 
 /*
@@ -2310,7 +2315,7 @@ void KSUserDB::DeleteProfileDrivers(const QSharedPointer<ProfileInfo> &pi)
 */
 void KSUserDB::AddDSLRLens(const QString &model, const QString &vendor, const double focalLength, const double focalRatio)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("dslrlens");
 
@@ -2324,13 +2329,12 @@ void KSUserDB::AddDSLRLens(const QString &model, const QString &vendor, const do
         qCritical() << __FUNCTION__ << equip.lastError();
     equip.submitAll();
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddDSLRLens(const QString &model, const QString &vendor, const double focalLength, const double focalRatio,
                            const QString &id)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("dslrlens");
     equip.setFilter("id = " + id);
@@ -2346,15 +2350,13 @@ void KSUserDB::AddDSLRLens(const QString &model, const QString &vendor, const do
         equip.setRecord(0, record);
         equip.submitAll();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllDSLRLenses(QList<OAL::DSLRLens *> &dslrlens_list)
 {
     dslrlens_list.clear();
 
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("dslrlens");
     equip.select();
@@ -2372,7 +2374,6 @@ void KSUserDB::GetAllDSLRLenses(QList<OAL::DSLRLens *> &dslrlens_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 
@@ -2478,7 +2479,7 @@ QStringList KSUserDB::getOpticalElementNames()
 
 void KSUserDB::AddProfileSettings(uint32_t profile, const QByteArray &settings)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel profileSettings(nullptr, m_UserDB);
     profileSettings.setTable("profilesettings");
     profileSettings.select();
@@ -2490,13 +2491,11 @@ void KSUserDB::AddProfileSettings(uint32_t profile, const QByteArray &settings)
 
     if (!profileSettings.submitAll())
         qCWarning(KSTARS) << profileSettings.lastError();
-
-    m_UserDB.close();
 }
 
 void KSUserDB::UpdateProfileSettings(uint32_t profile, const QByteArray &settings)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel profileSettings(nullptr, m_UserDB);
     profileSettings.setTable("profilesettings");
     profileSettings.setFilter(QString("profile=%1").arg(profile));
@@ -2508,14 +2507,12 @@ void KSUserDB::UpdateProfileSettings(uint32_t profile, const QByteArray &setting
 
     if (!profileSettings.submitAll())
         qCWarning(KSTARS) << profileSettings.lastError();
-
-    m_UserDB.close();
 }
 
 
 void KSUserDB::DeleteProfileSettings(uint32_t profile)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel profileSettings(nullptr, m_UserDB);
     profileSettings.setTable("profilesettings");
     profileSettings.setFilter(QString("profile=%1").arg(profile));
@@ -2523,40 +2520,35 @@ void KSUserDB::DeleteProfileSettings(uint32_t profile)
     profileSettings.select();
     profileSettings.removeRows(0, profileSettings.rowCount() - 1);
     profileSettings.submitAll();
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::GetProfileSettings(uint32_t profile, QVariantMap &settings)
 {
     settings.clear();
 
-    m_UserDB.open();
-    QSqlTableModel profileSettings(nullptr, m_UserDB);
-    profileSettings.setTable("profilesettings");
-    profileSettings.setFilter(QString("profile=%1").arg(profile));
-    profileSettings.select();
+    auto query = ExecPrepared("SELECT settings FROM profilesettings WHERE profile=?", {profile});
+    if (!query)
+        return false;
 
-    if (profileSettings.rowCount() > 0)
+    if (query->next())
     {
-        QSqlRecord record = profileSettings.record(0);
-        auto settingsField = record.value("settings").toByteArray();
+        auto settingsField = query->value(0).toByteArray();
+        query->finish();
         QJsonParseError parserError;
         auto doc = QJsonDocument::fromJson(settingsField, &parserError);
         if (parserError.error == QJsonParseError::NoError)
         {
             settings = doc.object().toVariantMap();
-            m_UserDB.close();
             return true;
         }
     }
-    m_UserDB.close();
+    query->finish();
     return false;
 }
 
 void KSUserDB::AddOpticalTrainSettings(uint32_t train, const QByteArray &settings)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel OpticalTrainSettings(nullptr, m_UserDB);
     OpticalTrainSettings.setTable("opticaltrainsettings");
     OpticalTrainSettings.select();
@@ -2568,13 +2560,11 @@ void KSUserDB::AddOpticalTrainSettings(uint32_t train, const QByteArray &setting
 
     if (!OpticalTrainSettings.submitAll())
         qCWarning(KSTARS) << OpticalTrainSettings.lastError();
-
-    m_UserDB.close();
 }
 
 void KSUserDB::UpdateOpticalTrainSettings(uint32_t train, const QByteArray &settings)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlTableModel OpticalTrainSettings(nullptr, m_UserDB);
     OpticalTrainSettings.setTable("opticaltrainsettings");
     OpticalTrainSettings.setFilter(QString("opticaltrain=%1").arg(train));
@@ -2586,44 +2576,38 @@ void KSUserDB::UpdateOpticalTrainSettings(uint32_t train, const QByteArray &sett
 
     if (!OpticalTrainSettings.submitAll())
         qCWarning(KSTARS) << OpticalTrainSettings.lastError();
-
-    m_UserDB.close();
 }
 
 
 void KSUserDB::DeleteOpticalTrainSettings(uint32_t train)
 {
-    m_UserDB.open();
+    OpenDB();
     QSqlQuery query(m_UserDB);
     auto rc = query.exec(QString("DELETE FROM opticaltrainsettings WHERE opticaltrain=%1").arg(train));
     if (rc == false)
         qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
-    m_UserDB.close();
 }
 
 bool KSUserDB::GetOpticalTrainSettings(uint32_t train, QVariantMap &settings)
 {
     settings.clear();
 
-    m_UserDB.open();
-    QSqlTableModel OpticalTrainSettings(nullptr, m_UserDB);
-    OpticalTrainSettings.setTable("OpticalTrainsettings");
-    OpticalTrainSettings.setFilter(QString("opticaltrain=%1").arg(train));
-    OpticalTrainSettings.select();
+    auto query = ExecPrepared("SELECT settings FROM opticaltrainsettings WHERE opticaltrain=?", {train});
+    if (!query)
+        return false;
 
-    if (OpticalTrainSettings.rowCount() > 0)
+    if (query->next())
     {
-        QSqlRecord record = OpticalTrainSettings.record(0);
-        auto settingsField = record.value("settings").toByteArray();
+        auto settingsField = query->value(0).toByteArray();
+        query->finish();
         QJsonParseError parserError;
         auto doc = QJsonDocument::fromJson(settingsField, &parserError);
         if (parserError.error == QJsonParseError::NoError)
         {
             settings = doc.object().toVariantMap();
-            m_UserDB.close();
             return true;
         }
     }
-    m_UserDB.close();
+    query->finish();
     return false;
 }
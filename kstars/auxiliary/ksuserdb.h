@@ -13,6 +13,8 @@
 #include "skyobjects/skyobject.h"
 
 #include <QFile>
+#include <QHash>
+#include <QSharedPointer>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QStringList>
@@ -23,12 +25,18 @@
 
 class LineList;
 class ArtificialHorizonEntity;
+class QSqlQuery;
+class QSqlRecord;
 
 /**
  * @brief Single class to delegate all User database I/O
  *
  * usage: Call QSqlDatabase::removeDatabase("userdb"); after the object
  * of this class is deallocated
+ *
+ * The connection stays open in WAL journal mode, frequent queries are prepared once
+ * and the dark frames and optical trains are kept in memory, so that the slow storage
+ * of small computers is not accessed each time they are needed.
  * @author Rishab Arora
  * @author Jasem Mutlaq
  * @version 1.2
@@ -73,7 +81,12 @@ class KSUserDB
         void AddDarkFrame(const QVariantMap &oneFrame);
         void UpdateDarkFrame(const QVariantMap &oneFrame);
         void DeleteDarkFrame(const QString &filename);
-        void GetAllDarkFrames(QList<QVariantMap> &darkFrames);
+        /**
+         * @brief GetAllDarkFrames Return all dark frames, from memory once they were read.
+         * @param darkFrames list to fill with the dark frames
+         * @param reload read the table again, after it was modified without KSUserDB
+         */
+        void GetAllDarkFrames(QList<QVariantMap> &darkFrames, bool reload = false);
 
 
         /************************************************************************
@@ -473,8 +486,32 @@ class KSUserDB
          **/
         inline QSqlError LastError();
 
+        /**
+         * @brief OpenDB Opens the connection unless it is open already, in WAL journal mode.
+         * @return true if the connection is open
+         */
+        bool OpenDB();
+
+        /**
+         * @brief ExecPrepared Executes a statement prepared on first use and kept for the next ones.
+         * @param statement SQL statement with ? placeholders
+         * @param values values bound to the placeholders, in order
+         * @return the executed query to read results from, or nullptr on error.
+         * Call finish() on it when done reading.
+         */
+        QSharedPointer<QSqlQuery> ExecPrepared(const QString &statement, const QVariantList &values = QVariantList());
+
+        static QVariantMap RecordToMap(const QSqlRecord &record);
+
         /** Linked to the user database _once_. **/
         QSqlDatabase m_UserDB;
+        /** Prepared statements of m_UserDB, by SQL text **/
+        QHash<QString, QSharedPointer<QSqlQuery>> m_Statements;
+        /** Tables read often, kept until they are modified **/
+        QList<QVariantMap> m_DarkFrames;
+        bool m_DarkFramesLoaded { false };
+        QList<QVariantMap> m_OpticalTrains;
+        bool m_OpticalTrainsLoaded { false };
         /** XML reader for importing old formats **/
         QXmlStreamReader *reader_ { nullptr };
 
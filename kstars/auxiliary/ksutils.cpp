@@ -16,6 +16,7 @@
 #include "Options.h"
 #include "starobject.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/logsink.h"
 
 #ifndef KSTARS_LITE
 #include <KMessageBox>
@@ -928,14 +929,7 @@ void Logging::UseFile()
 {
     if (_filename.isEmpty())
     {
-        QDir dir;
-        QString path =
-            QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
-            .filePath("logs/" + QDateTime::currentDateTime().toString("yyyy-MM-dd"));
-        dir.mkpath(path);
-        QString name =
-            "log_" + QDateTime::currentDateTime().toString("HH-mm-ss") + ".txt";
-        _filename = path + QStringLiteral("/") + name;
+        _filename = LogSink::newFileName();
 
         // Clear file contents
         QFile file(_filename);
@@ -947,17 +941,24 @@ void Logging::UseFile()
                        "%{if-debug}DEBG%{endif}%{if-info}INFO%{endif}%{if-warning}WARN%{"
                        "endif}%{if-critical}CRIT%{endif}%{if-fatal}FATL%{endif}] "
                        "%{if-category}[%{category}]%{endif} - %{message}");
+    LogSink::Instance()->open(_filename);
     qInstallMessageHandler(File);
 }
 
 void Logging::File(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    QFile file(_filename);
-    if (file.open(QFile::Append | QIODevice::Text))
+    // The line is formatted here so that its time is the time it was logged,
+    // the writer thread of the sink does the file access.
+    QByteArray line;
     {
-        QTextStream stream(&file);
+        QTextStream stream(&line, QIODevice::WriteOnly);
         Write(stream, type, context, msg);
     }
+    LogSink::Instance()->append(std::move(line), type);
+
+    // Qt aborts after a fatal message, make sure it reaches the file.
+    if (type == QtFatalMsg)
+        LogSink::Instance()->flush();
 }
 
 void Logging::UseStdout()
@@ -967,6 +968,7 @@ void Logging::UseStdout()
                        "endif}%{if-critical}CRIT%{endif}%{if-fatal}FATL%{endif}] "
                        "%{if-category}[%{category}]%{endif} - %{message}");
     qInstallMessageHandler(Stdout);
+    LogSink::Instance()->close();
 }
 
 void Logging::Stdout(QtMsgType type, const QMessageLogContext &context,
@@ -979,6 +981,7 @@ void Logging::Stdout(QtMsgType type, const QMessageLogContext &context,
 void Logging::UseStderr()
 {
     qInstallMessageHandler(Stderr);
+    LogSink::Instance()->close();
 }
 
 void Logging::Stderr(QtMsgType type, const QMessageLogContext &context,
@@ -1024,11 +1027,13 @@ void Logging::Write(QTextStream &stream, QtMsgType type,
 void Logging::UseDefault()
 {
     qInstallMessageHandler(nullptr);
+    LogSink::Instance()->close();
 }
 
 void Logging::Disable()
 {
     qInstallMessageHandler(Disabled);
+    LogSink::Instance()->close();
 }
 
 void Logging::Disabled(QtMsgType, const QMessageLogContext &, const QString &) {}
@@ -200,6 +200,8 @@ QString constNameToAbbrev(const QString &fullName_);
  */
 QString constGenetiveToAbbrev(const QString &genetive_);
 
+class LogSink;
+
 /**
 * Interface into Qt's logging system
 * @author: Yale Dedis 2011
@@ -239,6 +241,8 @@ class Logging
         static void SyncFilterRules();
 
     private:
+        friend class LogSink;
+
         static QString _filename;
 
         static void Disabled(QtMsgType type, const QMessageLogContext &context,
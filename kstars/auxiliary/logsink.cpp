@@ -0,0 +1,284 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "logsink.h"
+
+#include "ksutils.h"
+#include "auxiliary/kspaths.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+// Time between two writes when few lines are logged
+constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(100);
+// Time a warning or an error waits for room in the full buffer
+constexpr auto IMPORTANT_WAIT = std::chrono::milliseconds(10);
+// A new file is started above this size
+constexpr qint64 MAX_FILE_SIZE = 64 * 1024 * 1024;
+}
+
+namespace KSUtils
+{
+LogSink *LogSink::Instance()
+{
+    // Never deleted, messages may be logged until the very end of the process.
+    static LogSink *instance = new LogSink();
+    return instance;
+}
+
+QString LogSink::newFileName()
+{
+    QDir dir;
+    QString path =
+        QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
+        .filePath("logs/" + QDateTime::currentDateTime().toString("yyyy-MM-dd"));
+    dir.mkpath(path);
+    QString name =
+        "log_" + QDateTime::currentDateTime().toString("HH-mm-ss") + ".txt";
+    return path + QStringLiteral("/") + name;
+}
+
+LogSink::LogSink() : m_slots(new Slot[Capacity])
+{
+    for (size_t i = 0; i < Capacity; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+void LogSink::open(const QString &filename)
+{
+    if (m_running && fileName() == filename)
+        return;
+    close();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fileName = filename;
+    }
+
+    static bool registered = false;
+    if (!registered)
+    {
+        registered = true;
+        std::atexit([]()
+        {
+            LogSink::Instance()->close();
+        });
+    }
+
+    m_running = true;
+    m_thread  = std::thread(&LogSink::run, this);
+}
+
+void LogSink::close()
+{
+    if (!m_thread.joinable())
+        return;
+
+    m_running = false;
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+QString LogSink::fileName() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fileName;
+}
+
+// Bounded MPMC queue by Dmitry Vyukov, with a single consumer.
+bool LogSink::push(QByteArray &line)
+{
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot &slot       = m_slots[pos & (Capacity - 1)];
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const auto diff  = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                slot.line = std::move(line);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+            return false; // full
+        else
+            pos = m_head.load(std::memory_order_relaxed);
+    }
+}
+
+bool LogSink::pop(QByteArray &line)
+{
+    const size_t pos = m_tail.load(std::memory_order_relaxed);
+    Slot &slot       = m_slots[pos & (Capacity - 1)];
+    const size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1) < 0)
+        return false; // empty
+
+    line = std::move(slot.line);
+    slot.line = QByteArray();
+    slot.sequence.store(pos + Capacity, std::memory_order_release);
+    m_tail.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void LogSink::append(QByteArray &&line, QtMsgType type)
+{
+    // Counted before checking m_running, so that the last drain either sees this line or it is written directly.
+    m_appending++;
+    if (!m_running)
+    {
+        m_appending--;
+        writeDirect(line);
+        return;
+    }
+
+    const bool queued = enqueue(line, type);
+    m_appending--;
+    if (!queued)
+        return;
+
+    // Wake the writer early when the buffer fills up
+    const size_t pending = m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed);
+    if (pending == Capacity / 2)
+        m_wake.notify_one();
+}
+
+bool LogSink::enqueue(QByteArray &line, QtMsgType type)
+{
+    if (!push(line))
+    {
+        m_wake.notify_one();
+        // Warnings and errors get a short chance to find room, the rest is dropped right away.
+        bool pushed = false;
+        if (type != QtDebugMsg && type != QtInfoMsg)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + IMPORTANT_WAIT;
+            while (!pushed && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+                pushed = push(line);
+            }
+        }
+        if (!pushed)
+        {
+            m_dropped++;
+            return false;
+        }
+    }
+    return true;
+}
+
+void LogSink::flush()
+{
+    if (!m_running)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const quint64 request = ++m_flushRequest;
+    m_wake.notify_one();
+    m_flushed.wait(lock, [&]()
+    {
+        return m_flushDone >= request || !m_running;
+    });
+}
+
+void LogSink::run()
+{
+    QByteArray batch, line;
+    batch.reserve(64 * 1024);
+
+    for (;;)
+    {
+        quint64 flushRequest;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait_for(lock, WRITE_INTERVAL, [&]()
+            {
+                return !m_running || m_flushRequest != m_flushDone;
+            });
+            flushRequest = m_flushRequest;
+        }
+        const bool stopping = !m_running;
+        // A line is either written directly or pushed before this last drain.
+        if (stopping)
+        {
+            while (m_appending > 0)
+                std::this_thread::yield();
+        }
+
+        batch.clear();
+        while (pop(line))
+            batch.append(line);
+
+        const quint64 dropped = m_dropped.exchange(0);
+        if (dropped > 0)
+        {
+            // Same format as the other lines
+            QByteArray notice;
+            QTextStream stream(&notice, QIODevice::WriteOnly);
+            QMessageLogContext context(nullptr, 0, nullptr, "org.kde.kstars");
+            Logging::Write(stream, QtWarningMsg, context,
+                           QString("%1 log messages were dropped, the log file could not keep up.").arg(dropped));
+            batch.append(notice);
+        }
+
+        if (!batch.isEmpty())
+            writeBatch(batch);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_flushDone = flushRequest;
+        }
+        m_flushed.notify_all();
+
+        if (stopping)
+            break;
+    }
+}
+
+void LogSink::writeBatch(const QByteArray &batch)
+{
+    QString filename = fileName();
+    QFileInfo info(filename);
+
+    // Start a new file when the current one is too large or of a previous day
+    if (info.exists() && (info.size() + batch.size() > MAX_FILE_SIZE || info.lastModified().date() != QDate::currentDate()))
+    {
+        filename = newFileName();
+        if (filename == info.absoluteFilePath())
+            filename.replace(".txt", "_1.txt");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fileName = filename;
+    }
+
+    QFile file(filename);
+    if (file.open(QFile::Append | QIODevice::Text))
+        file.write(batch);
+}
+
+void LogSink::writeDirect(const QByteArray &line)
+{
+    const QString filename = fileName();
+    if (filename.isEmpty())
+        return;
+
+    QFile file(filename);
+    if (file.open(QFile::Append | QIODevice::Text))
+        file.write(line);
+}
+}
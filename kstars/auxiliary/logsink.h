@@ -0,0 +1,104 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace KSUtils
+{
+/**
+ * @class LogSink
+ * @short Writes the log lines to the log file from a background thread.
+ *
+ * The lines are formatted by the thread that logs them and pushed to a lock-free ring buffer with
+ * many producers and a single consumer. The writer thread drains the buffer into a single write
+ * every 100 ms, or as soon as the buffer is half full, so logging never waits on the disk.
+ *
+ * When the buffer is full, debug and info lines are dropped right away, and warnings and errors
+ * wait a few milliseconds for room before being dropped. The number of dropped lines is written to
+ * the log once there is room again.
+ *
+ * A new file is started when the current one grows over 64 MiB or when the day changes.
+ *
+ * When the sink is closed, the lines are appended synchronously, so nothing logged at exit is lost.
+ */
+class LogSink
+{
+    public:
+        static LogSink *Instance();
+
+        /** @return the name of a new log file, in a folder of the day in the logs folder */
+        static QString newFileName();
+
+        /**
+         * @short Starts writing to the given file from the writer thread
+         * @param filename file to append the log lines to
+         */
+        void open(const QString &filename);
+
+        /** @short Writes all pending lines, then stops the writer thread */
+        void close();
+
+        /** @return the file currently written */
+        QString fileName() const;
+
+        /**
+         * @short Queues a formatted line, never blocks for long
+         * @param line the formatted line, including the end of line
+         * @param type the type of the message, higher types are dropped last
+         */
+        void append(QByteArray &&line, QtMsgType type);
+
+        /** @short Waits until all lines queued so far are written, used before a fatal message aborts */
+        void flush();
+
+    private:
+        LogSink();
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence { 0 };
+            QByteArray line;
+        };
+
+        bool push(QByteArray &line);
+        // Pushes the line, waiting a little for room for warnings and errors, false if the line was dropped
+        bool enqueue(QByteArray &line, QtMsgType type);
+        bool pop(QByteArray &line);
+        void run();
+        void writeBatch(const QByteArray &batch);
+        void writeDirect(const QByteArray &line);
+
+        static constexpr size_t Capacity = 8192;
+
+        std::unique_ptr<Slot[]> m_slots;
+        // Next position to push, shared by all producers
+        alignas(64) std::atomic<size_t> m_head { 0 };
+        // Next position to pop, only written by the writer thread
+        alignas(64) std::atomic<size_t> m_tail { 0 };
+
+        std::atomic<bool> m_running { false };
+        // Appends that saw the writer running and may still push, the writer waits for them before its last drain
+        std::atomic<int> m_appending { 0 };
+        std::atomic<quint64> m_dropped { 0 };
+        std::thread m_thread;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_flushed;
+        quint64 m_flushRequest { 0 };
+        quint64 m_flushDone { 0 };
+        QString m_fileName;
+};
+}
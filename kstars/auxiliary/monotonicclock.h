@@ -0,0 +1,26 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <chrono>
+
+/**
+ * @namespace MonotonicClock
+ * @short Timestamps shared by the components recording the same events, e.g. the stages of a guide cycle
+ * from the camera driver to the guider.
+ */
+namespace MonotonicClock
+{
+/** @return microseconds on a monotonic clock, only differences of two timestamps are meaningful */
+inline qint64 timestamp()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
@@ -0,0 +1,163 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "renderprofiler.h"
+
+#include "Options.h"
+
+#include <KLocalizedString>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// Weight of the last frame in the smoothed frame time
+constexpr double SMOOTHING = 0.3;
+// The level is lowered when the smoothed frame time is below this fraction of the budget
+constexpr double RECOVERY = 0.6;
+// Frames to wait after a level change, so that the smoothed time reflects it
+constexpr int SETTLE_FRAMES = 3;
+}
+
+RenderProfiler *RenderProfiler::m_Instance = nullptr;
+
+RenderProfiler *RenderProfiler::Instance()
+{
+    if (m_Instance == nullptr)
+        m_Instance = new RenderProfiler();
+    return m_Instance;
+}
+
+RenderProfiler::Scope::Scope(const char *section) : m_section(section)
+{
+    if (RenderProfiler::Instance()->isEnabled())
+        m_timer.start();
+}
+
+RenderProfiler::Scope::~Scope()
+{
+    if (m_timer.isValid())
+        RenderProfiler::Instance()->addTime(m_section, m_timer.nsecsElapsed());
+}
+
+void RenderProfiler::setForced(bool forced)
+{
+    m_forced = forced;
+}
+
+void RenderProfiler::beginFrame()
+{
+    const bool enabled = m_forced || Options::showRenderProfile() || Options::renderFrameBudget() > 0;
+    if (!enabled)
+    {
+        m_enabled = false;
+        m_level   = NoDegradation;
+        m_sections.clear();
+        return;
+    }
+
+    m_enabled = true;
+    m_inFrame = true;
+    m_frameTimer.start();
+}
+
+void RenderProfiler::endFrame()
+{
+    if (!m_inFrame)
+        return;
+    m_inFrame = false;
+
+    m_lastFrameMs  = m_frameTimer.nsecsElapsed() / 1e6;
+    m_lastSections = m_sections;
+    m_sections.clear();
+    std::sort(m_lastSections.begin(), m_lastSections.end(), [](const Section & a, const Section & b)
+    {
+        return a.nsecs > b.nsecs;
+    });
+
+    updateLevel(m_lastFrameMs);
+}
+
+void RenderProfiler::addTime(const char *section, qint64 nsecs)
+{
+    // Few sections, a linear search is fine. The names are compared by value since the same
+    // literal may have different addresses in different translation units.
+    for (auto &item : m_sections)
+    {
+        if (item.name == section || !strcmp(item.name, section))
+        {
+            item.nsecs += nsecs;
+            item.calls++;
+            return;
+        }
+    }
+    m_sections.append({ section, nsecs, 1 });
+}
+
+void RenderProfiler::updateLevel(double frameMs)
+{
+    const double budget = Options::renderFrameBudget();
+    if (budget <= 0)
+    {
+        m_level      = NoDegradation;
+        m_smoothedMs = frameMs;
+        return;
+    }
+
+    m_smoothedMs = SMOOTHING * frameMs + (1 - SMOOTHING) * m_smoothedMs;
+    if (m_settle > 0)
+    {
+        m_settle--;
+        return;
+    }
+
+    if (m_smoothedMs > budget && m_level < Labels)
+    {
+        m_level++;
+        m_settle = SETTLE_FRAMES;
+    }
+    else if (m_smoothedMs < RECOVERY * budget && m_level > NoDegradation)
+    {
+        m_level--;
+        m_settle = SETTLE_FRAMES;
+    }
+}
+
+QStringList RenderProfiler::report() const
+{
+    QStringList lines;
+    if (!m_enabled)
+        return lines;
+
+    const int budget = Options::renderFrameBudget();
+    if (budget > 0)
+        lines << i18n("Frame: %1 ms (average %2 ms, budget %3 ms)", QString::number(m_lastFrameMs, 'f', 1),
+                      QString::number(m_smoothedMs, 'f', 1), budget);
+    else
+        lines << i18n("Frame: %1 ms", QString::number(m_lastFrameMs, 'f', 1));
+
+    switch (m_level)
+    {
+        case DeepStars:
+            lines << i18n("Dropped: deep stars");
+            break;
+        case FaintDeepSky:
+            lines << i18n("Dropped: deep stars, faint deep sky objects");
+            break;
+        case Labels:
+            lines << i18n("Dropped: deep stars, faint deep sky objects, labels");
+            break;
+        default:
+            break;
+    }
+
+    for (const auto &item : m_lastSections)
+    {
+        lines << QString("%1: %2 ms").arg(QLatin1String(item.name)).arg(item.nsecs / 1e6, 0, 'f', 2) +
+              (item.calls > 1 ? QString(" (%1x)").arg(item.calls) : QString());
+    }
+    return lines;
+}
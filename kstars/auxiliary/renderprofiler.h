@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @class RenderProfiler
+ * @short Measures where the time of a sky map frame goes, and keeps the frames within a budget.
+ *
+ * The drawing code wraps each step of a frame (the draw of every component, the updates, the
+ * projection setup, the labels and the painter submission) in a RenderProfiler::Scope. The times
+ * of a frame are collected between beginFrame() and endFrame(); the updates done by the clock
+ * between two frames are counted in the next one.
+ *
+ * The breakdown of the last frame is shown on the sky map when ShowRenderProfile is set, and is
+ * available through the getRenderProfile() DBus method.
+ *
+ * When RenderFrameBudget is set, the frame time is smoothed over a few frames and compared to the
+ * budget. While over budget, the low priority parts of the map are dropped one level at a time,
+ * first the deep stars, then the faint deep sky objects, then the star and deep sky labels. They
+ * come back once the frames are well within the budget again.
+ *
+ * The profiler is only used from the GUI thread. When neither option is set, and profiling was
+ * not requested over DBus, a Scope costs a single test.
+ */
+class RenderProfiler
+{
+    public:
+        /** Parts of the sky map that are dropped when over budget, in order. */
+        enum Degradation
+        {
+            NoDegradation,
+            DeepStars,
+            FaintDeepSky,
+            Labels
+        };
+
+        /**
+         * @class Scope
+         * @short Adds the time spent in its lifetime to a section of the current frame.
+         */
+        class Scope
+        {
+            public:
+                /** @param section name of the section, must be a string literal */
+                explicit Scope(const char *section);
+                ~Scope();
+
+            private:
+                const char *m_section;
+                QElapsedTimer m_timer;
+        };
+
+        static RenderProfiler *Instance();
+
+        /** @return true if the frames are currently profiled */
+        bool isEnabled() const
+        {
+            return m_enabled;
+        }
+
+        /** @short Enables profiling regardless of the options, used by the DBus interface */
+        void setForced(bool forced);
+
+        /** @short Starts timing a full redraw of the sky map */
+        void beginFrame();
+
+        /** @short Finishes the frame, keeps its breakdown and updates the degradation level */
+        void endFrame();
+
+        /** @short Adds nsecs to the given section of the current frame */
+        void addTime(const char *section, qint64 nsecs);
+
+        /** @return true if the given part of the sky map must be dropped to keep within the budget */
+        bool degrade(Degradation part) const
+        {
+            return part != NoDegradation && m_level >= part;
+        }
+
+        /** @return the breakdown of the last frame, one line per section, slowest first */
+        QStringList report() const;
+
+    private:
+        RenderProfiler() = default;
+
+        void updateLevel(double frameMs);
+
+        struct Section
+        {
+            const char *name { nullptr };
+            qint64 nsecs { 0 };
+            int calls { 0 };
+        };
+
+        static RenderProfiler *m_Instance;
+
+        bool m_enabled { false };
+        bool m_forced { false };
+        bool m_inFrame { false };
+        QElapsedTimer m_frameTimer;
+        QVector<Section> m_sections;
+        QVector<Section> m_lastSections;
+        double m_lastFrameMs { 0 };
+        double m_smoothedMs { 0 };
+        int m_level { NoDegradation };
+        // Frames left before the level may change again
+        int m_settle { 0 };
+};
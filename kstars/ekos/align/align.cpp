@@ -53,6 +53,7 @@
 #include <KActionCollection>
 #include <basedevice.h>
 #include <indicom.h>
+#include <algorithm>
 #include <memory>
 
 // Qt version calming
@@ -217,6 +218,7 @@ Align::Align(const QSharedPointer<ProfileInfo> &activeProfile) : m_ActiveProfile
 
     m_StellarSolver.reset(new StellarSolver());
     connect(m_StellarSolver.get(), &StellarSolver::logOutput, this, &Align::appendLogText);
+    connect(&m_DifferentialStarsWatcher, &QFutureWatcher<bool>::finished, this, &Align::differentialSolveComplete);
 
     setupPolarAlignmentAssistant();
     setupManualRotator();
@@ -624,6 +626,8 @@ bool Align::setCamera(ISD::Camera *device)
         m_Camera->disconnect(this);
 
     m_Camera = device;
+    // Stars of another camera cannot be matched
+    m_DifferentialSolver.clearReference();
 
     if (m_Camera)
     {
@@ -1683,8 +1687,9 @@ void Align::setCaptureComplete()
 {
     if (matchPAHStage(PAA::PAH_REFRESH))
     {
-        emit newFrame(m_AlignView);
+        // The refresh draws the user's star on the loaded frame, so the frame is shown only afterwards.
         m_PolarAlignmentAssistant->processPAHRefresh();
+        emit newFrame(m_AlignView);
         return;
     }
 
@@ -1710,7 +1715,9 @@ void Align::startSolving()
     QStringList astrometryDataDirs = KSUtils::getAstrometryDataDirs();
     disconnect(m_AlignView.get(), &FITSView::loaded, this, &Align::startSolving);
 
-    if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
+    if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL && canSolveDifferentially())
+        startDifferentialSolve();
+    else if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
     {
         if(Options::solverType() != SSolver::SOLVER_ASTAP
                 && Options::solverType() != SSolver::SOLVER_WATNEYASTROMETRY) //You don't need astrometry index files to use ASTAP or Watney
@@ -1890,10 +1897,79 @@ void Align::solverComplete()
     {
         FITSImage::Solution solution = m_StellarSolver->getSolution();
         const bool eastToTheRight = solution.parity == FITSImage::POSITIVE ? false : true;
+
+        // Keep the stars of the solved image, the next images of the same field are solved from them.
+        if (!m_SolveFromFile && Options::astrometryDifferentialSolve() && m_ImageData)
+        {
+            QList<FITSImage::Star> stars = m_StellarSolver->getStarList();
+            std::sort(stars.begin(), stars.end(), [](const FITSImage::Star & star1, const FITSImage::Star & star2)
+            {
+                return star1.flux > star2.flux;
+            });
+            QVector<QPointF> points;
+            points.reserve(stars.size());
+            for (const auto &star : stars)
+                points.append(QPointF(star.x, star.y));
+
+            DifferentialSolver::Solution reference;
+            reference.orientation    = solution.orientation;
+            reference.ra             = solution.ra;
+            reference.dec            = solution.dec;
+            reference.pixscale       = solution.pixscale;
+            reference.eastToTheRight = eastToTheRight;
+            m_DifferentialSolver.setReference(points, m_ImageData->width(), m_ImageData->height(), reference);
+        }
+
         solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale, eastToTheRight);
     }
 }
 
+bool Align::canSolveDifferentially() const
+{
+    // Polar alignment needs the index and healpix of the full solver.
+    return Options::astrometryDifferentialSolve() && m_DifferentialSolver.hasReference() && !m_SolveFromFile &&
+           m_PolarAlignmentAssistant && m_PolarAlignmentAssistant->getPAHStage() == PAA::PAH_IDLE;
+}
+
+void Align::startDifferentialSolve()
+{
+    if (!m_ImageData)
+        m_ImageData = m_AlignView->imageData();
+    solverTimer.start();
+    m_DifferentialStarsWatcher.setFuture(m_ImageData->findStars(ALGORITHM_SEP));
+}
+
+void Align::differentialSolveComplete()
+{
+    // Aborted while the stars were detected
+    if (state != ALIGN_PROGRESS || !m_ImageData)
+        return;
+
+    QList<Edge *> centers = m_ImageData->getStarCenters();
+    std::sort(centers.begin(), centers.end(), [](const Edge * edge1, const Edge * edge2)
+    {
+        return edge1->sum > edge2->sum;
+    });
+    QVector<QPointF> stars;
+    stars.reserve(centers.size());
+    for (const auto &center : centers)
+        stars.append(QPointF(center->x, center->y));
+
+    DifferentialSolver::Solution solution;
+    if (m_DifferentialStarsWatcher.result() &&
+            m_DifferentialSolver.solve(stars, m_ImageData->width(), m_ImageData->height(), solution))
+    {
+        appendLogText(i18n("Solved from %1 stars of the previous solution (RMS %2 pixels).", solution.matches,
+                           QString::number(solution.rms, 'f', 2)));
+        solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale, solution.eastToTheRight);
+        return;
+    }
+
+    appendLogText(i18n("Stars do not match the previous solution, running the full solver..."));
+    m_DifferentialSolver.clearReference();
+    startSolving();
+}
+
 void Align::solverFinished(double orientation, double ra, double dec, double pixscale, bool eastToTheRight)
 {
     pi->stopAnimation();
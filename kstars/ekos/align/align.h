@@ -18,10 +18,12 @@
 #include "indi/indidome.h"
 #include "ksuserdb.h"
 #include "ekos/auxiliary/darkprocessor.h"
+#include "differentialsolver.h"
 
 #include <QTime>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <KConfigDialog>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
@@ -663,6 +665,18 @@ class Align : public QWidget, public Ui::Align
          */
         void calculateAlignTargetDiff();
 
+        /**
+         * @brief canSolveDifferentially Check if the image can be solved from the stars of the last full solve.
+         */
+        bool canSolveDifferentially() const;
+
+        /**
+         * @brief startDifferentialSolve Detect the stars of the image, then match them to the reference stars in
+         * differentialSolveComplete(), which falls back to the full solver if they do not match.
+         */
+        void startDifferentialSolve();
+        void differentialSolveComplete();
+
         /**
              * @brief Get formatted RA & DEC coordinates compatible with astrometry.net format.
              * @param ra Right ascension
@@ -783,6 +797,9 @@ class Align : public QWidget, public Ui::Align
         std::unique_ptr<StellarSolver> m_StellarSolver;
         // StellarSolver Profiles
         QList<SSolver::Parameters> m_StellarSolverProfiles;
+        // Solves the images taken while converging on the target from the stars of the last full solve
+        DifferentialSolver m_DifferentialSolver;
+        QFutureWatcher<bool> m_DifferentialStarsWatcher;
 
         /// Have we slewed?
         bool m_wasSlewStarted { false };
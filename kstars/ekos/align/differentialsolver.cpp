@@ -0,0 +1,286 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "differentialsolver.h"
+
+#include "dms.h"
+
+#include <ekos_align_debug.h>
+
+#include <QPair>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Only the brightest stars are matched, they are detected in both images.
+constexpr int MAX_STARS = 50;
+// Stars used to vote for the offset between the images
+constexpr int VOTING_STARS = 20;
+// Distances in pixels between matched stars, looser for the offset than for the fitted transform
+constexpr double VOTE_TOLERANCE  = 6.0;
+constexpr double MATCH_TOLERANCE = 3.0;
+constexpr int MIN_MATCHES = 8;
+constexpr double MAX_RMS = 1.5;
+// Same optics, the fitted transform can only rotate and shift the field.
+constexpr double MAX_SCALE_ERROR = 0.02;
+
+// Gnomonic projection of ra, dec on the plane tangent at ra0, dec0, all in degrees
+bool project(double ra0, double dec0, double ra, double dec, double &xi, double &eta)
+{
+    double s0, c0, s, c;
+    dms::SinCos(dec0 * dms::DegToRad, s0, c0);
+    dms::SinCos(dec * dms::DegToRad, s, c);
+    const double dra  = (ra - ra0) * dms::DegToRad;
+    const double cosc = s0 * s + c0 * c * std::cos(dra);
+    if (cosc <= 0)
+        return false;
+
+    xi  = c * std::sin(dra) / cosc / dms::DegToRad;
+    eta = (c0 * s - s0 * c * std::cos(dra)) / cosc / dms::DegToRad;
+    return true;
+}
+
+// Inverse of project()
+void deproject(double ra0, double dec0, double xi, double eta, double &ra, double &dec)
+{
+    double s0, c0;
+    dms::SinCos(dec0 * dms::DegToRad, s0, c0);
+    const double x   = xi * dms::DegToRad;
+    const double y   = eta * dms::DegToRad;
+    const double den = c0 - y * s0;
+
+    ra  = ra0 + std::atan2(x, den) / dms::DegToRad;
+    dec = std::atan2(s0 + y * c0, std::hypot(x, den)) / dms::DegToRad;
+
+    ra = std::fmod(ra, 360.0);
+    if (ra < 0)
+        ra += 360.0;
+}
+}
+
+namespace Ekos
+{
+
+void DifferentialSolver::setReference(const QVector<QPointF> &stars, int width, int height, const Solution &solution)
+{
+    m_ReferenceStars = stars.mid(0, MAX_STARS);
+    m_Width     = width;
+    m_Height    = height;
+    m_Reference = solution;
+
+    // Same WCS as FITSData::injectWCS() writes for the solution
+    const double cdelt1 = (solution.eastToTheRight ? solution.pixscale : -solution.pixscale) / 3600.0;
+    const double cdelt2 = solution.pixscale / 3600.0;
+    double s, c;
+    dms::SinCos((360.0 - solution.orientation) * dms::DegToRad, s, c);
+    m_CD[0][0] = cdelt1 * c;
+    m_CD[0][1] = -cdelt2 * s;
+    m_CD[1][0] = cdelt1 * s;
+    m_CD[1][1] = cdelt2 * c;
+}
+
+void DifferentialSolver::clearReference()
+{
+    m_ReferenceStars.clear();
+}
+
+bool DifferentialSolver::solve(const QVector<QPointF> &stars, int width, int height, Solution &solution) const
+{
+    if (!hasReference() || width != m_Width || height != m_Height || stars.size() < MIN_MATCHES)
+        return false;
+
+    const QVector<QPointF> brightest = stars.mid(0, MAX_STARS);
+
+    Affine transform;
+    if (!findTranslation(brightest, transform))
+    {
+        qCDebug(KSTARS_EKOS_ALIGN) << "Differential solve: no offset matches the reference stars.";
+        return false;
+    }
+
+    // Refine the transform, the stars matched by the previous fit are matched again by the new one.
+    QVector<QPair<int, int>> pairs;
+    double rms = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (match(brightest, transform, MATCH_TOLERANCE, pairs) < MIN_MATCHES ||
+                !fit(brightest, m_ReferenceStars, pairs, transform, rms))
+        {
+            qCDebug(KSTARS_EKOS_ALIGN) << "Differential solve: only" << pairs.size() << "stars match the reference stars.";
+            return false;
+        }
+    }
+
+    const double det   = transform.a * transform.d - transform.b * transform.c;
+    const double scale = std::sqrt(std::fabs(det));
+    if (rms > MAX_RMS || det <= 0 || std::fabs(scale - 1) > MAX_SCALE_ERROR ||
+            std::fabs(transform.a - transform.d) > MAX_SCALE_ERROR || std::fabs(transform.b + transform.c) > MAX_SCALE_ERROR)
+    {
+        qCDebug(KSTARS_EKOS_ALIGN) << "Differential solve: rejected transform, RMS" << rms << "scale" << scale;
+        return false;
+    }
+
+    // The new solution is measured on the sky, around the center of the new image, since the direction of
+    // the pole changes across the reference image.
+    constexpr double step = 100;
+    const QPointF center(width / 2.0, height / 2.0);
+    double ra0, dec0, ra1, dec1, ra2, dec2;
+    referenceToSky(transform.map(center), ra0, dec0);
+    referenceToSky(transform.map(center + QPointF(step, 0)), ra1, dec1);
+    referenceToSky(transform.map(center + QPointF(0, step)), ra2, dec2);
+
+    double cd[2][2];
+    if (!project(ra0, dec0, ra1, dec1, cd[0][0], cd[1][0]) || !project(ra0, dec0, ra2, dec2, cd[0][1], cd[1][1]))
+        return false;
+    for (auto &row : cd)
+        for (auto &value : row)
+            value /= step;
+
+    // Inverse of the CD matrix built in setReference()
+    const double cdDet = cd[0][0] * cd[1][1] - cd[0][1] * cd[1][0];
+    const double sign  = cdDet > 0 ? 1 : -1;
+    const double rotation = std::atan2(sign * cd[1][0] - cd[0][1], sign * cd[0][0] + cd[1][1]) / dms::DegToRad;
+    double orientation = 360.0 - rotation;
+    while (orientation > 180)
+        orientation -= 360;
+    while (orientation <= -180)
+        orientation += 360;
+
+    solution.ra             = ra0;
+    solution.dec            = dec0;
+    solution.orientation    = orientation;
+    solution.pixscale       = std::sqrt(std::fabs(cdDet)) * 3600.0;
+    solution.eastToTheRight = cdDet > 0;
+    solution.matches        = pairs.size();
+    solution.rms            = rms;
+    return true;
+}
+
+int DifferentialSolver::match(const QVector<QPointF> &stars, const Affine &transform, double tolerance,
+                              QVector<QPair<int, int>> &pairs) const
+{
+    // Pairs of new and reference star indexes, a reference star is paired to its closest new star only.
+    QVector<int> closest(m_ReferenceStars.size(), -1);
+    QVector<double> distances(m_ReferenceStars.size(), tolerance * tolerance);
+
+    for (int i = 0; i < stars.size(); i++)
+    {
+        const QPointF p = transform.map(stars[i]);
+        int best = -1;
+        double bestDistance = tolerance * tolerance;
+        for (int j = 0; j < m_ReferenceStars.size(); j++)
+        {
+            const double dx = m_ReferenceStars[j].x() - p.x();
+            const double dy = m_ReferenceStars[j].y() - p.y();
+            const double distance = dx * dx + dy * dy;
+            if (distance < bestDistance)
+            {
+                best = j;
+                bestDistance = distance;
+            }
+        }
+        if (best >= 0 && bestDistance < distances[best])
+        {
+            closest[best]   = i;
+            distances[best] = bestDistance;
+        }
+    }
+
+    pairs.clear();
+    for (int j = 0; j < closest.size(); j++)
+    {
+        if (closest[j] >= 0)
+            pairs.append(qMakePair(closest[j], j));
+    }
+    return pairs.size();
+}
+
+bool DifferentialSolver::findTranslation(const QVector<QPointF> &stars, Affine &transform) const
+{
+    // Each pair of bright stars votes for the offset that would make them the same star, the offset matching
+    // the most stars wins.
+    QVector<QPair<int, int>> pairs;
+    int bestCount = 0;
+    for (int i = 0; i < std::min(VOTING_STARS, static_cast<int>(stars.size())); i++)
+    {
+        for (int j = 0; j < std::min(VOTING_STARS, static_cast<int>(m_ReferenceStars.size())); j++)
+        {
+            Affine candidate;
+            candidate.tx = m_ReferenceStars[j].x() - stars[i].x();
+            candidate.ty = m_ReferenceStars[j].y() - stars[i].y();
+            const int count = match(stars, candidate, VOTE_TOLERANCE, pairs);
+            if (count > bestCount)
+            {
+                bestCount = count;
+                transform = candidate;
+            }
+        }
+    }
+    return bestCount >= MIN_MATCHES;
+}
+
+bool DifferentialSolver::fit(const QVector<QPointF> &stars, const QVector<QPointF> &reference,
+                             const QVector<QPair<int, int>> &pairs, Affine &transform, double &rms)
+{
+    if (pairs.size() < 3)
+        return false;
+
+    // Least squares on centered coordinates
+    QPointF meanStar, meanReference;
+    for (const auto &pair : pairs)
+    {
+        meanStar += stars[pair.first];
+        meanReference += reference[pair.second];
+    }
+    meanStar /= pairs.size();
+    meanReference /= pairs.size();
+
+    double suu = 0, suv = 0, svv = 0, sux = 0, svx = 0, suy = 0, svy = 0;
+    for (const auto &pair : pairs)
+    {
+        const QPointF q = stars[pair.first] - meanStar;
+        const QPointF p = reference[pair.second] - meanReference;
+        suu += q.x() * q.x();
+        suv += q.x() * q.y();
+        svv += q.y() * q.y();
+        sux += q.x() * p.x();
+        svx += q.y() * p.x();
+        suy += q.x() * p.y();
+        svy += q.y() * p.y();
+    }
+
+    const double det = suu * svv - suv * suv;
+    if (std::fabs(det) < 1e-9)
+        return false;
+
+    transform.a  = (sux * svv - svx * suv) / det;
+    transform.b  = (svx * suu - sux * suv) / det;
+    transform.c  = (suy * svv - svy * suv) / det;
+    transform.d  = (svy * suu - suy * suv) / det;
+    transform.tx = meanReference.x() - transform.a * meanStar.x() - transform.b * meanStar.y();
+    transform.ty = meanReference.y() - transform.c * meanStar.x() - transform.d * meanStar.y();
+
+    double sum = 0;
+    for (const auto &pair : pairs)
+    {
+        const QPointF residual = transform.map(stars[pair.first]) - reference[pair.second];
+        sum += residual.x() * residual.x() + residual.y() * residual.y();
+    }
+    rms = std::sqrt(sum / pairs.size());
+    return true;
+}
+
+void DifferentialSolver::referenceToSky(const QPointF &pixel, double &ra, double &dec) const
+{
+    const double dx = pixel.x() - m_Width / 2.0;
+    const double dy = pixel.y() - m_Height / 2.0;
+    deproject(m_Reference.ra, m_Reference.dec, m_CD[0][0] * dx + m_CD[0][1] * dy, m_CD[1][0] * dx + m_CD[1][1] * dy,
+              ra, dec);
+}
+
+}
@@ -0,0 +1,103 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+
+namespace Ekos
+{
+
+/**
+ * @class DifferentialSolver
+ * @short Solves an image from the stars and solution of a previously solved image of the same field.
+ *
+ * When Align converges on a target, each new image is taken a small slew away from the previous one, with the
+ * same optics. Instead of running the full solver again, the detected stars of the new image are matched to the
+ * stars of the last image solved by the full solver, and an affine transform from the new image to the reference
+ * image is fitted to the matched pairs. The solution of the new image then follows from the gnomonic (TAN)
+ * projection of the reference solution, which takes milliseconds instead of seconds.
+ *
+ * Matching is rejected, so that the full solver runs instead, when too few stars match, when the residuals are
+ * large, or when the fitted transform is not a rigid motion of the field (different binning, focal length or a
+ * meridian flip).
+ *
+ * Coordinates are J2000 degrees and orientations follow the convention of the solver, as in FITSData::injectWCS().
+ */
+class DifferentialSolver
+{
+    public:
+        struct Solution
+        {
+            double orientation { 0 };
+            double ra { 0 };
+            double dec { 0 };
+            double pixscale { 0 };
+            bool eastToTheRight { false };
+            // Number of matched stars, and RMS residual in pixels of the fit
+            int matches { 0 };
+            double rms { 0 };
+        };
+
+        /**
+         * @brief setReference Keeps the stars and the solution of an image solved by the full solver.
+         * @param stars pixel positions of the detected stars, brightest first
+         * @param width width of the image in pixels
+         * @param height height of the image in pixels
+         * @param solution solution of the image
+         */
+        void setReference(const QVector<QPointF> &stars, int width, int height, const Solution &solution);
+
+        /** @brief clearReference Forgets the reference, the next image needs the full solver. */
+        void clearReference();
+
+        /** @return true if there is a reference to match new images to */
+        bool hasReference() const
+        {
+            return !m_ReferenceStars.isEmpty();
+        }
+
+        /**
+         * @brief solve Solves an image by matching its stars to the reference stars.
+         * @param stars pixel positions of the detected stars, brightest first
+         * @param width width of the image in pixels
+         * @param height height of the image in pixels
+         * @param solution set to the solution of the image on success
+         * @return true on success, false if the full solver is needed
+         */
+        bool solve(const QVector<QPointF> &stars, int width, int height, Solution &solution) const;
+
+    private:
+        // Affine transform x' = a x + b y + tx, y' = c x + d y + ty
+        struct Affine
+        {
+            double a { 1 }, b { 0 }, tx { 0 };
+            double c { 0 }, d { 1 }, ty { 0 };
+
+            QPointF map(const QPointF &p) const
+            {
+                return QPointF(a * p.x() + b * p.y() + tx, c * p.x() + d * p.y() + ty);
+            }
+        };
+
+        int match(const QVector<QPointF> &stars, const Affine &transform, double tolerance,
+                  QVector<QPair<int, int>> &pairs) const;
+        bool findTranslation(const QVector<QPointF> &stars, Affine &transform) const;
+        static bool fit(const QVector<QPointF> &stars, const QVector<QPointF> &reference,
+                        const QVector<QPair<int, int>> &pairs, Affine &transform, double &rms);
+
+        void referenceToSky(const QPointF &pixel, double &ra, double &dec) const;
+
+        QVector<QPointF> m_ReferenceStars;
+        int m_Width { 0 };
+        int m_Height { 0 };
+        Solution m_Reference;
+        // CD matrix of the reference solution, degrees per pixel
+        double m_CD[2][2] {{0, 0}, {0, 0}};
+};
+
+}
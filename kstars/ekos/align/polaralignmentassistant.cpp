@@ -15,6 +15,7 @@
 #include "ekos/auxiliary/solverutils.h"
 #include "Options.h"
 #include "polaralignwidget.h"
+#include "ekos/guide/internalguide/guidealgorithms.h"
 #include <ekos_align_debug.h>
 
 #define PAA_VERSION "v3.0"
@@ -410,8 +411,71 @@ void PolarAlignmentAssistant::updateRefreshDisplay(double azE, double altE)
     emit updatedErrorsChanged(totalError.Degrees(), azError.Degrees(), altError.Degrees());
 }
 
+bool PolarAlignmentAssistant::isTrackingRefreshStar() const
+{
+    return m_PAHStage == PAH_REFRESH && m_StarTracked && Options::pAHRefreshTracking() &&
+           pAHRefreshAlgorithm->currentIndex() == MOVE_STAR_UPDATE_ERR_ALGORITHM;
+}
+
+bool PolarAlignmentAssistant::trackRefreshStar()
+{
+    // The star nearest to its last position is searched within this many pixels, then its centroid is
+    // computed in a smaller box around its peak, which excludes most neighbouring stars.
+    constexpr int TRACKING_SEARCH_RADIUS = 32;
+    constexpr int TRACKING_REFINE_RADIUS = 12;
+    // The full star detection confirms the tracked star every few frames.
+    constexpr int TRACKING_CONFIRM_FRAMES = 10;
+
+    if (!isTrackingRefreshStar() || m_TrackedFrames >= TRACKING_CONFIRM_FRAMES)
+        return false;
+
+    QPointF star;
+    if (!GuideAlgorithms::findStarCentroid(m_ImageData, m_TrackedStar, TRACKING_SEARCH_RADIUS, TRACKING_REFINE_RADIUS,
+                                           &star))
+    {
+        qCDebug(KSTARS_EKOS_ALIGN) << QString("PAA Refresh(%1): Lost the tracked star near %2,%3")
+                                   .arg(refreshIteration).arg(m_TrackedStar.x(), 4, 'f', 0).arg(m_TrackedStar.y(), 4, 'f', 0);
+        m_StarTracked = false;
+        return false;
+    }
+
+    refreshIteration++;
+    m_TrackedFrames++;
+    m_TrackedStar = star;
+    m_AlignView->setStarCircle(star);
+    updateRefreshError(star);
+    return true;
+}
+
+void PolarAlignmentAssistant::updateRefreshError(const QPointF &star)
+{
+    double azE, altE;
+    if (polarAlign.pixelError(m_AlignView->keptImage(), star, correctionTo, &azE, &altE))
+    {
+        updateRefreshDisplay(azE, altE);
+        qCDebug(KSTARS_EKOS_ALIGN) << QString("PAA Refresh(%1): %2,%3 --> %4,%5 @ %6,%7")
+                                   .arg(refreshIteration).arg(correctionFrom.x(), 4, 'f', 0).arg(correctionFrom.y(), 4, 'f', 0)
+                                   .arg(correctionTo.x(), 4, 'f', 0).arg(correctionTo.y(), 4, 'f', 0)
+                                   .arg(star.x(), 4, 'f', 0).arg(star.y(), 4, 'f', 0);
+    }
+    else
+    {
+        qCDebug(KSTARS_EKOS_ALIGN) << QString("PAA Refresh(%1): pixelError failed to estimate the remaining correction")
+                                   .arg(refreshIteration);
+    }
+}
+
 void PolarAlignmentAssistant::processPAHRefresh()
 {
+    // Follow the user's star in a small box, the full star detection below only runs when the star is lost,
+    // and every few frames to confirm it.
+    if (trackRefreshStar())
+    {
+        PAHIteration->setText(QString("Image %1").arg(++imageNumber));
+        emit captureAndSolve();
+        return;
+    }
+
     m_AlignView->setStarCircle();
     PAHUpdatedErrorTotal->clear();
     PAHIteration->clear();
@@ -474,7 +538,10 @@ void PolarAlignmentAssistant::processPAHRefresh()
                 {
                     setupCorrectionGraphics(QPointF(stars[clickedStarIndex].x, stars[clickedStarIndex].y));
                     emit newCorrectionVector(QLineF(correctionFrom, correctionTo));
-                    emit newFrame(m_AlignView);
+
+                    m_TrackedStar   = QPointF(stars[clickedStarIndex].x, stars[clickedStarIndex].y);
+                    m_StarTracked   = true;
+                    m_TrackedFrames = 0;
                 }
             }
             else
@@ -518,22 +585,12 @@ void PolarAlignmentAssistant::processPAHRefresh()
                               .arg(stars[starIndex].x, 4, 'f', 0).arg(stars[starIndex].y, 4, 'f', 0).arg(dx).arg(dy);
                 qCDebug(KSTARS_EKOS_ALIGN) << debugString;
 
-                double azE, altE;
-                if (polarAlign.pixelError(m_AlignView->keptImage(), QPointF(stars[starIndex].x, stars[starIndex].y),
-                                          correctionTo, &azE, &altE))
-                {
-                    updateRefreshDisplay(azE, altE);
-                    debugString = QString("PAA Refresh(%1): %2,%3 --> %4,%5 @ %6,%7")
-                                  .arg(refreshIteration).arg(correctionFrom.x(), 4, 'f', 0).arg(correctionFrom.y(), 4, 'f', 0)
-                                  .arg(correctionTo.x(), 4, 'f', 0).arg(correctionTo.y(), 4, 'f', 0)
-                                  .arg(stars[starIndex].x, 4, 'f', 0).arg(stars[starIndex].y, 4, 'f', 0);
-                    qCDebug(KSTARS_EKOS_ALIGN) << debugString;
-                }
-                else
-                {
-                    debugString = QString("PAA Refresh(%1): pixelError failed to estimate the remaining correction").arg(refreshIteration);
-                    qCDebug(KSTARS_EKOS_ALIGN) << debugString;
-                }
+                updateRefreshError(QPointF(stars[starIndex].x, stars[starIndex].y));
+
+                // The next frames follow the star from here
+                m_TrackedStar   = QPointF(stars[starIndex].x, stars[starIndex].y);
+                m_StarTracked   = true;
+                m_TrackedFrames = 0;
             }
             else
             {
@@ -1021,6 +1078,8 @@ void PolarAlignmentAssistant::startPAHRefreshProcess()
     refreshIteration = 0;
     imageNumber = 0;
     m_NumHealpixFailures = 0;
+    m_StarTracked = false;
+    m_TrackedFrames = 0;
 
     setPAHStage(PAH_REFRESH);
     polarAlignWidget->updatePAHStage(m_PAHStage);
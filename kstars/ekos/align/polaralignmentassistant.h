@@ -100,8 +100,11 @@ class PolarAlignmentAssistant : public QWidget, public Ui::PolarAlignmentAssista
         {
             return pAHExposure->value();
         }
-        // Handle updates during the refresh phase such as error estimation.
+        // Handle updates during the refresh phase such as error estimation. Expects the frame to be
+        // loaded in the view already, the caller emits newFrame afterwards.
         void processPAHRefresh();
+        // True while the user's star is followed in a small box in the refresh phase.
+        bool isTrackingRefreshStar() const;
         // Handle solver failure and retry to capture until a preset number of retries is met.
         bool processSolverFailure();
         // Handle both automated and manual mount rotations.
@@ -237,6 +240,16 @@ class PolarAlignmentAssistant : public QWidget, public Ui::PolarAlignmentAssista
 
 
         bool detectStarsPAHRefresh(QList<Edge> *stars, int num, int x, int y, int *xyIndex);
+        // Follow the user's star from its last position, returns false if the full star detection is needed.
+        bool trackRefreshStar();
+        // Estimate the remaining error from the position of the user's star.
+        void updateRefreshError(const QPointF &star);
+
+        // Last position of the user's star in the refresh phase, followed without detecting all the stars.
+        QPointF m_TrackedStar;
+        bool m_StarTracked { false };
+        // Frames tracked since the full star detection last found the user's star
+        int m_TrackedFrames { 0 };
 
         // Incremented every time sufficient # of stars are detected (for move-star refresh) or
         // when solver is successful (for plate-solve refresh).
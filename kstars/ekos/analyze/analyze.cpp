@@ -7,14 +7,19 @@
 #include "analyze.h"
 
 #include <KNotifications/KNotification>
+#include <QCryptographicHash>
 #include <QDateTime>
+#include <QSaveFile>
 #include <QShortcut>
+#include <QtConcurrent>
 #include <QtGlobal>
 #include <QColor>
 
 #include "auxiliary/kspaths.h"
 #include "dms.h"
+#include "ekos/auxiliary/rmsfilter.h"
 #include "ekos/manager.h"
+#include "ekos/guide/internalguide/guidelatency.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsviewer.h"
 #include "ksmessagebox.h"
@@ -60,7 +65,7 @@ constexpr int MAX_SCROLL_VALUE = 10000;
 constexpr double halfTimelineHeight = 0.35;
 
 // These are initialized in initStatsPlot when the graphs are added.
-// They index the graphs in statsPlot, e.g. statsPlot->graph(HFR_GRAPH)->addData(...)
+// They index the graphs in statsPlot, e.g. addStatsData(HFR_GRAPH, ...)
 int HFR_GRAPH = -1;
 int TEMPERATURE_GRAPH = -1;
 int NUM_CAPTURE_STARS_GRAPH = -1;
@@ -82,6 +87,7 @@ int MOUNT_HA_GRAPH = -1;
 int AZ_GRAPH = -1;
 int ALT_GRAPH = -1;
 int PIER_SIDE_GRAPH = -1;
+int GUIDE_LATENCY_GRAPH = -1;
 int TARGET_DISTANCE_GRAPH = -1;
 
 // Initialized in initGraphicsPlot().
@@ -102,6 +108,21 @@ const QBrush progress4Brush(Qt::darkGreen, Qt::SolidPattern);
 const QBrush stoppedBrush(Qt::yellow, Qt::SolidPattern);
 const QBrush stopped2Brush(Qt::darkYellow, Qt::SolidPattern);
 
+// Lines of a .analyze file read at once, and chunks queued at once, when a file is read in the background.
+constexpr int LOG_CHUNK_LINES = 5000;
+constexpr int LOG_CHUNKS_IN_FLIGHT = 4;
+
+// Header of the index of a .analyze file.
+constexpr quint32 LOG_INDEX_MAGIC = 0x4b534149;
+constexpr quint32 LOG_INDEX_VERSION = 1;
+
+// The samples are restored from the index of a .analyze file, the other lines are processed again.
+bool isSampleLine(const QString &line)
+{
+    return line.startsWith(QLatin1String("GuideStats,")) || line.startsWith(QLatin1String("GuideLatency,")) ||
+           line.startsWith(QLatin1String("MountCoords,")) || line.startsWith(QLatin1String("Temperature,"));
+}
+
 // Utility to checks if a file exists and is not a directory.
 bool fileExists(const QString &path)
 {
@@ -290,33 +311,6 @@ IntervalFinder<Ekos::Analyze::SchedulerJobSession> schedulerJobSessions;
 namespace Ekos
 {
 
-// RmsFilter computes the RMS error of a 2-D sequence. Input the x error and y error
-// into newSample(). It returns the sqrt of an approximate moving average of the squared
-// errors roughly averaged over 40 samples--implemented by a simple digital low-pass filter.
-// It's used to compute RMS guider errors, where x and y would be RA and DEC errors.
-class RmsFilter
-{
-    public:
-        RmsFilter()
-        {
-            constexpr double timeConstant = 40.0;
-            alpha = 1.0 / pow(timeConstant, 0.865);
-        }
-        void resetFilter()
-        {
-            filteredRMS = 0;
-        }
-        double newSample(double x, double y)
-        {
-            const double valueSquared = x * x + y * y;
-            filteredRMS = alpha * valueSquared + (1.0 - alpha) * filteredRMS;
-            return sqrt(filteredRMS);
-        }
-    private:
-        double alpha { 0 };
-        double filteredRMS { 0 };
-};
-
 bool Analyze::eventFilter(QObject *obj, QEvent *ev)
 {
     // Quit if click wasn't on a QLineEdit.
@@ -376,6 +370,7 @@ Analyze::Analyze() : m_YAxisTool(this)
 
     captureRms.reset(new RmsFilter);
     guiderRms.reset(new RmsFilter);
+    m_LogChunkSlots.release(LOG_CHUNKS_IN_FLIGHT);
 
     alternateFolder = QDir::homePath();
 
@@ -507,11 +502,7 @@ void Analyze::initInputSelection()
             // If we do this after the readData call below, it would animate the sequence.
             runtimeDisplay = false;
 
-            maxXValue = readDataFromFile(inputURL.toLocalFile());
-            checkForMissingSchedulerJobEnd(maxXValue);
-            plotStart = 0;
-            plotWidth = maxXValue + 5;
-            replot();
+            loadLogFile(inputURL.toLocalFile());
         }
         else if (index == 2)
         {
@@ -559,6 +550,7 @@ void Analyze::setupKeyboardShortcuts(QWidget *plot)
 
 Analyze::~Analyze()
 {
+    stopLogReader();
     // TODO:
     // We should write out to disk any sessions that haven't terminated
     // (e.g. capture, focus, guide)
@@ -651,12 +643,12 @@ void Analyze::addGuideStats(double raDrift, double decDrift, int raPulse, int de
                 (time - lastCaptureRmsTime > MAX_GUIDE_STATS_GAP))
         {
             // this is the first sample in a series with a gap behind us.
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(lastCaptureRmsTime + .0001, qQNaN());
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time - .0001, qQNaN());
+            addStatsData(CAPTURE_RMS_GRAPH, lastCaptureRmsTime + .0001, qQNaN());
+            addStatsData(CAPTURE_RMS_GRAPH, time - .0001, qQNaN());
             captureRms->resetFilter();
         }
         const double rmsC = captureRms->newSample(raDrift, decDrift);
-        statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time, rmsC);
+        addStatsData(CAPTURE_RMS_GRAPH, time, rmsC);
         lastCaptureRmsTime = time;
     }
 
@@ -668,12 +660,12 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
                                     double numStars, double skyBackground,
                                     double drift, double rms, double time)
 {
-    statsPlot->graph(RA_GRAPH)->addData(time, raDrift);
-    statsPlot->graph(DEC_GRAPH)->addData(time, decDrift);
-    statsPlot->graph(RA_PULSE_GRAPH)->addData(time, raPulse);
-    statsPlot->graph(DEC_PULSE_GRAPH)->addData(time, decPulse);
-    statsPlot->graph(DRIFT_GRAPH)->addData(time, drift);
-    statsPlot->graph(RMS_GRAPH)->addData(time, rms);
+    addStatsData(RA_GRAPH, time, raDrift);
+    addStatsData(DEC_GRAPH, time, decDrift);
+    addStatsData(RA_PULSE_GRAPH, time, raPulse);
+    addStatsData(DEC_PULSE_GRAPH, time, decPulse);
+    addStatsData(DRIFT_GRAPH, time, drift);
+    addStatsData(RMS_GRAPH, time, rms);
 
     // Set the SNR axis' maximum to 95% of the way up from the middle to the top.
     if (!qIsNaN(snr))
@@ -683,9 +675,9 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
     if (!qIsNaN(numStars))
         numStarsMax = std::max(numStars, static_cast<double>(numStarsMax));
 
-    statsPlot->graph(SNR_GRAPH)->addData(time, snr);
-    statsPlot->graph(NUMSTARS_GRAPH)->addData(time, numStars);
-    statsPlot->graph(SKYBG_GRAPH)->addData(time, skyBackground);
+    addStatsData(SNR_GRAPH, time, snr);
+    addStatsData(NUMSTARS_GRAPH, time, numStars);
+    addStatsData(SKYBG_GRAPH, time, skyBackground);
 }
 
 void Analyze::addTemperature(double temperature, double time)
@@ -693,7 +685,7 @@ void Analyze::addTemperature(double temperature, double time)
     // The HFR corresponds to the last capture
     // If there is no temperature sensor, focus sends a large negative value.
     if (temperature > -200)
-        statsPlot->graph(TEMPERATURE_GRAPH)->addData(time, temperature);
+        addStatsData(TEMPERATURE_GRAPH, time, temperature);
 }
 
 void Analyze::addTargetDistance(double targetDistance, double time)
@@ -703,10 +695,10 @@ void Analyze::addTargetDistance(double targetDistance, double time)
             previousCaptureStartedTime < previousCaptureCompletedTime &&
             previousCaptureCompletedTime <= time)
     {
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureStartedTime - .0001, qQNaN());
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureStartedTime, targetDistance);
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureCompletedTime, targetDistance);
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureCompletedTime + .0001, qQNaN());
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureStartedTime - .0001, qQNaN());
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureStartedTime, targetDistance);
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureCompletedTime, targetDistance);
+        addStatsData(TARGET_DISTANCE_GRAPH, previousCaptureCompletedTime + .0001, qQNaN());
     }
 }
 
@@ -715,25 +707,25 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
                      double time, double startTime)
 {
     // The HFR corresponds to the last capture
-    statsPlot->graph(HFR_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(HFR_GRAPH)->addData(startTime, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time + .0001, qQNaN());
+    addStatsData(HFR_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(HFR_GRAPH, startTime, hfr);
+    addStatsData(HFR_GRAPH, time, hfr);
+    addStatsData(HFR_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, startTime, numCaptureStars);
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, time, numCaptureStars);
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(MEDIAN_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(MEDIAN_GRAPH, startTime, median);
+    addStatsData(MEDIAN_GRAPH, time, median);
+    addStatsData(MEDIAN_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(ECCENTRICITY_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(ECCENTRICITY_GRAPH, startTime, eccentricity);
+    addStatsData(ECCENTRICITY_GRAPH, time, eccentricity);
+    addStatsData(ECCENTRICITY_GRAPH, time + .0001, qQNaN());
 
     medianMax = std::max(median, medianMax);
     numCaptureStarsMax = std::max(numCaptureStars, numCaptureStarsMax);
@@ -744,12 +736,12 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
 void Analyze::addMountCoords(double ra, double dec, double az,
                              double alt, int pierSide, double ha, double time)
 {
-    statsPlot->graph(MOUNT_RA_GRAPH)->addData(time, ra);
-    statsPlot->graph(MOUNT_DEC_GRAPH)->addData(time, dec);
-    statsPlot->graph(MOUNT_HA_GRAPH)->addData(time, ha);
-    statsPlot->graph(AZ_GRAPH)->addData(time, az);
-    statsPlot->graph(ALT_GRAPH)->addData(time, alt);
-    statsPlot->graph(PIER_SIDE_GRAPH)->addData(time, double(pierSide));
+    addStatsData(MOUNT_RA_GRAPH, time, ra);
+    addStatsData(MOUNT_DEC_GRAPH, time, dec);
+    addStatsData(MOUNT_HA_GRAPH, time, ha);
+    addStatsData(AZ_GRAPH, time, az);
+    addStatsData(ALT_GRAPH, time, alt);
+    addStatsData(PIER_SIDE_GRAPH, time, double(pierSide));
 }
 
 // Read a .analyze file, and setup all the graphics.
@@ -772,6 +764,185 @@ double Analyze::readDataFromFile(const QString &filename)
     return lastTime;
 }
 
+void Analyze::loadLogFile(const QString &filename)
+{
+    stopLogReader();
+    if (readLogIndex(filename))
+    {
+        displayLoadedLog();
+        return;
+    }
+
+    m_LoadingFilename = filename;
+    m_LoadingMaxX = 10;
+    m_LoadingEvents.clear();
+
+    const int generation = m_LogGeneration;
+    m_LogReader = QtConcurrent::run([this, filename, generation]()
+    {
+        // Returns false if another file is loaded meanwhile.
+        auto post = [this, generation](const QStringList & lines)
+        {
+            while (!m_LogChunkSlots.tryAcquire(1, 100))
+            {
+                if (generation != m_LogGeneration)
+                    return false;
+            }
+            QMetaObject::invokeMethod(this, [this, generation, lines]()
+            {
+                m_LogChunkSlots.release();
+                processLogChunk(generation, lines);
+            }, Qt::QueuedConnection);
+            return true;
+        };
+
+        QFile inputFile(filename);
+        if (inputFile.open(QIODevice::ReadOnly))
+        {
+            QTextStream in(&inputFile);
+            QStringList lines;
+            while (!in.atEnd())
+            {
+                lines.append(in.readLine());
+                if (lines.size() == LOG_CHUNK_LINES)
+                {
+                    if (!post(lines))
+                        return;
+                    lines.clear();
+                }
+            }
+            if (!lines.isEmpty() && !post(lines))
+                return;
+        }
+        QMetaObject::invokeMethod(this, [this, generation]()
+        {
+            finishLogFile(generation);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void Analyze::processLogChunk(int generation, const QStringList &lines)
+{
+    if (generation != m_LogGeneration)
+        return;
+
+    for (const auto &line : lines)
+    {
+        const double time = processInputLine(line);
+        m_LoadingMaxX = std::max(time, m_LoadingMaxX);
+        if (!isSampleLine(line))
+            m_LoadingEvents.append(line);
+    }
+
+    // Display what was read so far.
+    maxXValue = m_LoadingMaxX;
+    plotStart = 0;
+    plotWidth = maxXValue + 5;
+    replot();
+}
+
+void Analyze::finishLogFile(int generation)
+{
+    if (generation != m_LogGeneration)
+        return;
+
+    maxXValue = m_LoadingMaxX;
+    writeLogIndex(m_LoadingFilename);
+    m_LoadingEvents.clear();
+    displayLoadedLog();
+}
+
+void Analyze::displayLoadedLog()
+{
+    checkForMissingSchedulerJobEnd(maxXValue);
+    plotStart = 0;
+    plotWidth = maxXValue + 5;
+    replot();
+}
+
+void Analyze::stopLogReader()
+{
+    // The reader stops at its next chunk, the chunks already queued are ignored.
+    m_LogGeneration++;
+    m_LogReader.waitForFinished();
+}
+
+namespace
+{
+QString logIndexPath(const QString &filename)
+{
+    const QByteArray hash = QCryptographicHash::hash(QFileInfo(filename).absoluteFilePath().toUtf8(),
+                            QCryptographicHash::Md5);
+    return QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(
+               QString("analyze/%1.index").arg(QString(hash.toHex())));
+}
+}
+
+bool Analyze::readLogIndex(const QString &filename)
+{
+    QFile indexFile(logIndexPath(filename));
+    if (!indexFile.open(QIODevice::ReadOnly))
+        return false;
+
+    const QFileInfo info(filename);
+    QDataStream in(&indexFile);
+    in.setVersion(QDataStream::Qt_5_12);
+    quint32 magic = 0, version = 0;
+    qint64 size = 0;
+    QDateTime modified;
+    in >> magic >> version >> size >> modified;
+    if (magic != LOG_INDEX_MAGIC || version != LOG_INDEX_VERSION || size != info.size() || modified != info.lastModified())
+        return false;
+
+    double maxX = 0;
+    qint32 count = 0;
+    in >> maxX >> count;
+    if (count != m_StatsSeries.size())
+        return false;
+    QVector<DecimatedSeries> series(count);
+    for (auto &oneSeries : series)
+    {
+        if (!oneSeries.load(in))
+            return false;
+    }
+    QStringList events;
+    in >> events;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    // The events rebuild the timeline, the samples they would add to the graphs are in the index already.
+    m_StatsSeries = series;
+    m_RestoringIndex = true;
+    for (const auto &line : events)
+        processInputLine(line);
+    m_RestoringIndex = false;
+    maxXValue = maxX;
+
+    qCDebug(KSTARS_EKOS_ANALYZE) << "Read" << filename << "from its index" << indexFile.fileName();
+    return true;
+}
+
+void Analyze::writeLogIndex(const QString &filename)
+{
+    const QFileInfo info(filename);
+    const QString path = logIndexPath(filename);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile indexFile(path);
+    if (!indexFile.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&indexFile);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << LOG_INDEX_MAGIC << LOG_INDEX_VERSION << info.size() << info.lastModified();
+    out << maxXValue << static_cast<qint32>(m_StatsSeries.size());
+    for (const auto &series : m_StatsSeries)
+        series.save(out);
+    out << m_LoadingEvents;
+    if (out.status() != QDataStream::Ok || !indexFile.commit())
+        qCWarning(KSTARS_EKOS_ANALYZE) << "Unable to write the index of" << filename << "to" << path;
+}
+
 // Process an input line read from a .analyze file.
 double Analyze::processInputLine(const QString &line)
 {
@@ -888,6 +1059,18 @@ double Analyze::processInputLine(const QString &line)
             return 0;
         processGuideStats(time, ra, dec, raPulse, decPulse, snr, skyBg, numStars, true);
     }
+    else if ((list[0] == "GuideLatency") && list.size() == 2 + GuideLatency::STAGE_COUNT)
+    {
+        QList<double> stageDurations;
+        for (int i = 2; i < list.size(); ++i)
+        {
+            const double duration = QString(list[i]).toDouble(&ok);
+            if (!ok)
+                return 0;
+            stageDurations.append(duration);
+        }
+        processGuideLatency(time, stageDurations, true);
+    }
     else if ((list[0] == "Temperature") && list.size() == 3)
     {
         const double temperature = QString(list[2]).toDouble(&ok);
@@ -1189,20 +1372,19 @@ void Analyze::displayGuideGraphics(double start, double end, double *raRMS,
                                    double *decRMS, double *totalRMS, int *numSamples)
 {
     resetGraphicsPlot();
-    auto ra = statsPlot->graph(RA_GRAPH)->data()->findBegin(start);
-    auto dec = statsPlot->graph(DEC_GRAPH)->data()->findBegin(start);
-    auto raEnd = statsPlot->graph(RA_GRAPH)->data()->findEnd(end);
-    auto decEnd = statsPlot->graph(DEC_GRAPH)->data()->findEnd(end);
+    const DecimatedSeries &raSeries = m_StatsSeries[RA_GRAPH];
+    const DecimatedSeries &decSeries = m_StatsSeries[DEC_GRAPH];
+    int ra = raSeries.findBegin(start);
+    int dec = decSeries.findBegin(start);
+    const int raEnd = raSeries.findEnd(end);
+    const int decEnd = decSeries.findEnd(end);
     int num = 0;
     double raSquareErrorSum = 0, decSquareErrorSum = 0;
-    while (ra != raEnd && dec != decEnd &&
-            ra->mainKey() < end && dec->mainKey() < end &&
-            ra != statsPlot->graph(RA_GRAPH)->data()->constEnd() &&
-            dec != statsPlot->graph(DEC_GRAPH)->data()->constEnd() &&
-            ra->mainKey() < end && dec->mainKey() < end)
-    {
-        const double raVal = ra->mainValue();
-        const double decVal = dec->mainValue();
+    while (ra < raEnd && dec < decEnd &&
+            raSeries.key(ra) < end && decSeries.key(dec) < end)
+    {
+        const double raVal = raSeries.value(ra);
+        const double decVal = decSeries.value(dec);
         graphicsPlot->graph(GUIDER_GRAPHICS)->addData(raVal, decVal);
         if (!qIsNaN(raVal) && !qIsNaN(decVal))
         {
@@ -1520,7 +1702,11 @@ void Analyze::replot(bool adjustSlider)
     timelinePlot->xAxis->setRange(plotStart, plotStart + plotWidth);
     timelinePlot->yAxis->setRange(0, LAST_Y);
 
+    // The graphs are filled again when the range changes, or here when only new samples arrived.
+    const QCPRange statsRange = statsPlot->xAxis->range();
     statsPlot->xAxis->setRange(plotStart, plotStart + plotWidth);
+    if (statsPlot->xAxis->range() == statsRange)
+        refreshStatsGraphs();
 
     // Rescale any automatic y-axes.
     if (statsPlot->isVisible())
@@ -1531,7 +1717,7 @@ void Analyze::replot(bool adjustSlider)
             if (statsPlot->graph(info.graphIndex)->visible() && info.rescale)
             {
                 QCPAxis *axis = info.axis;
-                axis->rescale();
+                rescaleStatsAxis(axis);
                 axis->scaleRange(1.1, axis->range().center());
             }
         }
@@ -1587,23 +1773,23 @@ namespace
 // Pass in a function that converts the double graph value to a string
 // for the value box.
 template<typename Func>
-void updateStat(double time, QLineEdit *valueBox, QCPGraph *graph, Func func, bool useLastRealVal = false)
+void updateStat(double time, QLineEdit *valueBox, const DecimatedSeries &series, Func func, bool useLastRealVal = false)
 {
-    auto begin = graph->data()->findBegin(time);
+    const int begin = series.findBegin(time);
     double timeDiffThreshold = 10000000.0;
-    if ((begin != graph->data()->constEnd()) &&
-            (fabs(begin->mainKey() - time) < timeDiffThreshold))
+    if ((begin < series.size()) &&
+            (fabs(series.key(begin) - time) < timeDiffThreshold))
     {
-        double foundVal = begin->mainValue();
+        double foundVal = series.value(begin);
         valueBox->setDisabled(false);
         if (qIsNaN(foundVal))
         {
-            int index = graph->findBegin(time);
+            int index = begin;
             const double MAX_TIME_DIFF = 600;
             while (useLastRealVal && index >= 0)
             {
-                const double val = graph->data()->at(index)->mainValue();
-                const double t = graph->data()->at(index)->mainKey();
+                const double val = series.value(index);
+                const double t = series.key(index);
                 if (time - t > MAX_TIME_DIFF)
                     break;
                 if (!qIsNaN(val))
@@ -1631,21 +1817,23 @@ void Analyze::updateStatsValues()
     auto d2Fcn = [](double d) -> QString { return QString::number(d, 'f', 2); };
     // HFR, numCaptureStars, median & eccentricity are the only ones to use the last real value,
     // that is, it keeps those values from the last exposure.
-    updateStat(time, hfrOut, statsPlot->graph(HFR_GRAPH), d2Fcn, true);
-    updateStat(time, eccentricityOut, statsPlot->graph(ECCENTRICITY_GRAPH), d2Fcn, true);
-    updateStat(time, skyBgOut, statsPlot->graph(SKYBG_GRAPH), d2Fcn);
-    updateStat(time, snrOut, statsPlot->graph(SNR_GRAPH), d2Fcn);
-    updateStat(time, raOut, statsPlot->graph(RA_GRAPH), d2Fcn);
-    updateStat(time, decOut, statsPlot->graph(DEC_GRAPH), d2Fcn);
-    updateStat(time, driftOut, statsPlot->graph(DRIFT_GRAPH), d2Fcn);
-    updateStat(time, rmsOut, statsPlot->graph(RMS_GRAPH), d2Fcn);
-    updateStat(time, rmsCOut, statsPlot->graph(CAPTURE_RMS_GRAPH), d2Fcn);
-    updateStat(time, azOut, statsPlot->graph(AZ_GRAPH), d2Fcn);
-    updateStat(time, altOut, statsPlot->graph(ALT_GRAPH), d2Fcn);
-    updateStat(time, temperatureOut, statsPlot->graph(TEMPERATURE_GRAPH), d2Fcn);
+    updateStat(time, hfrOut, m_StatsSeries[HFR_GRAPH], d2Fcn, true);
+    updateStat(time, eccentricityOut, m_StatsSeries[ECCENTRICITY_GRAPH], d2Fcn, true);
+    updateStat(time, skyBgOut, m_StatsSeries[SKYBG_GRAPH], d2Fcn);
+    updateStat(time, snrOut, m_StatsSeries[SNR_GRAPH], d2Fcn);
+    updateStat(time, raOut, m_StatsSeries[RA_GRAPH], d2Fcn);
+    updateStat(time, decOut, m_StatsSeries[DEC_GRAPH], d2Fcn);
+    updateStat(time, driftOut, m_StatsSeries[DRIFT_GRAPH], d2Fcn);
+    updateStat(time, rmsOut, m_StatsSeries[RMS_GRAPH], d2Fcn);
+    updateStat(time, rmsCOut, m_StatsSeries[CAPTURE_RMS_GRAPH], d2Fcn);
+    updateStat(time, azOut, m_StatsSeries[AZ_GRAPH], d2Fcn);
+    updateStat(time, altOut, m_StatsSeries[ALT_GRAPH], d2Fcn);
+    updateStat(time, temperatureOut, m_StatsSeries[TEMPERATURE_GRAPH], d2Fcn);
+    auto msFcn = [](double d) -> QString { return QString::number(d, 'f', 1); };
+    updateStat(time, guideLatencyOut, m_StatsSeries[GUIDE_LATENCY_GRAPH], msFcn);
 
     auto asFcn = [](double d) -> QString { return QString("%1\"").arg(d, 0, 'f', 0); };
-    updateStat(time, targetDistanceOut, statsPlot->graph(TARGET_DISTANCE_GRAPH), asFcn, true);
+    updateStat(time, targetDistanceOut, m_StatsSeries[TARGET_DISTANCE_GRAPH], asFcn, true);
 
     auto hmsFcn = [](double d) -> QString
     {
@@ -1654,9 +1842,9 @@ void Analyze::updateStatsValues()
         return QString("%1:%2:%3").arg(ra.hour()).arg(ra.minute()).arg(ra.second());
         //return ra.toHMSString();
     };
-    updateStat(time, mountRaOut, statsPlot->graph(MOUNT_RA_GRAPH), hmsFcn);
+    updateStat(time, mountRaOut, m_StatsSeries[MOUNT_RA_GRAPH], hmsFcn);
     auto dmsFcn = [](double d) -> QString { dms dec; dec.setD(d); return dec.toDMSString(); };
-    updateStat(time, mountDecOut, statsPlot->graph(MOUNT_DEC_GRAPH), dmsFcn);
+    updateStat(time, mountDecOut, m_StatsSeries[MOUNT_DEC_GRAPH], dmsFcn);
     auto haFcn = [](double d) -> QString
     {
         dms ha;
@@ -1671,21 +1859,21 @@ void Analyze::updateStatsValues()
         return QString("%1%2:%3").arg(sgn).arg(ha.hour(), 2, 10, z)
         .arg(ha.minute(), 2, 10, z);
     };
-    updateStat(time, mountHaOut, statsPlot->graph(MOUNT_HA_GRAPH), haFcn);
+    updateStat(time, mountHaOut, m_StatsSeries[MOUNT_HA_GRAPH], haFcn);
 
     auto intFcn = [](double d) -> QString { return QString::number(d, 'f', 0); };
-    updateStat(time, numStarsOut, statsPlot->graph(NUMSTARS_GRAPH), intFcn);
-    updateStat(time, raPulseOut, statsPlot->graph(RA_PULSE_GRAPH), intFcn);
-    updateStat(time, decPulseOut, statsPlot->graph(DEC_PULSE_GRAPH), intFcn);
-    updateStat(time, numCaptureStarsOut, statsPlot->graph(NUM_CAPTURE_STARS_GRAPH), intFcn, true);
-    updateStat(time, medianOut, statsPlot->graph(MEDIAN_GRAPH), intFcn, true);
+    updateStat(time, numStarsOut, m_StatsSeries[NUMSTARS_GRAPH], intFcn);
+    updateStat(time, raPulseOut, m_StatsSeries[RA_PULSE_GRAPH], intFcn);
+    updateStat(time, decPulseOut, m_StatsSeries[DEC_PULSE_GRAPH], intFcn);
+    updateStat(time, numCaptureStarsOut, m_StatsSeries[NUM_CAPTURE_STARS_GRAPH], intFcn, true);
+    updateStat(time, medianOut, m_StatsSeries[MEDIAN_GRAPH], intFcn, true);
 
 
     auto pierFcn = [](double d) -> QString
     {
         return d == 0.0 ? "W->E" : d == 1.0 ? "E->W" : "?";
     };
-    updateStat(time, pierSideOut, statsPlot->graph(PIER_SIDE_GRAPH), pierFcn);
+    updateStat(time, pierSideOut, m_StatsSeries[PIER_SIDE_GRAPH], pierFcn);
 }
 
 void Analyze::initStatsCheckboxes()
@@ -1712,6 +1900,7 @@ void Analyze::initStatsCheckboxes()
     azCB->setChecked(Options::analyzeAz());
     altCB->setChecked(Options::analyzeAlt());
     pierSideCB->setChecked(Options::analyzePierSide());
+    guideLatencyCB->setChecked(Options::analyzeGuideLatency());
 }
 
 void Analyze::zoomIn()
@@ -2150,6 +2339,10 @@ void Analyze::initStatsPlot()
     QCPAxis *pierSideAxis = newStatsYAxis(shortName, -2, 2);
     PIER_SIDE_GRAPH = initGraphAndCB(statsPlot, pierSideAxis, QCPGraph::lsLine, Qt::darkRed, "Mount Pier Side", shortName,
                                      pierSideCB, Options::setAnalyzePierSide, pierSideOut);
+    shortName = "Latency";
+    QCPAxis *latencyAxis = newStatsYAxis(shortName, 0, 2000);
+    GUIDE_LATENCY_GRAPH = initGraphAndCB(statsPlot, latencyAxis, QCPGraph::lsStepLeft, Qt::magenta, "Guider Latency (ms)",
+                                         shortName, guideLatencyCB, Options::setAnalyzeGuideLatency, guideLatencyOut);
 
     // This makes mouseMove only get called when a button is pressed.
     statsPlot->setMouseTracking(false);
@@ -2162,9 +2355,60 @@ void Analyze::initStatsPlot()
     // Didn't include QCP::iRangeDrag as it  interacts poorly with the curson logic.
     statsPlot->setInteractions(QCP::iRangeZoom);
 
+    // The graphs only hold the points in view, zooming with the mouse wheel needs others.
+    m_StatsSeries.resize(statsPlot->graphCount());
+    connect(statsPlot->xAxis, static_cast<void(QCPAxis::*)(const QCPRange &)>(&QCPAxis::rangeChanged), this,
+            [this](const QCPRange &)
+    {
+        refreshStatsGraphs();
+    });
+
     restoreYAxes(Options::analyzeStatsYAxis());
 }
 
+// Samples are kept in m_StatsSeries, replot() copies those in view to the graphs.
+void Analyze::addStatsData(int graph, double time, double value)
+{
+    if (!m_RestoringIndex)
+        m_StatsSeries[graph].append(time, value);
+}
+
+void Analyze::refreshStatsGraphs()
+{
+    for (int i = 0; i < statsPlot->graphCount() && i < m_StatsSeries.size(); ++i)
+        m_StatsSeries[i].fill(statsPlot->graph(i));
+}
+
+void Analyze::rescaleStatsAxis(QCPAxis *axis)
+{
+    QCPRange range;
+    bool haveRange = false;
+    for (int i = 0; i < statsPlot->graphCount() && i < m_StatsSeries.size(); ++i)
+    {
+        if (statsPlot->graph(i)->valueAxis() != axis)
+            continue;
+        bool found = false;
+        const QCPRange values = m_StatsSeries[i].valueRange(&found);
+        if (!found)
+            continue;
+        if (haveRange)
+            range.expand(values);
+        else
+            range = values;
+        haveRange = true;
+    }
+    if (!haveRange)
+        return;
+
+    // As QCPAxis::rescale(), a single value is centered in the current range.
+    if (!QCPRange::validRange(range))
+    {
+        const double center = range.center();
+        range = QCPRange(center - axis->range().size() / 2, center + axis->range().size() / 2);
+    }
+    axis->setRange(range);
+}
+
 // Clear the graphics and state when changing input data.
 void Analyze::reset()
 {
@@ -2177,8 +2421,12 @@ void Analyze::reset()
 
     unhighlightTimelineItem();
 
+    stopLogReader();
+
     for (int i = 0; i < statsPlot->graphCount(); ++i)
         statsPlot->graph(i)->data()->clear();
+    for (auto &series : m_StatsSeries)
+        series.clear();
     statsPlot->clearItems();
 
     for (int i = 0; i < timelinePlot->graphCount(); ++i)
@@ -2217,6 +2465,7 @@ void Analyze::reset()
     driftOut->setText("");
     rmsOut->setText("");
     rmsCOut->setText("");
+    guideLatencyOut->setText("");
 
     removeStatsCursor();
     removeTemporarySessions();
@@ -2890,6 +3139,28 @@ void Analyze::processGuideStats(double time, double raError, double decError,
         replot();
 }
 
+void Analyze::guideLatency(const QList<double> &stageDurations)
+{
+    QStringList durations;
+    for (const double duration : stageDurations)
+        durations << QString::number(duration, 'f', 2);
+    saveMessage("GuideLatency", durations.join(','));
+
+    if (runtimeDisplay)
+        processGuideLatency(logTime(), stageDurations);
+}
+
+// Only the total latency is plotted, the other stages are kept in the log for offline analysis.
+void Analyze::processGuideLatency(double time, const QList<double> &stageDurations, bool batchMode)
+{
+    if (stageDurations.size() != GuideLatency::STAGE_COUNT)
+        return;
+    addStatsData(GUIDE_LATENCY_GRAPH, time, stageDurations[GuideLatency::TOTAL]);
+    updateMaxX(time);
+    if (!batchMode)
+        replot();
+}
+
 void Analyze::resetGuideStats()
 {
     lastGuideStatsTime = -1;
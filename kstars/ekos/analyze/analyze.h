@@ -8,16 +8,21 @@
 #define ANALYZE_H
 
 #include <QtDBus>
+#include <QFuture>
+#include <QSemaphore>
+#include <atomic>
 #include <memory>
 #include "qcustomplot.h"
 #include "ekos/ekos.h"
 #include "ekos/mount/mount.h"
 #include "indi/indimount.h"
+#include "ekos/auxiliary/decimatedseries.h"
 #include "yaxistool.h"
 #include "ui_analyze.h"
 
 class FITSViewer;
 class OffsetDateTimeTicker;
+class TestAnalyzeLog;
 
 namespace Ekos
 {
@@ -165,6 +170,7 @@ class Analyze : public QWidget, public Ui::Analyze
         void guideState(Ekos::GuideState status);
         void guideStats(double raError, double decError, int raPulse, int decPulse,
                         double snr, double skyBg, int numStars);
+        void guideLatency(const QList<double> &stageDurations);
 
         // From Focus
         void autofocusStarting(double temperature, const QString &filter);
@@ -212,6 +218,7 @@ class Analyze : public QWidget, public Ui::Analyze
         void processGuideState(double time, const QString &state, bool batchMode = false);
         void processGuideStats(double time, double raError, double decError, int raPulse,
                                int decPulse, double snr, double skyBg, int numStars, bool batchMode = false);
+        void processGuideLatency(double time, const QList<double> &stageDurations, bool batchMode = false);
         void processMountCoords(double time, double ra, double dec, double az, double alt,
                                 int pierSide, double ha, bool batchMode = false);
 
@@ -315,6 +322,12 @@ class Analyze : public QWidget, public Ui::Analyze
                     const double time, double startTime);
         void addTemperature(double temperature, const double time);
         void addTargetDistance(double targetDistance, const double time);
+        void addStatsData(int graph, double time, double value);
+
+        // Fills the statsPlot graphs with the samples in view, at the resolution of the plot.
+        void refreshStatsGraphs();
+        // Rescales an automatic y-axis to all the samples of its graphs.
+        void rescaleStatsAxis(QCPAxis *axis);
 
         // Initialize the graphs (axes, linestyle, pen, name, checkbox callbacks).
         // Returns the graph index.
@@ -370,6 +383,17 @@ class Analyze : public QWidget, public Ui::Analyze
         double readDataFromFile(const QString &filename);
         double processInputLine(const QString &line);
 
+        // Read and display an input .analyze file in the background, the plots are updated as it is read.
+        void loadLogFile(const QString &filename);
+        void processLogChunk(int generation, const QStringList &lines);
+        void finishLogFile(int generation);
+        void stopLogReader();
+        void displayLoadedLog();
+
+        // The binary index of a .analyze file keeps its samples and events, to open it again quickly.
+        bool readLogIndex(const QString &filename);
+        void writeLogIndex(const QString &filename);
+
         // Opens a FITS file for viewing.
         void displayFITS(const QString &filename);
 
@@ -411,6 +435,24 @@ class Analyze : public QWidget, public Ui::Analyze
         // the corresponding y-axis can be found.
         std::map<QObject*, YAxisInfo> yAxisMap;
 
+        // All the samples of each graph of statsPlot, which only holds the points in view.
+        QVector<DecimatedSeries> m_StatsSeries;
+        // True while the events of a log index are replayed, its samples are already in m_StatsSeries.
+        bool m_RestoringIndex { false };
+
+        // Background reading of a .analyze file. Lines are read in chunks, processed by the main thread.
+        // The generation changes when another file is loaded, the chunks of the previous one are dropped.
+        QFuture<void> m_LogReader;
+        std::atomic<int> m_LogGeneration { 0 };
+        QSemaphore m_LogChunkSlots;
+        QString m_LoadingFilename;
+        double m_LoadingMaxX { 0 };
+        // Lines of the file being loaded, other than the samples, kept for its index.
+        QStringList m_LoadingEvents;
+
+        // Testing
+        friend class ::TestAnalyzeLog;
+
         // The .analyze log file being written.
         QString logFilename { "" };
         QFile logFile;
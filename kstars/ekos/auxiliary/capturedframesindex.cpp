@@ -0,0 +1,166 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "capturedframesindex.h"
+
+#include <ekos_debug.h>
+
+#include <QDir>
+#include <QFileInfo>
+
+namespace
+{
+// File systems may only store the modification time to the second (or worse on FAT).
+// A folder modified this close to its listing may have changed again unnoticed.
+constexpr qint64 MTIME_RESOLUTION_MS = 2000;
+}
+
+namespace Ekos
+{
+
+CapturedFramesIndex *CapturedFramesIndex::_CapturedFramesIndex = nullptr;
+
+CapturedFramesIndex *CapturedFramesIndex::Instance()
+{
+    if (_CapturedFramesIndex == nullptr)
+        _CapturedFramesIndex = new CapturedFramesIndex();
+    return _CapturedFramesIndex;
+}
+
+CapturedFramesIndex::CapturedFramesIndex()
+{
+    connect(&m_Watcher, &QFileSystemWatcher::directoryChanged, this, &CapturedFramesIndex::onDirectoryChanged);
+}
+
+int CapturedFramesIndex::count(const QString &signature)
+{
+    QFileInfo const path_info(signature);
+    QString const sig_dir(QDir::cleanPath(path_info.absolutePath()));
+    QString const sig_file(path_info.completeBaseName());
+
+    Directory &dir = directory(sig_dir);
+    auto it = dir.counts.find(sig_file);
+    if (it != dir.counts.end())
+        return it->count;
+
+    /* FIXME: this counts all files with prefix in the storage location, not just captures. DSS analysis files are counted in, for instance. */
+    Count count;
+    count.re = QRegularExpression(sig_file);
+    for (const auto &name : dir.files)
+    {
+        if (count.re.match(QFileInfo(name).completeBaseName()).hasMatch())
+            count.count++;
+    }
+    dir.counts.insert(sig_file, count);
+    return count.count;
+}
+
+QSet<QString> CapturedFramesIndex::files(const QString &directoryPath)
+{
+    return directory(QDir::cleanPath(directoryPath)).files;
+}
+
+void CapturedFramesIndex::addFile(const QString &filename)
+{
+    if (filename.isEmpty())
+        return;
+
+    QFileInfo const info(filename);
+    QString const path = QDir::cleanPath(info.absolutePath());
+    auto it = m_Directories.find(path);
+    // Folders are listed on their first query, which will find the file.
+    if (it == m_Directories.end())
+        return;
+
+    // A folder changed by another program since it was listed is listed again at its next query.
+    if (isStale(path, *it))
+        return;
+
+    const QString name = info.fileName();
+    if (it->files.contains(name))
+        return;
+
+    it->files.insert(name);
+    const QString baseName = info.completeBaseName();
+    for (auto &count : it->counts)
+    {
+        if (count.re.match(baseName).hasMatch())
+            count.count++;
+    }
+
+    // The new file changed the folder, this must not cause it to be listed again. Another file may
+    // be added in the same time step without changing the modification time, as for list().
+    it->modified = QFileInfo(path).lastModified();
+    it->certain  = isCertain(it->modified);
+}
+
+void CapturedFramesIndex::rescan()
+{
+    if (!m_Watcher.directories().isEmpty())
+        m_Watcher.removePaths(m_Watcher.directories());
+    m_Directories.clear();
+}
+
+CapturedFramesIndex::Directory &CapturedFramesIndex::directory(const QString &path)
+{
+    auto it = m_Directories.find(path);
+    if (it == m_Directories.end())
+    {
+        it = m_Directories.insert(path, Directory());
+        list(path, *it);
+    }
+    else if (isStale(path, *it))
+        list(path, *it);
+
+    return *it;
+}
+
+bool CapturedFramesIndex::isCertain(const QDateTime &modified)
+{
+    return !modified.isValid() || modified.msecsTo(QDateTime::currentDateTime()) >= MTIME_RESOLUTION_MS;
+}
+
+bool CapturedFramesIndex::isStale(const QString &path, const Directory &directory) const
+{
+    const QDateTime modified = QFileInfo(path).lastModified();
+    if (modified != directory.modified)
+        return true;
+
+    // The folder may have been changed again in the same time step as its listing.
+    return !directory.certain;
+}
+
+void CapturedFramesIndex::list(const QString &path, Directory &directory)
+{
+    // Read the time before listing, so a change during the listing is found at the next query.
+    directory.modified = QFileInfo(path).lastModified();
+    directory.certain  = isCertain(directory.modified);
+    directory.files.clear();
+    directory.counts.clear();
+
+    const QStringList entries = QDir(path).entryList(QDir::Files);
+    directory.files.reserve(entries.size());
+    for (const auto &name : entries)
+        directory.files.insert(name);
+
+    // The folder may not exist before the first capture
+    if (directory.modified.isValid() && !m_Watcher.directories().contains(path))
+        m_Watcher.addPath(path);
+
+    qCDebug(KSTARS_EKOS) << "Indexed" << directory.files.size() << "files in" << path;
+}
+
+void CapturedFramesIndex::onDirectoryChanged(const QString &path)
+{
+    auto it = m_Directories.find(QDir::cleanPath(path));
+    if (it == m_Directories.end() || !isStale(it.key(), *it))
+        return;
+
+    list(it.key(), *it);
+    emit directoryChanged(it.key());
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QRegularExpression>
+#include <QSet>
+#include <QString>
+
+namespace Ekos
+{
+
+/**
+ * @class CapturedFramesIndex
+ * @short Index of the captured frames, counting the frames stored for a job signature without listing its folder.
+ *
+ * The index lists each capture folder once and keeps the file names in memory. A folder is only listed
+ * again when its modification time changes, which costs a single file status instead of listing tens of
+ * thousands of frames, possibly on a network share. Frames captured by Ekos are added to the index as
+ * they are saved (see addFile()), and the modification time recorded for their folder is updated, so the
+ * captures of the running job never cause the folder to be listed again.
+ *
+ * A file system watcher updates the folders as soon as they are changed by other programs, when the file
+ * system supports it. Otherwise the change is found at the next query.
+ *
+ * Listing everything again is only done on demand, see rescan().
+ */
+class CapturedFramesIndex : public QObject
+{
+        Q_OBJECT
+
+    public:
+        static CapturedFramesIndex *Instance();
+
+        /**
+         * @brief count Counts the frames stored for a signature.
+         * @param signature path of the frames without the frame number and extension, as
+         * returned by SequenceJob::getSignature().
+         * @return the number of files in the folder of the signature whose base name contains
+         * the base name of the signature.
+         */
+        int count(const QString &signature);
+
+        /**
+         * @brief files Lists the files of a folder.
+         * @param directory the folder to list
+         * @return the names of the files, without their path, in no particular order.
+         */
+        QSet<QString> files(const QString &directory);
+
+        /**
+         * @brief addFile Adds a frame saved by Ekos to the index.
+         * @param filename absolute path of the frame
+         */
+        void addFile(const QString &filename);
+
+        /**
+         * @brief rescan Forgets everything, the folders are listed again at the next query.
+         */
+        void rescan();
+
+    signals:
+        /** The files of an indexed folder were changed by another program. */
+        void directoryChanged(const QString &directory);
+
+    private:
+        CapturedFramesIndex();
+
+        struct Count
+        {
+            QRegularExpression re;
+            int count { 0 };
+        };
+
+        struct Directory
+        {
+            QSet<QString> files;
+            // Modification time of the folder when it was listed
+            QDateTime modified;
+            // False if the folder was listed so soon after its modification that a change
+            // in the same time step would keep the same modification time
+            bool certain { false };
+            // Counts of the signatures of this folder, by base name
+            QHash<QString, Count> counts;
+        };
+
+        // Returns the folder, listing it if it changed since it was listed
+        Directory &directory(const QString &path);
+        void list(const QString &path, Directory &directory);
+        bool isStale(const QString &path, const Directory &directory) const;
+        // Whether no change can be missed after a listing at the given modification time
+        static bool isCertain(const QDateTime &modified);
+        void onDirectoryChanged(const QString &path);
+
+        static CapturedFramesIndex *_CapturedFramesIndex;
+
+        QHash<QString, Directory> m_Directories;
+        QFileSystemWatcher m_Watcher;
+};
+
+}
@@ -20,6 +20,7 @@
 #include "fitsviewer/fitsview.h"
 
 #include <QDesktopServices>
+#include <QtConcurrent>
 #include <QSqlRecord>
 #include <QSqlTableModel>
 #include <QStatusBar>
@@ -59,6 +60,14 @@ DarkLibrary::DarkLibrary(QWidget *parent) : QDialog(parent)
     // Dark Generation Connections
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     m_CurrentDarkFrame.reset(new FITSData(), &QObject::deleteLater);
+    m_DarkStacker.reset(new DarkStacker(writableDir.filePath("darks")));
+
+    // Kappa is only used by the sigma clipping algorithms.
+    connect(combinAlgorithmCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index)
+    {
+        stackingKappaSpin->setEnabled(index == DarkStacker::STACK_SIGMA_CLIP || index == DarkStacker::STACK_WINSORIZED_SIGMA_CLIP);
+    });
+    stackingKappaSpin->setEnabled(false);
 
     connect(darkTableView,  &QAbstractItemView::doubleClicked, this, [this](QModelIndex index)
     {
@@ -189,7 +198,8 @@ DarkLibrary::~DarkLibrary()
 ///////////////////////////////////////////////////////////////////////////////////////
 void DarkLibrary::refreshFromDB()
 {
-    KStarsData::Instance()->userdb()->GetAllDarkFrames(m_DarkFramesDatabaseList);
+    // The dark frame table is also edited here directly, read it again.
+    KStarsData::Instance()->userdb()->GetAllDarkFrames(m_DarkFramesDatabaseList, true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -498,8 +508,6 @@ void DarkLibrary::processNewImage(SequenceJob *job, const QSharedPointer<FITSDat
 
         metadata["count"] = job->getCoreProperty(SequenceJob::SJ_Count).toInt();
         generateMasterFrame(m_CurrentDarkFrame, metadata);
-        reloadDarksFromDatabase();
-        populateMasterMetedata();
     }
 }
 
@@ -525,11 +533,12 @@ void DarkLibrary::updateProperty(INDI::Property prop)
         return;
     }
 
-    uint32_t totalElements = m_CurrentDarkFrame->channels() * m_CurrentDarkFrame->samplesPerChannel();
-    if (totalElements != m_DarkMasterBuffer.size())
-        m_DarkMasterBuffer.assign(totalElements, 0);
+    if (!m_DarkStacker->addFrame(m_CurrentDarkFrame))
+    {
+        m_FileLabel->setText(m_DarkStacker->lastError());
+        return;
+    }
 
-    aggregate(m_CurrentDarkFrame);
     darkProgress->setValue(darkProgress->value() + 1);
     m_StatusLabel->setText(i18n("Received %1/%2 images.", darkProgress->value(), darkProgress->maximum()));
 }
@@ -1203,6 +1212,7 @@ void DarkLibrary::generateDarkJobs()
 void DarkLibrary::execute()
 {
     m_DarkImagesCounter = 0;
+    m_DarkStacker->clear();
     darkProgress->setValue(0);
     darkProgress->setTextVisible(true);
     connect(m_CaptureModule, &Capture::newImage, this, &DarkLibrary::processNewImage, Qt::UniqueConnection);
@@ -1225,6 +1235,7 @@ void DarkLibrary::execute()
 void DarkLibrary::stop()
 {
     m_CaptureModule->abort();
+    m_DarkStacker->clear();
     darkProgress->setValue(0);
     m_DarkView->reset();
 }
@@ -1247,127 +1258,61 @@ void DarkLibrary::initView()
     });
 }
 
-///////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////
-void DarkLibrary::aggregate(const QSharedPointer<FITSData> &data)
-{
-    switch (data->dataType())
-    {
-        case TBYTE:
-            aggregateInternal<uint8_t>(data);
-            break;
-
-        case TSHORT:
-            aggregateInternal<int16_t>(data);
-            break;
-
-        case TUSHORT:
-            aggregateInternal<uint16_t>(data);
-            break;
-
-        case TLONG:
-            aggregateInternal<int32_t>(data);
-            break;
-
-        case TULONG:
-            aggregateInternal<uint32_t>(data);
-            break;
-
-        case TFLOAT:
-            aggregateInternal<float>(data);
-            break;
-
-        case TLONGLONG:
-            aggregateInternal<int64_t>(data);
-            break;
-
-        case TDOUBLE:
-            aggregateInternal<double>(data);
-            break;
-
-        default:
-            break;
-    }
-}
-
-///////////////////////////////////////////////////////////////////////////////////////
-///
-///////////////////////////////////////////////////////////////////////////////////////
-template <typename T>
-void DarkLibrary::aggregateInternal(const QSharedPointer<FITSData> &data)
-{
-    T const *darkBuffer  = reinterpret_cast<T const*>(data->getImageBuffer());
-    for (uint32_t i = 0; i < m_DarkMasterBuffer.size(); i++)
-        m_DarkMasterBuffer[i] += darkBuffer[i];
-}
-
 ///////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
 void DarkLibrary::generateMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata)
 {
-    switch (data->dataType())
-    {
-        case TBYTE:
-            generateMasterFrameInternal<uint8_t>(data, metadata);
-            break;
-
-        case TSHORT:
-            generateMasterFrameInternal<int16_t>(data, metadata);
-            break;
-
-        case TUSHORT:
-            generateMasterFrameInternal<uint16_t>(data, metadata);
-            break;
-
-        case TLONG:
-            generateMasterFrameInternal<int32_t>(data, metadata);
-            break;
-
-        case TULONG:
-            generateMasterFrameInternal<uint32_t>(data, metadata);
-            break;
+    // Stack into a copy of the last frame so that the frames of the next job can be received meanwhile.
+    QSharedPointer<FITSData> master(new FITSData(data), &QObject::deleteLater);
+    QSharedPointer<DarkStacker> stacker = m_DarkStacker;
+    m_DarkStacker.reset(new DarkStacker(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("darks")));
 
-        case TFLOAT:
-            generateMasterFrameInternal<float>(data, metadata);
-            break;
+    const auto algorithm = static_cast<DarkStacker::Algorithm>(combinAlgorithmCombo->currentIndex());
+    const double kappa = stackingKappaSpin->value();
+    const int frameCount = stacker->frameCount();
+    m_StatusLabel->setText(i18n("Stacking %1 frames (%2)...", frameCount, DarkStacker::algorithmName(algorithm)));
 
-        case TLONGLONG:
-            generateMasterFrameInternal<int64_t>(data, metadata);
-            break;
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, master, stacker, metadata, frameCount]()
+    {
+        watcher->deleteLater();
+        if (!watcher->result())
+        {
+            m_FileLabel->setText(i18n("Failed to stack master frame: %1", stacker->lastError()));
+            return;
+        }
 
-        case TDOUBLE:
-            generateMasterFrameInternal<double>(data, metadata);
-            break;
+        if (stacker->rejectedCount() > 0)
+            emit newLog(i18n("Master dark frame stacked from %1 frames, %2 pixel values rejected.", frameCount,
+                             stacker->rejectedCount()));
 
-        default:
-            break;
-    }
-
-    emit newImage(data);
-    // Reset Master Buffer
-    m_DarkMasterBuffer.assign(m_DarkMasterBuffer.size(), 0);
+        saveMasterFrame(master, metadata);
+        emit newImage(master);
+        reloadDarksFromDatabase();
+        populateMasterMetedata();
+    });
 
+    watcher->setFuture(QtConcurrent::run([master, stacker, algorithm, kappa]()
+    {
+        if (!stacker->stack(master, algorithm, kappa))
+            return false;
+        master->calculateStats(true);
+        // The frame stores are not needed anymore.
+        stacker->clear();
+        return true;
+    }));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
-template <typename T>  void DarkLibrary::generateMasterFrameInternal(const QSharedPointer<FITSData> &data,
-        const QJsonObject &metadata)
+void DarkLibrary::saveMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata)
 {
-    T *writableBuffer = reinterpret_cast<T *>(data->getWritableImageBuffer());
-    const uint32_t count = metadata["count"].toInt();
-    // Average the values
-    for (uint32_t i = 0; i < m_DarkMasterBuffer.size(); i++)
-        writableBuffer[i] = m_DarkMasterBuffer[i] / count;
-
     QString ts = QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss");
     QString path = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("darks/darkframe_" + ts +
                    ".fits");
 
-    data->calculateStats(true);
     if (!data->saveImage(path))
     {
         m_FileLabel->setText(i18n("Failed to save master frame: %1", data->getLastError()));
@@ -9,6 +9,7 @@
 #include "indi/indicamera.h"
 #include "indi/indidustcap.h"
 #include "darkview.h"
+#include "darkstacker.h"
 #include "defectmap.h"
 #include "ekos/ekos.h"
 
@@ -166,33 +167,19 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
         void execute();
 
         /**
-         * @brief generateMasterFrameHelper Calls templated generateMasterFrame with the correct data type.
-         * @param data Passed dark frame data to generateMasterFrame
-         * @param metadata passed metadata to generateMasterFrame
-         */
-        void generateMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata);
-
-        /**
-         * @brief generateMasterFrame After data aggregation is done, the selected stacking algorithm is applied and the master dark
-         * frame is saved to disk and user database along with the metadata.
-         * @param data last used data. This is not used for reading, but to simply apply the algorithm to the FITSData buffer
-         * and then save it to disk.
+         * @brief generateMasterFrame Once all the frames of a job are received, they are combined in the background
+         * with the selected stacking algorithm and the master dark frame is saved to disk and user database.
+         * @param data last received frame. The master frame is a copy of it, which keeps its header.
          * @param metadata information on frame to help in the stacking process.
          */
-        template <typename T>  void generateMasterFrameInternal(const QSharedPointer<FITSData> &data, const QJsonObject &metadata);
-
-        /**
-         * @brief aggregateHelper Calls tempelated aggregate function with the appropiate data type.
-         * @param data Dark frame data to pass on to aggregate function.
-         */
-        void aggregate(const QSharedPointer<FITSData> &data);
+        void generateMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata);
 
         /**
-         * @brief aggregate Aggregate the data as per the selected algorithm. Each time a new dark frame is received, this function
-         * adds the frame data to the dark buffer.
-         * @param data Dark frame data.
+         * @brief saveMasterFrame Save the stacked master frame to disk and add it to the user database.
+         * @param data master frame.
+         * @param metadata information on frame to record in the database.
          */
-        template <typename T> void aggregateInternal(const QSharedPointer<FITSData> &data);
+        void saveMasterFrame(const QSharedPointer<FITSData> &data, const QJsonObject &metadata);
 
         /**
          * @brief cacheDarkFrameFromFile Load dark frame from disk and saves it in the local dark frames cache
@@ -285,7 +272,9 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
         QSqlTableModel *darkFramesModel = nullptr;
         QSortFilterProxyModel *sortFilter = nullptr;
 
-        std::vector<uint32_t> m_DarkMasterBuffer;
+        // Frames of the job being captured. Each job gets its own stacker, so a job can be stacked
+        // while the next one is captured.
+        QSharedPointer<DarkStacker> m_DarkStacker;
         uint32_t m_DarkImagesCounter {0};
         bool m_RememberFITSViewer {true};
         bool m_RememberSummaryView {true};
@@ -8,6 +8,9 @@
 #include "darklibrary.h"
 #include "ekos/auxiliary/opticaltrainsettings.h"
 
+#include <QThread>
+#include <QtConcurrent>
+
 #include <array>
 
 #include "ekos_debug.h"
@@ -78,38 +81,57 @@ void DarkProcessor::normalizeDefectsInternal(const QSharedPointer<DefectMap> &de
 {
 
     T *lightBuffer = reinterpret_cast<T *>(lightData->getWritableImageBuffer());
-    const uint32_t width = lightData->width();
+    const int width = lightData->width();
+    const int height = lightData->height();
 
     // Account for offset X and Y
     // e.g. if we send a subframed light frame 100x100 pixels wide
     // but the source defect map covers 1000x1000 pixels array, then we need to only compensate
     // for the 100x100 region.
-    for (BadPixelSet::const_iterator onePixel = defectMap->hotThreshold();
-            onePixel != defectMap->hotPixels().cend(); ++onePixel)
+    // The first and last rows and columns of the light frame are skipped since they lack neighbours.
+    const int firstX = offsetX + 1;
+    const int lastX = std::min(offsetX + width - 2, static_cast<int>(defectMap->bitmapWidth()) - 1);
+    const int lastY = std::min<int>(height - 2, static_cast<int>(defectMap->bitmapHeight()) - 1 - offsetY);
+    if (lastX < firstX || lastY < 1)
     {
-        const uint16_t x = (*onePixel).x;
-        const uint16_t y = (*onePixel).y;
-
-        if (x <= offsetX || y <= offsetY)
-            continue;
-
-        uint32_t offset = (x - offsetX) + (y - offsetY) * width;
-
-        lightBuffer[offset] = median3x3Filter(x - offsetX, y - offsetY, width, lightBuffer);
+        lightData->calculateStats(true);
+        return;
     }
 
-    for (BadPixelSet::const_iterator onePixel = defectMap->coldPixels().cbegin();
-            onePixel != defectMap->coldThreshold(); ++onePixel)
+    // Defective neighbours are never used to correct a pixel, so a corrected pixel is never read
+    // again and the rows can be corrected in any order.
+    auto correctRows = [&](const QPair<int, int> &rows)
     {
-        const uint16_t x = (*onePixel).x;
-        const uint16_t y = (*onePixel).y;
-
-        if (x <= offsetX || y <= offsetY)
-            continue;
-
-        uint32_t offset = (x - offsetX) + (y - offsetY) * width;
+        for (int y = rows.first; y <= rows.second; y++)
+        {
+            const quint64 *bits = defectMap->bitmapRow(y + offsetY);
+            // Look for the defects 64 pixels at a time
+            for (int word = firstX / 64; word <= lastX / 64; word++)
+            {
+                quint64 mask = bits[word];
+                while (mask)
+                {
+                    const int darkX = word * 64 + qCountTrailingZeroBits(mask);
+                    mask &= mask - 1;
+                    if (darkX < firstX || darkX > lastX)
+                        continue;
+                    median3x3Filter(defectMap, darkX - offsetX, y, offsetX, offsetY, width, lightBuffer);
+                }
+            }
+        }
+    };
 
-        lightBuffer[offset] = median3x3Filter(x - offsetX, y - offsetY, width, lightBuffer);
+    const uint32_t defects = (defectMap->hotEnabled() ? defectMap->hotCount() : 0) +
+                             (defectMap->coldEnabled() ? defectMap->coldCount() : 0);
+    if (defects < PARALLEL_DEFECT_COUNT)
+        correctRows(qMakePair(1, lastY));
+    else
+    {
+        QVector<QPair<int, int>> bands;
+        const int bandHeight = std::max(1, lastY / (QThread::idealThreadCount() * 4));
+        for (int y = 1; y <= lastY; y += bandHeight)
+            bands.append(qMakePair(y, std::min(y + bandHeight - 1, lastY)));
+        QtConcurrent::blockingMap(bands, correctRows);
     }
 
     lightData->calculateStats(true);
@@ -120,30 +142,33 @@ void DarkProcessor::normalizeDefectsInternal(const QSharedPointer<DefectMap> &de
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
 template <typename T>
-T DarkProcessor::median3x3Filter(uint16_t x, uint16_t y, uint32_t width, T *buffer)
+void DarkProcessor::median3x3Filter(const QSharedPointer<DefectMap> &defectMap, int x, int y, uint16_t offsetX,
+                                    uint16_t offsetY, int width, T *buffer)
 {
-    T *top = buffer + (y - 1) * width + (x - 1);
-    T *mid = buffer + (y - 0) * width + (x - 1);
-    T *bot = buffer + (y + 1) * width + (x - 1);
-
     std::array<T, 8> elements;
+    int count = 0;
+
+    for (int dy = -1; dy <= 1; dy++)
+    {
+        const T *row = buffer + (y + dy) * width;
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            // Skip the defective value itself and the neighbouring defects
+            if (defectMap->isDefective(x + dx + offsetX, y + dy + offsetY))
+                continue;
+            elements[count++] = row[x + dx];
+        }
+    }
+
+    // Clusters of defects are left as is
+    if (count == 0)
+        return;
 
-    // Top
-    elements[0] = *(top + 0);
-    elements[1] = *(top + 1);
-    elements[2] = *(top + 2);
-    // Mid
-    elements[3] = *(mid + 0);
-    // Mid+1 is the defective value, so we skip and go for + 2
-    elements[4] = *(mid + 2);
-    // Bottom
-    elements[5] = *(bot + 0);
-    elements[6] = *(bot + 1);
-    elements[7] = *(bot + 2);
-
-    std::sort(elements.begin(), elements.end());
-    auto median = (elements[3] + elements[4]) / 2;
-    return median;
+    std::sort(elements.begin(), elements.begin() + count);
+    if (count % 2)
+        buffer[x + y * width] = elements[count / 2];
+    else
+        buffer[x + y * width] = (elements[count / 2 - 1] + elements[count / 2]) / 2;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
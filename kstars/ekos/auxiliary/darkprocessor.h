@@ -81,7 +81,8 @@ class DarkProcessor : public QObject
 
         /**
         * @brief normalizeDefects Remove defects from LIGHT image by replacing bad pixels with a 3x3 median filter around
-        * them.
+        * them. Neighbours that are bad pixels themselves are left out of the median. Rows are scanned with the defect
+        * map bitmap and processed in parallel for large defect maps.
         * @param defectMap Defect Map containing a list of hot and cold pixels.
         * @param lightData Target light data to remove noise from.
         * @param offsetX Only apply filtering beyond offsetX in X-axis.
@@ -94,8 +95,17 @@ class DarkProcessor : public QObject
         void normalizeDefectsInternal(const QSharedPointer<DefectMap> &defectMap, const QSharedPointer<FITSData> &lightData,
                                       uint16_t offsetX, uint16_t offsetY);
 
+        /**
+        * @brief median3x3Filter Replaces a pixel with the median of its neighbours that are not defective.
+        * @param x X coordinate of the pixel in the light frame.
+        * @param y Y coordinate of the pixel in the light frame.
+        */
         template <typename T>
-        T median3x3Filter(uint16_t x, uint16_t y, uint32_t width, T *buffer);
+        void median3x3Filter(const QSharedPointer<DefectMap> &defectMap, int x, int y, uint16_t offsetX, uint16_t offsetY,
+                             int width, T *buffer);
+
+        // Above this number of defects, rows are corrected in parallel.
+        static constexpr uint32_t PARALLEL_DEFECT_COUNT { 20000 };
 
     signals:
         void darkFrameCompleted(bool);
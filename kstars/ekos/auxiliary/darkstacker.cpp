@@ -0,0 +1,399 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "darkstacker.h"
+
+#include "fitsviewer/fitsdata.h"
+
+#include <KLocalizedString>
+#include <QDir>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+#include <ekos_debug.h>
+
+namespace Ekos
+{
+
+namespace
+{
+// Maximum number of rejection passes.
+constexpr int MAX_ITERATIONS = 10;
+
+template <typename T>
+void toFloat(const uint8_t *buffer, float *output, qint64 count)
+{
+    const T *input = reinterpret_cast<const T *>(buffer);
+    for (qint64 i = 0; i < count; ++i)
+        output[i] = static_cast<float>(input[i]);
+}
+
+template <typename T>
+void fromFloat(const float *input, uint8_t *buffer, qint64 offset, qint64 count)
+{
+    T *output = reinterpret_cast<T *>(buffer) + offset;
+    if constexpr (std::is_integral<T>::value)
+    {
+        const float low = static_cast<float>(std::numeric_limits<T>::min());
+        const float high = static_cast<float>(std::numeric_limits<T>::max());
+        for (qint64 i = 0; i < count; ++i)
+            output[i] = static_cast<T>(std::clamp(std::round(input[i]), low, high));
+    }
+    else
+    {
+        for (qint64 i = 0; i < count; ++i)
+            output[i] = static_cast<T>(input[i]);
+    }
+}
+
+// Converts count samples between a FITS image buffer of the given type and floats.
+// Returns false if the data type is not supported.
+bool convertSamples(int dataType, const uint8_t *buffer, float *output, qint64 count)
+{
+    switch (dataType)
+    {
+        case TBYTE:
+            toFloat<uint8_t>(buffer, output, count);
+            return true;
+        case TSHORT:
+            toFloat<int16_t>(buffer, output, count);
+            return true;
+        case TUSHORT:
+            toFloat<uint16_t>(buffer, output, count);
+            return true;
+        case TLONG:
+            toFloat<int32_t>(buffer, output, count);
+            return true;
+        case TULONG:
+            toFloat<uint32_t>(buffer, output, count);
+            return true;
+        case TFLOAT:
+            toFloat<float>(buffer, output, count);
+            return true;
+        case TLONGLONG:
+            toFloat<int64_t>(buffer, output, count);
+            return true;
+        case TDOUBLE:
+            toFloat<double>(buffer, output, count);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool convertSamples(int dataType, const float *input, uint8_t *buffer, qint64 offset, qint64 count)
+{
+    switch (dataType)
+    {
+        case TBYTE:
+            fromFloat<uint8_t>(input, buffer, offset, count);
+            return true;
+        case TSHORT:
+            fromFloat<int16_t>(input, buffer, offset, count);
+            return true;
+        case TUSHORT:
+            fromFloat<uint16_t>(input, buffer, offset, count);
+            return true;
+        case TLONG:
+            fromFloat<int32_t>(input, buffer, offset, count);
+            return true;
+        case TULONG:
+            fromFloat<uint32_t>(input, buffer, offset, count);
+            return true;
+        case TFLOAT:
+            fromFloat<float>(input, buffer, offset, count);
+            return true;
+        case TLONGLONG:
+            fromFloat<int64_t>(input, buffer, offset, count);
+            return true;
+        case TDOUBLE:
+            fromFloat<double>(input, buffer, offset, count);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Median of the n first values. The values are reordered.
+float median(float *values, int n)
+{
+    const int middle = n / 2;
+    std::nth_element(values, values + middle, values + n);
+    const float upper = values[middle];
+    if (n % 2 == 1)
+        return upper;
+    // The lower middle value is the largest of the lower half.
+    return (*std::max_element(values, values + middle) + upper) / 2;
+}
+
+float mean(const float *values, int n)
+{
+    return std::accumulate(values, values + n, 0.0) / n;
+}
+
+float standardDeviation(const float *values, int n, float average)
+{
+    double sum = 0;
+    for (int i = 0; i < n; ++i)
+        sum += (values[i] - average) * (values[i] - average);
+    return std::sqrt(sum / (n - 1));
+}
+
+// Moves the values within limit of center to the front and returns their count.
+int keepWithin(float *values, int n, float center, float limit)
+{
+    return std::partition(values, values + n, [center, limit](float value)
+    {
+        return std::fabs(value - center) <= limit;
+    }) - values;
+}
+
+float sigmaClip(float *values, int n, float kappa, int *kept)
+{
+    int count = n;
+    for (int iteration = 0; iteration < MAX_ITERATIONS && count > 2; ++iteration)
+    {
+        const float center = median(values, count);
+        const float sigma = standardDeviation(values, count, mean(values, count));
+        if (sigma <= 0)
+            break;
+        // The median itself is always kept, so at least one value remains.
+        const int remaining = keepWithin(values, count, center, kappa * sigma);
+        if (remaining == count)
+            break;
+        count = remaining;
+    }
+    *kept = count;
+    return mean(values, count);
+}
+
+float winsorizedSigmaClip(float *values, int n, float kappa, float *scratch, int *kept)
+{
+    const float center = median(values, n);
+    float sigma = standardDeviation(values, n, mean(values, n));
+    for (int iteration = 0; iteration < MAX_ITERATIONS && sigma > 0; ++iteration)
+    {
+        const float low = center - 1.5f * sigma;
+        const float high = center + 1.5f * sigma;
+        for (int i = 0; i < n; ++i)
+            scratch[i] = std::clamp(values[i], low, high);
+        // 1.134 corrects the deviation of clamped gaussian values.
+        const float newSigma = 1.134f * standardDeviation(scratch, n, mean(scratch, n));
+        const bool converged = std::fabs(newSigma - sigma) <= 5e-4f * sigma;
+        sigma = newSigma;
+        if (converged)
+            break;
+    }
+
+    *kept = sigma > 0 ? keepWithin(values, n, center, kappa * sigma) : n;
+    return mean(values, *kept);
+}
+}
+
+DarkStacker::DarkStacker(const QString &directory) : m_Directory(directory)
+{
+}
+
+DarkStacker::~DarkStacker()
+{
+    clear();
+}
+
+QString DarkStacker::algorithmName(Algorithm algorithm)
+{
+    switch (algorithm)
+    {
+        case STACK_AVERAGE:
+            return i18n("Average");
+        case STACK_MEDIAN:
+            return i18n("Median");
+        case STACK_SIGMA_CLIP:
+            return i18n("Sigma Clipping");
+        case STACK_WINSORIZED_SIGMA_CLIP:
+            return i18n("Winsorized Sigma Clipping");
+    }
+    return QString();
+}
+
+void DarkStacker::clear()
+{
+    // Writes in progress hold a reference to their file, wait for them before the files are removed.
+    for (auto &frame : m_Frames)
+        frame.written.waitForFinished();
+    m_Frames.clear();
+    m_FrameSamples = 0;
+    m_Width = 0;
+    m_DataType = 0;
+}
+
+bool DarkStacker::addFrame(const QSharedPointer<FITSData> &data)
+{
+    const qint64 samples = static_cast<qint64>(data->samplesPerChannel()) * data->channels();
+    if (samples != m_FrameSamples || data->width() != m_Width || data->dataType() != m_DataType)
+    {
+        if (!m_Frames.isEmpty())
+            qCWarning(KSTARS_EKOS) << "Dark frame size changed, discarding" << m_Frames.count() << "frames.";
+        clear();
+        m_FrameSamples = samples;
+        m_Width = data->width();
+        m_DataType = data->dataType();
+    }
+
+    QVector<float> frame(samples);
+    if (!convertSamples(m_DataType, data->getImageBuffer(), frame.data(), samples))
+    {
+        m_LastError = i18n("Unsupported dark frame data type.");
+        return false;
+    }
+
+    QSharedPointer<QTemporaryFile> file(new QTemporaryFile(QDir(m_Directory).filePath("darkstack_XXXXXX.raw")));
+    if (!file->open())
+    {
+        m_LastError = i18n("Failed to create dark frame store in %1: %2", m_Directory, file->errorString());
+        return false;
+    }
+
+    FrameStore store;
+    store.file = file;
+    store.written = QtConcurrent::run([file, frame]()
+    {
+        const qint64 size = frame.size() * static_cast<qint64>(sizeof(float));
+        return file->write(reinterpret_cast<const char *>(frame.constData()), size) == size && file->flush();
+    });
+    m_Frames.append(store);
+    return true;
+}
+
+bool DarkStacker::stack(const QSharedPointer<FITSData> &master, Algorithm algorithm, double kappa)
+{
+    m_Rejected = 0;
+
+    const int n = m_Frames.count();
+    if (n == 0)
+    {
+        m_LastError = i18n("No dark frames to stack.");
+        return false;
+    }
+
+    if (static_cast<qint64>(master->samplesPerChannel()) * master->channels() != m_FrameSamples
+            || master->width() != m_Width || master->dataType() != m_DataType)
+    {
+        m_LastError = i18n("Master frame does not match the dark frames.");
+        return false;
+    }
+
+    for (auto &frame : m_Frames)
+    {
+        frame.written.waitForFinished();
+        if (!frame.written.result())
+        {
+            m_LastError = i18n("Failed to write dark frame store: %1", frame.file->errorString());
+            return false;
+        }
+    }
+
+    // Each band holds the same rows of every frame, for all channels.
+    const qint64 totalRows = m_FrameSamples / m_Width;
+    const qint64 rowBytes = m_Width * static_cast<qint64>(sizeof(float));
+    const qint64 bandRows = std::clamp<qint64>(BAND_MEMORY_LIMIT / (rowBytes * n), 1, totalRows);
+
+    // Each band is allocated on its own, copies of a single vector would share one buffer.
+    QVector<QVector<float>> bands(n);
+    QVector<float *> bandData(n);
+    for (int i = 0; i < n; ++i)
+    {
+        bands[i].resize(bandRows * m_Width);
+        bandData[i] = bands[i].data();
+    }
+    QVector<float> output(bandRows * m_Width);
+    float *outputData = output.data();
+    uint8_t *masterBuffer = master->getWritableImageBuffer();
+    const float rejectionKappa = static_cast<float>(kappa);
+
+    for (qint64 firstRow = 0; firstRow < totalRows; firstRow += bandRows)
+    {
+        const qint64 rows = std::min(bandRows, totalRows - firstRow);
+        const qint64 bytes = rows * rowBytes;
+        for (int i = 0; i < n; ++i)
+        {
+            QTemporaryFile *file = m_Frames[i].file.data();
+            if (!file->seek(firstRow * rowBytes) || file->read(reinterpret_cast<char *>(bandData[i]), bytes) != bytes)
+            {
+                m_LastError = i18n("Failed to read dark frame store: %1", file->errorString());
+                return false;
+            }
+        }
+
+        QVector<qint64> rowIndexes(rows);
+        std::iota(rowIndexes.begin(), rowIndexes.end(), 0);
+        QtConcurrent::blockingMap(rowIndexes, [&](const qint64 row)
+        {
+            QVector<const float *> rowData(n);
+            for (int i = 0; i < n; ++i)
+                rowData[i] = bandData[i] + row * m_Width;
+            QVector<float> values(n), scratch(n);
+            m_Rejected += combineRow(rowData, outputData + row * m_Width, algorithm, rejectionKappa, values, scratch);
+        });
+
+        convertSamples(m_DataType, output.constData(), masterBuffer, firstRow * m_Width, rows * m_Width);
+    }
+
+    qCInfo(KSTARS_EKOS) << "Stacked" << n << "dark frames with" << algorithmName(algorithm) << "in bands of" << bandRows
+                        << "rows," << m_Rejected.load() << "values rejected.";
+    return true;
+}
+
+qint64 DarkStacker::combineRow(const QVector<const float *> &rows, float *output, Algorithm algorithm, float kappa,
+                               QVector<float> &values, QVector<float> &scratch) const
+{
+    const int n = rows.size();
+
+    // Nothing can be rejected with less than 3 frames.
+    if (algorithm == STACK_AVERAGE || n < 3)
+    {
+        std::fill(output, output + m_Width, 0.0f);
+        for (const float *row : rows)
+        {
+            for (int x = 0; x < m_Width; ++x)
+                output[x] += row[x];
+        }
+        const float scale = 1.0f / n;
+        for (int x = 0; x < m_Width; ++x)
+            output[x] *= scale;
+        return 0;
+    }
+
+    qint64 rejected = 0;
+    float *pixelValues = values.data();
+    for (int x = 0; x < m_Width; ++x)
+    {
+        for (int i = 0; i < n; ++i)
+            pixelValues[i] = rows[i][x];
+
+        int kept = n;
+        switch (algorithm)
+        {
+            case STACK_MEDIAN:
+                output[x] = median(pixelValues, n);
+                break;
+            case STACK_SIGMA_CLIP:
+                output[x] = sigmaClip(pixelValues, n, kappa, &kept);
+                break;
+            case STACK_WINSORIZED_SIGMA_CLIP:
+            default:
+                output[x] = winsorizedSigmaClip(pixelValues, n, kappa, scratch.data(), &kept);
+                break;
+        }
+        rejected += n - kept;
+    }
+    return rejected;
+}
+}
@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFuture>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include <QTemporaryFile>
+#include <QVector>
+
+#include <atomic>
+
+class FITSData;
+
+namespace Ekos
+{
+
+/**
+ * @class DarkStacker
+ * @short Combines dark or bias frames into a master frame with outlier rejection.
+ *
+ * Each frame added to the stacker is converted to floating point and written to a temporary frame store
+ * on disk, so only one frame is kept in memory while the frames are captured. Once all frames are received,
+ * the stack is processed in bands of rows: the same band is read from every frame store, combined in parallel
+ * row by row, and written to the master frame. The band height is chosen so that the bands of all frames fit
+ * within a fixed memory budget, which lets a large number of full size frames be stacked.
+ *
+ * Pixels are combined with one of the following algorithms:
+ * - Average: plain mean of all frames.
+ * - Median: median of all frames.
+ * - Sigma clipping: values further than kappa standard deviations from the median are rejected iteratively,
+ *   and the remaining values are averaged. This removes cosmic rays and other transients but needs ~10 frames
+ *   or more, as a single outlier inflates the standard deviation of a small stack.
+ * - Winsorized sigma clipping: the standard deviation is estimated on values clamped to 1.5 standard deviations
+ *   around the median (Huber's winsorization), which makes the rejection robust for small stacks.
+ */
+class DarkStacker
+{
+    public:
+        typedef enum
+        {
+            STACK_AVERAGE,
+            STACK_MEDIAN,
+            STACK_SIGMA_CLIP,
+            STACK_WINSORIZED_SIGMA_CLIP
+        } Algorithm;
+
+        /**
+         * @param directory Directory of the temporary frame stores. It should be on a disk with enough space
+         * for all the frames in single precision floating point.
+         */
+        explicit DarkStacker(const QString &directory);
+        ~DarkStacker();
+
+        /**
+         * @brief addFrame Converts the image of data and writes it to a frame store in the background.
+         * The data can be reused as soon as the function returns. If the frame size differs from the
+         * previous frames, the previous frames are discarded.
+         * @return False if the frame store could not be created.
+         */
+        bool addFrame(const QSharedPointer<FITSData> &data);
+
+        /**
+         * @brief stack Combines all frames into master, which must have the same size and type as the frames.
+         * This blocks until the stack is complete, run it with QtConcurrent::run to keep the UI responsive.
+         * @return True if the master frame buffer was filled.
+         */
+        bool stack(const QSharedPointer<FITSData> &master, Algorithm algorithm, double kappa = 3);
+
+        // Discards all frames.
+        void clear();
+
+        int frameCount() const
+        {
+            return m_Frames.count();
+        }
+
+        // Number of pixel values rejected by the last stack.
+        qint64 rejectedCount() const
+        {
+            return m_Rejected;
+        }
+
+        const QString &lastError() const
+        {
+            return m_LastError;
+        }
+
+        static QString algorithmName(Algorithm algorithm);
+
+    private:
+        struct FrameStore
+        {
+            QSharedPointer<QTemporaryFile> file;
+            // Completes when the frame is written.
+            QFuture<bool> written;
+        };
+
+        // Combines one row from every frame into output. rows[i] points to the row of frame i.
+        // values and scratch are work buffers of one value per frame. Returns the number of rejected values.
+        qint64 combineRow(const QVector<const float *> &rows, float *output, Algorithm algorithm, float kappa,
+                          QVector<float> &values, QVector<float> &scratch) const;
+
+        QString m_Directory;
+        QList<FrameStore> m_Frames;
+        // Samples per frame and the width of a row.
+        qint64 m_FrameSamples { 0 };
+        int m_Width { 0 };
+        int m_DataType { 0 };
+        std::atomic<qint64> m_Rejected { 0 };
+        QString m_LastError;
+
+        // Upper limit of the memory used by the bands of all frames.
+        static constexpr qint64 BAND_MEMORY_LIMIT { 512 * 1024 * 1024 };
+};
+}
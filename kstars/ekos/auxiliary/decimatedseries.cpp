@@ -0,0 +1,236 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "decimatedseries.h"
+
+#include <algorithm>
+
+namespace
+{
+// Points of a level summarized by at most 3 points (min, max, gap) of the next level
+constexpr int BUCKET_SIZE = 8;
+}
+
+namespace Ekos
+{
+
+DecimatedSeries::DecimatedSeries(int capacity) : m_Capacity(std::max(0, capacity))
+{
+}
+
+void DecimatedSeries::append(double key, double value)
+{
+    extendRange(value);
+
+    if (m_Levels.isEmpty())
+        m_Levels.resize(1);
+
+    QVector<double> &keys = m_Levels[0].keys;
+    if (!keys.isEmpty() && key < keys.last())
+    {
+        // Rarely, a sample is older than the last one. It is inserted in place and the levels are built again.
+        const int index = std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+        keys.insert(index, key);
+        m_Levels[0].values.insert(index, value);
+        rebuild();
+        trim();
+        return;
+    }
+    appendTo(0, key, value);
+    trim();
+}
+
+void DecimatedSeries::trim()
+{
+    // The oldest samples are dropped by eighths of the capacity, so the levels are rarely rebuilt.
+    if (m_Capacity == 0 || size() <= m_Capacity + m_Capacity / BUCKET_SIZE)
+        return;
+
+    const int excess = size() - m_Capacity;
+    m_Levels[0].keys.remove(0, excess);
+    m_Levels[0].values.remove(0, excess);
+    rebuild();
+}
+
+void DecimatedSeries::extendRange(double value)
+{
+    if (qIsNaN(value))
+        return;
+    m_Min = m_HasValues ? std::min(m_Min, value) : value;
+    m_Max = m_HasValues ? std::max(m_Max, value) : value;
+    m_HasValues = true;
+}
+
+void DecimatedSeries::clear()
+{
+    m_Levels.clear();
+    m_Min = 0;
+    m_Max = 0;
+    m_HasValues = false;
+}
+
+void DecimatedSeries::appendTo(int level, double key, double value)
+{
+    m_Levels[level].keys.append(key);
+    m_Levels[level].values.append(value);
+    if (m_Levels[level].keys.size() - m_Levels[level].consumed >= BUCKET_SIZE)
+        decimate(level);
+}
+
+void DecimatedSeries::decimate(int level)
+{
+    if (m_Levels.size() == level + 1)
+        m_Levels.resize(level + 2);
+
+    const Level &source = m_Levels[level];
+    const int from = source.consumed;
+    int minIndex = -1, maxIndex = -1, nanIndex = -1;
+    for (int i = from; i < from + BUCKET_SIZE; i++)
+    {
+        const double value = source.values[i];
+        if (qIsNaN(value))
+        {
+            if (nanIndex < 0)
+                nanIndex = i;
+        }
+        else
+        {
+            if (minIndex < 0 || value < source.values[minIndex])
+                minIndex = i;
+            if (maxIndex < 0 || value > source.values[maxIndex])
+                maxIndex = i;
+        }
+    }
+
+    // The kept points stay in time order, a NaN keeps the gap it marks in the plot.
+    int indexes[3] = { minIndex, maxIndex, nanIndex };
+    std::sort(indexes, indexes + 3);
+    double keys[3], values[3];
+    int count = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (indexes[i] < 0 || (i > 0 && indexes[i] == indexes[i - 1]))
+            continue;
+        keys[count]   = source.keys[indexes[i]];
+        values[count] = source.values[indexes[i]];
+        count++;
+    }
+    m_Levels[level].consumed += BUCKET_SIZE;
+
+    for (int i = 0; i < count; i++)
+        appendTo(level + 1, keys[i], values[i]);
+}
+
+void DecimatedSeries::rebuild()
+{
+    const Level raw = m_Levels[0];
+    m_Levels.clear();
+    m_Levels.resize(1);
+    m_Levels[0].keys.reserve(raw.keys.size());
+    m_Levels[0].values.reserve(raw.values.size());
+    // The trimmed samples may have held the extremes.
+    m_HasValues = false;
+    for (int i = 0; i < raw.keys.size(); i++)
+    {
+        extendRange(raw.values[i]);
+        appendTo(0, raw.keys[i], raw.values[i]);
+    }
+}
+
+int DecimatedSeries::findBegin(double key) const
+{
+    if (isEmpty())
+        return 0;
+    const QVector<double> &keys = m_Levels[0].keys;
+    const int index = std::lower_bound(keys.cbegin(), keys.cend(), key) - keys.cbegin();
+    return index > 0 ? index - 1 : index;
+}
+
+int DecimatedSeries::findEnd(double key) const
+{
+    if (isEmpty())
+        return 0;
+    const QVector<double> &keys = m_Levels[0].keys;
+    const int index = std::upper_bound(keys.cbegin(), keys.cend(), key) - keys.cbegin();
+    return index < keys.size() ? index + 1 : index;
+}
+
+QCPRange DecimatedSeries::valueRange(bool *found) const
+{
+    if (found != nullptr)
+        *found = m_HasValues;
+    return QCPRange(m_Min, m_Max);
+}
+
+int DecimatedSeries::count(int level, double start, double end) const
+{
+    const QVector<double> &keys = m_Levels[level].keys;
+    const auto first = std::lower_bound(keys.cbegin(), keys.cend(), start);
+    const auto last = std::upper_bound(first, keys.cend(), end);
+    return last - first;
+}
+
+void DecimatedSeries::collect(int level, int from, double start, double end, QVector<QCPGraphData> &points) const
+{
+    const QVector<double> &keys = m_Levels[level].keys;
+    const QVector<double> &values = m_Levels[level].values;
+    int first = std::lower_bound(keys.cbegin() + from, keys.cend(), start) - keys.cbegin();
+    int last = std::upper_bound(keys.cbegin() + first, keys.cend(), end) - keys.cbegin();
+
+    // One more point on each side, so that lines reach the edges of the plot.
+    first = std::max(from, first - 1);
+    last = std::min(static_cast<int>(keys.size()), last + 1);
+    for (int i = first; i < last; i++)
+        points.append(QCPGraphData(keys[i], values[i]));
+}
+
+void DecimatedSeries::fill(QCPGraphDataContainer *data, double start, double end, int maxPoints) const
+{
+    QVector<QCPGraphData> points;
+    if (!isEmpty())
+    {
+        int level = 0;
+        while (level + 1 < m_Levels.size() && count(level, start, end) > maxPoints)
+            level++;
+
+        collect(level, 0, start, end, points);
+        // The latest points are not summarized by the coarser level yet.
+        for (int i = level - 1; i >= 0; i--)
+            collect(i, m_Levels[i].consumed, start, end, points);
+    }
+    data->set(points, true);
+}
+
+void DecimatedSeries::fill(QCPGraph *graph) const
+{
+    const QCPRange range = graph->keyAxis()->range();
+    // A minimum and a maximum for each pixel
+    const int maxPoints = 2 * std::max(100, graph->keyAxis()->axisRect()->width());
+    fill(graph->data().data(), range.lower, range.upper, maxPoints);
+}
+
+void DecimatedSeries::save(QDataStream &stream) const
+{
+    if (isEmpty())
+        stream << QVector<double>() << QVector<double>();
+    else
+        stream << m_Levels[0].keys << m_Levels[0].values;
+}
+
+bool DecimatedSeries::load(QDataStream &stream)
+{
+    QVector<double> keys, values;
+    stream >> keys >> values;
+    if (stream.status() != QDataStream::Ok || keys.size() != values.size())
+        return false;
+
+    clear();
+    for (int i = 0; i < keys.size(); i++)
+        append(keys[i], values[i]);
+    return true;
+}
+
+}
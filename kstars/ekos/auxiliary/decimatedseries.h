@@ -0,0 +1,111 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "qcustomplot.h"
+
+#include <QDataStream>
+#include <QVector>
+
+namespace Ekos
+{
+
+/**
+ * @class DecimatedSeries
+ * @short Column store of the samples of one time graph, with min/max decimated levels.
+ *
+ * A night of guiding adds hundreds of thousands of samples to each graph of Analyze and of the Guide tab.
+ * Instead of keeping all of them in the QCustomPlot graph, which draws every sample in view on each replot,
+ * the samples are kept here in key and value columns, along with coarser levels. Each level keeps the minimum and maximum of every bucket
+ * of 8 points of the level below, in time order, so peaks and gaps (NaN values) still show when zoomed out.
+ * Levels are extended as samples are appended, the last incomplete bucket of each level is only kept by the
+ * level below.
+ *
+ * fill() copies to the graph the points of the finest level that fits the number of pixels of the plot, so
+ * replotting does not depend on the length of the session.
+ *
+ * With a capacity, only about that many of the latest samples are kept.
+ */
+class DecimatedSeries
+{
+    public:
+        /** @param capacity number of samples to keep, 0 to keep them all */
+        explicit DecimatedSeries(int capacity = 0);
+
+        /** @brief append Adds a sample, normally after the last one. */
+        void append(double key, double value);
+
+        void clear();
+
+        /** @return number of samples */
+        int size() const
+        {
+            return m_Levels.isEmpty() ? 0 : m_Levels[0].keys.size();
+        }
+        bool isEmpty() const
+        {
+            return size() == 0;
+        }
+        double key(int index) const
+        {
+            return m_Levels[0].keys[index];
+        }
+        double value(int index) const
+        {
+            return m_Levels[0].values[index];
+        }
+
+        /** @return index of the last sample before key, or of the first sample, as QCPDataContainer::findBegin() */
+        int findBegin(double key) const;
+        /** @return index after the first sample after key, as QCPDataContainer::findEnd() */
+        int findEnd(double key) const;
+
+        /**
+         * @brief valueRange Range of all the values, NaN values excluded.
+         * @param found set to false when there is no value to scale to
+         */
+        QCPRange valueRange(bool *found) const;
+
+        /**
+         * @brief fill Replaces the data of a graph with the points to draw between start and end.
+         * @param data data of the graph
+         * @param maxPoints number of points above which a coarser level is used
+         */
+        void fill(QCPGraphDataContainer *data, double start, double end, int maxPoints) const;
+        /** @brief fill Replaces the data of a graph with the points in the range of its key axis. */
+        void fill(QCPGraph *graph) const;
+
+        /** @brief save Writes the samples, the levels are not saved. */
+        void save(QDataStream &stream) const;
+        /** @brief load Reads the samples written by save() and rebuilds the levels. */
+        bool load(QDataStream &stream);
+
+    private:
+        struct Level
+        {
+            QVector<double> keys;
+            QVector<double> values;
+            // Points of this level already decimated into the next level
+            int consumed { 0 };
+        };
+
+        void extendRange(double value);
+        void trim();
+        void appendTo(int level, double key, double value);
+        void decimate(int level);
+        void rebuild();
+        int count(int level, double start, double end) const;
+        void collect(int level, int from, double start, double end, QVector<QCPGraphData> &points) const;
+
+        int m_Capacity { 0 };
+        QVector<Level> m_Levels;
+        double m_Min { 0 };
+        double m_Max { 0 };
+        bool m_HasValues { false };
+};
+
+}
@@ -7,6 +7,16 @@
 #include "defectmap.h"
 #include <QJsonDocument>
 
+#include <algorithm>
+
+namespace
+{
+bool lessThanValue(const BadPixel &pixel, double value)
+{
+    return pixel.value < value;
+}
+}
+
 //////////////////////////////////////////////////////////////////////////////
 ///
 //////////////////////////////////////////////////////////////////////////////
@@ -26,7 +36,8 @@ QJsonObject BadPixel::json() const
 //////////////////////////////////////////////////////////////////////////////
 DefectMap::DefectMap() : QObject()
 {
-
+    m_HotPixelsThreshold = m_HotPixels.cend();
+    m_ColdPixelsThreshold = m_ColdPixels.cbegin();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -59,21 +70,28 @@ bool DefectMap::load(const QString &filename)
     m_HotPixels.clear();
     m_ColdPixels.clear();
 
+    m_HotPixels.reserve(hot.size());
     for (const auto &onePixel : qAsConst(hot))
     {
         QJsonObject oneObject = onePixel.toObject();
-        m_HotPixels.insert(BadPixel(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble()));
+        m_HotPixels.emplace_back(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble());
     }
 
     m_HotPixelsCount = m_HotPixels.size();
 
+    m_ColdPixels.reserve(cold.size());
     for (const auto &onePixel : qAsConst(cold))
     {
         QJsonObject oneObject = onePixel.toObject();
-        m_ColdPixels.insert(BadPixel(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble()));
+        m_ColdPixels.emplace_back(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble());
     }
 
     m_ColdPixelsCount = m_ColdPixels.size();
+
+    // Maps saved by the previous versions may not be sorted
+    std::sort(m_HotPixels.begin(), m_HotPixels.end());
+    std::sort(m_ColdPixels.begin(), m_ColdPixels.end());
+    rebuildBitmap();
     return true;
 }
 
@@ -167,6 +185,7 @@ void DefectMap::initBadPixels()
 
     m_ColdPixels.clear();
     m_HotPixels.clear();
+    rebuildBitmap();
 
     switch (m_DarkData->dataType())
     {
@@ -234,12 +253,16 @@ void DefectMap::initBadPixelsInternal(double hotPixelThreshold,
         {
             uint32_t offset = x + y * width;
             if (buffer[offset] > hotPixelThreshold)
-                m_HotPixels.insert(BadPixel(x, y, buffer[offset]));
+                m_HotPixels.emplace_back(x, y, buffer[offset]);
             else if (buffer[offset] < coldPixelThreshold)
-                m_ColdPixels.insert(BadPixel(x, y, buffer[offset]));
+                m_ColdPixels.emplace_back(x, y, buffer[offset]);
         }
     }
 
+    std::sort(m_HotPixels.begin(), m_HotPixels.end());
+    std::sort(m_ColdPixels.begin(), m_ColdPixels.end());
+    rebuildBitmap();
+
     filterPixels();
 }
 
@@ -251,8 +274,28 @@ void DefectMap::filterPixels()
     double hotPixelThreshold =  getHotThreshold(m_HotPixelsAggressiveness);
     double coldPixelThreshold = getColdThreshold(m_ColdPixelsAggressiveness);
 
-    m_HotPixelsThreshold = m_HotPixels.lower_bound(BadPixel(0, 0, hotPixelThreshold));
-    m_ColdPixelsThreshold = m_ColdPixels.lower_bound(BadPixel(0, 0, coldPixelThreshold));
+    auto hotThreshold = std::lower_bound(m_HotPixels.cbegin(), m_HotPixels.cend(), hotPixelThreshold, lessThanValue);
+    auto coldThreshold = std::lower_bound(m_ColdPixels.cbegin(), m_ColdPixels.cend(), coldPixelThreshold, lessThanValue);
+
+    // Only the pixels between the previous and the new thresholds change in the bitmap.
+    // Hot pixels are flagged from the threshold to the end, cold pixels from the beginning to the threshold.
+    if (m_HotEnabled)
+    {
+        if (hotThreshold < m_HotPixelsThreshold)
+            setBits(hotThreshold, m_HotPixelsThreshold, true);
+        else
+            setBits(m_HotPixelsThreshold, hotThreshold, false);
+    }
+    if (m_ColdEnabled)
+    {
+        if (coldThreshold > m_ColdPixelsThreshold)
+            setBits(m_ColdPixelsThreshold, coldThreshold, true);
+        else
+            setBits(coldThreshold, m_ColdPixelsThreshold, false);
+    }
+
+    m_HotPixelsThreshold = hotThreshold;
+    m_ColdPixelsThreshold = coldThreshold;
 
     if (m_HotPixelsThreshold == m_HotPixels.cend())
         m_HotPixelsCount = 0;
@@ -272,6 +315,8 @@ void DefectMap::filterPixels()
 //////////////////////////////////////////////////////////////////////////////
 void DefectMap::setHotEnabled(bool enabled)
 {
+    if (m_HotEnabled != enabled)
+        setBits(m_HotPixelsThreshold, m_HotPixels.cend(), enabled);
     m_HotEnabled = enabled;
     emit pixelsUpdated(m_HotEnabled ? m_HotPixelsCount : 0, m_ColdPixelsCount);
 }
@@ -281,6 +326,49 @@ void DefectMap::setHotEnabled(bool enabled)
 //////////////////////////////////////////////////////////////////////////////
 void DefectMap::setColdEnabled(bool enabled)
 {
+    if (m_ColdEnabled != enabled)
+        setBits(m_ColdPixels.cbegin(), m_ColdPixelsThreshold, enabled);
     m_ColdEnabled = enabled;
     emit pixelsUpdated(m_HotPixelsCount, m_ColdEnabled ? m_ColdPixelsCount : 0);
 }
+
+//////////////////////////////////////////////////////////////////////////////
+///
+//////////////////////////////////////////////////////////////////////////////
+void DefectMap::rebuildBitmap()
+{
+    // Thresholds are reset so that no pixel is flagged, filterPixels() flags them again.
+    m_HotPixelsThreshold = m_HotPixels.cend();
+    m_ColdPixelsThreshold = m_ColdPixels.cbegin();
+
+    m_BitmapWidth = m_BitmapHeight = 0;
+    for (const auto &onePixel : m_HotPixels)
+    {
+        m_BitmapWidth = std::max<uint32_t>(m_BitmapWidth, onePixel.x + 1);
+        m_BitmapHeight = std::max<uint32_t>(m_BitmapHeight, onePixel.y + 1);
+    }
+    for (const auto &onePixel : m_ColdPixels)
+    {
+        m_BitmapWidth = std::max<uint32_t>(m_BitmapWidth, onePixel.x + 1);
+        m_BitmapHeight = std::max<uint32_t>(m_BitmapHeight, onePixel.y + 1);
+    }
+
+    m_BitmapStride = (m_BitmapWidth + 63) / 64;
+    m_Bitmap.assign(static_cast<size_t>(m_BitmapStride) * m_BitmapHeight, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+///
+//////////////////////////////////////////////////////////////////////////////
+void DefectMap::setBits(BadPixelSet::const_iterator begin, BadPixelSet::const_iterator end, bool defective)
+{
+    for (auto onePixel = begin; onePixel != end; ++onePixel)
+    {
+        quint64 &word = m_Bitmap[onePixel->y * m_BitmapStride + onePixel->x / 64];
+        const quint64 bit = quint64(1) << (onePixel->x % 64);
+        if (defective)
+            word |= bit;
+        else
+            word &= ~bit;
+    }
+}
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <set>
+#include <vector>
 #include <QJsonObject>
 #include <QJsonArray>
 
@@ -26,7 +26,8 @@ class BadPixel
         double value {0};
 };
 
-typedef std::multiset<BadPixel> BadPixelSet;
+// Bad pixels sorted by increasing value.
+typedef std::vector<BadPixel> BadPixelSet;
 
 class DefectMap : public QObject
 {
@@ -91,6 +92,38 @@ class DefectMap : public QObject
         }
 
         void filterPixels();
+
+        /**
+         * @brief isDefective Checks whether a pixel is a hot or cold pixel within the current thresholds.
+         * Hot or cold pixels are ignored when they are disabled.
+         * @param x X coordinate in the dark frame.
+         * @param y Y coordinate in the dark frame.
+         */
+        bool isDefective(uint32_t x, uint32_t y) const
+        {
+            if (x >= m_BitmapWidth || y >= m_BitmapHeight)
+                return false;
+            return m_Bitmap[y * m_BitmapStride + x / 64] & (quint64(1) << (x % 64));
+        }
+
+        /**
+         * @brief bitmapRow Returns the defect bits of row y, pixel x of the row is bit x % 64 of word x / 64.
+         * @return nullptr if no defect can be found in the row.
+         */
+        const quint64 *bitmapRow(uint32_t y) const
+        {
+            return y < m_BitmapHeight ? m_Bitmap.data() + y * m_BitmapStride : nullptr;
+        }
+        // Width and height of the region of the dark frame covered by the bitmap.
+        uint32_t bitmapWidth() const
+        {
+            return m_BitmapWidth;
+        }
+        uint32_t bitmapHeight() const
+        {
+            return m_BitmapHeight;
+        }
+
     signals:
         //        void hotPixelsUpdated(const BadPixelSet::const_iterator &start, const BadPixelSet::const_iterator &end);
         //        void coldPixelsUpdated(const BadPixelSet::const_iterator &start, const BadPixelSet::const_iterator &end);
@@ -102,6 +135,10 @@ class DefectMap : public QObject
         double calculateSigma(uint8_t aggressiveness);
         template <typename T>
         void initBadPixelsInternal(double hotPixelThreshold, double coldPixelThreshold);
+        // Sizes the bitmap to cover all the candidate pixels and flags those within the thresholds.
+        void rebuildBitmap();
+        // Flags or clears the pixels of the given range.
+        void setBits(BadPixelSet::const_iterator begin, BadPixelSet::const_iterator end, bool defective);
 
         BadPixelSet m_ColdPixels, m_HotPixels;
         BadPixelSet::const_iterator m_ColdPixelsThreshold, m_HotPixelsThreshold;
@@ -114,5 +151,10 @@ class DefectMap : public QObject
 
         QSharedPointer<FITSData> m_DarkData;
 
+        // One bit per pixel, set for the hot and cold pixels within the thresholds, so that the pixels
+        // can be looked up in constant time and scanned 64 at a time when correcting frames.
+        std::vector<quint64> m_Bitmap;
+        uint32_t m_BitmapWidth {0}, m_BitmapHeight {0}, m_BitmapStride {0};
+
 };
 
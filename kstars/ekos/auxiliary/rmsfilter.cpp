@@ -0,0 +1,85 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "rmsfilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+RmsFilter::RmsFilter()
+{
+    constexpr double timeConstant = 40.0;
+    alpha = 1.0 / pow(timeConstant, 0.865);
+}
+
+double RmsFilter::newSample(double x, double y)
+{
+    const double valueSquared = x * x + y * y;
+    filteredRMS = alpha * valueSquared + (1.0 - alpha) * filteredRMS;
+    return sqrt(filteredRMS);
+}
+
+SlidingRms::SlidingRms(int window)
+{
+    m_X.fill(0, std::max(1, window));
+    m_Y.fill(0, std::max(1, window));
+}
+
+void SlidingRms::reset()
+{
+    m_X.fill(0);
+    m_Y.fill(0);
+    m_Next  = 0;
+    m_Count = 0;
+    m_SumX  = 0;
+    m_SumY  = 0;
+}
+
+void SlidingRms::newSample(double x, double y)
+{
+    const int window = m_X.size();
+    const double xSquared = x * x;
+    const double ySquared = y * y;
+
+    // The oldest sample leaves the window, its slot is 0 until the window is full.
+    m_SumX += xSquared - m_X[m_Next];
+    m_SumY += ySquared - m_Y[m_Next];
+    m_X[m_Next] = xSquared;
+    m_Y[m_Next] = ySquared;
+    m_Count = std::min(m_Count + 1, window);
+
+    if (++m_Next == window)
+    {
+        m_Next = 0;
+        m_SumX = 0;
+        m_SumY = 0;
+        for (int i = 0; i < window; i++)
+        {
+            m_SumX += m_X[i];
+            m_SumY += m_Y[i];
+        }
+    }
+}
+
+double SlidingRms::rmsX() const
+{
+    return m_Count == 0 ? 0 : std::sqrt(std::max(0.0, m_SumX) / m_Count);
+}
+
+double SlidingRms::rmsY() const
+{
+    return m_Count == 0 ? 0 : std::sqrt(std::max(0.0, m_SumY) / m_Count);
+}
+
+double SlidingRms::rms() const
+{
+    return m_Count == 0 ? 0 : std::sqrt(std::max(0.0, m_SumX + m_SumY) / m_Count);
+}
+
+}
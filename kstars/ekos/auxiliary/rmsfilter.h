@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QVector>
+
+namespace Ekos
+{
+
+/**
+ * @class RmsFilter
+ * @short Approximate moving RMS of a 2-D error.
+ *
+ * Input the x error and y error into newSample(). It returns the sqrt of an approximate moving average of the
+ * squared errors roughly averaged over 40 samples, implemented by a simple digital low-pass filter. Analyze uses
+ * it to plot RMS guider errors, where x and y are the RA and DEC errors.
+ */
+class RmsFilter
+{
+    public:
+        RmsFilter();
+
+        void resetFilter()
+        {
+            filteredRMS = 0;
+        }
+        double newSample(double x, double y);
+
+    private:
+        double alpha { 0 };
+        double filteredRMS { 0 };
+};
+
+/**
+ * @class SlidingRms
+ * @short Exact RMS of the last samples of a 2-D error, e.g. the RA and DEC guide errors.
+ *
+ * The sums of squares are updated as samples enter and leave the window, so a sample costs the same whatever
+ * the size of the window. The sums are computed again each time the window wraps around, so that rounding
+ * errors do not accumulate.
+ */
+class SlidingRms
+{
+    public:
+        explicit SlidingRms(int window = 50);
+
+        void reset();
+        void newSample(double x, double y);
+
+        /** @return number of samples in the window */
+        int count() const
+        {
+            return m_Count;
+        }
+        double rmsX() const;
+        double rmsY() const;
+        /** @return RMS of the 2-D error */
+        double rms() const;
+
+    private:
+        QVector<double> m_X;
+        QVector<double> m_Y;
+        int m_Next { 0 };
+        int m_Count { 0 };
+        double m_SumX { 0 };
+        double m_SumY { 0 };
+};
+
+}
@@ -22,6 +22,7 @@
 #include "scriptsmanager.h"
 #include "fitsviewer/fitsdata.h"
 #include "indi/driverinfo.h"
+#include "indi/imagefilewriter.h"
 #include "indi/indifilterwheel.h"
 #include "indi/indilistener.h"
 #include "oal/observeradd.h"
@@ -124,6 +125,17 @@ Capture::Capture()
     seqFileCount = 0;
     seqDelayTimer = new QTimer(this);
     connect(seqDelayTimer, &QTimer::timeout, this, &Capture::captureImage);
+
+    connect(ISD::ImageFileWriter::Instance(), &ISD::ImageFileWriter::congestionChanged, this, [this](bool congested)
+    {
+        if (congested && activeJob != nullptr)
+            appendLogText(i18n("Storage is lagging behind, delaying the next capture until the frames are written."));
+    });
+    connect(ISD::ImageFileWriter::Instance(), &ISD::ImageFileWriter::writeFailed, this,
+            [this](const QString & filename, const QString & error)
+    {
+        appendLogText(i18n("Error: failed writing image to %1: %2", filename, error));
+    });
     m_captureModuleState->getCaptureDelayTimer().setSingleShot(true);
     connect(&m_captureModuleState->getCaptureDelayTimer(), &QTimer::timeout, this, &Capture::start, Qt::UniqueConnection);
 
@@ -2037,16 +2049,35 @@ IPState Capture::setCaptureComplete()
     if (m_ImageData)
     {
         QVariant frameType;
-        if (Options::autoHFR() && m_ImageData && !m_ImageData->areStarsSearched() && m_ImageData->getRecordValue("FRAME", frameType)
-                && frameType.toString() == "Light")
-        {
-            QFuture<bool> result = m_ImageData->findStars(ALGORITHM_SEP);
+        const bool isLight = m_ImageData->getRecordValue("FRAME", frameType) && frameType.toString() == "Light";
+        // A quick search from the FITS viewer only looked at the center of the frame. That is enough for the
+        // HFR, but the HFR map needs a search of the whole frame.
+        const bool searched = Options::autoHFRMap() ? m_ImageData->areStarsSearchedInFullFrame() :
+                              m_ImageData->areStarsSearched();
+        if (Options::autoHFR() && m_ImageData && !searched && isLight)
+        {
+            // The HFR map needs the stars of the whole frame, not only those in its center.
+            QRect searchBox;
+            if (Options::autoHFRMap())
+                searchBox = QRect(0, 0, m_ImageData->width(), m_ImageData->height());
+            QFuture<bool> result = m_ImageData->findStars(ALGORITHM_SEP, searchBox);
             result.waitForFinished();
         }
         hfr = m_ImageData->getHFR(HFR_AVERAGE);
         numStars = m_ImageData->getSkyBackground().starsDetected;
         median = m_ImageData->getMedian();
         eccentricity = m_ImageData->getEccentricity();
+        m_FrameHFRMap.clear();
+        if (Options::autoHFR() && Options::autoHFRMap() && isLight)
+        {
+            const FITSHFRMap &hfrMap = m_ImageData->getHFRMap();
+            if (hfrMap.isValid())
+            {
+                m_FrameHFRMap = hfrMap.toVariantMap();
+                qCInfo(KSTARS_EKOS_CAPTURE) << "HFR map: HFR" << hfrMap.hfr() << "tilt" << hfrMap.tilt() << "% tiltX" << hfrMap.tiltX()
+                                            << "tiltY" << hfrMap.tiltY() << "offAxis" << hfrMap.offAxis();
+            }
+        }
         filename = m_ImageData->filename();
         appendLogText(i18n("Captured %1", filename));
         auto remainingPlaceholders = PlaceholderPath::remainingPlaceholders(filename);
@@ -2073,6 +2104,8 @@ IPState Capture::setCaptureComplete()
         metadata["starCount"] = numStars;
         metadata["median"] = median;
         metadata["eccentricity"] = eccentricity;
+        if (!m_FrameHFRMap.isEmpty())
+            metadata["hfrMap"] = m_FrameHFRMap;
         emit captureComplete(metadata);
 
         // Check if we need to execute post capture script first
@@ -2342,6 +2375,13 @@ void Capture::captureImage()
         return;
     }
 
+    // Do not start the next exposure while the previous frames are still waiting to be written
+    if (ISD::ImageFileWriter::Instance()->isCongested())
+    {
+        QTimer::singleShot(1000, this, &Capture::captureImage);
+        return;
+    }
+
     // Bail out if we have no CCD anymore
     if (m_captureDeviceAdaptor->getActiveCamera()->isConnected() == false)
     {
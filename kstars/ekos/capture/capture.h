@@ -305,6 +305,15 @@ class Capture : public QWidget, public Ui::Capture
         {
             return m_captureModuleState->getCaptureState();
         }
+
+        /** DBUS interface function.
+         *  Per-region HFR, FWHM and eccentricity of the last captured frame and the derived tilt figures,
+         *  see FITSHFRMap::toVariantMap(). Empty unless the HFR map is enabled in the FITS options.
+         */
+        Q_SCRIPTABLE QVariantMap getFrameHFRMap()
+        {
+            return m_FrameHFRMap;
+        }
         /** @} end of group CaptureDBusInterface */
 
 
@@ -1278,6 +1287,8 @@ class Capture : public QWidget, public Ui::Capture
         QPointer<QDBusInterface> mountInterface;
 
         QSharedPointer<FITSData> m_ImageData;
+        // HFR map of the last captured frame, see getFrameHFRMap().
+        QVariantMap m_FrameHFRMap;
 
         QStringList m_LogText;
         QUrl m_SequenceURL;
@@ -8,6 +8,7 @@
 
 #include "sequencejob.h"
 #include "kspaths.h"
+#include "ekos/auxiliary/capturedframesindex.h"
 
 #include <QString>
 #include <QStringList>
@@ -460,8 +461,8 @@ QList<int> PlaceholderPath::getCompletedFileIds(const SequenceJob &job, const QS
 {
     QString path = generateFilename(job, targetName, true, true, 0, ".*", "", true);
     QFileInfo path_info(path);
-    QDir dir(path_info.dir());
-    QStringList matchingFiles = dir.entryList(QDir::Files);
+    // The index only lists the folder again when it changed
+    const auto matchingFiles = CapturedFramesIndex::Instance()->files(path_info.absolutePath());
     QRegularExpressionMatch match;
     QRegularExpression re("^" + path_info.fileName() + "$");
     QList<int> ids = {};
@@ -2,6 +2,8 @@
 #include "ekos/ekos.h"
 #include <ekos_focus_debug.h>
 
+#include <algorithm>
+
 // Constants used to identify the number of parameters used for different curve types
 constexpr int NUM_HYPERBOLA_PARAMS = 4;
 constexpr int NUM_PARABOLA_PARAMS = 3;
@@ -50,7 +52,14 @@ const double INEPSREL = pow(GSL_DBL_EPSILON, 1.0 / 3.0);
 // code uses the basic LM solver which keeps it generic if more equations are to be added. Of course, if
 // required this could easily be tweaked. An optimisation that has been implemented is that since, in normal
 // operation, the solver is run multiple times with the same or similar parameters, the initial guess for
-// a solver run is set the solution from the previous run.
+// a solver run is set the solution from the previous run. The GSL solver and its vectors are also kept
+// between runs and only reallocated when the number of datapoints changes, and F(x) and J(x) are evaluated
+// together in a single pass over the datapoints.
+//
+// Optionally the fit can be made robust to outliers, e.g. an HFR spoiled by a passing cloud or a
+// satellite trail. After the normal fit the datapoints are reweighted according to their residuals
+// (Huber weights) and the curve is refitted, warm-started from the previous solution, until the
+// weights settle. See CurveFitting::robustRefit().
 //
 // The documents referenced provide the maths of the LM algorithm. What is required is the function to be
 // used f(x) and the derivative of f(x) with respect to the parameters of f(x). This partial derivative forms
@@ -144,7 +153,8 @@ enum { A_IDX = 0, B_IDX, C_IDX, D_IDX };
 // hypPhi() is a repeating part of the function calculations for Hyperbolas.
 inline double hypPhi(double x, double a, double c)
 {
-    return sqrt(1.0 + pow(((x - c) / a), 2.0));
+    const double t = (x - c) / a;
+    return sqrt(1.0 + t * t);
 }
 
 // Function to calculate f(x) for a hyperbola
@@ -193,24 +203,46 @@ int hypJx(const gsl_vector * X, void * inParams, gsl_matrix * J)
     for(int i = 0; i < DataPoints->dps.size(); ++i)
     {
         // Calculate the Jacobian Matrix
-        const double oneBySigma = 1.0f / DataPoints->dps[i].sigma;
+        const double oneBySigma = 1.0 / DataPoints->dps[i].sigma;
         const double x = DataPoints->dps[i].x;
         const double x_minus_c = x - c;
+        const double phi = hypPhi(x, a, c);
 
-        gsl_matrix_set(J, i, A_IDX, -oneBySigma * b * (x_minus_c * x_minus_c) / (a3 * hypPhi(x, a, c)));
-        gsl_matrix_set(J, i, B_IDX, oneBySigma * hypPhi(x, a, c));
-        gsl_matrix_set(J, i, C_IDX, -oneBySigma * b * x_minus_c / (a2 * hypPhi(x, a, c)));
+        gsl_matrix_set(J, i, A_IDX, -oneBySigma * b * (x_minus_c * x_minus_c) / (a3 * phi));
+        gsl_matrix_set(J, i, B_IDX, oneBySigma * phi);
+        gsl_matrix_set(J, i, C_IDX, -oneBySigma * b * x_minus_c / (a2 * phi));
         gsl_matrix_set(J, i, D_IDX, oneBySigma);
     }
 
     return GSL_SUCCESS;
 }
 
-// Invokes F(x) and J(x). Seems to be an optimisation employed by the GSL library to calc these together
-int hypFJx(const gsl_vector * x, void * inParams, gsl_vector * f, gsl_matrix * J)
+// Calculates F(x) and J(x) together. GSL calls this when it needs both, which lets
+// phi be calculated once per datapoint rather than once for F and again for J.
+int hypFJx(const gsl_vector * X, void * inParams, gsl_vector * f, gsl_matrix * J)
 {
-    hypFx(x, inParams, f);
-    hypJx(x, inParams, J);
+    CurveFitting::DataPointT * DataPoints = ((struct CurveFitting::DataPointT *)inParams);
+
+    const double a = gsl_vector_get(X, A_IDX);
+    const double b = gsl_vector_get(X, B_IDX);
+    const double c = gsl_vector_get(X, C_IDX);
+    const double d = gsl_vector_get(X, D_IDX);
+    const double a2 = a * a;
+    const double a3 = a * a2;
+
+    for(int i = 0; i < DataPoints->dps.size(); ++i)
+    {
+        const CurveFitting::DataPT &dp = DataPoints->dps[i];
+        const double oneBySigma = 1.0 / dp.sigma;
+        const double x_minus_c = dp.x - c;
+        const double phi = hypPhi(dp.x, a, c);
+
+        gsl_vector_set(f, i, (b * phi + d - dp.y) * oneBySigma);
+        gsl_matrix_set(J, i, A_IDX, -oneBySigma * b * (x_minus_c * x_minus_c) / (a3 * phi));
+        gsl_matrix_set(J, i, B_IDX, oneBySigma * phi);
+        gsl_matrix_set(J, i, C_IDX, -oneBySigma * b * x_minus_c / (a2 * phi));
+        gsl_matrix_set(J, i, D_IDX, oneBySigma);
+    }
 
     return GSL_SUCCESS;
 }
@@ -219,7 +251,7 @@ int hypFJx(const gsl_vector * x, void * inParams, gsl_vector * f, gsl_matrix * J
 // Function to calculate f(x) for a parabola.
 double parfx(double x, double a, double b, double c)
 {
-    return a + b * pow((x - c), 2.0);
+    return a + b * (x - c) * (x - c);
 }
 
 // Calculates f(x) for each data point in the parabola.
@@ -258,28 +290,121 @@ int parJx(const gsl_vector * X, void * inParams, gsl_matrix * J)
     for(int i = 0; i < DataPoint->dps.size(); ++i)
     {
         // Calculate the Jacobian Matrix
-        const double oneBySigma = 1.0f / DataPoint->dps[i].sigma;
-        const double x = DataPoint->dps[i].x;
+        const double oneBySigma = 1.0 / DataPoint->dps[i].sigma;
+        const double x_minus_c = DataPoint->dps[i].x - c;
 
-        gsl_matrix_set(J, i, 0, oneBySigma);
-        gsl_matrix_set(J, i, 1, oneBySigma * (x - c) * (x - c));
-        gsl_matrix_set(J, i, 2, -oneBySigma * b * (x - c));
+        gsl_matrix_set(J, i, A_IDX, oneBySigma);
+        gsl_matrix_set(J, i, B_IDX, oneBySigma * x_minus_c * x_minus_c);
+        gsl_matrix_set(J, i, C_IDX, -2.0 * oneBySigma * b * x_minus_c);
     }
 
     return GSL_SUCCESS;
 }
 
-// Invokes F(x) and J(x)
-int parFJx(const gsl_vector * x, void * inParams, gsl_vector * f, gsl_matrix * J)
+// Calculates F(x) and J(x) together in a single pass over the datapoints.
+int parFJx(const gsl_vector * X, void * inParams, gsl_vector * f, gsl_matrix * J)
 {
-    parFx(x, inParams, f);
-    parJx(x, inParams, J);
+    CurveFitting::DataPointT * DataPoint = ((struct CurveFitting::DataPointT *)inParams);
+
+    const double a = gsl_vector_get(X, A_IDX);
+    const double b = gsl_vector_get(X, B_IDX);
+    const double c = gsl_vector_get(X, C_IDX);
+
+    for(int i = 0; i < DataPoint->dps.size(); ++i)
+    {
+        const CurveFitting::DataPT &dp = DataPoint->dps[i];
+        const double oneBySigma = 1.0 / dp.sigma;
+        const double x_minus_c = dp.x - c;
+        const double x_minus_c2 = x_minus_c * x_minus_c;
+
+        gsl_vector_set(f, i, (a + b * x_minus_c2 - dp.y) * oneBySigma);
+        gsl_matrix_set(J, i, A_IDX, oneBySigma);
+        gsl_matrix_set(J, i, B_IDX, oneBySigma * x_minus_c2);
+        gsl_matrix_set(J, i, C_IDX, -2.0 * oneBySigma * b * x_minus_c);
+    }
 
     return GSL_SUCCESS;
 }
 
+// Median of the values. Reorders the vector.
+double median(QVector<double> &values)
+{
+    const int middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    return values[middle];
+}
+
 }  // namespace
 
+CurveFitting::Workspace::~Workspace()
+{
+    freeLM();
+    freeLinear();
+}
+
+void CurveFitting::Workspace::freeLM()
+{
+    if (m_Solver)
+        gsl_multifit_fdfsolver_free(m_Solver);
+    if (m_Guess)
+        gsl_vector_free(m_Guess);
+    m_Solver = nullptr;
+    m_Guess = nullptr;
+    m_SolverN = m_SolverP = 0;
+}
+
+void CurveFitting::Workspace::freeLinear()
+{
+    if (m_LinearWork)
+        gsl_multifit_linear_free(m_LinearWork);
+    if (m_LinearX)
+        gsl_matrix_free(m_LinearX);
+    if (m_LinearY)
+        gsl_vector_free(m_LinearY);
+    if (m_LinearC)
+        gsl_vector_free(m_LinearC);
+    if (m_LinearCov)
+        gsl_matrix_free(m_LinearCov);
+    m_LinearWork = nullptr;
+    m_LinearX = m_LinearCov = nullptr;
+    m_LinearY = m_LinearC = nullptr;
+    m_LinearN = m_LinearP = 0;
+}
+
+gsl_multifit_fdfsolver *CurveFitting::Workspace::lmSolver(size_t n, size_t p)
+{
+    if (m_Solver && n == m_SolverN && p == m_SolverP)
+        return m_Solver;
+
+    freeLM();
+    // Returns nullptr (the error handler is off) if there are fewer datapoints than parameters.
+    m_Solver = gsl_multifit_fdfsolver_alloc(gsl_multifit_fdfsolver_lmsder, n, p);
+    if (m_Solver == nullptr)
+        return nullptr;
+    m_Guess = gsl_vector_alloc(p);
+    m_SolverN = n;
+    m_SolverP = p;
+    return m_Solver;
+}
+
+bool CurveFitting::Workspace::linear(size_t n, size_t p)
+{
+    if (m_LinearWork && n == m_LinearN && p == m_LinearP)
+        return true;
+
+    freeLinear();
+    m_LinearWork = gsl_multifit_linear_alloc(n, p);
+    if (m_LinearWork == nullptr)
+        return false;
+    m_LinearX   = gsl_matrix_alloc(n, p);
+    m_LinearY   = gsl_vector_alloc(n);
+    m_LinearC   = gsl_vector_alloc(p);
+    m_LinearCov = gsl_matrix_alloc(p, p);
+    m_LinearN = n;
+    m_LinearP = p;
+    return true;
+}
+
 CurveFitting::CurveFitting()
 {
     // Constructor just initialises variables
@@ -287,17 +412,18 @@ CurveFitting::CurveFitting()
 }
 
 void CurveFitting::fitCurve(const QVector<int> &x_, const QVector<double> &y_, const QVector<double> &sigma_,
-                            const CurveFit curveFit, const bool useWeights)
+                            const CurveFit curveFit, const bool useWeights, const bool robust)
 {
     if ((x_.size() != y_.size()) || (x_.size() != sigma_.size()))
         qCDebug(KSTARS_EKOS_FOCUS) << QString("CurveFitting::CurveFitting inconsistent parameters. x=%1, y=%2, sigma=%3")
                                    .arg(x_.size()).arg(y_.size()).arg(sigma_.size());
 
-    m_x.clear();
+    m_x.resize(x_.size());
     for (int i = 0; i < x_.size(); ++i)
-        m_x.push_back(static_cast<double>(x_[i]));
+        m_x[i] = static_cast<double>(x_[i]);
     m_y = y_;
     m_sigma = sigma_;
+    m_RobustWeights.clear();
 
     m_CurveType = curveFit;
     switch (m_CurveType)
@@ -320,6 +446,69 @@ void CurveFitting::fitCurve(const QVector<int> &x_, const QVector<double> &y_, c
     lastCoefficients = m_coefficients;
     lastCurveType    = m_CurveType;
     firstSolverRun   = false;
+
+    if (robust && m_CurveType != FOCUS_QUADRATIC && !m_coefficients.empty())
+        robustRefit(useWeights);
+}
+
+// Robust fitting by iteratively reweighted least squares using Huber weights.
+// The residual of each datapoint (in units of its sigma) is compared to the robust spread of all the
+// residuals (1.4826 * the median absolute residual, which estimates the standard deviation for normally
+// distributed residuals). Datapoints within ROBUST_HUBER_K spreads keep their weight, ones further out
+// are down-weighted in proportion to their distance, which is done by inflating their sigma.
+// Each refit starts from the previous solution so it typically converges in a few LM iterations.
+void CurveFitting::robustRefit(bool useWeights)
+{
+    constexpr int ROBUST_ITERATIONS = 5;
+    constexpr double ROBUST_HUBER_K = 1.345;
+    constexpr double ROBUST_WEIGHT_TOLERANCE = 1e-3;
+
+    // With few datapoints beyond the number of parameters there isn't enough redundancy to spot an outlier.
+    if (m_x.size() < m_coefficients.size() + 2)
+        return;
+
+    QVector<double> residuals(m_x.size()), absResiduals(m_x.size());
+    for (int iteration = 0; iteration < ROBUST_ITERATIONS; ++iteration)
+    {
+        for (int i = 0; i < m_x.size(); ++i)
+        {
+            const double sigma = (useWeights && m_sigma[i] > 1e-8) ? m_sigma[i] : 1.0;
+            residuals[i] = (m_y[i] - f(m_x[i])) / sigma;
+            absResiduals[i] = std::abs(residuals[i]);
+        }
+        const double spread = 1.4826 * median(absResiduals);
+        if (spread <= 0.0)
+            break;
+
+        const double limit = ROBUST_HUBER_K * spread;
+        QVector<double> weights(m_x.size());
+        double maxChange = 0.0;
+        for (int i = 0; i < m_x.size(); ++i)
+        {
+            const double r = std::abs(residuals[i]);
+            weights[i] = (r <= limit) ? 1.0 : limit / r;
+            const double previous = m_RobustWeights.empty() ? 1.0 : m_RobustWeights[i];
+            maxChange = std::max(maxChange, std::abs(weights[i] - previous));
+        }
+        if (maxChange < ROBUST_WEIGHT_TOLERANCE)
+            break;
+
+        m_RobustWeights = weights;
+        const QVector<double> solution = (m_CurveType == FOCUS_HYPERBOLA) ?
+                                         hyperbola_fit(m_x, m_y, m_sigma, useWeights) :
+                                         parabola_fit(m_x, m_y, m_sigma, useWeights);
+        if (solution.empty())
+            // Keep the last good solution.
+            break;
+
+        m_coefficients = solution;
+        lastCoefficients = m_coefficients;
+    }
+
+    QStringList weights;
+    for (const double weight : m_RobustWeights)
+        weights << QString::number(weight, 'f', 2);
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("CurveFitting: robust fit weights %1").arg(weights.join(","));
 }
 
 double CurveFitting::curveFunction(double x, void *params)
@@ -338,8 +527,9 @@ double CurveFitting::f(double x)
     double y = 0;
     if (m_CurveType == FOCUS_QUADRATIC)
     {
-        for (int i = 0; i <= order; ++i)
-            y += m_coefficients[i] * pow(x, i);
+        // Horner's method
+        for (int i = order; i >= 0; --i)
+            y = y * x + m_coefficients[i];
     }
     else if (m_CurveType == FOCUS_HYPERBOLA && m_coefficients.size() == NUM_HYPERBOLA_PARAMS)
         y = hypfx(x, m_coefficients[A_IDX], m_coefficients[B_IDX], m_coefficients[C_IDX], m_coefficients[D_IDX]);
@@ -354,68 +544,87 @@ QVector<double> CurveFitting::polynomial_fit(const double *const data_x, const d
     int status = 0;
     double chisq = 0;
     QVector<double> vc;
-    gsl_vector *y, *c;
-    gsl_matrix *X, *cov;
-    y   = gsl_vector_alloc(n);
-    c   = gsl_vector_alloc(order + 1);
-    X   = gsl_matrix_alloc(n, order + 1);
-    cov = gsl_matrix_alloc(order + 1, order + 1);
+
+    // Must turn off error handler or it aborts on error
+    gsl_set_error_handler_off();
+
+    if (n < 1 || !m_Workspace.linear(n, order + 1))
+    {
+        qDebug() << Q_FUNC_INFO << "GSL multifit error: cannot fit" << n << "datapoints";
+        return vc;
+    }
+
+    gsl_matrix *X = m_Workspace.linearX();
+    gsl_vector *y = m_Workspace.linearY();
+    gsl_vector *c = m_Workspace.linearC();
 
     for (int i = 0; i < n; i++)
     {
+        double xj = 1.0;
         for (int j = 0; j < order + 1; j++)
         {
-            gsl_matrix_set(X, i, j, pow(data_x[i], j));
+            gsl_matrix_set(X, i, j, xj);
+            xj *= data_x[i];
         }
         gsl_vector_set(y, i, data_y[i]);
     }
 
-    // Must turn off error handler or it aborts on error
-    gsl_set_error_handler_off();
-
-    gsl_multifit_linear_workspace *work = gsl_multifit_linear_alloc(n, order + 1);
-    status                              = gsl_multifit_linear(X, y, c, cov, &chisq, work);
+    status = gsl_multifit_linear(X, y, c, m_Workspace.linearCov(), &chisq, m_Workspace.linearWork());
 
     if (status != GSL_SUCCESS)
         qDebug() << Q_FUNC_INFO << "GSL multifit error:" << gsl_strerror(status);
     else
     {
-        gsl_multifit_linear_free(work);
-
         for (int i = 0; i < order + 1; i++)
         {
             vc.push_back(gsl_vector_get(c, i));
         }
     }
 
-    gsl_vector_free(y);
-    gsl_vector_free(c);
-    gsl_matrix_free(X);
-    gsl_matrix_free(cov);
-
     return vc;
 }
 
-QVector<double> CurveFitting::hyperbola_fit(const QVector<double> data_x, const QVector<double> data_y,
-        const QVector<double> data_sigma,
-        const bool useWeights)
+void CurveFitting::setDataPoints(const QVector<double> &data_x, const QVector<double> &data_y,
+                                 const QVector<double> &data_sigma, bool useWeights)
 {
-    QVector<double> vc;
-
-    DataPointT dataPoints;
+    const bool robust = m_RobustWeights.size() == data_x.size();
+    m_DataPoints.useWeights = useWeights;
+    // resize rather than clear keeps the allocated storage.
+    m_DataPoints.dps.resize(data_x.size());
+    for (int i = 0; i < data_x.size(); i++)
+    {
+        double sigma = (useWeights && data_sigma[i] > 1e-8) ? data_sigma[i] : 1.0;
+        // A robust weight w scales the datapoint's contribution to the sum of squares by w.
+        if (robust && m_RobustWeights[i] > 0.0)
+            sigma /= sqrt(m_RobustWeights[i]);
+        m_DataPoints.dps[i] = {data_x[i], data_y[i], sigma};
+    }
+}
 
+QVector<double> CurveFitting::hyperbola_fit(const QVector<double> &data_x, const QVector<double> &data_y,
+        const QVector<double> &data_sigma,
+        const bool useWeights)
+{
     qCDebug(KSTARS_EKOS_FOCUS) <<
                                QString("Starting Levenberg-Marquardt solver, fit=hyperbola, Iterations= %1, Precision abs/rel=%2/%3...")
                                .arg(MAX_ITERATIONS).arg(INEPSABS).arg(INEPSREL);
 
     // Fill in the data to which the curve will be fitted
-    dataPoints.useWeights = useWeights;
-    for (int i = 0; i < data_x.size(); i++)
-        dataPoints.push_back(data_x[i], data_y[i], (useWeights && data_sigma[i] > 1e-8) ? data_sigma[i] : 1.0);
+    setDataPoints(data_x, data_y, data_sigma, useWeights);
 
     // Set the gsl error handler off as it aborts the program on error.
     gsl_set_error_handler_off();
 
+    // Create (or reuse) a Levenberg-Marquardt solver with n data points and 4 parameters
+    if (m_Workspace.lmSolver(data_x.size(), NUM_HYPERBOLA_PARAMS) == nullptr)
+    {
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Hyperbola): Cannot fit %1 datapoints").arg(data_x.size());
+        return QVector<double>();
+    }
+
+    // Make initial guesses, either from the previous solution or from the datapoints
+    hypMakeGuess(data_x, data_y, m_Workspace.lmGuess());
+
     // Fill in function info
     gsl_multifit_function_fdf f;
     f.f      = hypFx;
@@ -423,16 +632,16 @@ QVector<double> CurveFitting::hyperbola_fit(const QVector<double> data_x, const
     f.fdf    = hypFJx;
     f.n      = data_x.size();
     f.p      = NUM_HYPERBOLA_PARAMS;
-    f.params = &dataPoints;
+    f.params = &m_DataPoints;
 
-    // Allocate the guess vector
-    gsl_vector * guess = gsl_vector_alloc(NUM_HYPERBOLA_PARAMS);
-    // Make initial guesses - here we just set all parameters to 1.0
-    hypMakeGuess(data_x, data_y, guess);
-    // Create a Levenberg-Marquardt solver with n data points and 4 parameters
-    gsl_multifit_fdfsolver * solver = gsl_multifit_fdfsolver_alloc(gsl_multifit_fdfsolver_lmsder, data_x.size(),
-                                      NUM_HYPERBOLA_PARAMS);
-    gsl_multifit_fdfsolver_set(solver, & f, guess);  // Initialize the solver
+    return lmFit(&f, "Hyperbola");
+}
+
+QVector<double> CurveFitting::lmFit(gsl_multifit_function_fdf *f, const QString &curveName)
+{
+    QVector<double> vc;
+    gsl_multifit_fdfsolver * solver = m_Workspace.lmSolver(f->n, f->p);
+    gsl_multifit_fdfsolver_set(solver, f, m_Workspace.lmGuess());  // Initialize the solver
 
     int status, i = 0;
 
@@ -443,8 +652,8 @@ QVector<double> CurveFitting::hyperbola_fit(const QVector<double> data_x, const
         // Iterate through the solver. Function returns GSL_SUCCESS = 0 on success
         status = gsl_multifit_fdfsolver_iterate(solver);
 
-        //qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Hyperbola): Iteration %1 status=%2 [%3] f=%4")
-        //                           .arg(i).arg(status).arg(gsl_strerror(status)).arg(gsl_blas_dnrm2(solver->f));
+        //qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (%1): Iteration %2 status=%3 [%4] f=%5")
+        //                           .arg(curveName).arg(i).arg(status).arg(gsl_strerror(status)).arg(gsl_blas_dnrm2(solver->f));
         if (status)
             break;
 
@@ -453,30 +662,29 @@ QVector<double> CurveFitting::hyperbola_fit(const QVector<double> data_x, const
     while (status == GSL_CONTINUE && i < MAX_ITERATIONS);
 
     if (status != 0)
-        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Hyperbola): Failed with status=%1 [%2] after %3/%4 iterations")
-                                   .arg(status).arg(gsl_strerror(status)).arg(i).arg(MAX_ITERATIONS);
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (%1): Failed with status=%2 [%3] after %4/%5 iterations")
+                                   .arg(curveName).arg(status).arg(gsl_strerror(status)).arg(i).arg(MAX_ITERATIONS);
     else if (i == MAX_ITERATIONS)
-        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Hyperbola): Failed to converge after %1 iterations").arg(i);
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (%1): Failed to converge after %2 iterations").arg(curveName).arg(i);
     else
     {
-        // All good so store the results - parameters A, B, C and D
-        for (int j = 0; j < NUM_HYPERBOLA_PARAMS; j++)
+        // All good so store the results
+        for (size_t j = 0; j < f->p; j++)
         {
             vc.push_back(gsl_vector_get(solver->x, j));
         }
-        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM Solver (Hyperbola): Solution found after %1 iterations. A=%2 B=%3, C=%4, D=%5")
-                                   .arg(i).arg(vc[A_IDX]).arg(vc[B_IDX]).arg(vc[C_IDX]).arg(vc[D_IDX]);
+        QString solution;
+        for (int j = 0; j < vc.size(); j++)
+            solution.append(QString(" %1=%2").arg(QChar('A' + j)).arg(vc[j]));
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM Solver (%1): Solution found after %2 iterations.%3")
+                                   .arg(curveName).arg(i).arg(solution);
     }
 
-    // Free GSL memory
-    gsl_multifit_fdfsolver_free(solver);
-    gsl_vector_free(guess);
-
     return vc;
 }
 
 // Initialise parameters before starting the solver
-void CurveFitting::hypMakeGuess(const QVector<double> inX, const QVector<double> inY, gsl_vector * guess)
+void CurveFitting::hypMakeGuess(const QVector<double> &inX, const QVector<double> &inY, gsl_vector * guess)
 {
     if (inX.size() < 1)
         return;
@@ -512,25 +720,30 @@ void CurveFitting::hypMakeGuess(const QVector<double> inX, const QVector<double>
     }
 }
 
-QVector<double> CurveFitting::parabola_fit(const QVector<double> data_x, const QVector<double> data_y,
-        const QVector<double> data_sigma,
+QVector<double> CurveFitting::parabola_fit(const QVector<double> &data_x, const QVector<double> &data_y,
+        const QVector<double> &data_sigma,
         bool useWeights)
 {
-    QVector<double> vc;
-    DataPointT dataPoints;
-
     qCDebug(KSTARS_EKOS_FOCUS) <<
                                QString("Starting Levenberg-Marquardt solver, fit=parabola, Iterations= %1, Precision abs/rel=%2/%3...")
                                .arg(MAX_ITERATIONS).arg(INEPSABS).arg(INEPSREL);
 
     // Fill in the data to which the curve will be fitted
-    dataPoints.useWeights = useWeights;
-    for (int i = 0; i < data_x.size(); i++)
-        dataPoints.push_back(data_x[i], data_y[i], (useWeights && data_sigma[i] > 1e-8) ? data_sigma[i] : 1.0);
+    setDataPoints(data_x, data_y, data_sigma, useWeights);
 
     // Set the gsl error handler off as it aborts the program on error.
     gsl_set_error_handler_off();
 
+    // Create (or reuse) a Levenberg-Marquardt solver with n data points and 3 parameters
+    if (m_Workspace.lmSolver(data_x.size(), NUM_PARABOLA_PARAMS) == nullptr)
+    {
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Parabola): Cannot fit %1 datapoints").arg(data_x.size());
+        return QVector<double>();
+    }
+
+    // Make initial guesses, either from the previous solution or from the datapoints
+    parMakeGuess(data_x, data_y, m_Workspace.lmGuess());
+
     // Fill in function info
     gsl_multifit_function_fdf f;
     f.f      = parFx;
@@ -538,60 +751,13 @@ QVector<double> CurveFitting::parabola_fit(const QVector<double> data_x, const Q
     f.fdf    = parFJx;
     f.n      = data_x.size();
     f.p      = NUM_PARABOLA_PARAMS;
-    f.params = &dataPoints;
-
-    // Allocate the guess vector
-    gsl_vector * guess = gsl_vector_alloc(NUM_PARABOLA_PARAMS);
-    // Make initial guesses - here we just set all parameters to 1.0
-    parMakeGuess(data_x, data_y, guess);
-    // Create a Levenberg-Marquardt solver with n data points and 4 parameters
-    gsl_multifit_fdfsolver * solver = gsl_multifit_fdfsolver_alloc(gsl_multifit_fdfsolver_lmsder, data_x.size(),
-                                      NUM_PARABOLA_PARAMS);
-    gsl_multifit_fdfsolver_set(solver, & f, guess);  // Initialize the solver
-
-    int status, i = 0;
-
-    // Iterate to find a result
-    do
-    {
-        i++;
-        // Iterate through the solver. Function returns GSL_SUCCESS = 0 on success
-        status = gsl_multifit_fdfsolver_iterate(solver);
-
-        //qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Parabola): Iteration %1 status=%2 [%3] f=%4")
-        //                           .arg(i).arg(status).arg(gsl_strerror(status)).arg(gsl_blas_dnrm2(solver->f));
-        if (status)
-            break;
+    f.params = &m_DataPoints;
 
-        status = gsl_multifit_test_delta(solver->dx, solver->x, INEPSABS, INEPSREL);
-    }
-    while (status == GSL_CONTINUE && i < MAX_ITERATIONS);
-
-    if (status != 0)
-        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Parabola): Failed with status=%1 [%2] after %3/%4 iterations")
-                                   .arg(status).arg(gsl_strerror(status)).arg(i).arg(MAX_ITERATIONS);
-    else if (i == MAX_ITERATIONS)
-        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM solver (Parabola): Failed to converge after %1 iterations").arg(i);
-    else
-    {
-        // All good so store the results - parameters A, B, C and D
-        for (int j = 0; j < NUM_PARABOLA_PARAMS; j++)
-        {
-            vc.push_back(gsl_vector_get(solver->x, j));
-        }
-        qCDebug(KSTARS_EKOS_FOCUS) << QString("LM Solver (Parabola): Solution found after %1 iterations. A=%2 B=%3, C=%4")
-                                   .arg(i).arg(vc[A_IDX]).arg(vc[B_IDX]).arg(vc[C_IDX]);
-    }
-
-    // Free GSL memory
-    gsl_multifit_fdfsolver_free(solver);
-    gsl_vector_free(guess);
-
-    return vc;
+    return lmFit(&f, "Parabola");
 }
 
 // Initialise parameters before starting the solver
-void CurveFitting::parMakeGuess(const QVector<double> inX, const QVector<double> inY, gsl_vector * guess)
+void CurveFitting::parMakeGuess(const QVector<double> &inX, const QVector<double> &inY, gsl_vector * guess)
 {
     if (inX.size() < 1)
         return;
@@ -818,7 +984,7 @@ double CurveFitting::calculateR2(CurveFit curveFit)
 }
 
 // Do the maths to calculate R2 - how well the curve fits the datapoints
-double CurveFitting::calcR2(QVector<double> dataPoints, QVector<double> curvePoints)
+double CurveFitting::calcR2(const QVector<double> &dataPoints, const QVector<double> &curvePoints)
 {
     double R2 = 0.0, chisq = 0.0, sum = 0.0, totalSumSquares = 0.0, average;
     int i;
@@ -827,13 +993,15 @@ double CurveFitting::calcR2(QVector<double> dataPoints, QVector<double> curvePoi
     for (i = 0; i < dataPoints.size(); i++)
     {
         sum += dataPoints[i];
-        chisq += pow((dataPoints[i] - curvePoints[i]), 2.0);
+        const double residual = dataPoints[i] - curvePoints[i];
+        chisq += residual * residual;
     }
     average = sum / dataPoints.size();
 
     for (i = 0; i < dataPoints.size(); i++)
     {
-        totalSumSquares += pow((dataPoints[i] - average), 2.0);
+        const double deviation = dataPoints[i] - average;
+        totalSumSquares += deviation * deviation;
     }
 
     if (totalSumSquares > 0.0)
@@ -55,9 +55,11 @@ class CurveFitting
         // fitCurve takes in the vectors with the position, hfr and sigma (standard deviation in HFR) values
         // along with the type of curve to use and whether or not to sigmas in the calculation
         // It fits the curve and solves for the coefficients.
+        // If robust is set, the hyperbola and parabola fits are refined by iteratively reweighting the
+        // datapoints so that outliers have less influence on the solution. See robustRefit().
         void fitCurve(const QVector<int> &position, const QVector<double> &hfr, const QVector<double> &sigma,
                       const CurveFit curveFit,
-                      const bool useWeights);
+                      const bool useWeights, const bool robust = false);
 
         // Returns the minimum position and value in the pointers for the solved curve.
         // Returns false if the curve couldn't be solved.
@@ -68,31 +70,103 @@ class CurveFitting
         double calculateR2(CurveFit curveFit);
 
     private:
+        // The GSL solvers, vectors and matrices used by the fits. They are kept between fits and only
+        // reallocated when the number of datapoints or parameters changes, so repeated fits of the same
+        // size (e.g. refitting the curve of every star) don't touch the heap.
+        // Copying a CurveFitting object does not share the workspace, the copy allocates its own on demand.
+        class Workspace
+        {
+            public:
+                Workspace() = default;
+                Workspace(const Workspace &) {}
+                Workspace &operator=(const Workspace &)
+                {
+                    return *this;
+                }
+                ~Workspace();
+
+                // LM solver for n datapoints and p parameters, and the vector for the initial guess.
+                gsl_multifit_fdfsolver *lmSolver(size_t n, size_t p);
+                gsl_vector *lmGuess()
+                {
+                    return m_Guess;
+                }
+
+                // Linear least squares workspace and its design matrix, observation, solution and covariance.
+                bool linear(size_t n, size_t p);
+                gsl_multifit_linear_workspace *linearWork()
+                {
+                    return m_LinearWork;
+                }
+                gsl_matrix *linearX()
+                {
+                    return m_LinearX;
+                }
+                gsl_vector *linearY()
+                {
+                    return m_LinearY;
+                }
+                gsl_vector *linearC()
+                {
+                    return m_LinearC;
+                }
+                gsl_matrix *linearCov()
+                {
+                    return m_LinearCov;
+                }
+
+            private:
+                void freeLM();
+                void freeLinear();
+
+                gsl_multifit_fdfsolver *m_Solver { nullptr };
+                gsl_vector *m_Guess { nullptr };
+                size_t m_SolverN { 0 }, m_SolverP { 0 };
+
+                gsl_multifit_linear_workspace *m_LinearWork { nullptr };
+                gsl_matrix *m_LinearX { nullptr };
+                gsl_vector *m_LinearY { nullptr };
+                gsl_vector *m_LinearC { nullptr };
+                gsl_matrix *m_LinearCov { nullptr };
+                size_t m_LinearN { 0 }, m_LinearP { 0 };
+        };
+
         // TODO: This function will likely go when Linear and L1P merge to be closer.
         // Calculates the value of the polynomial at x. Params will be cast to a CurveFit*.
         static double curveFunction(double x, void *params);
 
         // TODO: This function will likely go when Linear and L1P merge to be closer.
         QVector<double> polynomial_fit(const double *const data_x, const double *const data_y, const int n, const int order);
-        QVector<double> hyperbola_fit(const QVector<double> data_x, const QVector<double> data_y, const QVector<double> data_sigma,
-                                      bool useWeights);
-        QVector<double> parabola_fit(const QVector<double> data_x, const QVector<double> data_y, const QVector<double> data_sigma,
-                                     bool useWeights);
+        QVector<double> hyperbola_fit(const QVector<double> &data_x, const QVector<double> &data_y,
+                                      const QVector<double> &data_sigma, bool useWeights);
+        QVector<double> parabola_fit(const QVector<double> &data_x, const QVector<double> &data_y,
+                                     const QVector<double> &data_sigma, bool useWeights);
+        // Runs the LM solver on the function f, which has been set up by hyperbola_fit or parabola_fit.
+        QVector<double> lmFit(gsl_multifit_function_fdf *f, const QString &curveName);
+        // Loads m_DataPoints, the data passed to the GSL LM routines, applying the robust weights if any.
+        void setDataPoints(const QVector<double> &data_x, const QVector<double> &data_y, const QVector<double> &data_sigma,
+                           bool useWeights);
+        // Iteratively reweighted least squares refinement of the last hyperbola or parabola fit.
+        void robustRefit(bool useWeights);
 
         bool minimumQuadratic(double expected, double minPosition, double maxPosition, double *position, double *value);
         bool minimumHyperbola(double expected, double minPosition, double maxPosition, double *position, double *value);
         bool minimumParabola(double expected, double minPosition, double maxPosition, double *position, double *value);
 
-        void hypMakeGuess(const QVector<double> inX, const QVector<double> inY, gsl_vector * guess);
-        void parMakeGuess(const QVector<double> inX, const QVector<double> inY, gsl_vector * guess);
+        void hypMakeGuess(const QVector<double> &inX, const QVector<double> &inY, gsl_vector * guess);
+        void parMakeGuess(const QVector<double> &inX, const QVector<double> &inY, gsl_vector * guess);
 
         // Calculation engine for the R-squared which is a measure of how well the curve fits the datapoints
-        double calcR2(QVector<double> dataPoints, QVector<double> curvePoints);
+        double calcR2(const QVector<double> &dataPoints, const QVector<double> &curvePoints);
 
         // Type of curve
         CurveFit m_CurveType;
         // The data values.
         QVector<double> m_x, m_y, m_sigma;
+        // Weights applied on top of the sigmas by the robust fit, empty when not fitting robustly.
+        QVector<double> m_RobustWeights;
+        // The datapoints in the form used by the LM solver. Kept as a member to reuse its storage.
+        DataPointT m_DataPoints;
         // The solved parameters.
         QVector<double> m_coefficients;
         // State variables used by the LM solver. These variables provide a way of optimising the starting
@@ -101,6 +175,7 @@ class CurveFitting
         bool firstSolverRun;
         CurveFit lastCurveType;
         QVector<double> lastCoefficients;
+        Workspace m_Workspace;
 };
 
 } //namespace
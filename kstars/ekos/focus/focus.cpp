@@ -1000,6 +1000,7 @@ void Focus::start()
                                << " Frames: " << 1 /*focusFramesCount->value()*/ << " Maximum Travel: " << focusMaxTravel->value()
                                << " Curve Fit: " << focusCurveFit->currentText()
                                << " Use Weights: " << ( focusUseWeights->isChecked() ? "yes" : "no" )
+                               << " Robust Fit: " << ( focusRobustFit->isChecked() ? "yes" : "no" )
                                << " R2 Limit: " << focusR2Limit->value();
 
     if (currentTemperatureSourceElement)
@@ -1043,7 +1044,8 @@ void Focus::start()
             MAXIMUM_ABS_ITERATIONS, focusTolerance->value() / 100.0, filter(),
             currentTemperatureSourceElement ? currentTemperatureSourceElement->value : INVALID_VALUE,
             focusOutStepsValue,
-            m_FocusAlgorithm, focusBacklash->value(), m_CurveFit, focusUseWeights->isChecked());
+            m_FocusAlgorithm, focusBacklash->value(), m_CurveFit, focusUseWeights->isChecked(),
+            focusRobustFit->isChecked());
         if (canAbsMove)
             initialFocuserAbsPosition = position;
         linearFocuser.reset(MakeLinearFocuser(params));
@@ -1144,6 +1146,7 @@ void Focus::stop(Ekos::FocusState completionState)
     m_FocusMotionTimer.stop();
     m_FocusMotionTimerCounter = 0;
     m_FocuserReconnectCounter = 0;
+    resetPipeline();
 
     opticalTrainCombo->setEnabled(true);
     inAutoFocus     = false;
@@ -1532,6 +1535,18 @@ void Focus::processData(const QSharedPointer<FITSData> &data)
     if (data->property("chip").toInt() == ISD::CameraChip::GUIDE_CCD)
         return;
 
+    // Pipelined autofocus: the next frame arrived before the HFR of the previous frame was computed.
+    // Hold on to it until the linear algorithm has consumed that HFR, see completePipelinedMove().
+    if (m_PipelineFramePosition >= 0 && hfrInProgress)
+    {
+        captureTimeout.stop();
+        captureTimeoutCounter = 0;
+        disconnect(m_Camera, &ISD::Camera::newImage, this, &Ekos::Focus::processData);
+        disconnect(m_Camera, &ISD::Camera::error, this, &Ekos::Focus::processCaptureError);
+        m_PipelineQueuedData = data;
+        return;
+    }
+
     if (data)
     {
         m_FocusView->loadData(data);
@@ -1888,7 +1903,7 @@ void Focus::setCurrentHFR(double value)
 
     // Let signal the current HFR now depending on whether the focuser is absolute or relative
     if (canAbsMove)
-        emit newHFR(currentHFR, currentPosition);
+        emit newHFR(currentHFR, framePosition());
     else
         emit newHFR(currentHFR, -1);
 
@@ -1997,6 +2012,10 @@ void Focus::setCaptureComplete()
     // Emit the tracking (bounding) box view. Used in Summary View
     emit newStarPixmap(m_FocusView->getTrackingBoxPixmap(10));
 
+    // In pipelined autofocus, move on to the next position while this frame is analyzed.
+    if (inAutoFocus && inFocusLoop == false)
+        startPipelinedMove();
+
     // If we are not looping; OR
     // If we are looping but we already have tracking box enabled; OR
     // If we are asked to analyze _all_ the stars within the field
@@ -2288,6 +2307,9 @@ bool Focus::autoFocusChecks()
         return false;
     }
 
+    // Kept, as resetPipeline() forgets it
+    const int position = framePosition();
+
     // No stars detected, try to capture again
     if (currentHFR == FocusAlgorithmInterface::IGNORED_HFR)
     {
@@ -2295,7 +2317,17 @@ bool Focus::autoFocusChecks()
         {
             noStarCount++;
             appendLogText(i18n("No stars detected, capturing again..."));
-            capture();
+            if (m_PipelineFramePosition >= 0)
+            {
+                // The retried frame must be taken where this one was, not at the predicted position.
+                qCDebug(KSTARS_EKOS_FOCUS) << QString("Pipelined: no stars at %1, moving back from %2 to capture again")
+                                           .arg(position).arg(currentPosition);
+                resetPipeline();
+                if (!changeFocus(position - currentPosition))
+                    completeFocusProcedure(Ekos::FOCUS_ABORTED, false);
+            }
+            else
+                capture();
             return false;
         }
         else if (m_FocusAlgorithm == FOCUS_LINEAR)
@@ -2303,7 +2335,7 @@ bool Focus::autoFocusChecks()
             // JEE TODO: Linear currently continues if there are no stars
             // For L1P I think its better to Abort and give control back either to the user or the scheduler
             // This needs to be revisited to find the best way of dealing with this scenario.
-            appendLogText(i18n("Failed to detect any stars at position %1. Continuing...", currentPosition));
+            appendLogText(i18n("Failed to detect any stars at position %1. Continuing...", position));
             noStarCount = 0;
         }
         else
@@ -2413,7 +2445,8 @@ void Focus::plotLinearFocus()
         }
         else // Linear 1 Pass
         {
-            curveFitting->fitCurve(pass1Positions, pass1HFRs, pass1Sigmas, params.curveFit, params.useWeights);
+            curveFitting->fitCurve(pass1Positions, pass1HFRs, pass1Sigmas, params.curveFit, params.useWeights,
+                                   params.robustFit);
 
             if (curveFitting->findMin(params.startPosition, searchMin, searchMax, &minPosition, &minValue, params.curveFit))
             {
@@ -2465,14 +2498,14 @@ void Focus::autoFocusLinear()
         }
     }
 
-    addPlotPosition(currentPosition, currentHFR, false);
+    addPlotPosition(framePosition(), currentHFR, false);
 
     // Only use the relativeHFR algorithm if full field is enabled with one capture/measurement.
     bool useFocusStarsHFR = focusUseFullField->isChecked() && focusFramesCount->value() == 1;
     auto focusStars = useFocusStarsHFR || (m_FocusAlgorithm == FOCUS_LINEAR1PASS) ? &(m_ImageData->getStarCenters()) : nullptr;
     int nextPosition;
 
-    linearRequestedPosition = linearFocuser->newMeasurement(currentPosition, currentHFR, focusStars);
+    linearRequestedPosition = linearFocuser->newMeasurement(framePosition(), currentHFR, focusStars);
     if (m_FocusAlgorithm == FOCUS_LINEAR1PASS && linearFocuser->isDone())
         // Linear 1 Pass is done, graph is drawn, so just move to the focus position, and update the graph title.
         plotLinearFinalUpdates();
@@ -2480,10 +2513,11 @@ void Focus::autoFocusLinear()
         // Update the graph with the next datapoint, draw the curve, etc.
         plotLinearFocus();
 
-    nextPosition = adjustLinearPosition(currentPosition, linearRequestedPosition, focusAFOverscan->value());
+    nextPosition = adjustLinearPosition(framePosition(), linearRequestedPosition, focusAFOverscan->value());
 
     if (linearFocuser->isDone())
     {
+        resetPipeline();
         if (linearFocuser->solution() != -1)
         {
             // Now test that the curve fit was acceptable. If not retry the focus process using standard retry process
@@ -2521,6 +2555,11 @@ void Focus::autoFocusLinear()
         }
         return;
     }
+    else if (m_PipelineFramePosition >= 0)
+    {
+        completePipelinedMove(nextPosition);
+        return;
+    }
     else
     {
         const int delta = nextPosition - currentPosition;
@@ -2532,6 +2571,89 @@ void Focus::autoFocusLinear()
     }
 }
 
+bool Focus::startPipelinedMove()
+{
+    if (focusPipelined->isChecked() == false || !linearFocuser || !canAbsMove || minimumRequiredHFR >= 0)
+        return false;
+
+    if (m_FocusAlgorithm != FOCUS_LINEAR && m_FocusAlgorithm != FOCUS_LINEAR1PASS)
+        return false;
+
+    // Stacked frames, and frames used to select the focus star, need their HFR before deciding what to do next.
+    if (focusFramesCount->value() != 1 || (focusUseFullField->isChecked() == false && starCenter.isNull()))
+        return false;
+
+    // Still undoing the backlash overscan.
+    if (focuserAdditionalMovement > 0)
+        return false;
+
+    const int position = linearFocuser->predictedPosition();
+    if (position < 0 || abs(position - currentPosition) <= 1)
+        return false;
+
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Pipelined: analyzing frame at %1 while moving to %2")
+                               .arg(currentPosition).arg(position);
+
+    m_PipelineFramePosition = currentPosition;
+    m_PipelinePredictedPosition = position;
+    if (!changeFocus(position - currentPosition))
+    {
+        m_PipelineFramePosition = m_PipelinePredictedPosition = -1;
+        return false;
+    }
+    return true;
+}
+
+void Focus::completePipelinedMove(int nextPosition)
+{
+    if (nextPosition == m_PipelinePredictedPosition)
+    {
+        // The prediction was right. The focuser is at, or on its way to, the next position and the
+        // next exposure has been, or will be, started when it gets there.
+        QSharedPointer<FITSData> queuedData = m_PipelineQueuedData;
+        m_PipelineFramePosition = m_PipelinePredictedPosition = -1;
+        m_PipelineQueuedData.reset();
+
+        // If that exposure was already received, process it now. This is queued as we may still be
+        // in the star detection completion handler of the previous frame.
+        if (queuedData)
+            QTimer::singleShot(0, this, [this, queuedData]()
+        {
+            processData(queuedData);
+        });
+        return;
+    }
+
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Pipelined: expected %1 but algorithm requested %2, discarding the frame at %1")
+                               .arg(m_PipelinePredictedPosition).arg(nextPosition);
+
+    resetPipeline();
+
+    if (!changeFocus(nextPosition - currentPosition))
+        completeFocusProcedure(Ekos::FOCUS_ABORTED, false);
+}
+
+void Focus::resetPipeline()
+{
+    const bool pipelining = m_PipelineFramePosition >= 0;
+    m_PipelineFramePosition = m_PipelinePredictedPosition = -1;
+    if (!pipelining)
+        return;
+
+    // Discard the speculative exposure, or the frame it already produced.
+    captureTimer.stop();
+    if (m_PipelineQueuedData)
+        m_PipelineQueuedData.reset();
+    else if (captureInProgress && m_Camera)
+    {
+        captureTimeout.stop();
+        disconnect(m_Camera, &ISD::Camera::newImage, this, &Ekos::Focus::processData);
+        disconnect(m_Camera, &ISD::Camera::error, this, &Ekos::Focus::processCaptureError);
+        m_Camera->getChip(ISD::CameraChip::PRIMARY_CCD)->abortExposure();
+    }
+    captureInProgress = false;
+}
+
 void Focus::autoFocusAbs()
 {
     // Q_ASSERT_X(canAbsMove || canRelMove, __FUNCTION__, "Prerequisite: only absolute and relative focusers");
@@ -4471,18 +4593,22 @@ void Focus::setCurveFit(CurveFitting::CurveFit curve)
         case CurveFitting::FOCUS_QUADRATIC:
             focusUseWeights->setEnabled(false);             // Use weights not allowed
             focusUseWeights->setChecked(false);
+            focusRobustFit->setEnabled(false);              // Robust fit not allowed
+            focusRobustFit->setChecked(false);
             focusR2Limit->setEnabled(false);                // focusR2Limit not allowed
             break;
 
         case CurveFitting::FOCUS_HYPERBOLA:
             focusUseWeights->setEnabled(
                 focusUseFullField->isChecked());    // Only use weights on multi-stars with analysis (=FullField)
+            focusRobustFit->setEnabled(true);                          // Robust fit allowed
             focusR2Limit->setEnabled(true);                            // focusR2Limit allowed
             break;
 
         case CurveFitting::FOCUS_PARABOLA:
             focusUseWeights->setEnabled(
                 focusUseFullField->isChecked());    // Only use weights on multi-stars with analysis (=FullField)
+            focusRobustFit->setEnabled(true);                          // Robust fit allowed
             focusR2Limit->setEnabled(true);                            // focusR2Limit allowed
             break;
     }
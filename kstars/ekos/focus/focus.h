@@ -648,6 +648,22 @@ class Focus : public QWidget, public Ui::Focus
         // to reduce backlash on such movement changes and so that we've always focused in before capture.
         int adjustLinearPosition(int position, int newPosition, int overscan);
 
+        // Pipelined autofocus. When the frame is received, move the focuser to the position the linear
+        // algorithm is expected to request next so that the next exposure starts while the HFR is computed.
+        // Returns true if the speculative move was started.
+        bool startPipelinedMove();
+        // Called once the linear algorithm requested nextPosition for the pipelined frame. Keeps the speculative
+        // move and exposure if the prediction was right, otherwise discards them and moves to nextPosition.
+        void completePipelinedMove(int nextPosition);
+        // Aborts a speculative exposure and drops any frame received for it.
+        void resetPipeline();
+        // Position at which the frame being analyzed was captured. In pipelined autofocus the focuser may
+        // already have moved on from it.
+        int framePosition() const
+        {
+            return m_PipelineFramePosition >= 0 ? m_PipelineFramePosition : currentPosition;
+        }
+
         /**
          * @brief syncTrackingBoxPosition Sync the tracking box to the current selected star center
          */
@@ -900,6 +916,13 @@ class Focus : public QWidget, public Ui::Focus
         int focuserAdditionalMovement { 0 };
         int linearRequestedPosition { 0 };
 
+        // Pipelined autofocus state. Position at which the frame being analyzed was captured, -1 if not pipelining.
+        int m_PipelineFramePosition { -1 };
+        // Position the focuser was sent to before the analysis of that frame completed.
+        int m_PipelinePredictedPosition { -1 };
+        // The next frame, if it was received before the analysis of the previous one completed.
+        QSharedPointer<FITSData> m_PipelineQueuedData;
+
         bool hasDeviation { false };
 
         //double observatoryTemperature { INVALID_VALUE };
@@ -48,6 +48,16 @@ class LinearFocusAlgorithm : public FocusAlgorithmInterface
         int newMeasurement(int position, double value,
                            const QList<Edge*> *stars) override;
 
+        // In the first pass the focuser steps inward by stepSize, unless the curve fit
+        // finds the minimum or decides to skip samples.
+        int predictedPosition() const override
+        {
+            if (done || !inFirstPass || solutionPending)
+                return -1;
+            const int position = requestedPosition - stepSize;
+            return position < minPositionLimit ? -1 : position;
+        }
+
         FocusAlgorithmInterface *Copy() override;
 
         void getMeasurements(QVector<int> *pos, QVector<double> *hfrs, QVector<double> *sds) const override
@@ -504,7 +514,7 @@ int LinearFocusAlgorithm::newMeasurement(int position, double value, const QList
             }
             else // Hyperbola or Parabola so use the LM solver
             {
-                curveFit.fitCurve(positions, values, sigmas, params.curveFit, params.useWeights);
+                curveFit.fitCurve(positions, values, sigmas, params.curveFit, params.useWeights, params.robustFit);
                 foundFit = curveFit.findMin(position, 0, params.maxPositionAllowed, &minPos, &minVal,
                                             static_cast<CurveFitting::CurveFit>(params.curveFit));
             }
@@ -61,19 +61,21 @@ class FocusAlgorithmInterface
             CurveFitting::CurveFit curveFit;
             // Whether we want to use weightings of datapoints in the curve fitting process
             bool useWeights;
+            // Whether outliers are down-weighted when fitting a hyperbola or parabola
+            bool robustFit;
 
             FocusParams(int _maxTravel, int _initialStepSize, int _startPosition,
                         int _minPositionAllowed, int _maxPositionAllowed,
                         int _maxIterations, double _focusTolerance, const QString &filterName_,
                         double _temperature, double _initialOutwardSteps, Focus::Algorithm _focusAlgorithm,
-                        int _backlash, CurveFitting::CurveFit _curveFit, bool _useWeights) :
+                        int _backlash, CurveFitting::CurveFit _curveFit, bool _useWeights, bool _robustFit) :
                 maxTravel(_maxTravel), initialStepSize(_initialStepSize),
                 startPosition(_startPosition), minPositionAllowed(_minPositionAllowed),
                 maxPositionAllowed(_maxPositionAllowed), maxIterations(_maxIterations),
                 focusTolerance(_focusTolerance), filterName(filterName_),
                 temperature(_temperature), initialOutwardSteps(_initialOutwardSteps),
                 focusAlgorithm(_focusAlgorithm), backlash(_backlash), curveFit(_curveFit),
-                useWeights(_useWeights) {}
+                useWeights(_useWeights), robustFit(_robustFit) {}
         };
 
         // Constructor initializes an autofocus algorithm from the input params.
@@ -90,6 +92,14 @@ class FocusAlgorithmInterface
         // If stars is not nullptr, then the they may be used to modify the HFR value.
         virtual int newMeasurement(int position, double value, const QList<Edge*> *stars = nullptr) = 0;
 
+        // Returns the position the algorithm is most likely to request after the measurement
+        // at the last requested position, or -1 if it can't be predicted. Used to move the focuser
+        // before that measurement is complete.
+        virtual int predictedPosition() const
+        {
+            return -1;
+        }
+
         // Returns true if the algorithm has terminated either successfully or in error.
         bool isDone() const
         {
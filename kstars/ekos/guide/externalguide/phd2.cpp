@@ -508,9 +508,7 @@ void PHD2::processPHD2Event(const QJsonObject &jsonEvent, const QByteArray &line
 
             if (std::isfinite(diff_ra_arcsecs) && std::isfinite(diff_de_arcsecs))
             {
-                errorLog.append(QPointF(diff_ra_arcsecs, diff_de_arcsecs));
-                if(errorLog.size() > 50)
-                    errorLog.remove(0);
+                errorLog.newSample(diff_ra_arcsecs, diff_de_arcsecs);
 
                 emit newAxisDelta(diff_ra_arcsecs, diff_de_arcsecs);
                 emit newAxisPulse(pulse_ra, pulse_dec);
@@ -519,16 +517,7 @@ void PHD2::processPHD2Event(const QJsonObject &jsonEvent, const QByteArray &line
                 emit guideStats(diff_ra_arcsecs, diff_de_arcsecs, pulse_ra, pulse_dec,
                                 std::isfinite(snr) ? snr : 0, 0, 0);
 
-                double total_sqr_RA_error = 0.0;
-                double total_sqr_DE_error = 0.0;
-
-                for (auto &point : errorLog)
-                {
-                    total_sqr_RA_error += point.x() * point.x();
-                    total_sqr_DE_error += point.y() * point.y();
-                }
-
-                emit newAxisSigma(sqrt(total_sqr_RA_error / errorLog.size()), sqrt(total_sqr_DE_error / errorLog.size()));
+                emit newAxisSigma(errorLog.rmsX(), errorLog.rmsY());
 
             }
             //Note that if it is receiving full size remote images, it should not get the guide star image.
@@ -1318,7 +1307,7 @@ bool PHD2::guide()
     // Recalibrate param
     args << false;
 
-    errorLog.clear();
+    errorLog.reset();
 
     isSettling = true;
     sendPHD2Request("guide", args);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "../guideinterface.h"
+#include "ekos/auxiliary/rmsfilter.h"
 #include "fitsviewer/fitsview.h"
 
 #include <QAbstractSocket>
@@ -227,7 +228,8 @@ class PHD2 : public GuideInterface
     private:
         QSharedPointer<FITSView> m_GuideFrame;
 
-        QVector<QPointF> errorLog;
+        // RMS of the last 50 guide errors
+        Ekos::SlidingRms errorLog { 50 };
 
         void sendPHD2Request(const QString &method, const QJsonArray &args = QJsonArray());
         void sendRpcCall(QJsonObject &call, PHD2ResultType resultType);
@@ -38,6 +38,8 @@
 
 #include "ui_manualdither.h"
 
+#include <QtConcurrent>
+
 #include <random>
 
 #define CAPTURE_TIMEOUT_THRESHOLD 30000
@@ -187,6 +189,19 @@ Guide::Guide() : QWidget()
         setCaptureComplete();
     });
 
+    connect(&m_DeferredStatsWatcher, &QFutureWatcher<void>::finished, this, [this]()
+    {
+        // Drop the update if a newer frame was received in the meantime.
+        if (m_DeferredImageData.isNull() || m_DeferredImageData != m_ImageData)
+            return;
+
+        m_GuideView->loadData(m_DeferredImageData);
+        m_DeferredImageData.reset();
+
+        emit newImage(m_GuideView);
+        emit newStarPixmap(m_GuideView->getTrackingBoxPixmap(10));
+    });
+
     loadGlobalSettings();
     connectSettings();
 
@@ -282,8 +297,8 @@ void Guide::guideHistory()
 {
     int sliderValue = guideSlider->value();
     latestCheck->setChecked(sliderValue == guideSlider->maximum() - 1 || sliderValue == guideSlider->maximum());
-    double ra = driftGraph->graph(GuideGraph::G_RA)->dataMainValue(sliderValue); //Get RA from RA data
-    double de = driftGraph->graph(GuideGraph::G_DEC)->dataMainValue(sliderValue); //Get DEC from DEC data
+    double ra = driftGraph->sampleValue(GuideGraph::G_RA, sliderValue); //Get RA from RA data
+    double de = driftGraph->sampleValue(GuideGraph::G_DEC, sliderValue); //Get DEC from DEC data
     driftGraph->guideHistory(sliderValue, graphOnLatestPt);
 
     targetPlot->showPoint(ra, de);
@@ -769,6 +784,9 @@ bool Guide::captureOneFrame()
     // Timeout is exposure duration + timeout threshold in seconds
     captureTimeout.start(finalExposure * 1000 + CAPTURE_TIMEOUT_THRESHOLD);
 
+    if (guiderType == GUIDE_INTERNAL)
+        internalGuider->startLatencyFrame(finalExposure);
+
     targetChip->capture(finalExposure);
 
     return true;
@@ -977,9 +995,21 @@ void Guide::processData(const QSharedPointer<FITSData> &data)
         return;
     }
 
+    // Low latency guiding only applies while guiding with the internal guider and one of the
+    // algorithms working exclusively on the tracking box. Otherwise, catch up on the statistics now.
+    m_DeferGuideView = false;
+    if (data && data->hasDeferredStats())
+    {
+        m_DeferGuideView = m_State == GUIDE_GUIDING && guiderType == GUIDE_INTERNAL && operationStack.isEmpty() &&
+                           !internalGuider->SEPMultiStarEnabled() && Options::guideAlgorithm() != SEP_THRESHOLD;
+        if (!m_DeferGuideView)
+            data->calculateStats();
+    }
+
     if (data)
     {
-        m_GuideView->loadData(data);
+        if (!m_DeferGuideView)
+            m_GuideView->loadData(data);
         m_ImageData = data;
     }
     else
@@ -1099,10 +1129,30 @@ void Guide::setCaptureComplete()
             break;
     }
 
+    if (m_DeferGuideView)
+    {
+        m_DeferGuideView = false;
+        updateDeferredGuideView();
+        return;
+    }
+
     emit newImage(m_GuideView);
     emit newStarPixmap(m_GuideView->getTrackingBoxPixmap(10));
 }
 
+void Guide::updateDeferredGuideView()
+{
+    if (m_ImageData.isNull())
+        return;
+
+    m_DeferredImageData = m_ImageData;
+    QSharedPointer<FITSData> data = m_ImageData;
+    m_DeferredStatsWatcher.setFuture(QtConcurrent::run([data]()
+    {
+        data->calculateStats();
+    }));
+}
+
 void Guide::appendLogText(const QString &text)
 {
     m_LogText.insert(0, i18nc("log entry; %1 is the date, %2 is the text", "%1 %2",
@@ -1804,6 +1854,7 @@ bool Guide::setGuiderType(int type)
             connect(internalGuider, &InternalGuider::newSinglePulse, this, &Guide::sendSinglePulse);
             connect(internalGuider, &InternalGuider::DESwapChanged, this, &Guide::setDECSwap);
             connect(internalGuider, &InternalGuider::newStarPixmap, this, &Guide::newStarPixmap);
+            connect(internalGuider, &InternalGuider::newLatency, this, &Guide::setLatency);
 
             m_GuiderInstance = internalGuider;
 
@@ -2065,7 +2116,7 @@ void Guide::setAxisDelta(double ra, double de)
 
     ra = -ra;  //The ra is backwards in sign from how it should be displayed on the graph.
 
-    int currentNumPoints = driftGraph->graph(GuideGraph::G_RA)->dataCount();
+    int currentNumPoints = driftGraph->sampleCount();
     guideSlider->setMaximum(currentNumPoints);
     if(graphOnLatestPt)
     {
@@ -2143,6 +2194,21 @@ void Guide::setSNR(double snr)
     l_SNR->setText(QString::number(snr, 'f', 1));
 }
 
+void Guide::setLatency(const QList<double> &stageDurations)
+{
+    const GuideLatency &latency = internalGuider->latency();
+    l_Latency->setText(QString("%1 / %2").arg(QString::number(latency.lastDuration(GuideLatency::TOTAL), 'f', 0))
+                       .arg(QString::number(latency.histogram(GuideLatency::TOTAL).percentile(0.5), 'f', 0)));
+    l_Latency->setToolTip(QString("<pre>%1</pre>").arg(latency.summary().toHtmlEscaped()));
+
+    emit guideLatency(stageDurations);
+}
+
+QVariantMap Guide::latencyStatistics()
+{
+    return internalGuider->latency().statistics();
+}
+
 void Guide::buildOperationStack(GuideState operation)
 {
     operationStack.clear();
@@ -2445,6 +2511,11 @@ void Guide::showFITSViewer()
     static int lastFVTabID = -1;
     if (m_ImageData)
     {
+        // Low latency guiding may still be calculating the statistics of this frame.
+        m_DeferredStatsWatcher.waitForFinished();
+        if (m_ImageData->hasDeferredStats())
+            m_ImageData->calculateStats();
+
         QUrl url = QUrl::fromLocalFile("guide.fits");
         if (fv.isNull())
         {
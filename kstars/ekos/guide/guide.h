@@ -14,6 +14,7 @@
 #include "indi/indimount.h"
 #include "ekos/auxiliary/darkprocessor.h"
 
+#include <QFutureWatcher>
 #include <QTime>
 #include <QTimer>
 #include <QtDBus>
@@ -297,6 +298,14 @@ class Guide : public QWidget, public Ui::Guide
          */
         Q_SCRIPTABLE QList<double> axisSigma();
 
+        /** DBUS interface function.
+         * @brief latencyStatistics returns rolling statistics of the internal guider cycle latency.
+         * @return Map of stage name (Download, Load, Dispatch, Detection, Drift, Pulse, Total) to a map of
+         * count, last, mean, median, p90 and max in milliseconds, plus the histogram bins. The upper bin edges
+         * in milliseconds are under binEdges.
+         */
+        Q_SCRIPTABLE QVariantMap latencyStatistics();
+
         /**
               * @brief checkCamera Check all CCD parameters and ensure all variables are updated to reflect the selected CCD
               * @param ccdNum CCD index number in the CCD selection combo box
@@ -415,6 +424,7 @@ class Guide : public QWidget, public Ui::Guide
         void setAxisSigma(double ra, double de);
         void setAxisPulse(double ra, double de);
         void setSNR(double snr);
+        void setLatency(const QList<double> &stageDurations);
         void calibrationUpdate(GuideInterface::CalibrationUpdateType type, const QString &message = QString(""), double dx = 0,
                                double dy = 0);
 
@@ -447,6 +457,8 @@ class Guide : public QWidget, public Ui::Guide
 
         void guideStats(double raError, double decError, int raPulse, int decPulse,
                         double snr, double skyBg, int numStars);
+        // Internal guider cycle latency in milliseconds, indexed by GuideLatency::Stage.
+        void guideLatency(const QList<double> &stageDurations);
 
         void guideChipUpdated(ISD::CameraChip *);
         void settingsUpdated(const QVariantMap &settings);
@@ -471,6 +483,12 @@ class Guide : public QWidget, public Ui::Guide
              */
         void syncTrackingBoxPosition();   
 
+        /**
+         * @brief updateDeferredGuideView In low latency guiding, calculate the statistics of the
+         * current guide frame in the background and load it into the guide view once done.
+         */
+        void updateDeferredGuideView();
+
         /**
              * @brief setBusy Indicate busy status within the module visually
              * @param enable True if module is busy, false otherwise
@@ -637,6 +655,11 @@ class Guide : public QWidget, public Ui::Guide
         QPointer<FITSViewer> fv;
         QSharedPointer<FITSData> m_ImageData;
 
+        // Low latency guiding: the guide view is updated after the guide pulse is sent.
+        bool m_DeferGuideView { false };
+        QFutureWatcher<void> m_DeferredStatsWatcher;
+        QSharedPointer<FITSData> m_DeferredImageData;
+
         // Dark Processor
         QPointer<DarkProcessor> m_DarkProcessor;
 
@@ -14,9 +14,17 @@
 // Qt version calming
 #include <qtendl.h>
 
+namespace
+{
+// Guide samples kept for each graph, 10 hours of 1 second exposures
+constexpr int MAX_GUIDE_SAMPLES = 36000;
+}
+
 GuideDriftGraph::GuideDriftGraph(QWidget *parent)
 {
     Q_UNUSED(parent);
+    m_Series.fill(Ekos::DecimatedSeries(MAX_GUIDE_SAMPLES), GuideGraph::G_RMS + 1);
+
     // Drift Graph Color Settings
     setBackground(QBrush(Qt::black));
     xAxis->setBasePen(QPen(Qt::white, 1));
@@ -174,18 +182,52 @@ GuideDriftGraph::GuideDriftGraph(QWidget *parent)
     graph(GuideGraph::G_SNR)->setVisible(Options::sNRDisplayedOnGuideGraph()); //SNR
     setRMSVisibility();
 
+    // The graphs only hold the points in view, zooming and dragging need others.
+    connect(xAxis, static_cast<void(QCPAxis::*)(const QCPRange &)>(&QCPAxis::rangeChanged), this, [this](const QCPRange &)
+    {
+        refreshGraphs();
+    });
+
     updateCorrectionsScaleVisibility();
 }
 
+int GuideDriftGraph::sampleCount() const
+{
+    return m_Series[GuideGraph::G_RA].size();
+}
+
+double GuideDriftGraph::sampleValue(GuideGraph::DRIFT_GRAPH_INDICES plot, int index) const
+{
+    const Ekos::DecimatedSeries &series = m_Series[plot];
+    return (index >= 0 && index < series.size()) ? series.value(index) : 0;
+}
+
+void GuideDriftGraph::addSample(GuideGraph::DRIFT_GRAPH_INDICES plot, double key, double value)
+{
+    m_Series[plot].append(key, value);
+}
+
+void GuideDriftGraph::refreshGraphs()
+{
+    for (int i = 0; i < m_Series.size() && i < graphCount(); ++i)
+    {
+        if (i == GuideGraph::G_RA_HIGHLIGHT || i == GuideGraph::G_DEC_HIGHLIGHT)
+            continue;
+        m_Series[i].fill(graph(i));
+    }
+}
+
 void GuideDriftGraph::guideHistory(int sliderValue, bool graphOnLatestPt)
 {
     graph(GuideGraph::G_RA_HIGHLIGHT)->data()->clear(); //Clear RA highlighted point
     graph(GuideGraph::G_DEC_HIGHLIGHT)->data()->clear(); //Clear DEC highlighted point
-    double t = graph(GuideGraph::G_RA)->dataMainKey(sliderValue); //Get time from RA data
-    double ra = graph(GuideGraph::G_RA)->dataMainValue(sliderValue); //Get RA from RA data
-    double de = graph(GuideGraph::G_DEC)->dataMainValue(sliderValue); //Get DEC from DEC data
-    double raPulse = graph(GuideGraph::G_RA_PULSE)->dataMainValue(sliderValue); //Get RA Pulse from RA pulse data
-    double dePulse = graph(GuideGraph::G_DEC_PULSE)->dataMainValue(sliderValue); //Get DEC Pulse from DEC pulse data
+    if (sliderValue < 0 || sliderValue >= sampleCount())
+        return;
+    double t = m_Series[GuideGraph::G_RA].key(sliderValue); //Get time from RA data
+    double ra = sampleValue(GuideGraph::G_RA, sliderValue); //Get RA from RA data
+    double de = sampleValue(GuideGraph::G_DEC, sliderValue); //Get DEC from DEC data
+    double raPulse = sampleValue(GuideGraph::G_RA_PULSE, sliderValue); //Get RA Pulse from RA pulse data
+    double dePulse = sampleValue(GuideGraph::G_DEC_PULSE, sliderValue); //Get DEC Pulse from DEC pulse data
     graph(GuideGraph::G_RA_HIGHLIGHT)->addData(t, ra); //Set RA highlighted point
     graph(GuideGraph::G_DEC_HIGHLIGHT)->addData(t, de); //Set DEC highlighted point
 
@@ -202,17 +244,15 @@ void GuideDriftGraph::guideHistory(int sliderValue, bool graphOnLatestPt)
         }
     }
     replot();
-    double snr = 0;
-    if (graph(GuideGraph::G_SNR)->data()->size() > 0)
-        snr = graph(GuideGraph::G_SNR)->dataMainValue(sliderValue);
-    double rms = graph(GuideGraph::G_RMS)->dataMainValue(sliderValue);
+    double snr = sampleValue(GuideGraph::G_SNR, sliderValue);
+    double rms = sampleValue(GuideGraph::G_RMS, sliderValue);
 
     if(!graphOnLatestPt)
     {
         QTime localTime = guideTimer;
         localTime = localTime.addSecs(t);
 
-        QPoint localTooltipCoordinates = graph(GuideGraph::G_RA)->dataPixelPosition(sliderValue).toPoint();
+        QPoint localTooltipCoordinates(xAxis->coordToPixel(t), yAxis->coordToPixel(ra));
         QPoint globalTooltipCoordinates = mapToGlobal(localTooltipCoordinates);
 
         if(raPulse == 0 && dePulse == 0)
@@ -364,6 +404,8 @@ void GuideDriftGraph::clear()
     graph(GuideGraph::G_RA_RMS)->data()->clear(); //RA RMS
     graph(GuideGraph::G_DEC_RMS)->data()->clear(); //DEC RMS
     graph(GuideGraph::G_RMS)->data()->clear(); //RMS
+    for (auto &series : m_Series)
+        series.clear();
     clearItems();  //Clears dither text items from the graph
     setupNSEWLabels();
     replot();
@@ -445,7 +487,7 @@ void GuideDriftGraph::setRMSVisibility()
 
 void GuideDriftGraph::exportGuideData()
 {
-    int numPoints = graph(GuideGraph::G_RA)->dataCount();
+    int numPoints = sampleCount();
     if (numPoints == 0)
         return;
 
@@ -493,11 +535,11 @@ void GuideDriftGraph::exportGuideData()
 
     for (int i = 0; i < numPoints; i++)
     {
-        double t = graph(GuideGraph::G_RA)->dataMainKey(i);
-        double ra = graph(GuideGraph::G_RA)->dataMainValue(i);
-        double de = graph(GuideGraph::G_DEC)->dataMainValue(i);
-        double raPulse = graph(GuideGraph::G_RA_PULSE)->dataMainValue(i);
-        double dePulse = graph(GuideGraph::G_DEC_PULSE)->dataMainValue(i);
+        double t = m_Series[GuideGraph::G_RA].key(i);
+        double ra = sampleValue(GuideGraph::G_RA, i);
+        double de = sampleValue(GuideGraph::G_DEC, i);
+        double raPulse = sampleValue(GuideGraph::G_RA_PULSE, i);
+        double dePulse = sampleValue(GuideGraph::G_DEC_PULSE, i);
 
         QTime localTime = guideTimer;
         localTime = localTime.addSecs(t);
@@ -532,9 +574,10 @@ void GuideDriftGraph::setAxisDelta(double ra, double de)
     // similar to same operation in Guide::setAxisDelta
     ra = -ra;
 
-    graph(GuideGraph::G_RA)->addData(key, ra);
-    graph(GuideGraph::G_DEC)->addData(key, de);
+    addSample(GuideGraph::G_RA, key, ra);
+    addSample(GuideGraph::G_DEC, key, de);
 
+    const QCPRange range = xAxis->range();
     if(graphOnLatestPt)
     {
         xAxis->setRange(key, xAxis->range().size(), Qt::AlignRight);
@@ -543,6 +586,9 @@ void GuideDriftGraph::setAxisDelta(double ra, double de)
         graph(GuideGraph::G_RA_HIGHLIGHT)->addData(key, ra); //Set highlighted RA point to latest point
         graph(GuideGraph::G_DEC_HIGHLIGHT)->addData(key, de); //Set highlighted DEC point to latest point
     }
+    // A change of range has already refreshed the graphs.
+    if (xAxis->range() == range)
+        refreshGraphs();
     replot();
 }
 
@@ -550,31 +596,26 @@ void GuideDriftGraph::setAxisSigma(double ra, double de)
 {
     const double key = guideElapsedTimer.elapsed() / 1000.0;
     const double total = std::hypot(ra, de);
-    graph(GuideGraph::G_RA_RMS)->addData(key, ra);
-    graph(GuideGraph::G_DEC_RMS)->addData(key, de);
-    graph(GuideGraph::G_RMS)->addData(key, total);
+    addSample(GuideGraph::G_RA_RMS, key, ra);
+    addSample(GuideGraph::G_DEC_RMS, key, de);
+    addSample(GuideGraph::G_RMS, key, total);
 }
 
 void GuideDriftGraph::setAxisPulse(double ra, double de)
 {
     double key = guideElapsedTimer.elapsed() / 1000.0;
-    graph(GuideGraph::G_RA_PULSE)->addData(key, ra);
-    graph(GuideGraph::G_DEC_PULSE)->addData(key, de);
+    addSample(GuideGraph::G_RA_PULSE, key, ra);
+    addSample(GuideGraph::G_DEC_PULSE, key, de);
 }
 
 void GuideDriftGraph::setSNR(double snr)
 {
     double key = guideElapsedTimer.elapsed() / 1000.0;
-    graph(GuideGraph::G_SNR)->addData(key, snr);
+    addSample(GuideGraph::G_SNR, key, snr);
 
     // Sets the SNR axis to have the maximum be 95% of the way up from the middle to the top.
-    QCPGraphData snrMax = *std::min_element(graph(GuideGraph::G_SNR)->data()->begin(),
-                                            graph(GuideGraph::G_SNR)->data()->end(),
-                                            [](QCPGraphData const & s1, QCPGraphData const & s2)
-    {
-        return s1.value > s2.value;
-    });
-    snrAxis->setRange(-1.05 * snrMax.value, 1.05 * snrMax.value);
+    const double snrMax = m_Series[GuideGraph::G_SNR].valueRange(nullptr).upper;
+    snrAxis->setRange(-1.05 * snrMax, 1.05 * snrMax);
 }
 
 void GuideDriftGraph::updateCorrectionsScaleVisibility()
@@ -592,23 +633,18 @@ void GuideDriftGraph::mouseOverLine(QMouseEvent *event)
     {
         if (plottableAt(event->pos(), false))
         {
-            int raIndex = graph(GuideGraph::G_RA)->findBegin(key);
-            int deIndex = graph(GuideGraph::G_DEC)->findBegin(key);
-            int rmsIndex = graph(GuideGraph::G_RMS)->findBegin(key);
+            int raIndex = m_Series[GuideGraph::G_RA].findBegin(key);
+            int deIndex = m_Series[GuideGraph::G_DEC].findBegin(key);
+            int rmsIndex = m_Series[GuideGraph::G_RMS].findBegin(key);
 
-            double raDelta = graph(GuideGraph::G_RA)->dataMainValue(raIndex);
-            double deDelta = graph(GuideGraph::G_DEC)->dataMainValue(deIndex);
+            double raDelta = sampleValue(GuideGraph::G_RA, raIndex);
+            double deDelta = sampleValue(GuideGraph::G_DEC, deIndex);
 
-            double raPulse = graph(GuideGraph::G_RA_PULSE)->dataMainValue(raIndex); //Get RA Pulse from RA pulse data
-            double dePulse = graph(GuideGraph::G_DEC_PULSE)->dataMainValue(deIndex); //Get DEC Pulse from DEC pulse data
+            double raPulse = sampleValue(GuideGraph::G_RA_PULSE, raIndex); //Get RA Pulse from RA pulse data
+            double dePulse = sampleValue(GuideGraph::G_DEC_PULSE, deIndex); //Get DEC Pulse from DEC pulse data
 
-            double rms = graph(GuideGraph::G_RMS)->dataMainValue(rmsIndex);
-            double snr = 0;
-            if (graph(GuideGraph::G_SNR)->data()->size() > 0)
-            {
-                int snrIndex = graph(GuideGraph::G_SNR)->findBegin(key);
-                snr = graph(GuideGraph::G_SNR)->dataMainValue(snrIndex);
-            }
+            double rms = sampleValue(GuideGraph::G_RMS, rmsIndex);
+            double snr = sampleValue(GuideGraph::G_SNR, m_Series[GuideGraph::G_SNR].findBegin(key));
 
             // Compute time value:
             QTime localTime = guideTimer;
@@ -667,23 +703,18 @@ void GuideDriftGraph::mouseOverLine(QMouseEvent *event)
 
         if (qcpgraph)
         {
-            int raIndex = graph(GuideGraph::G_RA)->findBegin(key);
-            int deIndex = graph(GuideGraph::G_DEC)->findBegin(key);
-            int rmsIndex = graph(GuideGraph::G_RMS)->findBegin(key);
+            int raIndex = m_Series[GuideGraph::G_RA].findBegin(key);
+            int deIndex = m_Series[GuideGraph::G_DEC].findBegin(key);
+            int rmsIndex = m_Series[GuideGraph::G_RMS].findBegin(key);
 
-            double raDelta = graph(GuideGraph::G_RA)->dataMainValue(raIndex);
-            double deDelta = graph(GuideGraph::G_DEC)->dataMainValue(deIndex);
+            double raDelta = sampleValue(GuideGraph::G_RA, raIndex);
+            double deDelta = sampleValue(GuideGraph::G_DEC, deIndex);
 
-            double raPulse = graph(GuideGraph::G_RA_PULSE)->dataMainValue(raIndex); //Get RA Pulse from RA pulse data
-            double dePulse = graph(GuideGraph::G_DEC_PULSE)->dataMainValue(deIndex); //Get DEC Pulse from DEC pulse data
+            double raPulse = sampleValue(GuideGraph::G_RA_PULSE, raIndex); //Get RA Pulse from RA pulse data
+            double dePulse = sampleValue(GuideGraph::G_DEC_PULSE, deIndex); //Get DEC Pulse from DEC pulse data
 
-            double rms = graph(GuideGraph::G_RMS)->dataMainValue(rmsIndex);
-            double snr = 0;
-            if (graph(GuideGraph::G_SNR)->data()->size() > 0)
-            {
-                int snrIndex = graph(GuideGraph::G_SNR)->findBegin(key);
-                snr = graph(GuideGraph::G_SNR)->dataMainValue(snrIndex);
-            }
+            double rms = sampleValue(GuideGraph::G_RMS, rmsIndex);
+            double snr = sampleValue(GuideGraph::G_SNR, m_Series[GuideGraph::G_SNR].findBegin(key));
 
             // Compute time value:
             QTime localTime = guideTimer;
@@ -12,6 +12,7 @@
 #include <QWidget>
 
 #include "qcustomplot.h"
+#include "ekos/auxiliary/decimatedseries.h"
 #include "guidegraph.h"
 #include "guideinterface.h"
 
@@ -30,6 +31,11 @@ public:
     void resetTimer();
     void connectGuider(Ekos::GuideInterface *guider);
 
+    /** @return number of guide samples kept, the oldest are dropped during long sessions */
+    int sampleCount() const;
+    /** @return value of a sample of a plot, 0 being the oldest sample kept */
+    double sampleValue(GuideGraph::DRIFT_GRAPH_INDICES plot, int index) const;
+
 public slots:
     void handleVerticalPlotSizeChange();
     void handleHorizontalPlotSizeChange();
@@ -61,6 +67,13 @@ public slots:
     void refreshColorScheme();
 
 private:
+    void addSample(GuideGraph::DRIFT_GRAPH_INDICES plot, double key, double value);
+    // Fills the graphs with the samples in view, at the resolution of the plot.
+    void refreshGraphs();
+
+    // The samples of each graph, the graphs only hold the points in view.
+    QVector<Ekos::DecimatedSeries> m_Series;
+
     // The scales of these zoom levels are defined in Guide::zoomX().
     static constexpr int defaultXZoomLevel = 3;
     int driftGraphZoomLevel {defaultXZoomLevel};
@@ -12,6 +12,11 @@
 #include "kstarsdata.h"
 #include "Options.h"
 
+namespace
+{
+// Guide points drawn on the target, an hour of 1 second exposures
+constexpr int MAX_TARGET_POINTS = 3600;
+}
 
 GuideTargetPlot::GuideTargetPlot(QWidget *parent) : QCustomPlot (parent)
 {
@@ -239,14 +244,26 @@ void GuideTargetPlot::clear()
 {
     graph(GuideGraph::G_RA)->data()->clear(); //Guide data
     graph(GuideGraph::G_DEC)->data()->clear(); //Guide highlighted point
+    m_Points.clear();
+    m_NextPoint = 0;
     setupNSEWLabels();
     replot();
 }
 
 void GuideTargetPlot::setAxisDelta(double ra, double de)
 {
-    //Add to Drift Plot
-    graph(GuideGraph::G_RA)->addData(ra, de);
+    //Add to Drift Plot, keeping the latest points only
+    if (m_Points.size() < MAX_TARGET_POINTS)
+    {
+        m_Points.append(QCPGraphData(ra, de));
+        graph(GuideGraph::G_RA)->addData(ra, de);
+    }
+    else
+    {
+        m_Points[m_NextPoint] = QCPGraphData(ra, de);
+        m_NextPoint = (m_NextPoint + 1) % MAX_TARGET_POINTS;
+        graph(GuideGraph::G_RA)->data()->set(m_Points, false);
+    }
     if(graphOnLatestPt)
     {
         graph(GuideGraph::G_DEC)->data()->clear(); //Clear highlighted point
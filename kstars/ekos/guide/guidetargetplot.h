@@ -48,4 +48,8 @@ private:
 
     bool graphOnLatestPt = true;
 
+    // Latest guide points, the oldest is replaced once the scatter is full
+    QVector<QCPGraphData> m_Points;
+    int m_NextPoint { 0 };
+
 };
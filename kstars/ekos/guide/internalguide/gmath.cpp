@@ -16,6 +16,7 @@
 #include "ekos_guide_debug.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
 #include "guidealgorithms.h"
+#include "guidelatency.h"
 
 #include <QVector3D>
 #include <cmath>
@@ -160,6 +161,7 @@ bool cgmath::reset()
     iterationCounter = 0;
     driftUpto[GUIDE_RA] = driftUpto[GUIDE_DEC] = 0;
     drift_integral[GUIDE_RA] = drift_integral[GUIDE_DEC] = 0;
+    rmsWindow.reset();
     out_params.reset();
 
     memset(drift[GUIDE_RA], 0, sizeof(double) * CIRCULAR_BUFFER_SIZE);
@@ -199,6 +201,7 @@ void cgmath::start()
     iterationCounter                   = 0;
     driftUpto[GUIDE_RA] = driftUpto[GUIDE_DEC] = 0;
     drift_integral[GUIDE_RA] = drift_integral[GUIDE_DEC] = 0;
+    rmsWindow.reset();
     out_params.reset();
 
     memset(drift[GUIDE_RA], 0, sizeof(double) * CIRCULAR_BUFFER_SIZE);
@@ -480,6 +483,9 @@ void cgmath::performProcessing(Ekos::GuideState state, QSharedPointer<FITSData>
     else
         setLostStar(false);
 
+    if (m_Latency)
+        m_Latency->mark(GuideLatency::STAR_DETECTED);
+
     // Emit the detected star center
     QVector3D starCenter(starPosition.x, starPosition.y, 0);
     emit newStarPosition(starCenter, true);
@@ -552,6 +558,9 @@ void cgmath::performProcessing(Ekos::GuideState state, QSharedPointer<FITSData>
     // make decision by axes
     calculatePulses(state, timeStep);
 
+    if (m_Latency)
+        m_Latency->mark(GuideLatency::DRIFT_COMPUTED);
+
     if (state == Ekos::GUIDE_GUIDING)
     {
         calculateRmsError();
@@ -636,18 +645,10 @@ void cgmath::calculateRmsError(void)
     if (!do_statistics)
         return;
 
-    if (iterationCounter == 0)
-        return;
-
-    int count = std::min(iterationCounter, static_cast<unsigned int>(CIRCULAR_BUFFER_SIZE));
-    for (int k = GUIDE_RA; k <= GUIDE_DEC; k++)
-    {
-        double sqr_avg = 0;
-        for (int i = 0; i < count; ++i)
-            sqr_avg += drift[k][i] * drift[k][i];
-
-        out_params.sigma[k] = sqrt(sqr_avg / (double)count);
-    }
+    // The window holds the same last drifts as the circular buffers.
+    rmsWindow.newSample(drift[GUIDE_RA][driftUpto[GUIDE_RA]], drift[GUIDE_DEC][driftUpto[GUIDE_DEC]]);
+    out_params.sigma[GUIDE_RA]  = rmsWindow.rmsX();
+    out_params.sigma[GUIDE_DEC] = rmsWindow.rmsY();
 }
 
 
@@ -11,6 +11,7 @@
 
 #include "vect.h"
 #include "indi/indicommon.h"
+#include "ekos/auxiliary/rmsfilter.h"
 
 #include <QObject>
 #include <QPointer>
@@ -30,6 +31,7 @@
 
 class FITSData;
 class Edge;
+class GuideLatency;
 
 // For now also copied in guidealgorithms.cpp
 #define SMART_THRESHOLD    0
@@ -153,6 +155,12 @@ class cgmath : public QObject
             return guideStars;
         }
 
+        // Optional recorder of the star detection and drift computation times.
+        void setLatency(GuideLatency *latency)
+        {
+            m_Latency = latency;
+        }
+
     signals:
         void newAxisDelta(double delta_ra, double delta_dec);
         void newStarPosition(QVector3D, bool);
@@ -204,6 +212,8 @@ class cgmath : public QObject
         uint32_t driftUpto[2];
 
         double drift_integral[2];
+        // RMS of the drifts in the circular buffers
+        Ekos::SlidingRms rmsWindow { CIRCULAR_BUFFER_SIZE };
 
         // overlays...
         cproc_in_params in_params;
@@ -217,6 +227,8 @@ class cgmath : public QObject
 
         GuideStars guideStars;
 
+        GuideLatency *m_Latency { nullptr };
+
         std::unique_ptr<GPG> gpg;
         Calibration calibration;
         bool configureInParams(Ekos::GuideState state);
@@ -9,7 +9,11 @@
 
 #include "guidealgorithms.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <set>
+#include <vector>
 #include <QObject>
 
 #include "ekos_guide_debug.h"
@@ -276,6 +280,203 @@ float *createFloatImage(const QSharedPointer<FITSData> &target)
     return imgFloat;
 }
 
+// Number of independent accumulators used by the centroid kernel.
+// Keeping them separate lets the compiler map them onto SIMD registers.
+constexpr int CENTROID_LANES = 4;
+
+// Computes the threshold-subtracted mass and first moments of a box of pixels,
+// the inner loop of all the threshold based guide algorithms.
+// Rows are processed contiguously and without branches so that the loop vectorizes.
+template <typename T>
+void boxMoments(T const *origin, int stride, int width, int height, double threshold,
+                double *mass, double *sumX, double *sumY)
+{
+    double totalMass = 0, totalX = 0, totalY = 0;
+    const int vectorWidth = width - (width % CENTROID_LANES);
+
+    for (int j = 0; j < height; ++j)
+    {
+        T const *row = origin + j * stride;
+        double laneMass[CENTROID_LANES] = {0}, laneX[CENTROID_LANES] = {0};
+
+        int i = 0;
+        for (; i < vectorWidth; i += CENTROID_LANES)
+        {
+            for (int k = 0; k < CENTROID_LANES; ++k)
+            {
+                const double pval = std::max(static_cast<double>(row[i + k]) - threshold, 0.0);
+                laneMass[k] += pval;
+                laneX[k] += (i + k) * pval;
+            }
+        }
+
+        double rowMass = 0, rowX = 0;
+        for (int k = 0; k < CENTROID_LANES; ++k)
+        {
+            rowMass += laneMass[k];
+            rowX += laneX[k];
+        }
+        for (; i < width; ++i)
+        {
+            const double pval = std::max(static_cast<double>(row[i]) - threshold, 0.0);
+            rowMass += pval;
+            rowX += i * pval;
+        }
+
+        totalMass += rowMass;
+        totalX += rowX;
+        totalY += j * rowMass;
+    }
+
+    *mass = totalMass;
+    *sumX = totalX;
+    *sumY = totalY;
+}
+
+// A star must peak this many noise deviations above the edges of its box.
+constexpr double CENTROID_MIN_SNR = 8.0;
+
+// Background and noise of a box, from the pixels on its edges
+template <typename T>
+void boxBackground(T const *origin, int stride, int width, int height, double *mean, double *sigma)
+{
+    double sum = 0, sumSquares = 0;
+    auto accumulate = [&](double value)
+    {
+        sum += value;
+        sumSquares += value * value;
+    };
+    for (int i = 0; i < width; ++i)
+    {
+        accumulate(origin[i]);
+        accumulate(origin[(height - 1) * stride + i]);
+    }
+    for (int j = 1; j < height - 1; ++j)
+    {
+        accumulate(origin[j * stride]);
+        accumulate(origin[j * stride + width - 1]);
+    }
+    const int count = 2 * width + 2 * (height - 2);
+    *mean  = sum / count;
+    *sigma = std::max(std::sqrt(std::max(sumSquares / count - *mean * *mean, 0.0)), 1e-6);
+}
+
+// Centroid of the star in a box, against the background of the edges of the box.
+template <typename T>
+bool boxCentroid(T const *pdata, int stride, const QRect &box, QPointF *centroid)
+{
+    T const *origin = pdata + box.y() * stride + box.x();
+    const int width  = box.width();
+    const int height = box.height();
+
+    double mean, sigma;
+    boxBackground(origin, stride, width, height, &mean, &sigma);
+
+    double peak = origin[0];
+    for (int j = 0; j < height; ++j)
+    {
+        T const *row = origin + j * stride;
+        for (int i = 0; i < width; ++i)
+            peak = std::max(peak, static_cast<double>(row[i]));
+    }
+    if (peak - mean < CENTROID_MIN_SNR * sigma)
+        return false;
+
+    double mass = 0, sumX = 0, sumY = 0;
+    boxMoments(origin, stride, width, height, mean + (peak - mean) * SMART_CUT_FACTOR, &mass, &sumX, &sumY);
+    if (mass <= 0)
+        return false;
+
+    *centroid = QPointF(box.x() + sumX / mass, box.y() + sumY / mass);
+    return true;
+}
+
+// Peak of the star nearest to a position in a search box. Peaks are local maxima of the 3x3 sums, which ignores
+// single noisy pixels, and must stand clearly above the background of the edges of the box. Several stars may be
+// in the box, the nearest one is kept rather than the brightest.
+template <typename T>
+bool nearestPeak(T const *pdata, int stride, const QRect &box, const QPointF &position, QPoint *peak)
+{
+    T const *origin = pdata + box.y() * stride + box.x();
+    const int width  = box.width();
+    const int height = box.height();
+
+    double mean, sigma;
+    boxBackground(origin, stride, width, height, &mean, &sigma);
+    const double threshold = 9 * (mean + CENTROID_MIN_SNR * sigma);
+
+    // 3x3 sums of the inner pixels of the box
+    std::vector<double> sums(width * height, 0);
+    for (int j = 1; j < height - 1; ++j)
+    {
+        for (int i = 1; i < width - 1; ++i)
+        {
+            double sum = 0;
+            for (int dj = -1; dj <= 1; ++dj)
+            {
+                T const *row = origin + (j + dj) * stride;
+                sum += static_cast<double>(row[i - 1]) + row[i] + row[i + 1];
+            }
+            sums[j * width + i] = sum;
+        }
+    }
+
+    double bestDistance = std::numeric_limits<double>::max();
+    for (int j = 1; j < height - 1; ++j)
+    {
+        for (int i = 1; i < width - 1; ++i)
+        {
+            const double sum = sums[j * width + i];
+            if (sum < threshold)
+                continue;
+
+            bool isPeak = true;
+            for (int dj = -1; dj <= 1 && isPeak; ++dj)
+            {
+                for (int di = -1; di <= 1 && isPeak; ++di)
+                    isPeak = sums[(j + dj) * width + i + di] <= sum;
+            }
+            if (!isPeak)
+                continue;
+
+            const double dx = box.x() + i - position.x();
+            const double dy = box.y() + j - position.y();
+            const double distance = dx * dx + dy * dy;
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                *peak = QPoint(box.x() + i, box.y() + j);
+            }
+        }
+    }
+    return bestDistance < std::numeric_limits<double>::max();
+}
+
+// Centroid of the star nearest to a position, in a refinement box around its peak.
+template <typename T>
+bool starCentroid(T const *pdata, int width, int height, const QPointF &position, int searchRadius, int refineRadius,
+                  QPointF *centroid)
+{
+    auto boxAround = [width, height](const QPoint &center, int radius)
+    {
+        return QRect(center.x() - radius, center.y() - radius, 2 * radius + 1, 2 * radius + 1)
+               .intersected(QRect(0, 0, width, height));
+    };
+
+    const QRect searchBox = boxAround(position.toPoint(), searchRadius);
+    if (searchBox.width() < 3 || searchBox.height() < 3)
+        return false;
+
+    QPoint peak;
+    if (!nearestPeak(pdata, width, searchBox, position, &peak))
+        return false;
+
+    const QRect refineBox = boxAround(peak, refineRadius);
+    if (refineBox.width() < 3 || refineBox.height() < 3)
+        return false;
+    return boxCentroid(pdata, width, refineBox, centroid);
+}
+
 }  // namespace
 
 // Based on PHD2 algorithm
@@ -493,7 +694,7 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
 
     GuiderUtils::Vector ret(-1, -1, -1);
     int i, j;
-    double resx, resy, mass, threshold, pval;
+    double resx, resy, mass, threshold;
     T const *psrc    = nullptr;
     T const *porigin = nullptr;
     T const *pptr;
@@ -814,22 +1015,7 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
         }
     }
 
-    psrc = porigin;
-    for (j = 0; j < trackingBox.width(); ++j)
-    {
-        for (i = 0; i < trackingBox.width(); ++i)
-        {
-            pptr = psrc + i;
-            pval = *pptr - threshold;
-            pval = pval < 0 ? 0 : pval;
-
-            resx += (double)i * pval;
-            resy += (double)j * pval;
-
-            mass += pval;
-        }
-        psrc += videoWidth;
-    }
+    boxMoments(porigin, videoWidth, trackingBox.width(), trackingBox.width(), threshold, &mass, &resx, &resy);
 
     if (mass == 0)
         mass = 1;
@@ -880,3 +1066,43 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
 
     return GuiderUtils::Vector(-1, -1, -1);
 }
+
+bool GuideAlgorithms::findStarCentroid(const QSharedPointer<FITSData> &imageData, const QPointF &position,
+                                       int searchRadius, int refineRadius, QPointF *centroid)
+{
+    if (imageData.isNull())
+        return false;
+
+    const int width  = imageData->width();
+    const int height = imageData->height();
+    uint8_t const *buffer = imageData->getImageBuffer();
+    switch (imageData->dataType())
+    {
+        case TBYTE:
+            return starCentroid(buffer, width, height, position, searchRadius, refineRadius, centroid);
+        case TSHORT:
+            return starCentroid(reinterpret_cast<int16_t const *>(buffer), width, height, position, searchRadius, refineRadius,
+                                centroid);
+        case TUSHORT:
+            return starCentroid(reinterpret_cast<uint16_t const *>(buffer), width, height, position, searchRadius, refineRadius,
+                                centroid);
+        case TLONG:
+            return starCentroid(reinterpret_cast<int32_t const *>(buffer), width, height, position, searchRadius, refineRadius,
+                                centroid);
+        case TULONG:
+            return starCentroid(reinterpret_cast<uint32_t const *>(buffer), width, height, position, searchRadius, refineRadius,
+                                centroid);
+        case TFLOAT:
+            return starCentroid(reinterpret_cast<float const *>(buffer), width, height, position, searchRadius, refineRadius,
+                                centroid);
+        case TLONGLONG:
+            return starCentroid(reinterpret_cast<int64_t const *>(buffer), width, height, position, searchRadius, refineRadius,
+                                centroid);
+        case TDOUBLE:
+            return starCentroid(reinterpret_cast<double const *>(buffer), width, height, position, searchRadius, refineRadius,
+                                centroid);
+        default:
+            break;
+    }
+    return false;
+}
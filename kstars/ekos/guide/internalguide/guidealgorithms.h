@@ -28,6 +28,21 @@ class GuideAlgorithms : public QObject
                 const int videoWidth,
                 const int videoHeight,
                 const QRect &trackingBox);
+
+        /**
+         * @brief findStarCentroid Finds the star nearest to a position and its centroid, against the background of
+         * the edges of a small box around it. Only the boxes are read, so a star can be followed on every frame.
+         * @param imageData image, only its first channel is used
+         * @param position expected position of the star
+         * @param searchRadius the peak of the star is searched within this many pixels of the position
+         * @param refineRadius the centroid is computed within this many pixels of the peak, which excludes most
+         * neighbouring stars
+         * @param centroid set to the position of the star in the image
+         * @return false if no star stands clearly above the background of the search box
+         */
+        static bool findStarCentroid(const QSharedPointer<FITSData> &imageData, const QPointF &position,
+                                     int searchRadius, int refineRadius, QPointF *centroid);
+
     private:
         template <typename T>
         static GuiderUtils::Vector findLocalStarPosition(QSharedPointer<FITSData> &imageData,
@@ -0,0 +1,218 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "guidelatency.h"
+
+#include "auxiliary/monotonicclock.h"
+
+#include <QVariantList>
+
+#include <algorithm>
+#include <cmath>
+
+GuideLatency::RollingHistogram::RollingHistogram(int capacity) : m_Capacity(capacity)
+{
+    m_Samples.reserve(capacity);
+}
+
+void GuideLatency::RollingHistogram::add(double value)
+{
+    m_Last = value;
+    if (m_Samples.size() < m_Capacity)
+        m_Samples.push_back(value);
+    else
+        m_Samples[m_Next] = value;
+    m_Next = (m_Next + 1) % m_Capacity;
+}
+
+void GuideLatency::RollingHistogram::clear()
+{
+    m_Samples.clear();
+    m_Next = 0;
+    m_Last = 0;
+}
+
+double GuideLatency::RollingHistogram::mean() const
+{
+    if (m_Samples.isEmpty())
+        return 0;
+    double sum = 0;
+    for (const double sample : m_Samples)
+        sum += sample;
+    return sum / m_Samples.size();
+}
+
+double GuideLatency::RollingHistogram::max() const
+{
+    if (m_Samples.isEmpty())
+        return 0;
+    return *std::max_element(m_Samples.cbegin(), m_Samples.cend());
+}
+
+double GuideLatency::RollingHistogram::percentile(double fraction) const
+{
+    if (m_Samples.isEmpty())
+        return 0;
+    QVector<double> sorted = m_Samples;
+    const int index = std::min(static_cast<int>(fraction * sorted.size()), sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+const QVector<double> &GuideLatency::RollingHistogram::binEdges()
+{
+    static const QVector<double> edges = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+    return edges;
+}
+
+QVector<int> GuideLatency::RollingHistogram::bins() const
+{
+    const QVector<double> &edges = binEdges();
+    QVector<int> counts(edges.size() + 1, 0);
+    for (const double sample : m_Samples)
+    {
+        const int bin = std::upper_bound(edges.cbegin(), edges.cend(), sample) - edges.cbegin();
+        counts[bin]++;
+    }
+    return counts;
+}
+
+GuideLatency::GuideLatency() : m_Histograms(STAGE_COUNT)
+{
+    reset();
+}
+
+QString GuideLatency::stageName(Stage stage)
+{
+    switch (stage)
+    {
+        case DOWNLOAD:
+            return "Download";
+        case LOAD:
+            return "Load";
+        case DISPATCH:
+            return "Dispatch";
+        case DETECTION:
+            return "Detection";
+        case DRIFT:
+            return "Drift";
+        case PULSE:
+            return "Pulse";
+        case TOTAL:
+            return "Total";
+        default:
+            return QString();
+    }
+}
+
+void GuideLatency::startFrame(double exposureSeconds)
+{
+    std::fill(m_Events, m_Events + EVENT_COUNT, 0);
+    m_Events[EXPOSURE_END] = MonotonicClock::timestamp() + static_cast<qint64>(exposureSeconds * 1e6);
+}
+
+void GuideLatency::mark(Event event, qint64 time)
+{
+    m_Events[event] = time > 0 ? time : MonotonicClock::timestamp();
+}
+
+bool GuideLatency::completeFrame()
+{
+    // The exposure end is only an estimate. Never let it be later than the BLOB arrival.
+    if (m_Events[BLOB_RECEIVED] > 0 && m_Events[BLOB_RECEIVED] < m_Events[EXPOSURE_END])
+        m_Events[EXPOSURE_END] = m_Events[BLOB_RECEIVED];
+
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        // Events must all be present and in order, otherwise the frame was
+        // not a regular guide cycle (e.g. a looping frame or a lost star).
+        if (m_Events[i] <= 0 || (i > 0 && m_Events[i] < m_Events[i - 1]))
+        {
+            std::fill(m_Events, m_Events + EVENT_COUNT, 0);
+            return false;
+        }
+    }
+
+    for (int stage = DOWNLOAD; stage < TOTAL; ++stage)
+        m_Histograms[stage].add((m_Events[stage + 1] - m_Events[stage]) / 1000.0);
+    m_Histograms[TOTAL].add((m_Events[PULSE_EMITTED] - m_Events[EXPOSURE_END]) / 1000.0);
+
+    std::fill(m_Events, m_Events + EVENT_COUNT, 0);
+    return true;
+}
+
+void GuideLatency::reset()
+{
+    std::fill(m_Events, m_Events + EVENT_COUNT, 0);
+    for (auto &histogram : m_Histograms)
+        histogram.clear();
+}
+
+QVariantMap GuideLatency::statistics() const
+{
+    QVariantList edges;
+    for (const double edge : RollingHistogram::binEdges())
+        edges << edge;
+
+    QVariantMap result;
+    result["binEdges"] = edges;
+    for (int stage = DOWNLOAD; stage < STAGE_COUNT; ++stage)
+    {
+        const RollingHistogram &histogram = m_Histograms[stage];
+        QVariantList bins;
+        for (const int count : histogram.bins())
+            bins << count;
+
+        QVariantMap stats;
+        stats["count"] = histogram.count();
+        stats["last"] = histogram.last();
+        stats["mean"] = histogram.mean();
+        stats["median"] = histogram.percentile(0.5);
+        stats["p90"] = histogram.percentile(0.9);
+        stats["max"] = histogram.max();
+        stats["bins"] = bins;
+        result[stageName(static_cast<Stage>(stage))] = stats;
+    }
+    return result;
+}
+
+QString GuideLatency::lastFrameString() const
+{
+    QStringList stages;
+    for (int stage = DOWNLOAD; stage < STAGE_COUNT; ++stage)
+        stages << QString("%1 = %2 ms").arg(stageName(static_cast<Stage>(stage)))
+               .arg(QString::number(m_Histograms[stage].last(), 'f', 1));
+    return stages.join(", ");
+}
+
+QString GuideLatency::summary() const
+{
+    QStringList lines;
+    lines << QString("%1 %2 %3 %4").arg("Stage", -10).arg("median", 8).arg("p90", 8).arg("max", 8);
+    for (int stage = DOWNLOAD; stage < STAGE_COUNT; ++stage)
+    {
+        const RollingHistogram &histogram = m_Histograms[stage];
+        lines << QString("%1 %2 %3 %4")
+              .arg(stageName(static_cast<Stage>(stage)), -10)
+              .arg(QString::number(histogram.percentile(0.5), 'f', 1), 8)
+              .arg(QString::number(histogram.percentile(0.9), 'f', 1), 8)
+              .arg(QString::number(histogram.max(), 'f', 1), 8);
+    }
+
+    // Text histogram of the total latency.
+    const RollingHistogram &total = m_Histograms[TOTAL];
+    const QVector<int> counts = total.bins();
+    const QVector<double> &edges = RollingHistogram::binEdges();
+    const int maxCount = std::max(1, *std::max_element(counts.cbegin(), counts.cend()));
+    lines << QString() << QString("Total latency over the last %1 frames").arg(total.count());
+    for (int i = 0; i < counts.size(); ++i)
+    {
+        const QString label = i < edges.size() ? QString("< %1 ms").arg(edges[i]) : QString(">= %1 ms").arg(edges.last());
+        lines << QString("%1 %2 %3").arg(label, -10).arg(counts[i], 5)
+              .arg(QString(static_cast<int>(std::ceil(20.0 * counts[i] / maxCount)), QChar('#')));
+    }
+    return lines.join('\n');
+}
@@ -0,0 +1,125 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+/*
+ * This class records when each stage of a guide cycle completes and keeps
+ * rolling statistics and histograms of the time spent in each stage.
+ *
+ * A guide cycle is described by a set of events:
+ * the exposure ends, the BLOB is received by ISD::Camera, the image is loaded into FITSData,
+ * the guider starts processing the frame, the guide star is detected, the drift is computed,
+ * and the guide pulses are emitted.
+ *
+ * The exposure end is estimated from the time the capture was requested plus the
+ * exposure duration, as INDI does not report it.
+ *
+ * Timestamps are in microseconds on a monotonic clock, see MonotonicClock::timestamp().
+ */
+class GuideLatency
+{
+    public:
+        enum Event
+        {
+            EXPOSURE_END,
+            BLOB_RECEIVED,
+            IMAGE_LOADED,
+            PROCESSING_STARTED,
+            STAR_DETECTED,
+            DRIFT_COMPUTED,
+            PULSE_EMITTED,
+            EVENT_COUNT
+        };
+
+        // A stage is the interval between an event and the following one.
+        // TOTAL is the interval between the exposure end and the pulse.
+        enum Stage
+        {
+            DOWNLOAD,
+            LOAD,
+            DISPATCH,
+            DETECTION,
+            DRIFT,
+            PULSE,
+            TOTAL,
+            STAGE_COUNT
+        };
+
+        // Keeps the last samples of a stage (in milliseconds) and computes statistics over them.
+        class RollingHistogram
+        {
+            public:
+                explicit RollingHistogram(int capacity = 500);
+
+                void add(double value);
+                void clear();
+
+                int count() const
+                {
+                    return m_Samples.size();
+                }
+                double last() const
+                {
+                    return m_Last;
+                }
+                double mean() const;
+                double max() const;
+                // Fraction in [0,1], e.g. 0.5 for the median.
+                double percentile(double fraction) const;
+                // Number of samples in each bin, see binEdges().
+                QVector<int> bins() const;
+
+                // Upper edges of the histogram bins in milliseconds. The last bin is open ended.
+                static const QVector<double> &binEdges();
+
+            private:
+                QVector<double> m_Samples;
+                int m_Capacity { 500 };
+                int m_Next { 0 };
+                double m_Last { 0 };
+        };
+
+        GuideLatency();
+
+        static QString stageName(Stage stage);
+
+        // Called when the guide exposure is requested.
+        void startFrame(double exposureSeconds);
+        // Records an event of the current frame. If time is 0, the current time is used.
+        void mark(Event event, qint64 time = 0);
+        // Called once the pulses were emitted. Adds the stage durations to the histograms.
+        // Returns false if the frame was incomplete, in which case nothing is recorded.
+        bool completeFrame();
+
+        void reset();
+
+        const RollingHistogram &histogram(Stage stage) const
+        {
+            return m_Histograms[stage];
+        }
+
+        // Duration of a stage of the last completed frame in milliseconds.
+        double lastDuration(Stage stage) const
+        {
+            return m_Histograms[stage].last();
+        }
+
+        // Per stage statistics (last, mean, median, p90, max, count and histogram bins), e.g. for DBus.
+        QVariantMap statistics() const;
+        // Stage durations of the last completed frame, e.g. for the guide log.
+        QString lastFrameString() const;
+        // Multi-line table of the rolling statistics, e.g. for a tooltip.
+        QString summary() const;
+
+    private:
+        qint64 m_Events[EVENT_COUNT];
+        QVector<RollingHistogram> m_Histograms;
+};
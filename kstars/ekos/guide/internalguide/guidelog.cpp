@@ -319,3 +319,11 @@ void GuideLog::settleCompletedInfo()
 {
     appendToLog("INFO: SETTLING STATE CHANGE, Settling complete\n");
 }
+
+// Prints a line that looks like:
+//   INFO: LATENCY Download = 35.2 ms, Load = 12.0 ms, ... , Total = 61.9 ms
+// Not part of the PHD2 log, phdlogview ignores INFO lines it does not know.
+void GuideLog::latencyInfo(const QString &stages)
+{
+    appendToLog(QString("INFO: LATENCY %1\n").arg(stages));
+}
@@ -35,6 +35,7 @@ InternalGuider::InternalGuider()
 {
     // Create math object
     pmath.reset(new cgmath());
+    pmath->setLatency(&m_Latency);
     connect(pmath.get(), &cgmath::newStarPosition, this, &InternalGuider::newStarPosition);
     connect(pmath.get(), &cgmath::guideStats, this, &InternalGuider::guideStats);
 
@@ -687,6 +688,12 @@ void InternalGuider::setGuideView(const QSharedPointer<GuideView> &guideView)
 void InternalGuider::setImageData(const QSharedPointer<FITSData> &data)
 {
     m_ImageData = data;
+    if (data)
+    {
+        // Set by ISD::Camera when the BLOB arrived and was loaded.
+        m_Latency.mark(GuideLatency::BLOB_RECEIVED, data->property("blobReceived").toLongLong());
+        m_Latency.mark(GuideLatency::IMAGE_LOADED, data->property("imageLoaded").toLongLong());
+    }
     if (Options::saveGuideImages())
     {
         QDateTime now(QDateTime::currentDateTime());
@@ -825,6 +832,8 @@ bool InternalGuider::processGuiding()
 {
     const cproc_out_params *out;
 
+    m_Latency.mark(GuideLatency::PROCESSING_STARTED);
+
     // On first frame, center the box (reticle) around the star so we do not start with an offset the results in
     // unnecessary guiding pulses.
     bool process = true;
@@ -888,6 +897,7 @@ bool InternalGuider::processGuiding()
         return true;
 
     bool sendPulses = !pmath->isStarLost();
+    const bool completeLatency = state == GUIDE_GUIDING && sendPulses;
 
 
     // Send pulse if we have one active direction at least.
@@ -895,9 +905,19 @@ bool InternalGuider::processGuiding()
     {
         emit newMultiPulse(out->pulse_dir[GUIDE_RA], out->pulse_length[GUIDE_RA],
                            out->pulse_dir[GUIDE_DEC], out->pulse_length[GUIDE_DEC], StartCaptureAfterPulses);
+        m_Latency.mark(GuideLatency::PULSE_EMITTED);
+        if (completeLatency)
+            completeLatencyFrame();
     }
     else
+    {
+        // No pulse needed, the guide cycle ends with the decision. The capture request starts the next
+        // latency frame right away, so this one is completed first.
+        m_Latency.mark(GuideLatency::PULSE_EMITTED);
+        if (completeLatency)
+            completeLatencyFrame();
         emit frameCaptureRequested();
+    }
 
     if (state == GUIDE_DITHERING || state == GUIDE_MANUAL_DITHERING)
         return true;
@@ -919,6 +939,24 @@ bool InternalGuider::processGuiding()
 }
 
 
+void InternalGuider::startLatencyFrame(double exposureSeconds)
+{
+    m_Latency.startFrame(exposureSeconds);
+}
+
+void InternalGuider::completeLatencyFrame()
+{
+    if (!m_Latency.completeFrame())
+        return;
+
+    QList<double> stageDurations;
+    for (int stage = GuideLatency::DOWNLOAD; stage < GuideLatency::STAGE_COUNT; ++stage)
+        stageDurations << m_Latency.lastDuration(static_cast<GuideLatency::Stage>(stage));
+
+    guideLog.latencyInfo(m_Latency.lastFrameString());
+    emit newLatency(stageDurations);
+}
+
 // Here we calculate the time until the next time we will be emitting guiding corrections.
 std::pair<Seconds, Seconds> InternalGuider::calculateGPGTimeStep()
 {
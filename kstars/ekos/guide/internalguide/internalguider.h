@@ -16,6 +16,7 @@
 #include "calibration.h"
 #include "calibrationprocess.h"
 #include "gmath.h"
+#include "guidelatency.h"
 #include "ekos_guide_debug.h"
 #include <QFile>
 #include <QPointer>
@@ -120,6 +121,14 @@ class InternalGuider : public GuideInterface
         void setDarkGuideTimerInterval();
         void setTimer(std::unique_ptr<QTimer> &timer, Seconds seconds);
 
+        // Guide cycle latency instrumentation.
+        // Called when the guide exposure is requested.
+        void startLatencyFrame(double exposureSeconds);
+        const GuideLatency &latency() const
+        {
+            return m_Latency;
+        }
+
     public slots:
         void setDECSwap(bool enable);
 
@@ -135,6 +144,8 @@ class InternalGuider : public GuideInterface
         void newSinglePulse(GuideDirection dir, int msecs, CaptureAfterPulses followWithCapture);
         //void newStarPosition(QVector3D, bool);
         void DESwapChanged(bool enable);
+        // Stage durations in milliseconds of the last guide cycle, indexed by GuideLatency::Stage.
+        void newLatency(const QList<double> &stageDurations);
     private:
         // Guiding
         bool processGuiding();
@@ -196,6 +207,9 @@ class InternalGuider : public GuideInterface
 
         GuideLog guideLog;
 
+        GuideLatency m_Latency;
+        void completeLatencyFrame();
+
         void iterateCalibration();
         std::unique_ptr<CalibrationProcess> calibrationProcess;
         double calibrationStartX = 0;
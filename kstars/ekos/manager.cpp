@@ -3026,6 +3026,8 @@ void Manager::connectModules()
 
             connect(guideProcess.get(), &Ekos::Guide::guideStats,
                     analyzeProcess.get(), &Ekos::Analyze::guideStats, Qt::UniqueConnection);
+            connect(guideProcess.get(), &Ekos::Guide::guideLatency,
+                    analyzeProcess.get(), &Ekos::Analyze::guideLatency, Qt::UniqueConnection);
         }
     }
 
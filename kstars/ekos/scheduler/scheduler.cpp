@@ -9,6 +9,8 @@
 
 #include "scheduler.h"
 
+#include "ekos/auxiliary/capturedframesindex.h"
+#include "ekos/scheduler/sequencesummary.h"
 #include "ekos/scheduler/framingassistantui.h"
 #include "ksnotification.h"
 #include "ksmessagebox.h"
@@ -5093,18 +5095,11 @@ void Scheduler::startFocusing()
 
 bool Scheduler::canCountCaptures(const SchedulerJob &job)
 {
-    QList<SequenceJob*> seqjobs;
-    bool hasAutoFocus = false;
-    SchedulerJob tempJob = job;
-    if (loadSequenceQueue(tempJob.getSequenceFile().toLocalFile(), &tempJob, seqjobs, hasAutoFocus, nullptr) == false)
+    SequenceSummary::Ptr const summary = SequenceSummary::load(job.getSequenceFile().toLocalFile(), job.getName());
+    if (summary.isNull())
         return false;
 
-    for (const SequenceJob *oneSeqJob : seqjobs)
-    {
-        if (oneSeqJob->getUploadMode() == ISD::Camera::UPLOAD_LOCAL)
-            return false;
-    }
-    return true;
+    return !summary->hasRemoteOnlyUploads();
 }
 
 // FindNextJob (probably misnamed) deals with what to do when jobs end.
@@ -5711,7 +5706,7 @@ void Scheduler::setDirty()
     //mosaicB->setEnabled(addingOK);
 }
 
-void Scheduler::updateLightFramesRequired(SchedulerJob *oneJob, const QList<SequenceJob*> &seqjobs,
+void Scheduler::updateLightFramesRequired(SchedulerJob *oneJob, const SequenceSummary &sequence,
         const SchedulerJob::CapturedFramesMap &framesCount)
 {
 
@@ -5722,13 +5717,13 @@ void Scheduler::updateLightFramesRequired(SchedulerJob *oneJob, const QList<Sequ
         case SchedulerJob::FINISH_SEQUENCE:
         case SchedulerJob::FINISH_REPEAT:
             // Step 1: determine expected frames
-            calculateExpectedCapturesMap(seqjobs, expected);
+            calculateExpectedCapturesMap(sequence, expected);
             // Step 2: compare with already captured frames
-            for (SequenceJob *oneSeqJob : seqjobs)
+            for (const SequenceSummary::Job &oneSeqJob : sequence.jobs())
             {
-                QString const signature = oneSeqJob->getSignature();
+                QString const &signature = oneSeqJob.signature;
                 /* If frame is LIGHT, how many do we have left? */
-                if (oneSeqJob->getFrameType() == FRAME_LIGHT && expected[signature] * oneJob->getRepeatsRequired() > framesCount[signature])
+                if (oneSeqJob.frameType == FRAME_LIGHT && expected[signature] * oneJob->getRepeatsRequired() > framesCount[signature])
                 {
                     lightFramesRequired = true;
                     // exit the loop, one found is sufficient
@@ -5743,15 +5738,14 @@ void Scheduler::updateLightFramesRequired(SchedulerJob *oneJob, const QList<Sequ
     oneJob->setLightFramesRequired(lightFramesRequired);
 }
 
-uint16_t Scheduler::calculateExpectedCapturesMap(const QList<SequenceJob *> &seqJobs, QMap<QString, uint16_t> &expected)
+uint16_t Scheduler::calculateExpectedCapturesMap(const SequenceSummary &sequence, QMap<QString, uint16_t> &expected)
 {
     uint16_t capturesPerRepeat = 0;
-    for (auto &seqJob : seqJobs)
+    for (const SequenceSummary::Job &seqJob : sequence.jobs())
     {
-        capturesPerRepeat += seqJob->getCoreProperty(SequenceJob::SJ_Count).toInt();
-        QString signature = seqJob->getCoreProperty(SequenceJob::SJ_Signature).toString();
-        expected[signature] = static_cast<uint16_t>(seqJob->getCoreProperty(SequenceJob::SJ_Count).toInt()) + (expected.contains(
-                                  signature) ? expected[signature] : 0);
+        capturesPerRepeat += seqJob.count;
+        expected[seqJob.signature] = static_cast<uint16_t>(seqJob.count) + (expected.contains(
+                                         seqJob.signature) ? expected[seqJob.signature] : 0);
     }
     return capturesPerRepeat;
 }
@@ -5828,13 +5822,10 @@ void Scheduler::updateCompletedJobsCount(bool forced)
     /* Enumerate SchedulerJobs to count captures that are already stored */
     for (SchedulerJob *oneJob : jobs)
     {
-        QList<SequenceJob*> seqjobs;
-        bool hasAutoFocus = false;
-
         //oneJob->setLightFramesRequired(false);
         /* Look into the sequence requirements, bypass if invalid */
-        if (loadSequenceQueue(oneJob->getSequenceFile().toLocalFile(), oneJob, seqjobs, hasAutoFocus,
-                              this) == false)
+        SequenceSummary::Ptr const sequence = loadSequenceSummary(oneJob, this);
+        if (sequence.isNull())
         {
             appendLogText(i18n("Warning: job '%1' has inaccessible sequence '%2', marking invalid.", oneJob->getName(),
                                oneJob->getSequenceFile().toLocalFile()));
@@ -5843,15 +5834,15 @@ void Scheduler::updateCompletedJobsCount(bool forced)
         }
 
         /* Enumerate the SchedulerJob's SequenceJobs to count captures stored for each */
-        for (SequenceJob *oneSeqJob : seqjobs)
+        for (const SequenceSummary::Job &oneSeqJob : sequence->jobs())
         {
             /* Only consider captures stored on client (Ekos) side */
             /* FIXME: ask the remote for the file count */
-            if (oneSeqJob->getUploadMode() == ISD::Camera::UPLOAD_LOCAL)
+            if (oneSeqJob.uploadMode == ISD::Camera::UPLOAD_LOCAL)
                 continue;
 
             /* FIXME: this signature path is incoherent when there is no filter wheel on the setup - bugfix should be elsewhere though */
-            QString const signature = oneSeqJob->getSignature();
+            QString const &signature = oneSeqJob.signature;
 
             /* If signature was processed during this run, keep it */
             if (newFramesCount.constEnd() != newFramesCount.constFind(signature))
@@ -5870,7 +5861,7 @@ void Scheduler::updateCompletedJobsCount(bool forced)
         }
 
         // determine whether we need to continue capturing, depending on captured frames
-        updateLightFramesRequired(oneJob, seqjobs, newFramesCount);
+        updateLightFramesRequired(oneJob, *sequence, newFramesCount);
     }
 
     m_CapturedFramesCount = newFramesCount;
@@ -5892,10 +5883,8 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
     /* updateCompletedJobsCount(); */
 
     // Load the sequence job associated with the argument scheduler job.
-    QList<SequenceJob *> seqJobs;
-    bool hasAutoFocus = false;
-    if (loadSequenceQueue(schedJob->getSequenceFile().toLocalFile(), schedJob, seqJobs, hasAutoFocus,
-                          scheduler) == false)
+    SequenceSummary::Ptr const sequence = loadSequenceSummary(schedJob, scheduler);
+    if (sequence.isNull())
     {
         qCWarning(KSTARS_EKOS_SCHEDULER) <<
                                          QString("Warning: Failed estimating the duration of job '%1', its sequence file is invalid.").arg(
@@ -5904,6 +5893,7 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
     }
 
     // FIXME: setting in-sequence focus should be done in XML processing.
+    bool const hasAutoFocus = sequence->hasAutoFocus();
     schedJob->setInSequenceFocus(hasAutoFocus);
 
     // Stop spam of log on re-evaluation. If we display the warning once, then that's it.
@@ -5926,32 +5916,32 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
 
     // Determine number of captures in the scheduler job
     QMap<QString, uint16_t> expected;
-    uint16_t capturesPerRepeat = calculateExpectedCapturesMap(seqJobs, expected);
+    uint16_t capturesPerRepeat = calculateExpectedCapturesMap(*sequence, expected);
 
     // fill the captured frames map
     uint16_t totalCompletedCount = fillCapturedFramesMap(expected, capturedFramesCount, *schedJob, capture_map);
 
     // Loop through sequence jobs to calculate the number of required frames and estimate duration.
-    foreach (SequenceJob *seqJob, seqJobs)
+    QVector<SequenceSummary::Job> const &seqJobs = sequence->jobs();
+    for (int i = 0; i < seqJobs.size(); i++)
     {
+        SequenceSummary::Job const &seqJob = seqJobs[i];
+
         // FIXME: find a way to actually display the filter name.
-        QString seqName = i18n("Job '%1' %2x%3\" %4", schedJob->getName(), seqJob->getCoreProperty(SequenceJob::SJ_Count).toInt(),
-                               seqJob->getCoreProperty(SequenceJob::SJ_Exposure).toDouble(),
-                               seqJob->getCoreProperty(SequenceJob::SJ_Filter).toString());
+        QString seqName = i18n("Job '%1' %2x%3\" %4", schedJob->getName(), seqJob.count, seqJob.exposure, seqJob.filter);
 
-        if (seqJob->getUploadMode() == ISD::Camera::UPLOAD_LOCAL)
+        if (seqJob.uploadMode == ISD::Camera::UPLOAD_LOCAL)
         {
             qCInfo(KSTARS_EKOS_SCHEDULER) <<
                                           QString("%1 duration cannot be estimated time since the sequence saves the files remotely.").arg(seqName);
             schedJob->setEstimatedTime(-2);
-            qDeleteAll(seqJobs);
             return true;
         }
 
         // Note that looping jobs will have zero repeats required.
-        QString const signature      = seqJob->getSignature();
+        QString const signature      = seqJob.signature;
         QString const signature_path = QFileInfo(signature).path();
-        int captures_required        = seqJob->getCoreProperty(SequenceJob::SJ_Count).toInt() * schedJob->getRepeatsRequired();
+        int captures_required        = seqJob.count * schedJob->getRepeatsRequired();
         int captures_completed       = capturedFramesCount[signature];
 
         if (rememberJobProgress && schedJob->getCompletionCondition() != SchedulerJob::FINISH_LOOP)
@@ -5984,20 +5974,17 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
              * This is why it is important to manage the repeat count of the scheduler job, as stated earlier.
              */
 
-            captures_required = expected[seqJob->getSignature()] * schedJob->getRepeatsRequired();
+            captures_required = expected[signature] * schedJob->getRepeatsRequired();
 
             qCInfo(KSTARS_EKOS_SCHEDULER) << QString("%1 sees %2 captures in output folder '%3'.").arg(seqName).arg(
                                               captures_completed).arg(QFileInfo(signature).path());
 
             // Enumerate sequence jobs to check how many captures are completed overall in the same storage as the current one
-            foreach (SequenceJob *prevSeqJob, seqJobs)
+            // Enumerate seqJobs up to the current one
+            for (int j = 0; j < i; j++)
             {
-                // Enumerate seqJobs up to the current one
-                if (seqJob == prevSeqJob)
-                    break;
-
                 // If the previous sequence signature matches the current, skip counting to take duplicates into account
-                if (!signature.compare(prevSeqJob->getSignature()))
+                if (!signature.compare(seqJobs[j].signature))
                     captures_required = 0;
 
                 // And break if no captures remain, this job does not need to be executed
@@ -6012,8 +5999,7 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
         // Else rely on the captures done during this session
         else if (0 < capturesPerRepeat)
         {
-            captures_completed = schedJob->getCompletedCount() / capturesPerRepeat * seqJob->getCoreProperty(
-                                     SequenceJob::SJ_Count).toInt();
+            captures_completed = schedJob->getCompletedCount() / capturesPerRepeat * seqJob.count;
         }
         else
         {
@@ -6027,7 +6013,7 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
         // Note that looping jobs will have zero repeats required.
         // FIXME: As it is implemented now, FINISH_LOOP may loop over a capture-complete, therefore inoperant, scheduler job.
         bool const areJobCapturesComplete = (0 == captures_required || captures_completed >= captures_required);
-        if (seqJob->getFrameType() == FRAME_LIGHT)
+        if (seqJob.frameType == FRAME_LIGHT)
         {
             if(areJobCapturesComplete)
             {
@@ -6044,11 +6030,10 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
         if (!areJobCapturesComplete)
         {
             unsigned int const captures_to_go = captures_required - captures_completed;
-            totalImagingTime += fabs((seqJob->getCoreProperty(SequenceJob::SJ_Exposure).toDouble() + seqJob->getCoreProperty(
-                                          SequenceJob::SJ_Delay).toInt()) * captures_to_go);
+            totalImagingTime += fabs((seqJob.exposure + seqJob.delay) * captures_to_go);
 
             /* If we have light frames to process, add focus/dithering delay */
-            if (seqJob->getFrameType() == FRAME_LIGHT)
+            if (seqJob.frameType == FRAME_LIGHT)
             {
                 // If inSequenceFocus is true
                 if (hasAutoFocus)
@@ -6075,8 +6060,6 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob, const QMap<QString, uint
     if (rememberJobProgress)
         schedJob->setCompletedCount(totalCompletedCount);
 
-    qDeleteAll(seqJobs);
-
     // FIXME: Move those ifs away to the caller in order to avoid estimating in those situations!
 
     // We can't estimate times that do not finish when sequence is done
@@ -6866,7 +6849,8 @@ void Scheduler::startJobEvaluation()
         job->setCompletedCount(0);
     }
 
-    // Unconditionally update the capture storage
+    // Unconditionally update the capture storage, listing the storage folders again
+    CapturedFramesIndex::Instance()->rescan();
     updateCompletedJobsCount(true);
 
     // And evaluate all pending jobs per the conditions set in each
@@ -7436,6 +7420,27 @@ bool Scheduler::loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob
     return true;
 }
 
+SequenceSummary::Ptr Scheduler::loadSequenceSummary(SchedulerJob *schedJob, Scheduler *scheduler)
+{
+    QString error;
+    SequenceSummary::Ptr const sequence = SequenceSummary::load(schedJob->getSequenceFile().toLocalFile(), schedJob->getName(),
+                                          &error);
+    if (sequence.isNull())
+    {
+        if (scheduler != nullptr && !error.isEmpty())
+            scheduler->appendLogText(error);
+        return sequence;
+    }
+
+    // Same changes to the scheduler job as loadSequenceQueue()
+    if (sequence->hasLightFrames())
+        schedJob->setLightFramesRequired(true);
+    if (!sequence->jobs().isEmpty() && sequence->jobs().first().frameType == FRAME_LIGHT)
+        schedJob->setInitialFilter(sequence->initialFilter());
+
+    return sequence;
+}
+
 SequenceJob * Scheduler::processJobInfo(XMLEle *root, SchedulerJob *schedJob)
 {
     SequenceJob *job = new SequenceJob(root);
@@ -7450,25 +7455,7 @@ SequenceJob * Scheduler::processJobInfo(XMLEle *root, SchedulerJob *schedJob)
 
 int Scheduler::getCompletedFiles(const QString &path)
 {
-    int seqFileCount = 0;
-    QFileInfo const path_info(path);
-    QString const sig_dir(path_info.dir().path());
-    QString const sig_file(path_info.completeBaseName());
-    QRegularExpression re(sig_file);
-
-    QDirIterator it(sig_dir, QDir::Files);
-
-    /* FIXME: this counts all files with prefix in the storage location, not just captures. DSS analysis files are counted in, for instance. */
-    while (it.hasNext())
-    {
-        QString const fileName = QFileInfo(it.next()).completeBaseName();
-
-        QRegularExpressionMatch match = re.match(fileName);
-        if (match.hasMatch())
-            seqFileCount++;
-    }
-
-    return seqFileCount;
+    return CapturedFramesIndex::Instance()->count(path);
 }
 
 void Scheduler::setINDICommunicationStatus(Ekos::CommunicationStatus status)
@@ -8352,6 +8339,9 @@ bool Scheduler::preemptiveShutdown()
 
 void Scheduler::setCaptureComplete(const QVariantMap &metadata)
 {
+    // Count the new frame without listing its folder again
+    CapturedFramesIndex::Instance()->addFile(metadata["filename"].toString());
+
     if (currentJob &&
             currentJob->getStepPipeline() & SchedulerJob::USE_ALIGN &&
             metadata["type"].toInt() == FRAME_LIGHT &&
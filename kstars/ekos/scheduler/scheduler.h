@@ -14,6 +14,7 @@
 #include "indi/indiweather.h"
 #include "ekos/auxiliary/solverutils.h"
 #include "schedulerjob.h"
+#include "sequencesummary.h"
 
 #include <lilxml.h>
 
@@ -486,6 +487,14 @@ class Scheduler : public QWidget, public Ui::Scheduler
              */
         static SequenceJob *processJobInfo(XMLEle *root, SchedulerJob *schedJob);
 
+        /**
+             * @brief loadSequenceSummary Returns the cached summary of the capture sequence of a job, parsing the file only if it changed
+             * @param schedJob the SchedulerJob is modified according to the contents of the sequence queue, as by loadSequenceQueue()
+             * @param scheduler instance of the scheduler used for logging. Can be nullptr.
+             * @return the summary of the sequence, or a null pointer if the file is invalid
+             */
+        static SequenceSummary::Ptr loadSequenceSummary(SchedulerJob *schedJob, Scheduler *scheduler);
+
         /**
              * @brief timeHeuristics Estimates the number of seconds of overhead above and beyond imaging time, used by estimateJobTime.
              * @param schedJob the scheduler job.
@@ -940,21 +949,21 @@ class Scheduler : public QWidget, public Ui::Scheduler
         /**
          * @brief Update the flag for the given job whether light frames are required
          * @param oneJob scheduler job where the flag should be updated
-         * @param seqjobs list of capture sequences of the job
+         * @param sequence summary of the capture sequence of the job
          * @param framesCount map capture signature -> frame count
          * @return true iff the job need to capture light frames
          */
-        void updateLightFramesRequired(SchedulerJob *oneJob, const QList<SequenceJob *> &seqjobs,
+        void updateLightFramesRequired(SchedulerJob *oneJob, const SequenceSummary &sequence,
                                        const SchedulerJob::CapturedFramesMap &framesCount);
 
         /**
          * @brief Calculate the map signature -> expected number of captures from the given list of capture sequence jobs,
          *        i.e. the expected number of captures from a single scheduler job run.
-         * @param seqJobs list of capture sequence jobs
+         * @param sequence summary of the capture sequence
          * @param expected map to be filled
          * @return total expected number of captured frames of a single run of all jobs
          */
-        static uint16_t calculateExpectedCapturesMap(const QList<SequenceJob *> &seqJobs, QMap<QString, uint16_t> &expected);
+        static uint16_t calculateExpectedCapturesMap(const SequenceSummary &sequence, QMap<QString, uint16_t> &expected);
 
         /**
          * @brief Fill the map signature -> frame count so that a single iteration of the scheduled job creates as many frames as possible
@@ -0,0 +1,151 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "sequencesummary.h"
+
+#include "ekos/capture/placeholderpath.h"
+#include "ekos/capture/sequencejob.h"
+
+#include <KLocalizedString>
+
+#include <ekos_scheduler_debug.h>
+#include <lilxml.h>
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+
+namespace
+{
+// Summaries of more sequence files than this are dropped all at once, the jobs in use are parsed again.
+constexpr int MAX_CACHED_SEQUENCES = 256;
+}
+
+namespace Ekos
+{
+
+QHash<QString, SequenceSummary::CacheEntry> SequenceSummary::m_Cache;
+
+SequenceSummary::Ptr SequenceSummary::load(const QString &fileURL, const QString &targetName, QString *error)
+{
+    const QFileInfo info(fileURL);
+    const QString key = info.absoluteFilePath() + QChar('\n') + targetName;
+
+    auto it = m_Cache.constFind(key);
+    if (it != m_Cache.constEnd() && info.exists() && it->modified == info.lastModified() && it->size == info.size())
+        return it->summary;
+
+    Ptr summary = parse(fileURL, targetName, error);
+    if (summary.isNull())
+    {
+        m_Cache.remove(key);
+        return summary;
+    }
+
+    if (m_Cache.size() >= MAX_CACHED_SEQUENCES)
+        m_Cache.clear();
+
+    CacheEntry entry;
+    entry.modified = info.lastModified();
+    entry.size     = info.size();
+    entry.summary  = summary;
+    m_Cache.insert(key, entry);
+    return summary;
+}
+
+void SequenceSummary::clearCache()
+{
+    m_Cache.clear();
+}
+
+SequenceSummary::Ptr SequenceSummary::parse(const QString &fileURL, const QString &targetName, QString *error)
+{
+    QFile sFile(fileURL);
+    if (!sFile.open(QIODevice::ReadOnly))
+    {
+        if (error != nullptr)
+            *error = i18n("Unable to open sequence queue file '%1'", fileURL);
+        return Ptr();
+    }
+
+    QSharedPointer<SequenceSummary> summary(new SequenceSummary());
+
+    LilXML *xmlParser = newLilXML();
+    char errmsg[MAXRBUF];
+    XMLEle *root = nullptr;
+    XMLEle *ep   = nullptr;
+
+    // The file is read at once, feeding the parser from memory is much faster than reading each character from the file
+    const QByteArray content = sFile.readAll();
+    for (const char c : content)
+    {
+        root = readXMLEle(xmlParser, c, errmsg);
+
+        if (root)
+        {
+            for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+            {
+                if (!strcmp(tagXMLEle(ep), "Autofocus"))
+                    summary->m_HasAutoFocus = (!strcmp(findXMLAttValu(ep, "enabled"), "true"));
+                else if (!strcmp(tagXMLEle(ep), "Job"))
+                {
+                    // Read the job exactly as Capture does, then keep only what the Scheduler needs
+                    SequenceJob seqJob(ep);
+                    PlaceholderPath().processJobInfo(&seqJob, targetName);
+
+                    Job job;
+                    job.frameType  = seqJob.getFrameType();
+                    job.filter     = seqJob.getCoreProperty(SequenceJob::SJ_Filter).toString();
+                    job.count      = seqJob.getCoreProperty(SequenceJob::SJ_Count).toInt();
+                    job.exposure   = seqJob.getCoreProperty(SequenceJob::SJ_Exposure).toDouble();
+                    job.delay      = seqJob.getCoreProperty(SequenceJob::SJ_Delay).toInt();
+                    job.uploadMode = seqJob.getUploadMode();
+                    job.signature  = seqJob.getSignature();
+                    summary->m_Jobs.append(job);
+                }
+            }
+            delXMLEle(root);
+        }
+        else if (errmsg[0])
+        {
+            if (error != nullptr)
+                *error = QString(errmsg);
+            delLilXML(xmlParser);
+            return Ptr();
+        }
+    }
+    delLilXML(xmlParser);
+
+    qCDebug(KSTARS_EKOS_SCHEDULER) << "Parsed" << summary->m_Jobs.size() << "capture jobs of sequence" << fileURL
+                                   << "for target" << targetName;
+    return summary;
+}
+
+bool SequenceSummary::hasLightFrames() const
+{
+    return std::any_of(m_Jobs.cbegin(), m_Jobs.cend(), [](const Job & job)
+    {
+        return job.frameType == FRAME_LIGHT;
+    });
+}
+
+bool SequenceSummary::hasRemoteOnlyUploads() const
+{
+    return std::any_of(m_Jobs.cbegin(), m_Jobs.cend(), [](const Job & job)
+    {
+        return job.uploadMode == ISD::Camera::UPLOAD_LOCAL;
+    });
+}
+
+QString SequenceSummary::initialFilter() const
+{
+    if (m_Jobs.isEmpty() || m_Jobs.first().frameType != FRAME_LIGHT)
+        return QString();
+    return m_Jobs.first().filter;
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "indi/indicamera.h"
+#include "indi/indistd.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+namespace Ekos
+{
+
+/**
+ * @class SequenceSummary
+ * @short What the Scheduler needs to know of a capture sequence file, read once.
+ *
+ * The Scheduler counts the captures, estimates the duration and checks the upload mode of each of its jobs
+ * on every evaluation. Parsing the sequence file into SequenceJob objects each time costs far more than the
+ * evaluation itself, so the file is parsed once into an immutable summary, which is kept until the file is
+ * modified.
+ *
+ * Summaries are cached by file and target name, since the storage signatures of the frames depend on the name
+ * of the scheduler job. A cached summary is used as long as the modification time and size of the file are
+ * unchanged.
+ */
+class SequenceSummary
+{
+    public:
+        using Ptr = QSharedPointer<const SequenceSummary>;
+
+        /** A capture job of the sequence */
+        struct Job
+        {
+            CCDFrameType frameType { FRAME_LIGHT };
+            QString filter;
+            int count { 0 };
+            double exposure { 0 };
+            int delay { 0 };
+            ISD::Camera::UploadMode uploadMode { ISD::Camera::UPLOAD_CLIENT };
+            // Storage signature of the frames, see SequenceJob::getSignature()
+            QString signature;
+        };
+
+        /**
+         * @brief load Returns the summary of a sequence file, parsing it if it changed since it was cached.
+         * @param fileURL path of the sequence file
+         * @param targetName name of the scheduler job capturing the sequence
+         * @param error if not null, set to the reason of the failure
+         * @return the summary, or a null pointer if the file cannot be read
+         */
+        static Ptr load(const QString &fileURL, const QString &targetName, QString *error = nullptr);
+
+        /** @brief clearCache Forgets all summaries, the files are parsed again at the next load(). */
+        static void clearCache();
+
+        const QVector<Job> &jobs() const
+        {
+            return m_Jobs;
+        }
+        /** @return true if the sequence enables in-sequence autofocus */
+        bool hasAutoFocus() const
+        {
+            return m_HasAutoFocus;
+        }
+        /** @return true if one of the jobs captures light frames */
+        bool hasLightFrames() const;
+        /** @return true if one of the jobs only saves its frames on the remote side */
+        bool hasRemoteOnlyUploads() const;
+        /** @return the filter of the first job if it captures light frames, an empty string otherwise */
+        QString initialFilter() const;
+
+    private:
+        SequenceSummary() = default;
+
+        static Ptr parse(const QString &fileURL, const QString &targetName, QString *error);
+
+        struct CacheEntry
+        {
+            QDateTime modified;
+            qint64 size { 0 };
+            Ptr summary;
+        };
+
+        static QHash<QString, CacheEntry> m_Cache;
+
+        QVector<Job> m_Jobs;
+        bool m_HasAutoFocus { false };
+};
+
+}
@@ -40,6 +40,7 @@
 
 #include <cfloat>
 #include <cmath>
+#include <vector>
 
 #include <fits_debug.h>
 
@@ -85,6 +86,9 @@ FITSData::FITSData(const QSharedPointer<FITSData> &other)
     this->m_Mode = other->m_Mode;
     this->m_Statistics.channels = other->m_Statistics.channels;
     memcpy(&m_Statistics, &(other->m_Statistics), sizeof(m_Statistics));
+    // Keep the header so the copy can be saved like the original.
+    m_FITSBITPIX = other->m_FITSBITPIX;
+    m_HeaderRecords = other->m_HeaderRecords;
     m_ImageBuffer = new uint8_t[m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel];
     memcpy(m_ImageBuffer, other->m_ImageBuffer,
            m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel);
@@ -178,6 +182,7 @@ bool FITSData::privateLoad(const QByteArray &buffer, const QString &extension)
     m_isTemporary = m_Filename.startsWith(KSPaths::writableLocation(QStandardPaths::TempLocation));
     cacheHFR = -1;
     cacheEccentricity = -1;
+    m_HFRMap = FITSHFRMap();
 
     if (extension.contains("fit"))
         return loadFITSImage(buffer, extension);
@@ -419,6 +424,10 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const QString &extension,
         m_DateTime = KStarsDateTime(ts.date(), ts.time());
     }
 
+    // In low latency guiding, only the tracking box is needed before the guide pulse is sent.
+    // The full frame statistics are calculated later by the guide module for display.
+    m_StatsDeferred = (m_Mode == FITS_GUIDE && Options::guideLowLatency());
+
     // Only check for debayed IF the original naxes[2] is 1
     // which is for single channels.
     if (naxes[2] == 1 && m_Statistics.channels == 1 && Options::autoDebayer() && checkDebayer())
@@ -431,10 +440,10 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const QString &extension,
             m_Filename = m_TemporaryDataFile.fileName();
         }
 
-        if (debayer())
+        if (debayer() && !m_StatsDeferred)
             calculateStats(false, false);
     }
-    else
+    else if (!m_StatsDeferred)
         calculateStats(false, false);
 
     if (m_Mode == FITS_NORMAL || m_Mode == FITS_ALIGN)
@@ -1036,6 +1045,8 @@ void FITSData::calculateStats(bool refresh, bool roi)
     // Calculate min max
     if(roi == false)
     {
+        m_StatsDeferred = false;
+
         calculateMinMax(refresh);
         calculateMedian(refresh);
 
@@ -1867,6 +1878,8 @@ QFuture<bool> FITSData::findStars(StarAlgorithm algorithm, const QRect &tracking
     qDeleteAll(starCenters);
     starCenters.clear();
     starsSearched = true;
+    m_StarsSearchedInFullFrame = trackingBox.isNull() || trackingBox.contains(QRect(0, 0, width(), height()));
+    m_HFRMap = FITSHFRMap();
 
     switch (algorithm)
     {
@@ -1879,6 +1892,7 @@ QFuture<bool> FITSData::findStars(StarAlgorithm algorithm, const QRect &tracking
                 if (Options::quickHFR())
                 {
                     //Just finds stars in the center 25% of the image.
+                    m_StarsSearchedInFullFrame = false;
                     const int w = getStatistics().width;
                     const int h = getStatistics().height;
                     QRect middle(static_cast<int>(w * 0.25), static_cast<int>(h * 0.25), w / 2, h / 2);
@@ -1952,6 +1966,7 @@ int FITSData::filterStars(const float innerRadius, const float outerRadius)
         long const sqRadius = x * x + y * y;
         return sqRadius < sqInnerRadius || sqOuterRadius < sqRadius;
     }), starCenters.end());
+    m_HFRMap = FITSHFRMap();
 
     return starCenters.count();
 }
@@ -1996,6 +2011,7 @@ double FITSData::getHFR(HFRType type)
         {
             return (oneStar->x < minX || oneStar->x > maxX || oneStar->y < minY || oneStar->y > maxY);
         }), starCenters.end());
+        m_HFRMap = FITSHFRMap();
         // Top 5%
         if (starCenters.empty())
             return -1;
@@ -2087,6 +2103,13 @@ double FITSData::getHFR(int x, int y)
     return -1;
 }
 
+const FITSHFRMap &FITSData::getHFRMap(int columns, int rows)
+{
+    if (m_HFRMap.columns() != columns || m_HFRMap.rows() != rows)
+        m_HFRMap.compute(starCenters, width(), height(), columns, rows);
+    return m_HFRMap;
+}
+
 double FITSData::getEccentricity()
 {
     if (starCenters.empty())
@@ -2551,6 +2574,7 @@ bool FITSData::checkForWCS()
     int nkeyrec = 0, nreject = 0;
 
     // Free wcs before re-use
+    m_WCSGrid = WCSGrid();
     if (m_WCSHandle != nullptr)
     {
         wcsvfree(&m_nwcs, &m_WCSHandle);
@@ -2622,6 +2646,7 @@ bool FITSData::loadWCS(bool extras)
         return true;
     }
 
+    m_WCSGrid = WCSGrid();
     if (m_WCSHandle != nullptr)
     {
         wcsvfree(&m_nwcs, &m_WCSHandle);
@@ -2770,6 +2795,189 @@ bool FITSData::pixelToWCS(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord)
 #endif
 }
 
+bool FITSData::wcsToPixel(const QVector<SkyPoint> &wcsCoords, QVector<QPointF> &wcsPixelPoints, QVector<bool> &valid)
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (m_WCSHandle == nullptr)
+    {
+        m_LastError = i18n("No world coordinate systems found.");
+        return false;
+    }
+
+    const int count = wcsCoords.size();
+    wcsPixelPoints.resize(count);
+    valid.fill(false, count);
+    if (count == 0)
+        return true;
+
+    std::vector<double> world(2 * count), imgcrd(2 * count), pixcrd(2 * count), phi(count), theta(count);
+    std::vector<int> stat(count);
+    for (int i = 0; i < count; i++)
+    {
+        world[2 * i]     = wcsCoords[i].ra0().Degrees();
+        world[2 * i + 1] = wcsCoords[i].dec0().Degrees();
+    }
+
+    // Invalid coordinates are flagged in stat, the others are still converted.
+    int status = wcss2p(m_WCSHandle, count, 2, world.data(), phi.data(), theta.data(), imgcrd.data(), pixcrd.data(), stat.data());
+    if (status != 0 && status != WCSERR_BAD_WORLD)
+    {
+        m_LastError = QString("wcss2p error %1: %2.").arg(status).arg(wcs_errmsg[status]);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (stat[i] != 0)
+            continue;
+        wcsPixelPoints[i] = QPointF(pixcrd[2 * i], pixcrd[2 * i + 1]);
+        valid[i] = true;
+    }
+    return true;
+#else
+    Q_UNUSED(wcsCoords);
+    Q_UNUSED(wcsPixelPoints);
+    Q_UNUSED(valid);
+    return false;
+#endif
+}
+
+bool FITSData::pixelToWCS(const QVector<QPointF> &wcsPixelPoints, QVector<SkyPoint> &wcsCoords, QVector<bool> &valid)
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (m_WCSHandle == nullptr)
+    {
+        m_LastError = i18n("No world coordinate systems found.");
+        return false;
+    }
+
+    const int count = wcsPixelPoints.size();
+    wcsCoords.resize(count);
+    valid.fill(false, count);
+    if (count == 0)
+        return true;
+
+    std::vector<double> pixcrd(2 * count), imgcrd(2 * count), world(2 * count), phi(count), theta(count);
+    std::vector<int> stat(count);
+    for (int i = 0; i < count; i++)
+    {
+        pixcrd[2 * i]     = wcsPixelPoints[i].x();
+        pixcrd[2 * i + 1] = wcsPixelPoints[i].y();
+    }
+
+    // Invalid pixels are flagged in stat, the others are still converted.
+    int status = wcsp2s(m_WCSHandle, count, 2, pixcrd.data(), imgcrd.data(), phi.data(), theta.data(), world.data(), stat.data());
+    if (status != 0 && status != WCSERR_BAD_PIX)
+    {
+        m_LastError = QString("wcsp2s error %1: %2.").arg(status).arg(wcs_errmsg[status]);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (stat[i] != 0)
+            continue;
+        wcsCoords[i].setRA0(world[2 * i] / 15.0);
+        wcsCoords[i].setDec0(world[2 * i + 1]);
+        valid[i] = true;
+    }
+    return true;
+#else
+    Q_UNUSED(wcsPixelPoints);
+    Q_UNUSED(wcsCoords);
+    Q_UNUSED(valid);
+    return false;
+#endif
+}
+
+void FITSData::buildWCSGrid()
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    WCSGrid grid;
+    // One node past the last pixel, so every pixel of the image is inside a cell
+    grid.columns = (width() - 1) / grid.step + 2;
+    grid.rows    = (height() - 1) / grid.step + 2;
+
+    QVector<QPointF> pixels;
+    pixels.reserve(grid.columns * grid.rows);
+    for (int row = 0; row < grid.rows; row++)
+        for (int column = 0; column < grid.columns; column++)
+            pixels.append(QPointF(column * grid.step, row * grid.step));
+
+    QVector<SkyPoint> coords;
+    if (!pixelToWCS(pixels, coords, grid.valid))
+        return;
+
+    // Unit vectors interpolate across RA = 0 and near the poles, unlike angles.
+    grid.nodes.resize(3 * coords.size());
+    for (int i = 0; i < coords.size(); i++)
+    {
+        double sinRA, cosRA, sinDec, cosDec;
+        coords[i].ra0().SinCos(sinRA, cosRA);
+        coords[i].dec0().SinCos(sinDec, cosDec);
+        grid.nodes[3 * i]     = cosDec * cosRA;
+        grid.nodes[3 * i + 1] = cosDec * sinRA;
+        grid.nodes[3 * i + 2] = sinDec;
+    }
+
+    m_WCSGrid = grid;
+#endif
+}
+
+bool FITSData::pixelToWCSInterpolated(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord)
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (m_WCSHandle == nullptr)
+    {
+        m_LastError = i18n("No world coordinate systems found.");
+        return false;
+    }
+
+    if (m_WCSGrid.nodes.isEmpty())
+        buildWCSGrid();
+
+    const double gx = wcsPixelPoint.x() / m_WCSGrid.step;
+    const double gy = wcsPixelPoint.y() / m_WCSGrid.step;
+    const int column = static_cast<int>(std::floor(gx));
+    const int row    = static_cast<int>(std::floor(gy));
+    if (m_WCSGrid.nodes.isEmpty() || column < 0 || row < 0 || column + 1 >= m_WCSGrid.columns || row + 1 >= m_WCSGrid.rows)
+        return pixelToWCS(wcsPixelPoint, wcsCoord);
+
+    const int corners[4] =
+    {
+        row * m_WCSGrid.columns + column, row * m_WCSGrid.columns + column + 1,
+        (row + 1) * m_WCSGrid.columns + column, (row + 1) * m_WCSGrid.columns + column + 1
+    };
+    for (int corner : corners)
+    {
+        if (!m_WCSGrid.valid[corner])
+            return pixelToWCS(wcsPixelPoint, wcsCoord);
+    }
+
+    const double fx = gx - column, fy = gy - row;
+    const double weights[4] = { (1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy };
+    double v[3] = { 0, 0, 0 };
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 3; j++)
+            v[j] += weights[i] * m_WCSGrid.nodes[3 * corners[i] + j];
+
+    const double norm = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (norm <= 0)
+        return pixelToWCS(wcsPixelPoint, wcsCoord);
+
+    double ra = std::atan2(v[1], v[0]) / dms::DegToRad;
+    if (ra < 0)
+        ra += 360;
+    wcsCoord.setRA0(ra / 15.0);
+    wcsCoord.setDec0(std::asin(std::max(-1.0, std::min(1.0, v[2] / norm))) / dms::DegToRad);
+    return true;
+#else
+    Q_UNUSED(wcsPixelPoint);
+    Q_UNUSED(wcsCoord);
+    return false;
+#endif
+}
+
 #if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
 bool FITSData::searchObjects()
 {
@@ -2800,36 +3008,81 @@ bool FITSData::findWCSBounds(double &minRA, double &maxRA, double &minDec, doubl
     maxDec = -1000;
     minDec = 1000;
 
-    auto updateMinMax = [&](int x, int y)
+    // The coordinates vary smoothly along the edges, so instead of converting every edge pixel the edges
+    // are sampled, and each extreme sample is refined at the vertex of the parabola through it and its neighbors.
+    constexpr int EDGE_SAMPLES = 64;
+    const double right = width() - 1, bottom = height() - 1;
+    const QPointF edges[4][2] =
     {
-        int stat[2];
-        double imgcrd[2], phi, pixcrd[2], theta, world[2];
+        { QPointF(0, 0), QPointF(right, 0) },
+        { QPointF(right, 0), QPointF(right, bottom) },
+        { QPointF(right, bottom), QPointF(0, bottom) },
+        { QPointF(0, bottom), QPointF(0, 0) }
+    };
 
-        pixcrd[0] = x;
-        pixcrd[1] = y;
+    QVector<QPointF> samples;
+    samples.reserve(4 * (EDGE_SAMPLES + 1));
+    for (const auto &edge : edges)
+        for (int i = 0; i <= EDGE_SAMPLES; i++)
+            samples.append(edge[0] + (edge[1] - edge[0]) * (static_cast<double>(i) / EDGE_SAMPLES));
 
-        if (wcsp2s(m_WCSHandle, 1, 2, &pixcrd[0], &imgcrd[0], &phi, &theta, &world[0], &stat[0]))
-            return;
+    QVector<SkyPoint> coords;
+    QVector<bool> valid;
+    if (!pixelToWCS(samples, coords, valid))
+        return false;
 
-        minRA = std::min(minRA, world[0]);
-        maxRA = std::max(maxRA, world[0]);
-        minDec = std::min(minDec, world[1]);
-        maxDec = std::max(maxDec, world[1]);
+    auto updateMinMax = [&](const QVector<SkyPoint> &points, const QVector<bool> &isValid)
+    {
+        for (int i = 0; i < points.size(); i++)
+        {
+            if (!isValid[i])
+                continue;
+            const double ra = points[i].ra0().Degrees(), dec = points[i].dec0().Degrees();
+            minRA  = std::min(minRA, ra);
+            maxRA  = std::max(maxRA, ra);
+            minDec = std::min(minDec, dec);
+            maxDec = std::max(maxDec, dec);
+        }
     };
+    updateMinMax(coords, valid);
 
-    // Find min and max values from edges
-    for (int y = 0; y < height(); y++)
+    QVector<QPointF> refinements;
+    for (int e = 0; e < 4; e++)
     {
-        updateMinMax(0, y);
-        updateMinMax(width() - 1, y);
-    }
+        const int first = e * (EDGE_SAMPLES + 1);
+        const QPointF step = (edges[e][1] - edges[e][0]) / EDGE_SAMPLES;
+        // RA min, RA max, Dec min, Dec max
+        for (int quantity = 0; quantity < 4; quantity++)
+        {
+            auto value = [&](int i)
+            {
+                const SkyPoint &point = coords[first + i];
+                const double v = quantity < 2 ? point.ra0().Degrees() : point.dec0().Degrees();
+                return (quantity % 2) ? v : -v;
+            };
 
-    for (int x = 1; x < width() - 1; x++)
-    {
-        updateMinMax(x, 0);
-        updateMinMax(x, height() - 1);
+            int best = -1;
+            for (int i = 0; i <= EDGE_SAMPLES; i++)
+            {
+                if (valid[first + i] && (best < 0 || value(i) > value(best)))
+                    best = i;
+            }
+            // Extremes at the corners are exact
+            if (best <= 0 || best >= EDGE_SAMPLES || !valid[first + best - 1] || !valid[first + best + 1])
+                continue;
+
+            const double a = value(best - 1), b = value(best), c = value(best + 1);
+            const double curvature = a - 2 * b + c;
+            if (curvature >= 0)
+                continue;
+            const double offset = std::max(-1.0, std::min(1.0, 0.5 * (a - c) / curvature));
+            refinements.append(samples[first + best] + step * offset);
+        }
     }
 
+    if (!refinements.isEmpty() && pixelToWCS(refinements, coords, valid))
+        updateMinMax(coords, valid);
+
     // Check if either pole is in the image
     SkyPoint NCP(0, 90);
     SkyPoint SCP(0, -90);
@@ -2894,20 +3147,30 @@ bool FITSData::findObjectsInImage(SkyPoint startPoint, SkyPoint endPoint)
                 type == SkyObject::SATELLITE);
     }), list.end());
 
-    double world[2], phi, theta, imgcrd[2], pixcrd[2];
-    int stat[2];
+    // Convert all the objects in a single call
+    QVector<SkyPoint> coords;
+    coords.reserve(list.size());
     for (auto &object : list)
     {
-        world[0] = object->ra0().Degrees();
-        world[1] = object->dec0().Degrees();
+        SkyPoint point;
+        point.setRA0(object->ra0());
+        point.setDec0(object->dec0());
+        coords.append(point);
+    }
 
-        if (wcss2p(m_WCSHandle, 1, 2, &world[0], &phi, &theta, &imgcrd[0], &pixcrd[0], &stat[0]) == 0)
+    QVector<QPointF> pixels;
+    QVector<bool> valid;
+    if (wcsToPixel(coords, pixels, valid))
+    {
+        for (int i = 0; i < list.size(); i++)
         {
+            if (!valid[i])
+                continue;
             //The X and Y are set to the found position if it does work.
-            int x = pixcrd[0];
-            int y = pixcrd[1];
+            int x = pixels[i].x();
+            int y = pixels[i].y();
             if (x > 0 && y > 0 && x < w && y < h)
-                m_SkyObjects.append(new FITSSkyObject(object, x, y));
+                m_SkyObjects.append(new FITSSkyObject(list[i], x, y));
         }
     }
 
@@ -23,6 +23,7 @@
 #include "skybackground.h"
 #include "fitscommon.h"
 #include "fitsstardetector.h"
+#include "fitshfrmap.h"
 
 #ifdef WIN32
 // This header must be included before fitsio.h to avoid compiler errors with Visual Studio
@@ -140,6 +141,12 @@ class FITSData : public QObject
         ////////////////////////////////////////////////////////////////////////////////////////
         // Calculate stats
         void calculateStats(bool refresh = false, bool roi = false);
+        // Guide frames loaded in low latency mode skip the statistics on load.
+        // They must be calculated with calculateStats() before the data is displayed.
+        bool hasDeferredStats() const
+        {
+            return m_StatsDeferred;
+        }
         void saveStatistics(FITSImage::Statistic &other);
         void restoreStatistics(FITSImage::Statistic &other);
         FITSImage::Statistic const &getStatistics() const
@@ -282,9 +289,15 @@ class FITSData : public QObject
         {
             return starsSearched;
         }
+        /** @return true if the last star search covered the whole frame, not a box or the quick HFR center */
+        bool areStarsSearchedInFullFrame() const
+        {
+            return starsSearched && m_StarsSearchedInFullFrame;
+        }
         void appendStar(Edge *newCenter)
         {
             starCenters.append(newCenter);
+            m_HFRMap = FITSHFRMap();
         }
         const QList<Edge *> &getStarCenters() const
         {
@@ -296,6 +309,7 @@ class FITSData : public QObject
         {
             qDeleteAll(starCenters);
             starCenters = centers;
+            m_HFRMap = FITSHFRMap();
         }
         QFuture<bool> findStars(StarAlgorithm algorithm = ALGORITHM_CENTROID, const QRect &trackingBox = QRect());
 
@@ -335,6 +349,13 @@ class FITSData : public QObject
         double getHFR(HFRType type = HFR_AVERAGE);
         double getHFR(int x, int y);
 
+        /**
+         * @brief getHFRMap Computes the HFR, FWHM and eccentricity of the detected stars in each cell
+         * of a columns x rows grid over the frame, see FITSHFRMap.
+         * @note The map is cached until the stars change, so it can be requested repeatedly.
+         */
+        const FITSHFRMap &getHFRMap(int columns = 3, int rows = 3);
+
         ////////////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////////////////////////////////////////////////////////////////
         /// Date & Time (WCS) Functions.
@@ -407,6 +428,34 @@ class FITSData : public QObject
              */
         bool pixelToWCS(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord);
 
+        /**
+             * @brief wcsToPixel Converts many J2000 coordinates to pixel coordinates in a single WCS call.
+             * @param wcsCoords Coordinates of the targets
+             * @param wcsPixelPoints Return XY FITS coordinates, one per target
+             * @param valid Return whether each target could be converted
+             * @return True if the conversion ran, even if some targets could not be converted, false otherwise.
+             */
+        bool wcsToPixel(const QVector<SkyPoint> &wcsCoords, QVector<QPointF> &wcsPixelPoints, QVector<bool> &valid);
+
+        /**
+             * @brief pixelToWCS Converts many pixel coordinates to J2000 world coordinates in a single WCS call.
+             * @param wcsPixelPoints Pixel coordinates in XY Image space.
+             * @param wcsCoords Return the world coordinates, one per pixel
+             * @param valid Return whether each pixel could be converted
+             * @return True if the conversion ran, even if some pixels could not be converted, false otherwise.
+             */
+        bool pixelToWCS(const QVector<QPointF> &wcsPixelPoints, QVector<SkyPoint> &wcsCoords, QVector<bool> &valid);
+
+        /**
+             * @brief pixelToWCSInterpolated Approximate pixelToWCS() for interactive use, such as tracking the mouse.
+             * The world coordinates are interpolated in a grid computed once per WCS solution, the error is far below
+             * an arcsecond for the usual fields. Pixels outside the grid fall back to pixelToWCS().
+             * @param wcsPixelPoint Pixel coordinates in XY Image space.
+             * @param wcsCoord Store back WCS world coordinate in wcsCoord
+             * @return True if successful, false otherwise.
+             */
+        bool pixelToWCSInterpolated(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord);
+
         /**
              * @brief injectWCS Add WCS keywords
              * @param orientation Solver orientation, degrees E of N.
@@ -657,6 +706,10 @@ class FITSData : public QObject
         bool m_isCompressed { false };
         /// Did we search for stars yet?
         bool starsSearched { false };
+        /// Did the last search cover the whole frame?
+        bool m_StarsSearchedInFullFrame { false };
+        /// Were the statistics skipped on load?
+        bool m_StatsDeferred { false };
         ///Star Selection Algorithm
         StarAlgorithm starAlgorithm { ALGORITHM_GRADIENT };
         /// Do we have WCS keywords in this FITS data?
@@ -690,6 +743,17 @@ class FITSData : public QObject
         /// Number of coordinate representations found.
         int m_nwcs {0};
         WCSState m_WCSState { Idle };
+        /// Unit vectors of the world coordinates on a coarse pixel grid, see pixelToWCSInterpolated()
+        struct WCSGrid
+        {
+            int step { 32 };
+            int columns { 0 };
+            int rows { 0 };
+            // x, y, z of each node, row after row
+            QVector<double> nodes;
+            QVector<bool> valid;
+        } m_WCSGrid;
+        void buildWCSGrid();
         /// All the stars we detected, if any.
         QList<Edge *> starCenters;
         QList<Edge *> localStarCenters;
@@ -744,5 +808,6 @@ class FITSData : public QObject
         double cacheHFR { -1 };
         HFRType cacheHFRType { HFR_AVERAGE };
         double cacheEccentricity { -1 };
+        FITSHFRMap m_HFRMap;
         QPoint roiCenter;
 };
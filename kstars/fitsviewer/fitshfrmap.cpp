@@ -0,0 +1,206 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitshfrmap.h"
+#include "fitsstardetector.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Below this number of stars, the cells are processed in the calling thread.
+constexpr int PARALLEL_STAR_COUNT = 2000;
+
+// HFR and ellipticities of the stars of a cell, and the cell to fill from them.
+struct Bucket
+{
+    QVector<float> hfrs;
+    QVector<float> ellipticities;
+    FITSHFRMap::Cell *cell { nullptr };
+};
+
+float median(QVector<float> &values)
+{
+    const int middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    return values[middle];
+}
+}
+
+void FITSHFRMap::compute(const QList<Edge *> &stars, int width, int height, int columns, int rows, int minStars)
+{
+    m_Columns = std::max(1, columns);
+    m_Rows = std::max(1, rows);
+    m_Cells = QVector<Cell>(m_Columns * m_Rows);
+    m_HFR = m_Tilt = -1;
+    m_TiltX = m_TiltY = m_OffAxis = 0;
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    for (int row = 0; row < m_Rows; ++row)
+    {
+        const int top = row * height / m_Rows;
+        const int bottom = (row + 1) * height / m_Rows;
+        for (int column = 0; column < m_Columns; ++column)
+        {
+            const int left = column * width / m_Columns;
+            const int right = (column + 1) * width / m_Columns;
+            m_Cells[row * m_Columns + column].region = QRect(left, top, right - left, bottom - top);
+        }
+    }
+
+    QVector<Bucket> buckets(m_Cells.size());
+    for (int i = 0; i < buckets.size(); ++i)
+        buckets[i].cell = &m_Cells[i];
+
+    QVector<float> allHFRs;
+    allHFRs.reserve(stars.size());
+    for (const Edge *star : stars)
+    {
+        if (star->HFR <= 0)
+            continue;
+        const int column = std::clamp(static_cast<int>(star->x * m_Columns / width), 0, m_Columns - 1);
+        const int row = std::clamp(static_cast<int>(star->y * m_Rows / height), 0, m_Rows - 1);
+        Bucket &bucket = buckets[row * m_Columns + column];
+        bucket.hfrs.append(star->HFR);
+        bucket.ellipticities.append(star->ellipticity);
+        allHFRs.append(star->HFR);
+    }
+
+    if (allHFRs.isEmpty())
+        return;
+
+    auto processBucket = [minStars](Bucket & bucket)
+    {
+        Cell *cell = bucket.cell;
+        cell->stars = bucket.hfrs.size();
+        if (cell->stars < std::max(1, minStars))
+            return;
+        cell->hfr = median(bucket.hfrs);
+        // For a gaussian profile, half of the flux is within FWHM / 2 of the center.
+        cell->fwhm = 2 * cell->hfr;
+        // SEP gives the ellipticity (flattening), see FITSData::getEccentricity().
+        const float ellipticity = median(bucket.ellipticities);
+        cell->eccentricity = std::sqrt(ellipticity * (2 - ellipticity));
+    };
+
+    if (allHFRs.size() >= PARALLEL_STAR_COUNT && m_Cells.size() > 1)
+    {
+        // The frame median is computed while the cells are processed.
+        QFuture<void> cellsFuture = QtConcurrent::map(buckets, processBucket);
+        m_HFR = median(allHFRs);
+        cellsFuture.waitForFinished();
+    }
+    else
+    {
+        std::for_each(buckets.begin(), buckets.end(), processBucket);
+        m_HFR = median(allHFRs);
+    }
+
+    computeTilt();
+}
+
+bool FITSHFRMap::isValid() const
+{
+    return m_HFR > 0 && std::any_of(m_Cells.cbegin(), m_Cells.cend(), [](const Cell & cell)
+    {
+        return cell.isValid();
+    });
+}
+
+double FITSHFRMap::meanHFR(int firstColumn, int lastColumn, int firstRow, int lastRow) const
+{
+    double sum = 0;
+    int count = 0;
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        for (int column = firstColumn; column <= lastColumn; ++column)
+        {
+            const Cell &oneCell = cell(column, row);
+            if (oneCell.isValid())
+            {
+                sum += oneCell.hfr;
+                count++;
+            }
+        }
+    }
+    return count > 0 ? sum / count : -1;
+}
+
+void FITSHFRMap::computeTilt()
+{
+    const int lastColumn = m_Columns - 1;
+    const int lastRow = m_Rows - 1;
+
+    const double left = meanHFR(0, 0, 0, lastRow);
+    const double right = meanHFR(lastColumn, lastColumn, 0, lastRow);
+    if (lastColumn > 0 && left > 0 && right > 0)
+        m_TiltX = right - left;
+
+    const double top = meanHFR(0, lastColumn, 0, 0);
+    const double bottom = meanHFR(0, lastColumn, lastRow, lastRow);
+    if (lastRow > 0 && top > 0 && bottom > 0)
+        m_TiltY = bottom - top;
+
+    if (lastColumn == 0 || lastRow == 0)
+        return;
+
+    const Cell *corners[4] = { &cell(0, 0), &cell(lastColumn, 0), &cell(0, lastRow), &cell(lastColumn, lastRow) };
+    double minCorner = corners[0]->hfr, maxCorner = corners[0]->hfr, sumCorners = 0;
+    for (const Cell *corner : corners)
+    {
+        if (!corner->isValid())
+            return;
+        minCorner = std::min(minCorner, corner->hfr);
+        maxCorner = std::max(maxCorner, corner->hfr);
+        sumCorners += corner->hfr;
+    }
+    m_Tilt = 100.0 * (maxCorner - minCorner) / m_HFR;
+
+    // With an even number of columns or rows, the center is shared by the middle cells.
+    const double center = meanHFR(lastColumn / 2, m_Columns / 2, lastRow / 2, m_Rows / 2);
+    if (center > 0)
+        m_OffAxis = sumCorners / 4 - center;
+}
+
+QVariantMap FITSHFRMap::toVariantMap() const
+{
+    QVariantList cellList;
+    for (int row = 0; row < m_Rows; ++row)
+    {
+        for (int column = 0; column < m_Columns; ++column)
+        {
+            const Cell &oneCell = cell(column, row);
+            QVariantMap cellMap;
+            cellMap["column"] = column;
+            cellMap["row"] = row;
+            cellMap["x"] = oneCell.region.x();
+            cellMap["y"] = oneCell.region.y();
+            cellMap["width"] = oneCell.region.width();
+            cellMap["height"] = oneCell.region.height();
+            cellMap["stars"] = oneCell.stars;
+            cellMap["hfr"] = oneCell.hfr;
+            cellMap["fwhm"] = oneCell.fwhm;
+            cellMap["eccentricity"] = oneCell.eccentricity;
+            cellList << cellMap;
+        }
+    }
+
+    QVariantMap result;
+    result["columns"] = m_Columns;
+    result["rows"] = m_Rows;
+    result["hfr"] = m_HFR;
+    result["tilt"] = m_Tilt;
+    result["tiltX"] = m_TiltX;
+    result["tiltY"] = m_TiltY;
+    result["offAxis"] = m_OffAxis;
+    result["cells"] = cellList;
+    return result;
+}
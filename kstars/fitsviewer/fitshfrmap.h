@@ -0,0 +1,130 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QList>
+#include <QRect>
+#include <QVariantMap>
+#include <QVector>
+
+class Edge;
+
+/**
+ * @class FITSHFRMap
+ * @short Star quality statistics for each region of a frame.
+ *
+ * The frame is partitioned into a grid of columns x rows cells. Each detected star is
+ * assigned to the cell containing its center, and the median HFR, FWHM and eccentricity
+ * of the stars of each cell are computed. Cells with too few stars are left invalid.
+ *
+ * From the cells, a few figures describe how the star shapes vary across the field:
+ * the tilt is the spread of the corner HFRs relative to the frame HFR, tiltX and tiltY
+ * are the HFR differences between the right and left, and bottom and top edges,
+ * and offAxis is the difference between the corners and the center of the frame
+ * (field curvature or spacing issues).
+ *
+ * Computing the map only goes through the star list once and never touches the pixels,
+ * so it is cheap enough to be done for every captured frame.
+ */
+class FITSHFRMap
+{
+    public:
+        struct Cell
+        {
+            // Region of the frame covered by the cell, in pixels.
+            QRect region;
+            // Number of stars in the cell.
+            int stars { 0 };
+            // Median HFR of the stars, in pixels, -1 if the cell has too few stars.
+            double hfr { -1 };
+            // FWHM estimated from the median HFR assuming gaussian stars, in pixels.
+            double fwhm { -1 };
+            // Eccentricity of the median star ellipticity.
+            double eccentricity { -1 };
+
+            bool isValid() const
+            {
+                return hfr > 0;
+            }
+        };
+
+        FITSHFRMap() = default;
+
+        /**
+         * @brief compute Builds the map from a list of detected stars.
+         * @param stars Stars detected in the frame.
+         * @param width Width of the frame in pixels.
+         * @param height Height of the frame in pixels.
+         * @param columns Number of columns of the grid.
+         * @param rows Number of rows of the grid.
+         * @param minStars Minimum number of stars for a cell to be valid.
+         */
+        void compute(const QList<Edge *> &stars, int width, int height, int columns = 3, int rows = 3, int minStars = 3);
+
+        bool isValid() const;
+
+        int columns() const
+        {
+            return m_Columns;
+        }
+        int rows() const
+        {
+            return m_Rows;
+        }
+        const Cell &cell(int column, int row) const
+        {
+            return m_Cells[row * m_Columns + column];
+        }
+        // Cells in row-major order.
+        const QVector<Cell> &cells() const
+        {
+            return m_Cells;
+        }
+
+        // Median HFR over the whole frame, -1 if no star was found.
+        double hfr() const
+        {
+            return m_HFR;
+        }
+        // (max corner HFR - min corner HFR) / frame HFR in percent, -1 if a corner is invalid.
+        double tilt() const
+        {
+            return m_Tilt;
+        }
+        // Mean HFR of the right column minus the left column, in pixels.
+        double tiltX() const
+        {
+            return m_TiltX;
+        }
+        // Mean HFR of the bottom row minus the top row, in pixels.
+        double tiltY() const
+        {
+            return m_TiltY;
+        }
+        // Mean corner HFR minus the center HFR, in pixels.
+        double offAxis() const
+        {
+            return m_OffAxis;
+        }
+
+        // The map and its cells as nested maps and lists, e.g. for DBus or JSON.
+        QVariantMap toVariantMap() const;
+
+    private:
+        // Mean HFR of the valid cells in the given column and row range, -1 if none is valid.
+        double meanHFR(int firstColumn, int lastColumn, int firstRow, int lastRow) const;
+        void computeTilt();
+
+        int m_Columns { 0 };
+        int m_Rows { 0 };
+        QVector<Cell> m_Cells;
+        double m_HFR { -1 };
+        double m_Tilt { -1 };
+        double m_TiltX { 0 };
+        double m_TiltY { 0 };
+        double m_OffAxis { 0 };
+};
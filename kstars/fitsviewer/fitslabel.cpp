@@ -252,7 +252,8 @@ void FITSLabel::mouseMoveEvent(QMouseEvent *e)
     {
         QPointF wcsPixelPoint(x, y);
         SkyPoint wcsCoord;
-        if(imageData->pixelToWCS(wcsPixelPoint, wcsCoord))
+        // Called on every mouse move, the interpolated coordinates are accurate enough for display
+        if(imageData->pixelToWCSInterpolated(wcsPixelPoint, wcsCoord))
         {
             m_RA = wcsCoord.ra0();
             m_DE = wcsCoord.dec0();
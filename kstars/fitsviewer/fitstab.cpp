@@ -468,9 +468,9 @@ void FITSTab::processData()
     //        imageData->constructHistogram();
     //    }
 
-    if (shouldComputeHFR())
+    if (shouldComputeHFR() || m_View->isHFRMapShown())
     {
-        m_View->searchStars();
+        m_View->searchStars(m_View->isHFRMapShown());
         qCDebug(KSTARS_FITS) << "FITS HFR:" << imageData->getHFR();
     }
 
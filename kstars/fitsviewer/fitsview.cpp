@@ -1083,6 +1083,9 @@ void FITSView::drawOverlay(QPainter * painter, double scale)
     if (showPixelGrid)
         drawPixelGrid(painter, scale);
 
+    if (showHFRMap)
+        drawHFRMap(painter, scale);
+
     if (markStars)
         drawStarCentroid(painter, scale);
 
@@ -1432,6 +1435,48 @@ void FITSView::drawPixelGrid(QPainter * painter, double scale)
         painter->drawLine(0, cY - y, width, cY - y);
     }
 }
+void FITSView::drawHFRMap(QPainter * painter, double scale)
+{
+    const FITSHFRMap &map = m_ImageData->getHFRMap();
+    if (!map.isValid())
+        return;
+
+    QFont painterFont;
+    painterFont.setPointSizeF(isLargeImage() ? scaleSize(painterFont.pointSizeF()) : painterFont.pointSizeF() * 1.5);
+    painter->setFont(painterFont);
+
+    for (const auto &cell : map.cells())
+    {
+        const QRectF region(cell.region.x() * scale, cell.region.y() * scale,
+                            cell.region.width() * scale, cell.region.height() * scale);
+        painter->setPen(QPen(Qt::yellow, scaleSize(1), Qt::DashLine));
+        painter->drawRect(region);
+
+        if (!cell.isValid())
+        {
+            painter->setPen(QPen(Qt::gray, scaleSize(1)));
+            painter->drawText(region, Qt::AlignCenter, i18n("%1 stars", cell.stars));
+            continue;
+        }
+
+        // Cells more than 10% worse than the frame are highlighted.
+        const double ratio = cell.hfr / map.hfr();
+        painter->setPen(QPen(ratio > 1.1 ? Qt::red : (ratio < 0.9 ? Qt::cyan : Qt::green), scaleSize(1)));
+        painter->drawText(region, Qt::AlignCenter,
+                          i18n("HFR %1\nFWHM %2\nEcc. %3\n%4 stars",
+                               QString::number(cell.hfr, 'f', 2), QString::number(cell.fwhm, 'f', 2),
+                               QString::number(cell.eccentricity, 'f', 2), cell.stars));
+    }
+
+    QString summary = i18n("HFR %1", QString::number(map.hfr(), 'f', 2));
+    if (map.tilt() >= 0)
+        summary += i18n(", tilt %1%, off-axis %2", QString::number(map.tilt(), 'f', 1),
+                        QString::number(map.offAxis(), 'f', 2));
+    painter->setPen(QPen(Qt::yellow, scaleSize(1)));
+    painter->drawText(QRectF(0, 0, m_ImageData->width() * scale, m_ImageData->height() * scale),
+                      Qt::AlignTop | Qt::AlignHCenter, summary);
+}
+
 bool FITSView::imageHasWCS()
 {
     if (m_ImageData != nullptr)
@@ -1514,7 +1559,7 @@ void FITSView::drawEQGrid(QPainter * painter, double scale)
 
         painter->setPen(QPen(Qt::yellow));
 
-        QPointF pixelPoint, imagePoint, pPoint;
+        QPointF imagePoint, pPoint;
 
         //This section draws the RA Gridlines
 
@@ -1529,16 +1574,10 @@ void FITSView::drawEQGrid(QPainter * painter, double scale)
             double increment = std::abs((maxDec - minDec) /
                                         100.0); //This will determine how many points to use to create the RA Line
 
+            QVector<SkyPoint> pointsToGet;
             for (double targetDec = minDec; targetDec <= maxDec; targetDec += increment)
-            {
-                SkyPoint pointToGet(target / 15.0, targetDec);
-                bool inImage = m_ImageData->wcsToPixel(pointToGet, pixelPoint, imagePoint);
-                if (inImage)
-                {
-                    QPointF pt(pixelPoint.x() * scale, pixelPoint.y() * scale);
-                    eqGridPoints.append(pt);
-                }
-            }
+                pointsToGet.append(SkyPoint(target / 15.0, targetDec));
+            appendEQGridPoints(pointsToGet, scale);
 
             if (eqGridPoints.count() > 1)
             {
@@ -1565,16 +1604,10 @@ void FITSView::drawEQGrid(QPainter * painter, double scale)
                                         100.0); //This will determine how many points to use to create the Dec Line
             double target    = targetDec * decConvert;
 
+            QVector<SkyPoint> pointsToGet;
             for (double targetRA = minRA; targetRA <= maxRA; targetRA += increment)
-            {
-                SkyPoint pointToGet(targetRA / 15, targetDec * decConvert);
-                bool inImage = m_ImageData->wcsToPixel(pointToGet, pixelPoint, imagePoint);
-                if (inImage)
-                {
-                    QPointF pt(pixelPoint.x() * scale, pixelPoint.y() * scale);
-                    eqGridPoints.append(pt);
-                }
-            }
+                pointsToGet.append(SkyPoint(targetRA / 15, targetDec * decConvert));
+            appendEQGridPoints(pointsToGet, scale);
             if (eqGridPoints.count() > 1)
             {
                 for (int i = 1; i < eqGridPoints.count(); i++)
@@ -1623,6 +1656,23 @@ void FITSView::drawEQGrid(QPainter * painter, double scale)
 }
 #endif
 
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+void FITSView::appendEQGridPoints(const QVector<SkyPoint> &points, double scale)
+{
+    // A grid line is converted in a single WCS call
+    QVector<QPointF> pixelPoints;
+    QVector<bool> valid;
+    if (!m_ImageData->wcsToPixel(points, pixelPoints, valid))
+        return;
+
+    for (int i = 0; i < pixelPoints.size(); i++)
+    {
+        if (valid[i])
+            eqGridPoints.append(QPointF(pixelPoints[i].x() * scale, pixelPoints[i].y() * scale));
+    }
+}
+#endif
+
 bool FITSView::pointIsInImage(QPointF pt, double scale)
 {
     int image_width = m_ImageData->width();
@@ -1832,6 +1882,11 @@ bool FITSView::isPixelGridShown()
     return showPixelGrid;
 }
 
+bool FITSView::isHFRMapShown()
+{
+    return showHFRMap;
+}
+
 void FITSView::toggleCrosshair()
 {
     showCrosshair = !showCrosshair;
@@ -2012,6 +2067,15 @@ void FITSView::togglePixelGrid()
     updateFrame();
 }
 
+void FITSView::toggleHFRMap()
+{
+    showHFRMap = !showHFRMap;
+    // The map needs the stars of the whole frame.
+    if (showHFRMap)
+        searchStars(true);
+    updateFrame();
+}
+
 QFuture<bool> FITSView::findStars(StarAlgorithm algorithm, const QRect &searchBox)
 {
     if(trackingBoxEnabled)
@@ -2028,11 +2092,14 @@ void FITSView::toggleStars(bool enable)
         searchStars();
 }
 
-void FITSView::searchStars()
+void FITSView::searchStars(bool fullFrame)
 {
     QVariant frameType;
-    if (m_ImageData->areStarsSearched() || !m_ImageData || (m_ImageData->getRecordValue("FRAME", frameType)
-            && frameType.toString() != "Light"))
+    if (!m_ImageData || (m_ImageData->getRecordValue("FRAME", frameType) && frameType.toString() != "Light"))
+        return;
+
+    // A previous quick or subframe search does not do for a full frame search.
+    if (m_ImageData->areStarsSearched() && (!fullFrame || m_ImageData->areStarsSearchedInFullFrame()))
         return;
 
     QApplication::setOverrideCursor(Qt::WaitCursor);
@@ -2046,7 +2113,8 @@ void FITSView::searchStars()
     imageData()->setSourceExtractorSettings(extractionSettings);
 #endif
 
-    QFuture<bool> result = findStars(ALGORITHM_SEP);
+    const QRect searchBox = fullFrame ? QRect(0, 0, m_ImageData->width(), m_ImageData->height()) : QRect();
+    QFuture<bool> result = findStars(ALGORITHM_SEP, searchBox);
     result.waitForFinished();
     if (result.result() && isVisible())
     {
@@ -2307,6 +2375,10 @@ void FITSView::createFloatingToolBar()
                                    i18n("Detect Stars in Image"), this, SLOT(toggleStars()));
     toggleStarsAction->setCheckable(true);
 
+    action = floatingToolBar->addAction(QIcon::fromTheme("view-grid"),
+                                        i18n("Show HFR Map"), this, SLOT(toggleHFRMap()));
+    action->setCheckable(true);
+
 #ifdef HAVE_DATAVISUALIZATION
     toggleProfileAction =
         floatingToolBar->addAction(QIcon::fromTheme("star-profile", QIcon(":/icons/star_profile.svg")),
@@ -132,6 +132,7 @@ class FITSView : public QScrollArea
 #endif
         void drawObjectNames(QPainter *painter, double scale);
         void drawPixelGrid(QPainter *painter, double scale);
+        void drawHFRMap(QPainter *painter, double scale);
         void drawMagnifyingGlass(QPainter *painter, double scale);
         bool isImageStretched();
         bool isCrosshairShown();
@@ -140,6 +141,7 @@ class FITSView : public QScrollArea
         bool isEQGridShown();
         bool isSelectionRectShown();
         bool isPixelGridShown();
+        bool isHFRMapShown();
         bool imageHasWCS();
 
         // Setup the graphics.
@@ -179,7 +181,9 @@ class FITSView : public QScrollArea
         // Star Detection
         QFuture<bool> findStars(StarAlgorithm algorithm = ALGORITHM_CENTROID, const QRect &searchBox = QRect());
         void toggleStars(bool enable);
-        void searchStars();
+        // Detects the stars of the frame if not done yet. Normal frames are only searched in
+        // their center when QuickHFR is set, unless fullFrame is set.
+        void searchStars(bool fullFrame = false);
         void setStarsEnabled(bool enable);
         void setStarsHFREnabled(bool enable);
         void setStarFilterRange(float const innerRadius, float const outerRadius);
@@ -284,6 +288,7 @@ class FITSView : public QScrollArea
         void toggleObjects();
         void togglePixelGrid();
         void toggleCrosshair();
+        void toggleHFRMap();
 
         //Selection Rectngle
         void toggleSelectionMode();
@@ -324,6 +329,10 @@ class FITSView : public QScrollArea
 
         QPointF getPointForGridLabel(QPainter *painter, const QString &str, double scale);
         bool pointIsInImage(QPointF pt, double scale);
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+        // Converts the points of a grid line and appends those found to eqGridPoints
+        void appendEQGridPoints(const QVector<SkyPoint> &points, double scale);
+#endif
 
         void loadInFrame();
 
@@ -384,6 +393,7 @@ class FITSView : public QScrollArea
         bool showObjects { false };
         bool showEQGrid { false };
         bool showPixelGrid { false };
+        bool showHFRMap { false };
         bool showStarsHFR { false };
         bool showClipping { false };
 
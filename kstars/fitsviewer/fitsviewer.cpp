@@ -224,6 +224,12 @@ FITSViewer::FITSViewer(QWidget *parent) : KXmlGuiWindow(parent)
     action->setCheckable(true);
     connect(action, SIGNAL(triggered(bool)), SLOT(togglePixelGrid()));
 
+    action = actionCollection()->addAction("view_hfr_map");
+    action->setIcon(QIcon::fromTheme("view-grid"));
+    action->setText(i18n("Show HFR Map"));
+    action->setCheckable(true);
+    connect(action, SIGNAL(triggered(bool)), SLOT(toggleHFRMap()));
+
     action = actionCollection()->addAction("view_eq_grid");
     action->setIcon(QIcon::fromTheme("kstars_grid"));
     action->setText(i18n("Show Equatorial Gridlines"));
@@ -691,6 +697,7 @@ void FITSViewer::tabFocusUpdated(int currentIndex)
         updateButtonStatus("currentView_eq_grid", i18n("Equatorial Gridines"), currentView->isEQGridShown());
         updateButtonStatus("currentView_objects", i18n("Objects in Image"), currentView->areObjectsShown());
         updateButtonStatus("currentView_pixel_grid", i18n("Pixel Gridlines"), currentView->isPixelGridShown());
+        updateButtonStatus("view_hfr_map", i18n("HFR Map"), currentView->isHFRMapShown());
     }
 
     updateScopeButton();
@@ -1189,6 +1196,19 @@ void FITSViewer::togglePixelGrid()
     updateButtonStatus("view_pixel_grid", i18n("Pixel Gridlines"), currentView->isPixelGridShown());
 }
 
+void FITSViewer::toggleHFRMap()
+{
+    if (fitsTabs.empty())
+        return;
+
+    QSharedPointer<FITSView> currentView;
+    if (!getCurrentView(currentView))
+        return;
+
+    currentView->toggleHFRMap();
+    updateButtonStatus("view_hfr_map", i18n("HFR Map"), currentView->isHFRMapShown());
+}
+
 void FITSViewer::toggle3DGraph()
 {
     if (fitsTabs.empty())
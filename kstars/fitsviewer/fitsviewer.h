@@ -115,6 +115,7 @@ class FITSViewer : public KXmlGuiWindow
         void toggleEQGrid();
         void toggleObjects();
         void togglePixelGrid();
+        void toggleHFRMap();
         void toggle3DGraph();
         void starProfileButtonOff();
         void centerTelescope();
@@ -10,12 +10,16 @@
 #define HIPS_H
 
 #include <QString>
+#include <QHash>
 #include <QImage>
 #include <QDebug>
 
 #define HIPS_FRAME_EQT          0
 #define HIPS_FRAME_GAL          1
 
+// Lowest order of the HiPS tiles, lower orders are rendered from the allsky image
+#define HIPS_MIN_ORDER          3
+
 typedef struct
 {
   QString cachePath;
@@ -47,4 +51,15 @@ typedef struct
 
 Q_DECLARE_METATYPE(pixCacheKey_t)
 
+inline uint qHash(const pixCacheKey_t &key, uint seed = 0)
+{
+  return qHash(key.uid, seed) ^ qHash((static_cast<quint64>(static_cast<quint32>(key.level)) << 32) |
+                                      static_cast<quint32>(key.pix), seed);
+}
+
+inline bool operator==(const pixCacheKey_t &k1, const pixCacheKey_t &k2)
+{
+  return (k1.uid == k2.uid) && (k1.level == k2.level) && (k1.pix == k2.pix);
+}
+
 #endif // HIPS_H
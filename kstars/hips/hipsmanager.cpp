@@ -22,19 +22,86 @@
 #include <QHash>
 #include <QNetworkDiskCache>
 #include <QPainter>
+#include <QtConcurrent>
 
 static QNetworkDiskCache *g_discCache = nullptr;
 static UrlFileDownload *g_download = nullptr;
 
-static int qHash(const pixCacheKey_t &key, uint seed)
+namespace
 {
-    return qHash(QString("%1_%2_%3").arg(key.level).arg(key.pix).arg(key.uid), seed);
-}
+// Level of the allsky image tiles in the memory cache.
+constexpr int ALLSKY_LEVEL = -1;
+// Number of tiles in the allsky image, of order 3.
+constexpr int ALLSKY_TILES = 12 * 64;
+// Width of the tiles in the allsky image.
+constexpr int ALLSKY_TILE_WIDTH = 64;
+
+typedef QVector<QPair<pixCacheKey_t, QImage>> DecodedTiles;
+
+QImage loadImage(const QByteArray &data, const QString &filename, const QByteArray &format)
+{
+    QImage image;
+
+    if (!data.isEmpty())
+        image.loadFromData(data, format.constData());
+    else
+    {
+        // Offline tiles are decoded straight from the mapped file, without copying it first.
+        QFile file(filename);
+        if (!file.open(QIODevice::ReadOnly))
+            return image;
+
+        uchar *memory = file.map(0, file.size());
+        if (memory)
+        {
+            image.loadFromData(memory, file.size(), format.constData());
+            file.unmap(memory);
+        }
+        else
+            image.loadFromData(file.readAll(), format.constData());
+    }
 
+    // The scan renderer reads 32 bits pixels, convert grayscale and paletted tiles once here.
+    if (!image.isNull() && image.depth() != 32)
+        image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32);
 
-inline bool operator==(const pixCacheKey_t &k1, const pixCacheKey_t &k2)
+    return image;
+}
+
+DecodedTiles decode(const pixCacheKey_t &key, const QByteArray &data, const QString &filename, const QByteArray &format)
 {
-    return (k1.uid == k2.uid) && (k1.level == k2.level) && (k1.pix == k2.pix);
+    DecodedTiles tiles;
+    QImage image = loadImage(data, filename, format);
+    if (image.isNull())
+        return tiles;
+
+    if (key.level != ALLSKY_LEVEL)
+    {
+        tiles.append(qMakePair(key, image));
+        return tiles;
+    }
+
+    // Slice the allsky image once so that its tiles can be rendered without copies.
+    const int columns = image.width() / ALLSKY_TILE_WIDTH;
+    if (columns == 0)
+        return tiles;
+
+    tiles.reserve(ALLSKY_TILES);
+    for (int pix = 0; pix < ALLSKY_TILES; pix++)
+    {
+        const int ox = pix % columns;
+        const int oy = pix / columns;
+        if ((oy + 1) * ALLSKY_TILE_WIDTH > image.height())
+            break;
+
+        pixCacheKey_t tileKey = key;
+        tileKey.pix = pix;
+        tiles.append(qMakePair(tileKey, image.copy(ox * ALLSKY_TILE_WIDTH, oy * ALLSKY_TILE_WIDTH, ALLSKY_TILE_WIDTH,
+                                                   ALLSKY_TILE_WIDTH)));
+    }
+
+    return tiles;
+}
 }
 
 HIPSManager * HIPSManager::_HIPSManager = nullptr;
@@ -79,8 +146,8 @@ HIPSManager::HIPSManager() : QObject(KStars::Instance())
     value = Options::hIPSMemoryCache() * 1024 * 1024;
     m_cache.setMaxCost(Options::hIPSMemoryCache() * 1024 * 1024);
 
-
-
+    // Leave a core to the GUI thread.
+    m_decodePool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
 }
 
 void HIPSManager::showSettings()
@@ -145,7 +212,7 @@ void HIPSManager::readSources()
   m_uid = qHash(param.url);
 }*/
 
-QImage *HIPSManager::getPix(bool allsky, int level, int pix, bool &freeImage)
+QImage *HIPSManager::getPix(bool allsky, int level, int pix, QRectF &uvRegion)
 {
     if (Options::hIPSUseOfflineSource() == false && m_currentSource.isEmpty())
     {
@@ -153,98 +220,92 @@ QImage *HIPSManager::getPix(bool allsky, int level, int pix, bool &freeImage)
         return nullptr;
     }
 
-    int origPix = pix;
-    freeImage = false;
-
-    if (allsky)
-    {
-        level = 0;
-        pix = 0;
-    }
+    uvRegion = QRectF(0, 0, 1, 1);
 
     pixCacheKey_t key;
 
-    key.level = level;
+    key.level = allsky ? ALLSKY_LEVEL : level;
     key.pix = pix;
     key.uid = m_uid;
 
     pixCacheItem_t *item = getCacheItem(key);
 
-    if (m_downloadMap.contains(key))
+    if (item != nullptr)
     {
-        // downloading
-
-        // try render (level - 1) while downloading
-        key.level = level - 1;
-        key.pix = pix / 4;
-        pixCacheItem_t *item = getCacheItem(key);
+        Q_ASSERT(!item->image->isNull());
+        return item->image;
+    }
 
-        if (item != nullptr)
-        {
-            QImage *cacheImage = item->image;
-            int size = m_currentTileWidth >> 1;
-            int offset = cacheImage->width() / size;
-            QImage *image = cacheImage;
+    // The allsky image is loaded once for all its tiles.
+    if (allsky)
+        key.pix = ALLSKY_TILES;
 
-            int index[4] = {0, 2, 1, 3};
+    if (m_downloadMap.contains(key) == false)
+    {
+        QString path;
 
-            int ox = index[pix % 4] % offset;
-            int oy = index[pix % 4] / offset;
+        if (!allsky)
+        {
+            int dir = (pix / 10000) * 10000;
 
-            QImage *newImage = new QImage(image->copy(ox * size, oy * size, size, size));
-            freeImage = true;
-            return newImage;
+            path = "/Norder" + QString::number(level) + "/Dir" + QString::number(dir) + "/Npix" + QString::number(pix) +
+                   '.' + m_currentFormat;
+        }
+        else
+        {
+            path = "/Norder3/Allsky." + m_currentFormat;
         }
-        return nullptr;
-    }
-
-    if (item != nullptr)
-    {
-        QImage *cacheImage = item->image;
 
-        Q_ASSERT(!item->image->isNull());
+        QUrl downloadURL(m_currentURL);
+        downloadURL.setPath(downloadURL.path() + path);
+        m_downloadMap.insert(key);
 
-        if (allsky && cacheImage != nullptr)
-        {
-            // all sky
-            int size = 64;
-            int offset = cacheImage->width() / size;
-            QImage *image = cacheImage;
+        // Local surveys are read directly by the decoders.
+        if (downloadURL.isLocalFile())
+            decodeTile(key, QByteArray(), downloadURL.toLocalFile());
+        else
+            g_download->begin(downloadURL, key);
+    }
 
-            int ox = origPix % offset;
-            int oy = origPix / offset;
+    // Render a lower resolution tile while loading
+    if (allsky)
+        return nullptr;
+    return getAncestorPix(level, pix, uvRegion);
+}
 
-            QImage *newImage = new QImage(image->copy(ox * size, oy * size, size, size));
-            freeImage = true;
-            return newImage;
-        }
+QImage *HIPSManager::getAncestorPix(int level, int pix, QRectF &uvRegion)
+{
+    pixCacheKey_t key;
 
-        return cacheImage;
-    }
+    key.level = level;
+    key.pix = pix;
+    key.uid = m_uid;
 
-    QString path;
+    // Offset of the tile in the ancestor, in tiles.
+    int ox = 0, oy = 0, scale = 1;
 
-    if (!allsky)
+    while (key.level > HIPS_MIN_ORDER)
     {
-        int dir = (pix / 10000) * 10000;
+        // The 4 children of a tile are ordered top left, bottom left, top right, bottom right.
+        const int child = key.pix % 4;
+        ox += ((child >> 1) & 1) * scale;
+        oy += (child & 1) * scale;
+        scale *= 2;
 
-        path = "/Norder" + QString::number(level) + "/Dir" + QString::number(dir) + "/Npix" + QString::number(pix) +
-               '.' + m_currentFormat;
-    }
-    else
-    {
-        path = "/Norder3/Allsky." + m_currentFormat;
-    }
+        key.level--;
+        key.pix /= 4;
 
-    QUrl downloadURL(m_currentURL);
-    downloadURL.setPath(downloadURL.path() + path);
-    g_download->begin(downloadURL, key);
-    m_downloadMap.insert(key);
+        pixCacheItem_t *item = getCacheItem(key);
+        if (item != nullptr)
+        {
+            uvRegion = QRectF(static_cast<double>(ox) / scale, static_cast<double>(oy) / scale, 1.0 / scale, 1.0 / scale);
+            return item->image;
+        }
+    }
 
     return nullptr;
 }
 
-
 #if 0
 bool HIPSManager::parseProperties(hipsParams_t *param, const QString &filename, const QString &url)
 {
@@ -348,22 +409,8 @@ void HIPSManager::slotDone(QNetworkReply::NetworkError error, QByteArray &data,
 {
     if (error == QNetworkReply::NoError)
     {
-        m_downloadMap.remove(key);
-
-        auto *item = new pixCacheItem_t;
-
-        item->image = new QImage();
-        if (item->image->loadFromData(data))
-        {
-            addToMemoryCache(key, item);
-
-            //SkyMap::Instance()->forceUpdate();
-        }
-        else
-        {
-            delete item;
-            qCWarning(KSTARS) << "no image" << data;
-        }
+        // The key stays in the download map until the tile is decoded.
+        decodeTile(key, data);
     }
     else
     {
@@ -373,13 +420,50 @@ void HIPSManager::slotDone(QNetworkReply::NetworkError error, QByteArray &data,
         }
         else
         {
-            auto *timer = new RemoveTimer();
-            timer->setKey(key);
-            connect(timer, SIGNAL(remove(pixCacheKey_t &)), this, SLOT(removeTimer(pixCacheKey_t &)));
+            retryLater(key);
         }
     }
 }
 
+void HIPSManager::decodeTile(const pixCacheKey_t &key, const QByteArray &data, const QString &filename)
+{
+    auto *watcher = new QFutureWatcher<DecodedTiles>(this);
+    connect(watcher, &QFutureWatcher<DecodedTiles>::finished, this, [this, watcher, key]()
+    {
+        pixCacheKey_t downloadKey = key;
+        const DecodedTiles tiles = watcher->result();
+        watcher->deleteLater();
+
+        if (tiles.isEmpty())
+        {
+            qCWarning(KSTARS) << "Failed to decode HiPS tile" << key.level << key.pix;
+            retryLater(downloadKey);
+            return;
+        }
+
+        m_downloadMap.remove(downloadKey);
+
+        for (const auto &oneTile : tiles)
+        {
+            pixCacheKey_t tileKey = oneTile.first;
+            auto *item = new pixCacheItem_t;
+            item->image = new QImage(oneTile.second);
+            addToMemoryCache(tileKey, item);
+        }
+
+        emit sigRepaint();
+    });
+
+    watcher->setFuture(QtConcurrent::run(&m_decodePool, decode, key, data, filename, m_currentFormat.toLatin1()));
+}
+
+void HIPSManager::retryLater(const pixCacheKey_t &key)
+{
+    auto *timer = new RemoveTimer();
+    timer->setKey(key);
+    connect(timer, SIGNAL(remove(pixCacheKey_t &)), this, SLOT(removeTimer(pixCacheKey_t &)));
+}
+
 void HIPSManager::removeTimer(pixCacheKey_t &key)
 {
     m_downloadMap.remove(key);
@@ -14,6 +14,7 @@
 #include "urlfiledownload.h"
 
 #include <QObject>
+#include <QThreadPool>
 
 #include <memory>
 
@@ -51,7 +52,14 @@ class HIPSManager : public QObject
 
         typedef enum { HIPS_EQUATORIAL_FRAME, HIPS_GALACTIC_FRAME, HIPS_OTHER_FRAME } HIPSFrame;
 
-        QImage *getPix(bool allsky, int level, int pix, bool &freeImage);
+        /**
+         * @brief getPix Returns the image of a HiPS tile from the memory cache, and starts loading it if it is missing.
+         * @param allsky Get the tile from the allsky image instead of the tiles of the level.
+         * @param uvRegion Region of the returned image that covers the tile, in UV coordinates. While a tile is
+         * loading, a quarter, sixteenth... of the closest ancestor in the cache is returned as a low resolution fallback.
+         * @return The tile image owned by the cache, or nullptr if neither the tile nor an ancestor is available.
+         */
+        QImage *getPix(bool allsky, int level, int pix, QRectF &uvRegion);
 
         void readSources();
 
@@ -120,6 +128,19 @@ class HIPSManager : public QObject
         void addToMemoryCache(pixCacheKey_t &key, pixCacheItem_t *item);
         pixCacheItem_t *getCacheItem(pixCacheKey_t &key);
 
+        // Closest ancestor of the tile in the memory cache, and the region of the ancestor covering the tile.
+        QImage *getAncestorPix(int level, int pix, QRectF &uvRegion);
+
+        /**
+         * @brief decodeTile Decodes the tile image in the decode thread pool and adds it to the memory cache.
+         * @param data Downloaded image, or empty to read the image from filename.
+         */
+        void decodeTile(const pixCacheKey_t &key, const QByteArray &data, const QString &filename = QString());
+        void retryLater(const pixCacheKey_t &key);
+
+        // Decoding happens out of the GUI thread in its own pool, so it doesn't compete with the global pool.
+        QThreadPool m_decodePool;
+
         // List of all sources in the database
         QList<QMap<QString, QString>> m_hipsSources;
 
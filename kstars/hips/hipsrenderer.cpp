@@ -15,6 +15,18 @@
 #include "skyqpainter.h"
 #include "projections/projector.h"
 
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+// Bands are not made smaller than this, as polygons crossing bands are scanned once per band.
+constexpr int MIN_BAND_HEIGHT = 64;
+}
+
 HIPSRenderer::HIPSRenderer()
 {
     m_scanRender.reset(new ScanRender());
@@ -44,6 +56,8 @@ bool HIPSRenderer::render(uint16_t w, uint16_t h, QImage *hipsImage, const Proje
     level = HIPSManager::Instance()->getUsableLevel(level);
 
     m_renderedMap.clear();
+    m_polygons.clear();
+    m_cells.clear();
     m_rendered = 0;
     m_blocks = 0;
     m_size = 0;
@@ -96,6 +110,10 @@ bool HIPSRenderer::render(uint16_t w, uint16_t h, QImage *hipsImage, const Proje
     m_scanRender->setBilinearInterpolationEnabled(Options::hIPSBiLinearInterpolation() && (size >= HIPSManager::Instance()->getCurrentTileWidth() || allSky));
 
     renderRec(allSky, level, centerPix, hipsImage);
+    renderPolygons(hipsImage);
+
+    if (Options::hIPSShowGrid())
+        renderGrid(hipsImage);
 
     m_scanRender->setBilinearInterpolationEnabled(old);
 
@@ -126,9 +144,11 @@ void HIPSRenderer::renderRec(bool allsky, int level, int pix, QImage *pDest)
 
 bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
 {
+    Q_UNUSED(pDest);
+
     SkyPoint cornerSkyCoords[4];
     QPointF cornerScreenCoords[4];
-    bool freeImage = false;
+    QRectF uvRegion;
 
     m_HEALpix->getCornerPoints(level, pix, cornerSkyCoords);
     bool isVisible = false;
@@ -151,7 +171,7 @@ bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
           trfProjectPointNoCheck(&pts[i]);
         } */
 
-        QImage *image = HIPSManager::Instance()->getPix(allsky, level, pix, freeImage);
+        QImage *image = HIPSManager::Instance()->getPix(allsky, level, pix, uvRegion);
 
         if (image)
         {
@@ -189,6 +209,17 @@ bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
                 {QPointF(1, 1), QPointF(1, 0.75), QPointF(.75, .75), QPointF(.75, 1)},
             };
 
+            // Map to the region of the image covering the pixel, e.g. a quarter of the parent tile while loading
+            if (uvRegion != QRectF(0, 0, 1, 1))
+            {
+                for (auto &onePolygon : uv)
+                {
+                    for (auto &onePoint : onePolygon)
+                        onePoint = QPointF(uvRegion.x() + onePoint.x() * uvRegion.width(),
+                                           uvRegion.y() + onePoint.y() * uvRegion.height());
+                }
+            }
+
             int childPixelID[4];
 
             // Find all the 4 children of the current pixel
@@ -205,38 +236,36 @@ bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
                 // system.
                 m_HEALpix->getPixChilds(id, grandChildPixelID);
 
-                QPointF fineScreenCoords[4];
-
                 for (int id2 : grandChildPixelID)
                 {
                     SkyPoint fineSkyPoints[4];
                     m_HEALpix->getCornerPoints(level + 2, id2, fineSkyPoints);
 
+                    // The polygons are rasterized once all the visible cells are found, see renderPolygons()
+                    Polygon polygon;
+                    polygon.image = image;
                     for (int i = 0; i < 4; i++)
-                        fineScreenCoords[i] = m_projector->toScreen(&fineSkyPoints[i]);
-                    m_scanRender->renderPolygon(3, fineScreenCoords, pDest, image, uv[j]);
+                    {
+                        polygon.points[i] = m_projector->toScreen(&fineSkyPoints[i]);
+                        polygon.uv[i] = uv[j][i];
+                    }
+                    polygon.top = std::floor(std::min({polygon.points[0].y(), polygon.points[1].y(),
+                                                       polygon.points[2].y(), polygon.points[3].y()}));
+                    polygon.bottom = std::ceil(std::max({polygon.points[0].y(), polygon.points[1].y(),
+                                                         polygon.points[2].y(), polygon.points[3].y()}));
+                    m_polygons.append(polygon);
                     j++;
                 }
             }
-
-            if (freeImage)
-            {
-                delete image;
-            }
         }
 
         if (Options::hIPSShowGrid())
         {
-            QPainter p(pDest);
-            p.setRenderHint(QPainter::Antialiasing);
-            p.setPen(gridColor);
-
-            p.drawLine(cornerScreenCoords[0].x(), cornerScreenCoords[0].y(), cornerScreenCoords[1].x(), cornerScreenCoords[1].y());
-            p.drawLine(cornerScreenCoords[1].x(), cornerScreenCoords[1].y(), cornerScreenCoords[2].x(), cornerScreenCoords[2].y());
-            p.drawLine(cornerScreenCoords[2].x(), cornerScreenCoords[2].y(), cornerScreenCoords[3].x(), cornerScreenCoords[3].y());
-            p.drawLine(cornerScreenCoords[3].x(), cornerScreenCoords[3].y(), cornerScreenCoords[0].x(), cornerScreenCoords[0].y());
-            p.drawText((cornerScreenCoords[0].x() + cornerScreenCoords[1].x() + cornerScreenCoords[2].x() + cornerScreenCoords[3].x()) / 4,
-                       (cornerScreenCoords[0].y() + cornerScreenCoords[1].y() + cornerScreenCoords[2].y() + cornerScreenCoords[3].y()) / 4, QString::number(pix) + " / " + QString::number(level));
+            Cell cell;
+            std::copy(cornerScreenCoords, cornerScreenCoords + 4, cell.corners);
+            cell.pix = pix;
+            cell.level = level;
+            m_cells.append(cell);
         }
 
         return true;
@@ -244,3 +273,75 @@ bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
 
     return false;
 }
+
+void HIPSRenderer::renderPolygons(QImage *pDest)
+{
+    const int height = pDest->height();
+    // HiPS tiles cover the view evenly, so one band per core balances well enough. Each rasterizer
+    // holds a large scanline table, so the number of bands is kept low.
+    const int bandCount = std::max(1, std::min(QThread::idealThreadCount(), height / MIN_BAND_HEIGHT));
+    const int bandHeight = (height + bandCount - 1) / bandCount;
+
+    while (static_cast<int>(m_bandRenders.size()) < bandCount)
+        m_bandRenders.emplace_back(new ScanRender());
+
+    // Each band gets the polygons overlapping it, in the order they were found, so that the result
+    // is the same as rendering all the polygons in sequence.
+    QVector<QVector<int>> bins(bandCount);
+    for (int i = 0; i < m_polygons.size(); i++)
+    {
+        const Polygon &polygon = m_polygons[i];
+        if (polygon.bottom < 0 || polygon.top >= height)
+            continue;
+
+        const int first = std::max(0, polygon.top) / bandHeight;
+        const int last = std::min(height - 1, polygon.bottom) / bandHeight;
+        for (int band = first; band <= last; band++)
+            bins[band].append(i);
+    }
+
+    // The bands write to distinct rows of the same buffer, each through its own image so that
+    // the destination image is not accessed from several threads.
+    QVector<QImage> bandImages;
+    uchar *bits = pDest->bits();
+    for (int band = 0; band < bandCount; band++)
+        bandImages.append(QImage(bits, pDest->width(), height, pDest->bytesPerLine(), pDest->format()));
+
+    const bool bilinear = m_scanRender->isBilinearInterpolationEnabled();
+
+    QVector<int> bands(bandCount);
+    std::iota(bands.begin(), bands.end(), 0);
+
+    QtConcurrent::blockingMap(bands, [&](int band)
+    {
+        ScanRender *scanRender = m_bandRenders[band].get();
+        scanRender->setBilinearInterpolationEnabled(bilinear);
+        scanRender->setClipRows(band * bandHeight, std::min(height, (band + 1) * bandHeight) - 1);
+
+        for (int index : bins[band])
+        {
+            const Polygon &polygon = m_polygons[index];
+            scanRender->renderPolygon(3, polygon.points, &bandImages[band], polygon.image, polygon.uv);
+        }
+    });
+}
+
+void HIPSRenderer::renderGrid(QImage *pDest)
+{
+    QPainter p(pDest);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(gridColor);
+
+    for (const Cell &cell : qAsConst(m_cells))
+    {
+        const QPointF *cornerScreenCoords = cell.corners;
+
+        p.drawLine(cornerScreenCoords[0].x(), cornerScreenCoords[0].y(), cornerScreenCoords[1].x(), cornerScreenCoords[1].y());
+        p.drawLine(cornerScreenCoords[1].x(), cornerScreenCoords[1].y(), cornerScreenCoords[2].x(), cornerScreenCoords[2].y());
+        p.drawLine(cornerScreenCoords[2].x(), cornerScreenCoords[2].y(), cornerScreenCoords[3].x(), cornerScreenCoords[3].y());
+        p.drawLine(cornerScreenCoords[3].x(), cornerScreenCoords[3].y(), cornerScreenCoords[0].x(), cornerScreenCoords[0].y());
+        p.drawText((cornerScreenCoords[0].x() + cornerScreenCoords[1].x() + cornerScreenCoords[2].x() + cornerScreenCoords[3].x()) / 4,
+                   (cornerScreenCoords[0].y() + cornerScreenCoords[1].y() + cornerScreenCoords[2].y() + cornerScreenCoords[3].y()) / 4,
+                   QString::number(cell.pix) + " / " + QString::number(cell.level));
+    }
+}
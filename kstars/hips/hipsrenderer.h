@@ -13,6 +13,7 @@
 #include "scanrender.h"
 
 #include <memory>
+#include <vector>
 
 class Projector;
 
@@ -30,13 +31,39 @@ signals:
 
 public slots:
 
-private:  
+private:
+  // A polygon of a HEALPix cell, with its corners on the screen and in the tile image.
+  struct Polygon
+  {
+    QPointF points[4];
+    QPointF uv[4];
+    QImage *image { nullptr };
+    int top { 0 };
+    int bottom { 0 };
+  };
+
+  // A visible cell, for the grid.
+  struct Cell
+  {
+    QPointF corners[4];
+    int pix { 0 };
+    int level { 0 };
+  };
+
+  // Bins the polygons in horizontal bands of the destination image and rasterizes the bands in parallel.
+  void renderPolygons(QImage *pDest);
+  void renderGrid(QImage *pDest);
+
   int m_blocks { 0 };
   int m_rendered { 0 };
   int m_size { 0 };
   QSet<int>  m_renderedMap;
   std::unique_ptr<HEALPix> m_HEALpix;
   std::unique_ptr<ScanRender> m_scanRender;
+  // One rasterizer per band, as a rasterizer keeps the scanlines of the polygon being rendered.
+  std::vector<std::unique_ptr<ScanRender>> m_bandRenders;
+  QVector<Polygon> m_polygons;
+  QVector<Cell> m_cells;
   const Projector *m_projector;
   QColor gridColor;
 };
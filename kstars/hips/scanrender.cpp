@@ -19,6 +19,22 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wcast-align"
 
+// Linear interpolation of two ARGB pixels with a weight f in 1/256th, red and blue then alpha and
+// green are interpolated at once in the two 16 bits halves of a word, since a channel times a weight
+// cannot overflow 16 bits.
+static inline quint32 lerpPixel(quint32 p, quint32 q, int f)
+{
+  const quint32 rb = ((((p & 0xff00ff) * (256 - f)) + ((q & 0xff00ff) * f)) >> 8) & 0xff00ff;
+  const quint32 ag = ((((p >> 8) & 0xff00ff) * (256 - f)) + (((q >> 8) & 0xff00ff) * f)) & 0xff00ff00;
+  return rb | ag;
+}
+
+// Bilinear interpolation of the texels a (top left), b (top right), c (bottom left) and d (bottom right).
+static inline quint32 bilinear(quint32 a, quint32 b, quint32 c, quint32 d, int fx, int fy)
+{
+  return lerpPixel(lerpPixel(a, b, fx), lerpPixel(c, d, fx), fy);
+}
+
 //////////////////////////////
 ScanRender::ScanRender(void)
 //////////////////////////////
@@ -39,6 +55,14 @@ bool ScanRender::isBilinearInterpolationEnabled()
   return(bBilinear);
 }
 
+///////////////////////////////////////////////
+void ScanRender::setClipRows(int top, int bottom)
+///////////////////////////////////////////////
+{
+  m_clipTop = top;
+  m_clipBottom = bottom;
+}
+
 ///////////////////////////////////////////////
 void ScanRender::resetScanPoly(int sx, int sy)
 ///////////////////////////////////////////////
@@ -54,6 +78,8 @@ void ScanRender::resetScanPoly(int sx, int sy)
 
   m_sx = sx;
   m_sy = sy;
+  m_top = qMax(0, m_clipTop);
+  m_bottom = qMin(sy - 1, m_clipBottom);
 }
 
 //////////////////////////////////////////////////////////
@@ -73,12 +99,12 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2)
     side = 1;
   }
 
-  if (y2 < 0)
+  if (y2 < m_top)
   {
     return; // offscreen
   }
 
-  if (y1 >= m_sy)
+  if (y1 > m_bottom)
   {
     return; // offscreen
   }
@@ -94,17 +120,17 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2)
   float x = x1;
   int   y;
 
-  if (y2 >= m_sy)
+  if (y2 > m_bottom)
   {
-    y2 = m_sy - 1;
+    y2 = m_bottom;
   }
 
-  if (y1 < 0)
+  if (y1 < m_top)
   { // partially off screen
-    float m = (float) -y1;
+    float m = (float) (m_top - y1);
 
     x += dx * m;
-    y1 = 0;
+    y1 = m_top;
   }
 
   int minY = qMin(y1, y2);
@@ -168,9 +194,9 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
     side = 1;
   }
 
-  if (y2 < 0)
+  if (y2 < m_top)
     return; // offscreen
-  if (y1 >= m_sy)
+  if (y1 > m_bottom)
     return; // offscreen
 
   float dy = (float)(y2 - y1);
@@ -182,8 +208,8 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
   float x = x1;
   int   y;
 
-  if (y2 >= m_sy)
-    y2 = m_sy - 1;
+  if (y2 > m_bottom)
+    y2 = m_bottom;
 
   float duv[2];
   float uv[2] = {u1, v1};
@@ -191,15 +217,15 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
   duv[0] = (u2 - u1) / dy;
   duv[1] = (v2 - v1) / dy;
 
-  if (y1 < 0)
+  if (y1 < m_top)
   { // partially off screen
-    float m = (float) -y1;
+    float m = (float) (m_top - y1);
 
     uv[0] += duv[0] * m;
     uv[1] += duv[1] * m;
 
     x += dx * m;
-    y1 = 0;
+    y1 = m_top;
   }
 
   int minY = qMin(y1, y2);
@@ -333,7 +359,7 @@ void ScanRender::renderPolygon(QImage *dst, QImage *src)
     renderPolygonNI(dst, src);
 }
 
-void ScanRender::renderPolygon(int interpolation, QPointF *pts, QImage *pDest, QImage *pSrc, QPointF *uv)
+void ScanRender::renderPolygon(int interpolation, const QPointF *pts, QImage *pDest, QImage *pSrc, const QPointF *uv)
 {
   QPointF Auv = uv[0];
   QPointF Buv = uv[1];
@@ -599,40 +625,37 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
     }
     else
     {
-      for (int x = px1; x < px2; x++)
-      {
-        float x_diff = uv[0] - static_cast<int>(uv[0]);
-        float y_diff = uv[1] - static_cast<int>(uv[1]);
-        float x_1diff = 1 - x_diff;
-        float y_1diff = 1 - y_diff;
-
-        int index = ((int)uv[0] + ((int)uv[1] * sw));
+      // 16.16 fixed point source coordinates
+      int fuv[2];
+      int fduv[2];
 
-        quint32 a = bitsSrc[index];
-        quint32 b = bitsSrc[(index + 1) % size];
-        quint32 c = bitsSrc[(index + sw) % size];
-        quint32 d = bitsSrc[(index + sw + 1) % size];
+      fuv[0] = uv[0] * 65536;
+      fuv[1] = uv[1] * 65536;
 
-        int qxy1 = (x_1diff * y_1diff) * 65536;
-        int qxy2 =(x_diff * y_1diff) * 65536;
-        int qxy = (x_diff * y_diff) * 65536;
-        int qyx1 = (y_diff * x_1diff) * 65536;
+      fduv[0] = duv[0] * 65536;
+      fduv[1] = duv[1] * 65536;
 
-        // blue element
-        int blue = ((a&0xff)*(qxy1) + (b&0xff)*(qxy2) + (c&0xff)*(qyx1)  + (d&0xff)*(qxy)) >> 16;
+      const int maxU = (sw - 1) << 16;
+      const int maxV = (sh - 1) << 16;
 
-        // green element
-        int green = (((a>>8)&0xff)*(qxy1) + ((b>>8)&0xff)*(qxy2) + ((c>>8)&0xff)*(qyx1)  + ((d>>8)&0xff)*(qxy)) >> 16;
+      for (int x = px1; x < px2; x++)
+      {
+        const int u = CLAMP(fuv[0], 0, maxU);
+        const int v = CLAMP(fuv[1], 0, maxV);
+        const int sx = u >> 16;
+        const int sy = v >> 16;
 
-        // red element
-        int red = (((a>>16)&0xff)*(qxy1) + ((b>>16)&0xff)*(qxy2) +((c>>16)&0xff)*(qyx1)  + ((d>>16)&0xff)*(qxy)) >> 16;
+        // Texels on the right and bottom edges are interpolated with themselves
+        const quint32 *top = bitsSrc + sy * sw;
+        const quint32 *bottom = (sy < sh - 1) ? top + sw : top;
+        const int sx1 = (sx < sw - 1) ? sx + 1 : sx;
 
-        *pDst = 0xff000000 | (((red)<<16)&0xff0000) | (((green)<<8)&0xff00) | (blue);
+        *pDst = 0xff000000 | bilinear(top[sx], top[sx1], bottom[sx], bottom[sx1], (u >> 8) & 0xff, (v >> 8) & 0xff);
 
         pDst++;
 
-        uv[0] += duv[0];
-        uv[1] += duv[1];
+        fuv[0] += fduv[0];
+        fuv[1] += fduv[1];
       }
     }
   }
@@ -11,6 +11,8 @@
 #include <QtCore>
 #include <QtGui>
 
+#include <limits>
+
 #define MAX_BK_SCANLINES      32000
 
 typedef struct
@@ -26,12 +28,14 @@ class ScanRender
     explicit ScanRender(void);
     void setBilinearInterpolationEnabled(bool enable);
     bool isBilinearInterpolationEnabled(void);
+    // Restricts rendering to the destination rows from top to bottom, e.g. to render bands in parallel.
+    void setClipRows(int top, int bottom);
     void resetScanPoly(int sx, int sy);
     void scanLine(int x1, int y1, int x2, int y2);
     void scanLine(int x1, int y1, int x2, int y2, float u1, float v1, float u2, float v2);
     void renderPolygon(QColor col, QImage *dst);
     void renderPolygon(QImage *dst, QImage *src);
-    void renderPolygon(int interpolation, QPointF *pts, QImage *pDest, QImage *pSrc, QPointF *uv);
+    void renderPolygon(int interpolation, const QPointF *pts, QImage *pDest, QImage *pSrc, const QPointF *uv);
 
     void renderPolygonNI(QImage *dst, QImage *src);
     void renderPolygonBI(QImage *dst, QImage *src);
@@ -49,6 +53,11 @@ private:
     int      plMaxY { 0 };
     int      m_sx { 0 };
     int      m_sy { 0 };
+    int      m_clipTop { 0 };
+    int      m_clipBottom { std::numeric_limits<int>::max() };
+    // First and last rows rendered, within the image and the clip rows.
+    int      m_top { 0 };
+    int      m_bottom { -1 };
     bkScan_t scLR[MAX_BK_SCANLINES];
     bool     bBilinear { false };
 };
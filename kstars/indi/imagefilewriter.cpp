@@ -0,0 +1,245 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "imagefilewriter.h"
+
+#include "Options.h"
+#include "indi_debug.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+#include <fitsio.h>
+
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ISD
+{
+
+ImageFileWriter *ImageFileWriter::_ImageFileWriter = nullptr;
+
+ImageFileWriter *ImageFileWriter::Instance()
+{
+    if (_ImageFileWriter == nullptr)
+        _ImageFileWriter = new ImageFileWriter();
+    return _ImageFileWriter;
+}
+
+ImageFileWriter::ImageFileWriter()
+{
+    // Threads are only kept while frames are written
+    m_Pool.setExpiryTimeout(30000);
+}
+
+void ImageFileWriter::queue(const QString &filename, const QByteArray &data, bool compress, bool sync)
+{
+    // Several frames are only compressed at once if cfitsio supports it
+    const int threads = (compress && !fits_is_reentrant()) ? 1 : std::max(1u, Options::captureWriteThreads());
+    if (m_Pool.maxThreadCount() != threads)
+        m_Pool.setMaxThreadCount(threads);
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Capacity = static_cast<qint64>(std::max(1u, Options::captureWriteQueueSize())) * 1024 * 1024;
+        // This runs on the thread receiving the frames, which must not wait for the storage. A frame over the
+        // size of the queue is accepted anyway, the congestion keeps Capture from starting the next exposure.
+        if (m_PendingFiles > 0 && m_PendingBytes + data.size() > m_Capacity)
+            qCWarning(KSTARS_INDI) << "Image write queue is full, queuing" << filename << "over its size";
+        m_PendingBytes += data.size();
+        m_PendingFiles++;
+    }
+    updateCongestion();
+
+    // The blob is reused for the next frame, the queue owns a copy.
+    QByteArray copy(data.constData(), data.size());
+    QtConcurrent::run(&m_Pool, [this, filename, copy, compress, sync]()
+    {
+        writeQueued(filename, copy, compress, sync);
+    });
+}
+
+void ImageFileWriter::writeQueued(const QString &filename, const QByteArray &data, bool compress, bool sync)
+{
+    QString error;
+    if (!write(filename, data, compress, sync, &error))
+    {
+        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to write" << filename << error;
+        emit writeFailed(filename, error);
+    }
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_PendingBytes -= data.size();
+        m_PendingFiles--;
+    }
+    updateCongestion();
+}
+
+void ImageFileWriter::waitForDone()
+{
+    m_Pool.waitForDone();
+}
+
+bool ImageFileWriter::isCongested() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Congested;
+}
+
+void ImageFileWriter::updateCongestion()
+{
+    bool changed = false, congested = false;
+    {
+        QMutexLocker locker(&m_Mutex);
+        // Hysteresis, so that Capture does not stop and resume on every frame
+        if (!m_Congested && m_PendingBytes > m_Capacity / 2)
+            m_Congested = changed = true;
+        else if (m_Congested && m_PendingBytes < m_Capacity / 4)
+        {
+            m_Congested = false;
+            changed     = true;
+        }
+        congested = m_Congested;
+    }
+
+    if (changed)
+    {
+        qCInfo(KSTARS_INDI) << (congested ? "Storage is lagging behind the captured frames." : "Storage caught up with the captured frames.");
+        emit congestionChanged(congested);
+    }
+}
+
+bool ImageFileWriter::write(const QString &filename, const QByteArray &data, bool compress, bool sync, QString *error)
+{
+    bool ok = compress ? writeCompressed(filename, data, error) : writeRaw(filename, data, error);
+    if (!ok)
+        return false;
+
+    QFile::setPermissions(filename, QFileDevice::ReadUser |
+                          QFileDevice::WriteUser |
+                          QFileDevice::ReadGroup |
+                          QFileDevice::ReadOther);
+
+    if (sync && !syncFile(filename))
+    {
+        if (error)
+            *error = QString("Unable to flush %1 to storage").arg(filename);
+        return false;
+    }
+    return true;
+}
+
+bool ImageFileWriter::writeRaw(const QString &filename, const QByteArray &data, QString *error)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+
+    bool ok = file.write(data) == data.size();
+    ok = file.flush() && ok;
+    if (!ok && error)
+        *error = file.errorString();
+    file.close();
+    return ok;
+}
+
+bool ImageFileWriter::writeCompressed(const QString &filename, const QByteArray &data, QString *error)
+{
+    fitsfile *in = nullptr, *out = nullptr;
+    int status = 0;
+    char errmsg[FLEN_ERRMSG];
+
+    void *memory = const_cast<char *>(data.constData());
+    size_t memorySize = data.size();
+    if (fits_open_memfile(&in, "", READONLY, &memory, &memorySize, 0, nullptr, &status))
+    {
+        fits_get_errstatus(status, errmsg);
+        if (error)
+            *error = QString(errmsg);
+        return false;
+    }
+
+    // ! replaces the empty file created when the file name was generated
+    const QByteArray outName = QString("!%1").arg(filename).toLocal8Bit();
+    if (fits_create_file(&out, outName.constData(), &status))
+    {
+        fits_get_errstatus(status, errmsg);
+        if (error)
+            *error = QString(errmsg);
+        status = 0;
+        fits_close_file(in, &status);
+        return false;
+    }
+
+    int hdus = 0;
+    fits_get_num_hdus(in, &hdus, &status);
+    for (int i = 1; i <= hdus && status == 0; i++)
+    {
+        int hduType = 0, naxis = 0, bitpix = 0;
+        fits_movabs_hdu(in, i, &hduType, &status);
+        if (hduType == IMAGE_HDU)
+        {
+            fits_get_img_dim(in, &naxis, &status);
+            fits_get_img_type(in, &bitpix, &status);
+        }
+
+        if (status == 0 && hduType == IMAGE_HDU && naxis > 0)
+        {
+            // Rice is lossless for integer images, floating point images would be quantized, use GZIP instead.
+            fits_set_compression_type(out, bitpix > 0 ? RICE_1 : GZIP_2, &status);
+            if (bitpix < 0)
+                fits_set_quantize_level(out, 0, &status);
+            fits_img_compress(in, out, &status);
+        }
+        else
+            fits_copy_hdu(in, out, 0, &status);
+    }
+
+    if (status)
+    {
+        fits_get_errstatus(status, errmsg);
+        if (error)
+            *error = QString(errmsg);
+    }
+
+    int closeStatus = 0;
+    fits_close_file(out, &closeStatus);
+    if (status == 0 && closeStatus)
+    {
+        fits_get_errstatus(closeStatus, errmsg);
+        if (error)
+            *error = QString(errmsg);
+    }
+    int inStatus = 0;
+    fits_close_file(in, &inStatus);
+
+    return status == 0 && closeStatus == 0;
+}
+
+bool ImageFileWriter::syncFile(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadWrite))
+        return false;
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+namespace ISD
+{
+
+/**
+ * @class ImageFileWriter
+ * @short Writes the captured frames to disk on background threads.
+ *
+ * Frames are copied into a queue bounded by its size in bytes, and written by a pool of writer threads, so
+ * receiving the next frame does not wait for the previous one to reach the disk. Queueing never blocks the
+ * caller: a frame that does not fit the queue is still accepted and the writer reports that storage is
+ * lagging, so that no new exposure is started until the queue drains.
+ *
+ * FITS frames can be written tile-compressed (Rice for integer images, lossless GZIP for floating point
+ * images), as fpack does, which reduces the written size two to three times for typical frames. Several
+ * frames are compressed in parallel when cfitsio is thread-safe.
+ *
+ * When the queue grows over half of its size, the writer reports that storage is lagging, so that Capture
+ * can delay the next exposure until the queue drains below a quarter of its size.
+ */
+class ImageFileWriter : public QObject
+{
+        Q_OBJECT
+
+    public:
+        static ImageFileWriter *Instance();
+
+        /**
+         * @brief queue Queues a frame to be written to disk.
+         * @param filename file to write, replaced if it exists
+         * @param data content of the file, copied
+         * @param compress true to write a FITS frame tile-compressed
+         * @param sync true to flush the file to storage before the write is done
+         */
+        void queue(const QString &filename, const QByteArray &data, bool compress, bool sync);
+
+        /** @brief waitForDone Waits until all queued frames are written. */
+        void waitForDone();
+
+        /** @return true while the storage does not keep up with the captured frames */
+        bool isCongested() const;
+
+        /**
+         * @brief write Writes a file synchronously on the calling thread.
+         * @param filename file to write, replaced if it exists
+         * @param data content of the file
+         * @param compress true to write a FITS frame tile-compressed
+         * @param sync true to flush the file to storage before returning
+         * @param error set to the reason of the failure
+         * @return true on success
+         */
+        static bool write(const QString &filename, const QByteArray &data, bool compress, bool sync,
+                          QString *error = nullptr);
+
+    signals:
+        /** Emitted when the storage starts or stops lagging behind the captured frames */
+        void congestionChanged(bool congested);
+        /** Emitted when a queued frame could not be written */
+        void writeFailed(const QString &filename, const QString &error);
+
+    private:
+        ImageFileWriter();
+
+        void writeQueued(const QString &filename, const QByteArray &data, bool compress, bool sync);
+        static bool writeRaw(const QString &filename, const QByteArray &data, QString *error);
+        static bool writeCompressed(const QString &filename, const QByteArray &data, QString *error);
+        static bool syncFile(const QString &filename);
+        void updateCongestion();
+
+        static ImageFileWriter *_ImageFileWriter;
+
+        QThreadPool m_Pool;
+        mutable QMutex m_Mutex;
+        // Size of the queue in bytes, read from the options when queuing as the writer threads do not access them
+        qint64 m_Capacity { 0 };
+        // Bytes of the frames queued or being written
+        qint64 m_PendingBytes { 0 };
+        int m_PendingFiles { 0 };
+        bool m_Congested { false };
+};
+
+}
@@ -6,6 +6,7 @@
 
 #include "indicamera.h"
 #include "indicamerachip.h"
+#include "imagefilewriter.h"
 
 #include "config-kstars.h"
 
@@ -19,6 +20,7 @@
 #ifdef HAVE_CFITSIO
 #include "fitsviewer/fitsdata.h"
 #endif
+#include "auxiliary/monotonicclock.h"
 
 #include <KNotifications/KNotification>
 #include "auxiliary/ksmessagebox.h"
@@ -55,10 +57,8 @@ Camera::~Camera()
 {
     if (m_ImageViewerWindow)
         m_ImageViewerWindow->close();
-    if (fileWriteThread.isRunning())
-        fileWriteThread.waitForFinished();
-    if (fileWriteBuffer != nullptr)
-        delete [] fileWriteBuffer;
+    // Frames of this camera may still be queued
+    ImageFileWriter::Instance()->waitForDone();
 }
 
 void Camera::setBLOBManager(const char *device, INDI::Property prop)
@@ -561,44 +561,25 @@ bool Camera::generateFilename(bool batch_mode, const QString &extension, QString
 
 bool Camera::writeImageFile(const QString &filename, INDI::Property prop, bool is_fits)
 {
+    auto bp = prop.getBLOB()->at(0);
+    QByteArray const data = QByteArray::fromRawData(static_cast<char *>(bp->getBlob()), bp->getBlobLen());
+
     // TODO: Not yet threading the writes for non-fits files.
     // Would need to deal with the raw conversion, etc.
     if (is_fits)
     {
-        // Check if the last write is still ongoing, and if so wait.
-        // It is using the fileWriteBuffer.
-        if (fileWriteThread.isRunning())
-        {
-            fileWriteThread.waitForFinished();
-        }
-
-        // Wait until the file is written before overwritting the filename.
-        fileWriteFilename = filename;
-
-        // Will write blob data in a separate thread, and can't depend on the blob
-        // memory, so copy it first.
-
-        auto bp = prop.getBLOB()->at(0);
-        // Check buffer size.
-        if (fileWriteBufferSize != bp->getBlobLen())
-        {
-            if (fileWriteBuffer != nullptr)
-                delete [] fileWriteBuffer;
-            fileWriteBufferSize = bp->getBlobLen();
-            fileWriteBuffer = new char[fileWriteBufferSize];
-        }
-
-        // Copy memory, and write file on a separate thread.
-        // Probably too late to return an error if the file couldn't write.
-        memcpy(fileWriteBuffer, bp->getBlob(), bp->getBlobLen());
-        fileWriteThread = QtConcurrent::run(this, &ISD::Camera::WriteImageFileInternal, fileWriteFilename, fileWriteBuffer,
-                                            bp->getBlobLen());
+        // Write the file on the writer threads, which copy the blob.
+        // Probably too late to return an error if the file couldn't write, see ImageFileWriter::writeFailed.
+        ImageFileWriter::Instance()->queue(filename, data, Options::compressCapturedFITS(), Options::captureWriteSync());
     }
     else
     {
-        auto bp = prop.getBLOB()->at(0);
-        if (!WriteImageFileInternal(filename, static_cast<char*>(bp->getBlob()), bp->getBlobLen()))
+        QString errorMessage;
+        if (!ImageFileWriter::write(filename, data, false, Options::captureWriteSync(), &errorMessage))
+        {
+            qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to write file:" << filename << errorMessage;
             return false;
+        }
     }
     return true;
 }
@@ -653,6 +634,9 @@ bool Camera::processBLOB(INDI::Property prop)
     if (bvp->getPermission() == IP_WO || bvp->at(0)->getSize() == 0)
         return false;
 
+    // Used by the guide latency instrumentation
+    const qint64 blobReceived = MonotonicClock::timestamp();
+
     BType = BLOB_OTHER;
 
     auto bp = bvp->at(0);
@@ -720,7 +704,9 @@ bool Camera::processBLOB(INDI::Property prop)
     {
         // If either generating file name or writing the image file fails
         // then return
-        if (!generateFilename(targetChip->isBatchMode(), format, &filename) ||
+        // Compressed FITS frames get the extension used by fpack
+        const bool compressed = BType == BLOB_FITS && Options::compressCapturedFITS();
+        if (!generateFilename(targetChip->isBatchMode(), compressed ? format + ".fz" : format, &filename) ||
                 !writeImageFile(filename, prop, BType == BLOB_FITS))
         {
             connect(KSMessageBox::Instance(), &KSMessageBox::accepted, this, [ = ]()
@@ -858,6 +844,8 @@ bool Camera::processBLOB(INDI::Property prop)
         emit error(ERROR_LOAD);
         return true;
     }
+    imageData->setProperty("blobReceived", blobReceived);
+    imageData->setProperty("imageLoaded", MonotonicClock::timestamp());
 
     handleImage(targetChip, filename, prop, imageData);
     return true;
@@ -1784,37 +1772,6 @@ bool Camera::setScopeInfo(double focalLength, double aperture)
     return true;
 }
 
-// Internal function to write an image blob to disk.
-bool Camera::WriteImageFileInternal(const QString &filename, char *buffer, const size_t size)
-{
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly))
-    {
-        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to open write file: " <<
-                                filename;
-        return false;
-    }
-    int n = 0;
-    QDataStream out(&file);
-    bool ok = true;
-    for (size_t nr = 0; nr < size; nr += n)
-    {
-        n = out.writeRawData(buffer + nr, size - nr);
-        if (n < 0)
-        {
-            ok = false;
-            break;
-        }
-    }
-    ok = file.flush() && ok;
-    file.close();
-    file.setPermissions(QFileDevice::ReadUser |
-                        QFileDevice::WriteUser |
-                        QFileDevice::ReadGroup |
-                        QFileDevice::ReadOther);
-    return ok;
-}
-
 QString Camera::getCaptureFormat() const
 {
     if (m_CaptureFormatIndex < 0 || m_CaptureFormats.isEmpty() || m_CaptureFormatIndex > m_CaptureFormats.size())
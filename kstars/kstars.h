@@ -464,6 +464,17 @@ class KStars : public KXmlGuiWindow
              */
         Q_SCRIPTABLE QString getSkyMapDimensions();
 
+        /** DBUS interface function.  Get the time spent in each part of the last sky map frame.
+             * @return a newline-separated list, the frame time first, then the sections from the slowest.
+             * Empty if the frames are not profiled, see setRenderProfiling().
+             */
+        Q_SCRIPTABLE QString getRenderProfile();
+
+        /** DBUS interface function.  Profile the sky map frames even if the render profile is not shown.
+             * @param enable true to profile the frames
+             */
+        Q_SCRIPTABLE Q_NOREPLY void setRenderProfiling(bool enable);
+
         /** DBUS interface function.  Return a newline-separated list of objects in the observing wishlist.
              * @note Unfortunately, unnamed objects are troublesome. Hopefully, we don't have them on the observing list.
              */
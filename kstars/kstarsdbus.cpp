@@ -15,6 +15,7 @@
 #include "kstarsdata.h"
 #include "observinglist.h"
 #include "Options.h"
+#include "renderprofiler.h"
 #include "skymap.h"
 #include "skycomponents/constellationboundarylines.h"
 #include "skycomponents/skymapcomposite.h"
@@ -975,6 +976,18 @@ QString KStars::getSkyMapDimensions()
 {
     return (QString::number(map()->width()) + 'x' + QString::number(map()->height()));
 }
+
+QString KStars::getRenderProfile()
+{
+    return RenderProfiler::Instance()->report().join('\n');
+}
+
+void KStars::setRenderProfiling(bool enable)
+{
+    RenderProfiler::Instance()->setForced(enable);
+    map()->forceUpdate();
+}
+
 void KStars::printImage(bool usePrintDialog, bool useChartColors)
 {
     //QPRINTER_FOR_NOW
@@ -18,6 +18,7 @@
 #include "projections/projector.h"
 #include "skynodes/pointsourcenode.h"
 #include "skynodes/trixelnode.h"
+#include "skynodes/nodes/starbatchnode.h"
 
 DeepStarItem::DeepStarItem(DeepStarComponent *deepStarComp, RootNode *rootNode)
     : SkyItem(LabelsItem::label_t::NO_LABEL, rootNode), m_deepStarComp(deepStarComp),
@@ -169,20 +170,7 @@ void DeepStarItem::update()
 
                     if (trixel->hideCount() > delLim)
                     {
-                        QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = trixel->m_nodes.begin();
-
-                        while (i != trixel->m_nodes.end())
-                        {
-                            SkyNode *node = (*i).second;
-                            if (node)
-                            {
-                                trixel->removeChildNode(node);
-                                delete node;
-
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            ++i;
-                        }
+                        trixel->deleteAllChildNodes();
                     }
 
                     trixel = static_cast<TrixelNode *>(trixel->nextSibling());
@@ -198,70 +186,44 @@ void DeepStarItem::update()
                         regionID = region.next();
                     }
 
-                    QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = (&trixel->m_nodes)->begin();
-
-                    while (i != (&trixel->m_nodes)->end())
+                    //All stars of the trixel are drawn by a single node
+                    if (!trixel->m_batch)
                     {
-                        bool hide     = false;
-                        bool hideSlew = false;
+                        trixel->m_batch = new StarBatchNode(rootNode());
+                        trixel->appendChildNode(trixel->m_batch);
+                    }
+                    StarBatchNode *batch = trixel->m_batch;
+                    batch->beginUpdate();
 
-                        bool drawLabel = false;
+                    // Stars are hidden while slewing
+                    if (!(hideFaintStars && hideStarsMag))
+                    {
+                        QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = (&trixel->m_nodes)->begin();
 
-                        StarObject *starObj = static_cast<StarObject *>((*i).first);
-                        SkyNode *node       = (*i).second;
+                        while (i != (&trixel->m_nodes)->end())
+                        {
+                            StarObject *starObj = static_cast<StarObject *>((*i).first);
+                            ++i;
 
-                        int mag = starObj->mag();
+                            int mag = starObj->mag();
 
-                        // break loop if maglim is reached
-                        if (mag > maglim)
-                            hide = true;
-                        if (hideFaintStars && hideStarsMag)
-                            hideSlew = true;
-                        if (starObj->updateID != KStarsData::Instance()->updateID())
-                            starObj->JITupdate();
+                            if (mag > maglim)
+                                continue;
+                            if (starObj->updateID != KStarsData::Instance()->updateID())
+                                starObj->JITupdate();
 
-                        if (node)
-                        {
-                            if (node->hideCount() > delLim || hide)
+                            if (projector->checkVisibility(starObj))
                             {
-                                trixel->removeChildNode(node);
-                                delete node;
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            else
-                            {
-                                if (!hideSlew)
-                                {
-                                    node->update(drawLabel);
-                                }
-                                else
-                                {
-                                    node->hide();
-                                }
-                            }
-                        }
-                        else
-                        {
-                            if (!hide && !hideSlew && projector->checkVisibility(starObj))
-                            {
-                                QPointF pos;
-
                                 bool visible = false;
-                                pos          = projector->toScreen(starObj, true, &visible);
+                                QPointF pos  = projector->toScreen(starObj, true, &visible);
                                 if (visible && projector->onScreen(pos))
                                 {
-                                    PointSourceNode *point =
-                                        new PointSourceNode(starObj, rootNode(), LabelsItem::label_t::STAR_LABEL,
-                                                            starObj->spchar(), starObj->mag(), trixelID);
-                                    trixel->appendChildNode(point);
-
-                                    *i = QPair<SkyObject *, SkyNode *>((*i).first, static_cast<SkyNode *>(point));
-                                    point->updatePos(pos, drawLabel);
+                                    batch->addStar(pos, starObj->spchar(), PointSourceNode::starWidth(starObj->mag()));
                                 }
                             }
                         }
-                        ++i;
                     }
+                    batch->endUpdate();
                 }
             }
             else if (false)
@@ -1,3 +1,4 @@
+#include <QPainter>
 #include <QSGTexture>
 #include <QQuickWindow>
 
@@ -160,6 +161,8 @@ RootNode::~RootNode()
             delete m_textureCache[i][c];
         }
     }
+    delete m_starAtlas;
+    delete m_oldStarAtlas;
 }
 
 void RootNode::genCachedTextures()
@@ -180,6 +183,46 @@ void RootNode::genCachedTextures()
                 win->createTextureFromImage(images[i][c]->toImage(), QQuickWindow::TextureCanUseAtlas);
         }
     }
+
+    // Pack all star images in a single texture, one row per spectral class and one column per size.
+    // Each image is padded by 1 pixel so that linear filtering doesn't sample the neighbor images.
+    int cellSize = 0, sizes = 0;
+    for (const auto &classImages : images)
+    {
+        sizes = qMax(sizes, classImages.length());
+        for (const QPixmap *pixmap : classImages)
+            cellSize = qMax(cellSize, qMax(pixmap->width(), pixmap->height()));
+    }
+    cellSize += 2;
+
+    QImage atlas(qMax(1, cellSize * sizes), qMax(1, cellSize * images.length()), QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    const qreal ratio = win->effectiveDevicePixelRatio();
+
+    m_starAtlasRects = QVector<QVector<QRectF>>(images.length());
+    m_starAtlasSizes = QVector<QVector<QSizeF>>(images.length());
+    QPainter p(&atlas);
+    for (int i = 0; i < images.length(); ++i)
+    {
+        m_starAtlasRects[i] = QVector<QRectF>(images[i].length());
+        m_starAtlasSizes[i] = QVector<QSizeF>(images[i].length());
+        for (int c = 1; c < images[i].length(); ++c)
+        {
+            const QPixmap *pixmap = images[i][c];
+            const int x = c * cellSize + 1, y = i * cellSize + 1;
+            p.drawPixmap(x, y, *pixmap);
+            m_starAtlasRects[i][c] = QRectF(qreal(x) / atlas.width(), qreal(y) / atlas.height(),
+                                            qreal(pixmap->width()) / atlas.width(), qreal(pixmap->height()) / atlas.height());
+            //We divide size of texture by ratio. Otherwise texture will be very large
+            m_starAtlasSizes[i][c] = QSizeF(pixmap->width() / ratio, pixmap->height() / ratio);
+        }
+    }
+    p.end();
+
+    //The old atlas is deleted once all StarBatchNodes use the new one
+    delete m_oldStarAtlas;
+    m_oldStarAtlas = m_starAtlas;
+    m_starAtlas    = win->createTextureFromImage(atlas);
 }
 
 QSGTexture *RootNode::getCachedTexture(int size, char spType)
@@ -187,6 +230,16 @@ QSGTexture *RootNode::getCachedTexture(int size, char spType)
     return m_textureCache[SkyMapLite::Instance()->harvardToIndex(spType)][size];
 }
 
+QRectF RootNode::starAtlasRect(int size, char spType) const
+{
+    return m_starAtlasRects[SkyMapLite::Instance()->harvardToIndex(spType)][size];
+}
+
+QSizeF RootNode::starAtlasSize(int size, char spType) const
+{
+    return m_starAtlasSizes[SkyMapLite::Instance()->harvardToIndex(spType)][size];
+}
+
 void RootNode::updateClipPoly()
 {
     QPolygonF newClip = m_skyMapLite->projector()->clipPoly();
@@ -299,5 +352,7 @@ void RootNode::update(bool clearTextures)
                 qDeleteAll(textures.begin(), textures.end());
             }
         }
+        delete m_oldStarAtlas;
+        m_oldStarAtlas = nullptr;
     }
 }
@@ -70,6 +70,22 @@ class RootNode : public QSGClipNode
      */
     QSGTexture *getCachedTexture(int size, char spType);
 
+    /**
+     * @short returns the texture that holds the images of stars of all sizes and spectral classes.
+     * Used by StarBatchNode to draw many stars with a single material.
+     */
+    inline QSGTexture *starAtlas() const { return m_starAtlas; }
+
+    /**
+     * @short returns the normalized rectangle of the image of a star in starAtlas()
+     * @param size size of the star
+     * @param spType spectral class
+     */
+    QRectF starAtlasRect(int size, char spType) const;
+
+    /** @short returns the size of the image of a star on SkyMapLite */
+    QSizeF starAtlasSize(int size, char spType) const;
+
     /** @short triangulates and sets new clipping polygon provided by Projection system */
     void updateClipPoly();
 
@@ -97,6 +113,10 @@ class RootNode : public QSGClipNode
   private:
     QVector<QVector<QSGTexture *>> m_textureCache;
     QVector<QVector<QSGTexture *>> m_oldTextureCache;
+    QSGTexture *m_starAtlas { nullptr };
+    QSGTexture *m_oldStarAtlas { nullptr };
+    QVector<QVector<QRectF>> m_starAtlasRects;
+    QVector<QVector<QSizeF>> m_starAtlasSizes;
     SkyMapLite *m_skyMapLite { nullptr };
 
     QPolygonF m_clipPoly;
@@ -0,0 +1,96 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "starbatchnode.h"
+
+#include "../../rootnode.h"
+
+#include <QVector>
+
+#include <cstring>
+
+StarBatchNode::StarBatchNode(RootNode *rootNode)
+    : m_rootNode(rootNode), m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0)
+{
+    m_geometry.setDrawingMode(GL_TRIANGLES);
+    setGeometry(&m_geometry);
+
+    m_material.setFiltering(QSGTexture::Linear);
+    m_opaqueMaterial.setFiltering(QSGTexture::Linear);
+    setMaterial(&m_material);
+    setOpaqueMaterial(&m_opaqueMaterial);
+    setTexture();
+}
+
+void StarBatchNode::setTexture()
+{
+    QSGTexture *atlas = m_rootNode->starAtlas();
+    if (m_material.texture() != atlas)
+    {
+        m_material.setTexture(atlas);
+        m_opaqueMaterial.setTexture(atlas);
+        markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+void StarBatchNode::beginUpdate()
+{
+    // The atlas is recreated when the star colors change
+    setTexture();
+    m_count = 0;
+}
+
+void StarBatchNode::addStar(const QPointF &pos, char spType, float size)
+{
+    const int capacity = m_geometry.vertexCount() / 6;
+    if (m_count == capacity)
+    {
+        // Grow by half to avoid reallocating on every star of a filling trixel
+        const int used = m_count * 6;
+        QVector<QSGGeometry::TexturedPoint2D> vertices(used);
+        if (used > 0)
+            memcpy(vertices.data(), m_geometry.vertexDataAsTexturedPoint2D(), used * sizeof(QSGGeometry::TexturedPoint2D));
+        const int newCapacity = qMax(64, capacity + capacity / 2);
+        m_geometry.allocate(newCapacity * 6);
+        if (used > 0)
+            memcpy(m_geometry.vertexDataAsTexturedPoint2D(), vertices.constData(), used * sizeof(QSGGeometry::TexturedPoint2D));
+        // The new vertices are collapsed in endUpdate()
+        m_lastCount = newCapacity;
+    }
+
+    const int isize      = qMin(static_cast<int>(size), 14);
+    const QRectF texRect = m_rootNode->starAtlasRect(isize, spType);
+    const QSizeF tSize   = m_rootNode->starAtlasSize(isize, spType);
+
+    const float x1 = pos.x() - 0.5 * tSize.width();
+    const float y1 = pos.y() - 0.5 * tSize.height();
+    const float x2 = x1 + tSize.width();
+    const float y2 = y1 + tSize.height();
+    const float tx1 = texRect.left(), ty1 = texRect.top(), tx2 = texRect.right(), ty2 = texRect.bottom();
+
+    QSGGeometry::TexturedPoint2D *v = m_geometry.vertexDataAsTexturedPoint2D() + m_count * 6;
+    v[0].set(x1, y1, tx1, ty1);
+    v[1].set(x2, y1, tx2, ty1);
+    v[2].set(x1, y2, tx1, ty2);
+    v[3].set(x2, y1, tx2, ty1);
+    v[4].set(x2, y2, tx2, ty2);
+    v[5].set(x1, y2, tx1, ty2);
+    m_count++;
+}
+
+void StarBatchNode::endUpdate()
+{
+    // Stars that were drawn in the previous update but not in this one are collapsed
+    // to a point, which doesn't produce any fragment.
+    if (m_lastCount > m_count)
+    {
+        QSGGeometry::TexturedPoint2D *v = m_geometry.vertexDataAsTexturedPoint2D();
+        memset(v + m_count * 6, 0, (qMin(m_lastCount, m_geometry.vertexCount() / 6) - m_count) * 6 *
+               sizeof(QSGGeometry::TexturedPoint2D));
+    }
+    m_lastCount = m_count;
+    m_geometry.markVertexDataDirty();
+    markDirty(QSGNode::DirtyGeometry);
+}
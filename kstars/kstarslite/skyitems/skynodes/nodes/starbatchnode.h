@@ -0,0 +1,56 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QPointF>
+#include <QSGGeometryNode>
+#include <QSGTextureMaterial>
+
+class RootNode;
+
+/**
+ * @class StarBatchNode
+ * @short QSGGeometryNode derived class that draws all stars of a trixel as a single geometry
+ *
+ * Each star is a textured quad (2 triangles) sampling the star atlas of RootNode, where the
+ * texture coordinates select the spectral class and the size of the star. Compared to a PointNode
+ * per star, the scenegraph only holds one node per visible trixel.
+ *
+ * The stars are added between beginUpdate() and endUpdate() on each update. The geometry is only
+ * reallocated when it grows, unused vertices are collapsed so they produce no fragments.
+ */
+class StarBatchNode : public QSGGeometryNode
+{
+  public:
+    explicit StarBatchNode(RootNode *rootNode);
+
+    /** @short Starts filling the geometry, must be followed by addStar() calls and endUpdate() */
+    void beginUpdate();
+
+    /**
+     * @short Appends a star to the geometry
+     * @param pos position of the center of the star on SkyMapLite
+     * @param spType spectral class
+     * @param size size of the star, as returned by PointSourceNode::starWidth()
+     */
+    void addStar(const QPointF &pos, char spType, float size);
+
+    /** @short Clears the unused vertices and marks the geometry dirty */
+    void endUpdate();
+
+    /** @return the number of stars added since the last beginUpdate() */
+    inline int starCount() const { return m_count; }
+
+  private:
+    void setTexture();
+
+    RootNode *m_rootNode { nullptr };
+    QSGTextureMaterial m_material;
+    QSGOpaqueTextureMaterial m_opaqueMaterial;
+    QSGGeometry m_geometry;
+    int m_count { 0 };
+    int m_lastCount { 0 };
+};
@@ -6,6 +6,7 @@
 #include "trixelnode.h"
 
 #include "skynode.h"
+#include "nodes/starbatchnode.h"
 
 #include <QSGSimpleTextureNode>
 
@@ -29,6 +30,13 @@ void TrixelNode::deleteAllChildNodes()
         }
         ++i;
     }
+
+    if (m_batch)
+    {
+        removeChildNode(m_batch);
+        delete m_batch;
+        m_batch = nullptr;
+    }
 }
 
 void TrixelNode::hide()
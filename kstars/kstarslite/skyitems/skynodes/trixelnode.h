@@ -8,10 +8,13 @@
 #include "typedef.h"
 #include "../skyopacitynode.h"
 
+#include <QHash>
 #include <QLinkedList>
 
+class LabelNode;
 class SkyObject;
 class SkyNode;
+class StarBatchNode;
 
 /**
  * @short Convenience class that represents trixel in SkyMapLite. It should be used as a parent for
@@ -40,7 +43,16 @@ class TrixelNode : public SkyOpacityNode
     /** m_nodes - holds SkyNodes with corresponding SkyObjects */
     QLinkedList<QPair<SkyObject *, SkyNode *>> m_nodes;
 
-    /** @short Delete all childNodes and remove nodes from pairs in m_nodes **/
+    /**
+     * m_batch - draws the stars of this trixel at once, instead of a SkyNode per star.
+     * Created when the trixel becomes visible and deleted with the other child nodes.
+     */
+    StarBatchNode *m_batch { nullptr };
+
+    /** m_labels - labels of the stars drawn by m_batch */
+    QHash<SkyObject *, LabelNode *> m_labels;
+
+    /** @short Delete all childNodes (including m_batch) and remove nodes from pairs in m_nodes **/
     virtual void deleteAllChildNodes();
 
   private:
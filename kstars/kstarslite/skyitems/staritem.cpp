@@ -15,8 +15,10 @@
 #include "starcomponent.h"
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
+#include "skynodes/labelnode.h"
 #include "skynodes/pointsourcenode.h"
 #include "skynodes/trixelnode.h"
+#include "skynodes/nodes/starbatchnode.h"
 
 #include <QLinkedList>
 
@@ -176,6 +178,9 @@ void StarItem::update()
                 trixel->removeChildNode(c);
                 delete c;
             }
+            trixel->m_batch = nullptr;
+            //Labels were already deleted by deleteLabels()
+            trixel->m_labels.clear();
 
             //Delete all pairs that represent stars
             trixel->m_nodes.clear();
@@ -199,6 +204,9 @@ void StarItem::update()
             if (trixel->hideCount() > delLim)
             {
                 trixel->deleteAllChildNodes();
+                for (LabelNode *starLabel : trixel->m_labels)
+                    rootNode()->labelsItem()->deleteLabel(starLabel);
+                trixel->m_labels.clear();
             }
         }
         else
@@ -211,6 +219,15 @@ void StarItem::update()
                 regionID = region.next();
             }
 
+            //All stars of the trixel are drawn by a single node
+            if (!trixel->m_batch)
+            {
+                trixel->m_batch = new StarBatchNode(rootNode());
+                trixel->appendChildNode(trixel->m_batch);
+            }
+            StarBatchNode *batch = trixel->m_batch;
+            batch->beginUpdate();
+
             QLinkedList<QPair<SkyObject *, SkyNode *>> *nodes = &trixel->m_nodes;
             QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = nodes->begin();
             bool hide = false;
@@ -220,7 +237,7 @@ void StarItem::update()
                 bool drawLabel = false;
 
                 StarObject *starObj = static_cast<StarObject *>((*i).first);
-                SkyNode *node       = (*i).second;
+                ++i;
 
                 int mag = starObj->mag();
 
@@ -229,51 +246,49 @@ void StarItem::update()
                     hide = true;
                 if (!(hideLabel || mag > labelMagLim))
                     drawLabel = true;
+
+                LabelNode *starLabel = trixel->m_labels.isEmpty() ? nullptr : trixel->m_labels.value(starObj);
+                if (hide)
+                {
+                    //Stars are sorted by magnitude, the remaining ones are hidden too
+                    if (trixel->m_labels.isEmpty())
+                        break;
+                    if (starLabel)
+                        starLabel->hide();
+                    continue;
+                }
+
                 if (starObj->updateID != KStarsData::Instance()->updateID())
                     starObj->JITupdate();
 
-                if (node)
+                bool visible = false;
+                QPointF pos;
+                if (projector->checkVisibility(starObj))
                 {
-                    if (node->hideCount() > delLim || hide)
-                    {
-                        trixel->removeChildNode(node);
-                        delete node;
-                        *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                    }
-                    else
-                    {
-                        if (!hide)
-                        {
-                            node->update(drawLabel);
-                        }
-                        else
-                        {
-                            node->hide();
-                        }
-                    }
+                    pos     = projector->toScreen(starObj, true, &visible);
+                    visible = visible && projector->onScreen(pos);
                 }
-                else
+
+                if (visible)
                 {
-                    if (!hide && projector->checkVisibility(starObj))
-                    {
-                        QPointF pos;
+                    batch->addStar(pos, starObj->spchar(), PointSourceNode::starWidth(starObj->mag()));
 
-                        bool visible = false;
-                        pos          = projector->toScreen(starObj, true, &visible);
-                        if (visible && projector->onScreen(pos))
+                    if (drawLabel)
+                    {
+                        //Labels are created only when they are needed
+                        if (!starLabel)
                         {
-                            PointSourceNode *point =
-                                new PointSourceNode(starObj, rootNode(), LabelsItem::label_t::STAR_LABEL,
-                                                    starObj->spchar(), starObj->mag(), trixelID);
-                            trixel->appendChildNode(point);
-
-                            *i = QPair<SkyObject *, SkyNode *>((*i).first, static_cast<SkyNode *>(point));
-                            point->updatePos(pos, drawLabel);
+                            starLabel = rootNode()->labelsItem()->addLabel(starObj, labelType(), trixelID);
+                            trixel->m_labels.insert(starObj, starLabel);
                         }
+                        starLabel->setLabelPos(pos);
+                        continue;
                     }
                 }
-                ++i;
+                if (starLabel)
+                    starLabel->hide();
             }
+            batch->endUpdate();
         }
         trixel = static_cast<TrixelNode *>(trixel->nextSibling());
         label  = static_cast<TrixelNode *>(label->nextSibling());
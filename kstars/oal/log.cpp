@@ -102,10 +102,18 @@ void OAL::Log::writeSessions()
 void OAL::Log::writeTargets()
 {
     writer->writeStartElement("targets");
-    //foreach (SkyObject *o, m_targetList)
+
+    // Look up all the constellations at once
+    QList<const SkyPoint *> points;
+    points.reserve(m_targetList.size());
     for (auto &o : m_targetList)
+        points.append(o.data());
+    const QStringList constellations =
+        KStarsData::Instance()->skyComposite()->constellationBoundary()->constellationNames(points);
+
+    for (int i = 0; i < m_targetList.size(); ++i)
     {
-        writeTarget(o.data());
+        writeTarget(m_targetList[i].data(), constellations[i]);
     }
     writer->writeEndElement();
 }
@@ -162,7 +170,7 @@ void OAL::Log::writeObservations()
         writeObservation(o);
 }
 
-void OAL::Log::writeTarget(SkyObject *o)
+void OAL::Log::writeTarget(SkyObject *o, const QString &constellation)
 {
     writer->writeStartElement("target");
     writer->writeAttribute("id", o->name().remove(' '));
@@ -253,10 +261,7 @@ void OAL::Log::writeTarget(SkyObject *o)
         writer->writeEndElement();
     }
     writer->writeStartElement("constellation");
-    writer->writeCDATA(KStarsData::Instance()
-                       ->skyComposite()
-                       ->constellationBoundary()
-                       ->constellationName(o));
+    writer->writeCDATA(constellation);
     writer->writeEndElement();
     writer->writeStartElement("notes");
     writer->writeCDATA(KStarsData::Instance()->getUserData(o->name()).userLog);
@@ -90,7 +90,7 @@ class OAL::Log
         void writeObserver(OAL::Observer *o);
         void writeSite(OAL::Site *s);
         void writeSession(OAL::Session *s);
-        void writeTarget(SkyObject *o);
+        void writeTarget(SkyObject *o, const QString &constellation);
         void writeScope(OAL::Scope *s);
         void writeDSLRLenses(OAL::DSLRLens *s);
         void writeEyepiece(OAL::Eyepiece *ep);
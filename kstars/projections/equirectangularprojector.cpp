@@ -90,6 +90,23 @@ SkyPoint EquirectangularProjector::fromScreen(const QPointF &p, dms *LST, const
     }
 }
 
+void EquirectangularProjector::fromScreenHorizontal(double y, double x0, double step, int count, float *az,
+        float *alt) const
+{
+    // The altitude only depends on the row.
+    const double dy = (0.5 * m_vp.height - y) / m_vp.zoomFactor;
+    const double rowAlt = SkyPoint::unrefract(dy / dms::DegToRad + SkyPoint::refract(m_vp.focus->alt(),
+                          m_vp.useRefraction).Degrees(), m_vp.useRefraction);
+
+    for (int i = 0; i < count; i++)
+    {
+        //Azimuth goes in opposite direction compared to RA
+        const double dx = -1.0 * (0.5 * m_vp.width - (x0 + i * step)) / m_vp.zoomFactor;
+        az[i] = dx / dms::DegToRad;
+        alt[i] = rowAlt;
+    }
+}
+
 bool EquirectangularProjector::unusablePoint(const QPointF &p) const
 {
     double dx = (0.5 * m_vp.width - p.x()) / m_vp.zoomFactor;
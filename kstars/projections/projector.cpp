@@ -460,6 +460,30 @@ SkyPoint Projector::fromScreen(const QPointF &p, dms *LST, const dms *lat, bool
     return result;
 }
 
+void Projector::fromScreenHorizontal(double y, double x0, double step, int count, float *az, float *alt) const
+{
+    // Same as fromScreen() in horizontal coordinates, with the focus terms computed once for the row.
+    double sinY0, cosY0;
+    SkyPoint::refract(m_vp.focus->alt(), m_vp.useRefraction).SinCos(sinY0, cosY0);
+    const double dy = (0.5 * m_vp.height - y) / m_vp.zoomFactor;
+
+    for (int i = 0; i < count; i++)
+    {
+        //Azimuth goes in opposite direction compared to RA
+        const double dx = -1.0 * (0.5 * m_vp.width - (x0 + i * step)) / m_vp.zoomFactor;
+        const double r = sqrt(dx * dx + dy * dy);
+        const double c = projectionL(r);
+        const double sinc = sin(c);
+        const double cosc = cos(c);
+
+        const double Y = asin(cosc * sinY0 + (r == 0 ? 0 : (dy * sinc * cosY0) / r));
+        const double A = atan2(dx * sinc, r * cosY0 * cosc - dy * sinY0 * sinc);
+
+        alt[i] = SkyPoint::unrefract(Y / dms::DegToRad, m_vp.useRefraction);
+        az[i] = A / dms::DegToRad;
+    }
+}
+
 Eigen::Vector2f Projector::toScreenVec(const SkyPoint *o, bool oRefract, bool *onVisibleHemisphere) const
 {
     double Y, dX;
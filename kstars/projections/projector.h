@@ -142,6 +142,21 @@ class Projector
          */
         virtual SkyPoint fromScreen(const QPointF &p, dms *LST, const dms *lat, bool onlyAltAz = false) const;
 
+        /**
+         * @short Determine the horizontal coordinates of a row of screen pixels, for views in horizontal coordinates.
+         * This is the inverse projection of fromScreen() without the SkyPoint overhead, for callers that need
+         * the coordinates of many pixels. The azimuths are relative to the azimuth of the focus, so they don't
+         * change when the view is only rotated in azimuth.
+         * @param y the row of the pixels
+         * @param x0 the column of the first pixel
+         * @param step the distance in pixels between two consecutive pixels of the row
+         * @param count the number of pixels
+         * @param az the azimuths relative to the focus, in degrees
+         * @param alt the altitudes, in degrees
+         * @note Only valid if the view uses horizontal coordinates.
+         */
+        virtual void fromScreenHorizontal(double y, double x0, double step, int count, float *az, float *alt) const;
+
         /**
          * ASSUMES *p1 did not clip but *p2 did.  Returns the QPointF on the line
          * between *p1 and *p2 that just clips.
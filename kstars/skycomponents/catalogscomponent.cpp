@@ -18,9 +18,11 @@
 #include "skymapcomposite.h"
 #include "kspaths.h"
 #include "import_skycomp.h"
+#include "renderprofiler.h"
 
 #include <QtConcurrent>
 
+#include <algorithm>
 #include <cmath>
 
 constexpr std::size_t expectedKnownMagObjectsPerTrixel = 500;
@@ -79,6 +81,14 @@ void CatalogsComponent::draw(SkyPainter *skyp)
     bool showUnknownMagObjects = Options::showUnknownMagObjects();
     auto maglim                = compute_maglim();
 
+    // Drop the faint objects when the frames are over budget
+    auto *profiler = RenderProfiler::Instance();
+    if (profiler->degrade(RenderProfiler::FaintDeepSky))
+    {
+        showUnknownMagObjects = false;
+        maglim                = std::min(maglim, Options::magLimitDrawDeepSkyZoomOut());
+    }
+
     auto &labeler = *SkyLabeler::Instance();
     labeler.setPen(
         QColor(KStarsData::Instance()->colorScheme()->colorNamed("DSNameColor")));
@@ -86,7 +96,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
     auto &map       = *SkyMap::Instance();
     auto hideLabels = (map.isSlewing() && Options::hideOnSlew()) ||
-                      !(Options::showDeepSkyMagnitudes() || Options::showDeepSkyNames());
+                      !(Options::showDeepSkyMagnitudes() || Options::showDeepSkyNames()) ||
+                      profiler->degrade(RenderProfiler::Labels);
 
     const auto label_padding{ 1 + (1 - (Options::deepSkyLabelDensity() / 100)) * 50 };
     auto &proj = *map.projector();
@@ -21,6 +21,11 @@
 #include "skycomponents/skymapcomposite.h"
 
 #include <QHash>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
     : NoPrecessIndex(parent, i18n("Constellation Boundaries"))
@@ -156,6 +161,9 @@ void ConstellationBoundaryLines::preDraw(SkyPainter *skyp)
 
 void ConstellationBoundaryLines::appendPoly(std::shared_ptr<PolyList> &polyList, KSFileReader *file, int debug)
 {
+    m_polyLists.append(polyList);
+    m_polyBounds.append(polyList->poly()->boundingRect());
+
     if (!file || debug == -1)
         return appendPoly(polyList, debug);
 
@@ -258,14 +266,119 @@ PolyList *ConstellationBoundaryLines::ContainingPoly(const SkyPoint *p) const
     return nullptr;
 }
 
-//-------------------------------------------------------------------
-// The routines for providing public access to the boundary index
-// start here.  (Some of them may not be needed (or working)).
-//-------------------------------------------------------------------
+bool ConstellationBoundaryLines::polyContains(int polyIndex, double ra, double dec) const
+{
+    // Same as ContainingPoly(): the polygons wrapping around RA = 0 have negative RAs.
+    PolyList *polyList = m_polyLists[polyIndex].get();
+    const QPointF point((ra > 12.0 && polyList->wrapRA()) ? ra - 24.0 : ra, dec);
+    return m_polyBounds[polyIndex].contains(point) && polyList->poly()->containsPoint(point, Qt::OddEvenFill);
+}
 
-QString ConstellationBoundaryLines::constellationName(const SkyPoint *p) const
+void ConstellationBoundaryLines::buildGrid() const
+{
+    const double raCell = 24.0 / GRID_RA_CELLS;
+    const double decCell = 180.0 / GRID_DEC_CELLS;
+    m_grid.assign(GRID_RA_CELLS * GRID_DEC_CELLS, GRID_UNKNOWN);
+    m_boundaryCells.clear();
+
+    // Mark the cells crossed by the boundaries, and their neighbors. The edges are sampled every
+    // quarter of a cell, so any cell crossed by an edge is a neighbor of the cell of a sample.
+    for (int polyIndex = 0; polyIndex < m_polyLists.size(); ++polyIndex)
+    {
+        const QPolygonF *poly = m_polyLists[polyIndex]->poly();
+        for (int i = 0; i < poly->size(); ++i)
+        {
+            const QPointF &p1 = poly->at(i);
+            const QPointF &p2 = poly->at((i + 1) % poly->size());
+            const int samples = 1 + static_cast<int>(std::max(std::fabs(p2.x() - p1.x()) / raCell,
+                                std::fabs(p2.y() - p1.y()) / decCell) * 4);
+            for (int s = 0; s <= samples; ++s)
+            {
+                const QPointF p = p1 + (p2 - p1) * s / samples;
+                const int column = static_cast<int>(std::floor(p.x() / raCell));
+                const int row = std::clamp(static_cast<int>(std::floor((p.y() + 90.0) / decCell)), 0, GRID_DEC_CELLS - 1);
+                for (int r = std::max(0, row - 1); r <= std::min(GRID_DEC_CELLS - 1, row + 1); ++r)
+                {
+                    for (int c = column - 1; c <= column + 1; ++c)
+                    {
+                        qint32 &cell = m_grid[r * GRID_RA_CELLS + (c + 2 * GRID_RA_CELLS) % GRID_RA_CELLS];
+                        if (cell == GRID_UNKNOWN)
+                        {
+                            cell = -1 - static_cast<qint32>(m_boundaryCells.size());
+                            m_boundaryCells.emplace_back();
+                        }
+                        std::vector<qint16> &polys = m_boundaryCells[-1 - cell];
+                        if (std::find(polys.begin(), polys.end(), polyIndex) == polys.end())
+                            polys.push_back(polyIndex);
+                    }
+                }
+            }
+        }
+    }
+
+    // No boundary crosses the other cells, nor the border between two consecutive cells of a row,
+    // so only the first cell of each run of a row has to be tested with the polygons.
+    for (int row = 0; row < GRID_DEC_CELLS; ++row)
+    {
+        const double dec = -90.0 + (row + 0.5) * decCell;
+        qint32 previous = GRID_UNKNOWN;
+        for (int column = 0; column < GRID_RA_CELLS; ++column)
+        {
+            qint32 &cell = m_grid[row * GRID_RA_CELLS + column];
+            if (cell < 0)
+            {
+                previous = GRID_UNKNOWN;
+                continue;
+            }
+            if (previous == GRID_UNKNOWN)
+            {
+                const double ra = (column + 0.5) * raCell;
+                for (int polyIndex = 0; polyIndex < m_polyLists.size(); ++polyIndex)
+                {
+                    if (polyContains(polyIndex, ra, dec))
+                    {
+                        previous = polyIndex;
+                        break;
+                    }
+                }
+            }
+            cell = previous;
+        }
+    }
+}
+
+PolyList *ConstellationBoundaryLines::gridPoly(const SkyPoint *p, bool *found) const
+{
+    std::call_once(m_gridBuilt, [this]()
+    {
+        buildGrid();
+    });
+
+    const double ra = p->ra().Hours();
+    const double dec = p->dec().Degrees();
+    const int column = std::clamp(static_cast<int>(ra * GRID_RA_CELLS / 24.0), 0, GRID_RA_CELLS - 1);
+    const int row = std::clamp(static_cast<int>((dec + 90.0) * GRID_DEC_CELLS / 180.0), 0, GRID_DEC_CELLS - 1);
+    const qint32 cell = m_grid[row * GRID_RA_CELLS + column];
+
+    *found = true;
+    if (cell >= 0 && cell != GRID_UNKNOWN)
+        return m_polyLists[cell].get();
+
+    if (cell < 0)
+    {
+        for (qint16 polyIndex : m_boundaryCells[-1 - cell])
+        {
+            if (polyContains(polyIndex, ra, dec))
+                return m_polyLists[polyIndex].get();
+        }
+    }
+
+    *found = false;
+    return nullptr;
+}
+
+QString ConstellationBoundaryLines::polyName(PolyList *polyList) const
 {
-    PolyList *polyList = ContainingPoly(p);
     if (polyList)
     {
         return (Options::useLocalConstellNames() ?
@@ -274,3 +387,51 @@ QString ConstellationBoundaryLines::constellationName(const SkyPoint *p) const
     }
     return i18n("Unknown");
 }
+
+//-------------------------------------------------------------------
+// The routines for providing public access to the boundary index
+// start here.  (Some of them may not be needed (or working)).
+//-------------------------------------------------------------------
+
+QString ConstellationBoundaryLines::constellationName(const SkyPoint *p) const
+{
+    bool found = false;
+    PolyList *polyList = gridPoly(p, &found);
+    if (!found)
+        polyList = ContainingPoly(p);
+    return polyName(polyList);
+}
+
+QStringList ConstellationBoundaryLines::constellationNames(const QList<const SkyPoint *> &points) const
+{
+    QVector<PolyList *> polyLists(points.size());
+    QVector<bool> found(points.size());
+    auto lookup = [&](int i)
+    {
+        bool pointFound = false;
+        polyLists[i] = gridPoly(points[i], &pointFound);
+        found[i] = pointFound;
+    };
+
+    QVector<int> indexes(points.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+    // The grid lookup is so fast that it is only worth spreading large lists over threads.
+    if (points.size() >= 10000)
+        QtConcurrent::blockingMap(indexes, lookup);
+    else
+        std::for_each(indexes.begin(), indexes.end(), lookup);
+
+    // ContainingPoly() uses the sky mesh buffers, so the few points the grid couldn't place are done here.
+    QHash<PolyList *, QString> names;
+    QStringList result;
+    result.reserve(points.size());
+    for (int i = 0; i < points.size(); ++i)
+    {
+        PolyList *polyList = found[i] ? polyLists[i] : ContainingPoly(points[i]);
+        auto name = names.constFind(polyList);
+        if (name == names.constEnd())
+            name = names.insert(polyList, polyName(polyList));
+        result.append(name.value());
+    }
+    return result;
+}
@@ -10,6 +10,11 @@
 
 #include <QHash>
 #include <QPolygonF>
+#include <QRectF>
+
+#include <limits>
+#include <mutex>
+#include <vector>
 
 class PolyList;
 class ConstellationBoundary;
@@ -43,6 +48,12 @@ class ConstellationBoundaryLines : public NoPrecessIndex
 
     QString constellationName(const SkyPoint *p) const;
 
+    /**
+     * @short Returns the names of the constellations containing the points, in the same order.
+     * This is faster than calling constellationName() for each point, large lists are processed in parallel.
+     */
+    QStringList constellationNames(const QList<const SkyPoint *> &points) const;
+
     bool selected() override;
 
     void preDraw(SkyPainter *skyp) override;
@@ -59,7 +70,37 @@ class ConstellationBoundaryLines : public NoPrecessIndex
 
     PolyList *ContainingPoly(const SkyPoint *p) const;
 
+    /**
+     * @short Finds the polygon containing the point from the lookup grid.
+     * The polygons are only tested in cells crossed by a boundary, and only the polygons crossing the cell.
+     * @param found set to false if the grid can't tell, the caller then falls back to ContainingPoly().
+     * Unlike ContainingPoly(), this doesn't use the sky mesh and can be called from any thread.
+     */
+    PolyList *gridPoly(const SkyPoint *p, bool *found) const;
+
+    // Fills m_grid and m_boundaryCells, on first use.
+    void buildGrid() const;
+
+    // Tests the point with the polygon, taking care of the polygons wrapping around RA = 0.
+    bool polyContains(int polyIndex, double ra, double dec) const;
+
+    QString polyName(PolyList *polyList) const;
+
     SkyMesh *m_skyMesh { nullptr };
     PolyIndex m_polyIndex;
     int m_polyIndexCnt { 0 };
+
+    // All the constellation polygons, the lookup grid refers to their index.
+    QVector<std::shared_ptr<PolyList>> m_polyLists;
+    QVector<QRectF> m_polyBounds;
+
+    // Lookup grid of the constellations in RA, Dec. Each cell holds the index of the polygon containing
+    // the cell, or -1 - the index in m_boundaryCells of the polygons crossing the cell.
+    mutable std::vector<qint32> m_grid;
+    mutable std::vector<std::vector<qint16>> m_boundaryCells;
+    mutable std::once_flag m_gridBuilt;
+
+    static constexpr int GRID_RA_CELLS { 1440 };
+    static constexpr int GRID_DEC_CELLS { 720 };
+    static constexpr qint32 GRID_UNKNOWN { std::numeric_limits<qint32>::max() };
 };
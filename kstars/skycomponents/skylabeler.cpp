@@ -6,6 +6,8 @@
 
 #include "skylabeler.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 
 #include <QPainter>
@@ -279,6 +281,7 @@ void SkyLabeler::reset(SkyMap *skyMap)
 
     int m_maxX = skyMap->width();
     m_size     = (maxY + 1) * m_maxX;
+    m_cellWidth = std::max(1, int(std::ceil(m_maxX / 64.0)));
 
     // Resize if needed:
     if (maxY > m_maxY)
@@ -291,20 +294,17 @@ void SkyLabeler::reset(SkyMap *skyMap)
         //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
     }
 
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
+    // Clear all pre-existing rows, the rows below the screen may hold labels
+    // of a previous, taller screen.
+    for (auto &row : screenRows)
     {
-        LabelRow *row = screenRows[y];
-
         for (auto &item : *row)
         {
             delete item;
         }
         row->clear();
     }
+    m_rowMasks.fill(0, screenRows.size());
 
     // never decrease m_maxY:
     if (m_maxY < maxY)
@@ -344,6 +344,7 @@ void SkyLabeler::reset()
 
     int m_maxX = skyMap->width();
     m_size     = (maxY + 1) * m_maxX;
+    m_cellWidth = std::max(1, int(std::ceil(m_maxX / 64.0)));
 
     // Resize if needed:
     if (maxY > m_maxY)
@@ -356,19 +357,17 @@ void SkyLabeler::reset()
         //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
     }
 
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
+    // Clear all pre-existing rows, the rows below the screen may hold labels
+    // of a previous, taller screen.
+    for (auto &row : screenRows)
     {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
+        for (auto &item : *row)
         {
-            delete row->at(i);
+            delete item;
         }
         row->clear();
     }
+    m_rowMasks.fill(0, screenRows.size());
 
     // never decrease m_maxY:
     if (m_maxY < maxY)
@@ -462,8 +461,13 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
 
     // check to see if we overlap any existing label
     // We must check all rows before we start marking
+    const quint64 mask = cellMask(minX, maxX);
     for (int y = minY; y <= maxY; y++)
     {
+        // No run touches the columns of the region in this row
+        if (!(m_rowMasks[y] & mask))
+            continue;
+
         LabelRow *row = screenRows[y];
         int i;
         for (i = 0; i < row->size(); i++)
@@ -486,94 +490,119 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
     for (int y = minY; y <= maxY; y++)
     {
         LabelRow *row = screenRows[y];
+        // The run holding the new region once it is merged or inserted
+        LabelRun *run = nullptr;
 
         // Simplest case: an empty row
         if (row->size() < 1)
         {
-            row->append(new LabelRun(minX, maxX));
+            run = new LabelRun(minX, maxX);
+            row->append(run);
             m_elements++;
-            continue;
         }
-
-        // Find out our place in the universe (or row).
-        // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end >= minX)
-                break;
-        }
-
-        // i now points to first label PAST ours
-
-        // if we are first, append or merge at start of list
-        if (i == 0)
+        else
         {
-            if (row->at(0)->start - maxX < m_minDeltaX)
+            // Find out our place in the universe (or row).
+            // H'mm.  Maybe we could cache these numbers above.
+            int i;
+            for (i = 0; i < row->size(); i++)
             {
-                row->at(0)->start = minX;
+                if (row->at(i)->end >= minX)
+                    break;
             }
-            else
+
+            // i now points to first label PAST ours
+
+            // if we are first, append or merge at start of list
+            if (i == 0)
             {
-                row->insert(0, new LabelRun(minX, maxX));
-                m_elements++;
+                if (row->at(0)->start - maxX < m_minDeltaX)
+                {
+                    run        = row->at(0);
+                    run->start = minX;
+                }
+                else
+                {
+                    run = new LabelRun(minX, maxX);
+                    row->insert(0, run);
+                    m_elements++;
+                }
             }
-            continue;
-        }
 
-        // if we are past the last label, merge or append at end
-        else if (i == row->size())
-        {
-            if (minX - row->at(i - 1)->end < m_minDeltaX)
+            // if we are past the last label, merge or append at end
+            else if (i == row->size())
             {
-                row->at(i - 1)->end = maxX;
+                if (minX - row->at(i - 1)->end < m_minDeltaX)
+                {
+                    run      = row->at(i - 1);
+                    run->end = maxX;
+                }
+                else
+                {
+                    run = new LabelRun(minX, maxX);
+                    row->append(run);
+                    m_elements++;
+                }
             }
+
+            // if we got here, we must insert or merge the new label
+            //  between [i-1] and [i]
             else
             {
-                row->append(new LabelRun(minX, maxX));
-                m_elements++;
+                bool mergeHead = (minX - row->at(i - 1)->end < m_minDeltaX);
+                bool mergeTail = (row->at(i)->start - maxX < m_minDeltaX);
+
+                // double merge => combine all 3 into one
+                if (mergeHead && mergeTail)
+                {
+                    run      = row->at(i - 1);
+                    run->end = row->at(i)->end;
+                    delete row->at(i);
+                    row->removeAt(i);
+                    m_elements--;
+                }
+
+                // Merge label with [i-1]
+                else if (mergeHead)
+                {
+                    run      = row->at(i - 1);
+                    run->end = maxX;
+                }
+
+                // Merge label with [i]
+                else if (mergeTail)
+                {
+                    run        = row->at(i);
+                    run->start = minX;
+                }
+
+                // insert between the two
+                else
+                {
+                    run = new LabelRun(minX, maxX);
+                    row->insert(i, run);
+                    m_elements++;
+                }
             }
-            continue;
         }
 
-        // if we got here, we must insert or merge the new label
-        //  between [i-1] and [i]
-
-        bool mergeHead = (minX - row->at(i - 1)->end < m_minDeltaX);
-        bool mergeTail = (row->at(i)->start - maxX < m_minDeltaX);
-
-        // double merge => combine all 3 into one
-        if (mergeHead && mergeTail)
-        {
-            row->at(i - 1)->end = row->at(i)->end;
-            delete row->at(i);
-            row->removeAt(i);
-            m_elements--;
-        }
-
-        // Merge label with [i-1]
-        else if (mergeHead)
-        {
-            row->at(i - 1)->end = maxX;
-        }
-
-        // Merge label with [i]
-        else if (mergeTail)
-        {
-            row->at(i)->start = minX;
-        }
-
-        // insert between the two
-        else
-        {
-            row->insert(i, new LabelRun(minX, maxX));
-            m_elements++;
-        }
+        // A merge also covers the gap between the region and its neighbour
+        m_rowMasks[y] |= cellMask(run->start, run->end);
     }
 
     return true;
 }
 
+quint64 SkyLabeler::cellMask(int minX, int maxX) const
+{
+    // Clamping keeps the mask conservative for regions partly off the screen:
+    // overlapping regions always share at least one bit.
+    const int first = qBound(0, minX / m_cellWidth, 63);
+    const int last  = qBound(0, maxX / m_cellWidth, 63);
+    const quint64 upTo = (last == 63) ? ~quint64(0) : ((quint64(1) << (last + 1)) - 1);
+    return upTo & ~((quint64(1) << first) - 1);
+}
+
 void SkyLabeler::addLabel(SkyObject *obj, SkyLabeler::label_t type)
 {
     bool visible = false;
@@ -590,38 +619,93 @@ void SkyLabeler::addLabel(SkyObject *obj, QPointF pos, label_t type)
 }
 #endif
 
-void SkyLabeler::drawQueuedLabels()
+int SkyLabeler::labelPriority(SkyLabeler::label_t type)
+{
+    switch (type)
+    {
+        case PLANET_LABEL:
+            return 0;
+        case SATURN_MOON_LABEL:
+        case JUPITER_MOON_LABEL:
+            return 1;
+        case ASTEROID_LABEL:
+        case COMET_LABEL:
+            return 2;
+        case SATELLITE_LABEL:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
+void SkyLabeler::setLabelStyle(SkyLabeler::label_t type)
 {
     KStarsData *data = KStarsData::Instance();
 
     resetFont();
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
-    drawQueuedLabelsType(PLANET_LABEL);
+    if (type == SATURN_MOON_LABEL || type == JUPITER_MOON_LABEL)
+        shrinkFont(2);
 
-    if (labelList[SATURN_MOON_LABEL].size() > 0)
+    // No colors for asteroids and comets? Just following planets along?
+    if (type == SATELLITE_LABEL)
+        m_p.setPen(QColor(data->colorScheme()->colorNamed("SatLabelColor")));
+    else
+        m_p.setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
+}
+
+void SkyLabeler::drawQueuedLabels()
+{
+    struct QueuedLabel
     {
-        shrinkFont(2);
-        drawQueuedLabelsType(SATURN_MOON_LABEL);
-        resetFont();
+        const SkyLabel *label;
+        label_t type;
+        int priority;
+        bool placed;
+        float mag;
+    };
+
+    m_lastPlaced.swap(m_placed);
+    m_placed.clear();
+
+    // Rude labels are drawn last without marking, they don't need a place.
+    QVector<QueuedLabel> queue;
+    for (int type = 0; type < NUM_LABEL_TYPES; type++)
+    {
+        if (type == RUDE_LABEL)
+            continue;
+        for (const auto &item : labelList[type])
+        {
+            const float mag = item.obj->mag();
+            queue.append({ &item, label_t(type), labelPriority(label_t(type)), m_lastPlaced.contains(item.obj),
+                           std::isnan(mag) ? 99.0f : mag });
+        }
     }
 
-    if (labelList[JUPITER_MOON_LABEL].size() > 0)
+    std::stable_sort(queue.begin(), queue.end(), [](const QueuedLabel & a, const QueuedLabel & b)
     {
-        shrinkFont(2);
-        drawQueuedLabelsType(JUPITER_MOON_LABEL);
-        resetFont();
+        if (a.priority != b.priority)
+            return a.priority < b.priority;
+        if (a.placed != b.placed)
+            return a.placed;
+        return a.mag < b.mag;
+    });
+
+    int styleType = -1;
+    for (const auto &item : queue)
+    {
+        if (item.type != styleType)
+        {
+            setLabelStyle(item.type);
+            styleType = item.type;
+        }
+        if (drawNameLabel(item.label->obj, item.label->o))
+            m_placed.insert(item.label->obj);
     }
 
-    // No colors for these fellas? Just following planets along?
-    drawQueuedLabelsType(ASTEROID_LABEL);
-    drawQueuedLabelsType(COMET_LABEL);
-
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("SatLabelColor")));
-    drawQueuedLabelsType(SATELLITE_LABEL);
-
     // Whelp we're here and we don't have a Rude Label color?
     // Will just set it to Planet color since this is how it used to be!!
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
+    resetFont();
+    m_p.setPen(QColor(KStarsData::Instance()->colorScheme()->colorNamed("PNameColor")));
     LabelList list = labelList[RUDE_LABEL];
 
     for (const auto &item : list)
@@ -9,6 +9,7 @@
 
 #include <QFontMetricsF>
 #include <QList>
+#include <QSet>
 #include <QVector>
 #include <QPainter>
 #include <QPicture>
@@ -51,6 +52,11 @@ typedef QVector<LabelRow *> ScreenRows;
  * saves a lot of space over an explicit array and it also makes checking for
  * overlaps faster and even makes inserting new overlaps faster on average.
  *
+ * On top of the runs, each strip keeps a 64 bit occupancy mask where each bit
+ * covers 1/64 of the screen width.  A bit is set as soon as a run touches its
+ * column, so a label whose columns are all clear in all its strips is placed
+ * without walking the runs at all.  On a sparse screen this is most labels.
+ *
  * Synopsis:
  *
  *   1) Create a new SkyLabeler
@@ -78,6 +84,12 @@ typedef QVector<LabelRow *> ScreenRows;
  * draw() routine by adjusting the order in which the various buffers get
  * drawn.
  *
+ * drawQueuedLabels() places all queued labels from a single queue ordered by
+ * the priority of their type (see labelPriority()), then by magnitude.  Within
+ * a priority, the labels that were placed on the previous frame are placed
+ * first, so that labels don't flicker between overlapping objects while the
+ * sky is panned or the time runs.
+ *
  * Finally, even though this code was written to be very efficient, we might
  * want to take some care in how many labels we throw at it.  Sending it
  * a large number of overlapping labels can be wasteful. Also, if one type
@@ -265,6 +277,12 @@ class SkyLabeler
          */
     void drawQueuedLabelsType(SkyLabeler::label_t type);
 
+    /**
+         * @short placement priority of the queued label types, lower values are
+         * placed first.  Types sharing a priority are ordered by magnitude.
+         */
+    static int labelPriority(SkyLabeler::label_t type);
+
     //----- Marking Regions -----//
 
     /**
@@ -325,7 +343,20 @@ class SkyLabeler
     int marks() { return m_marks; }
 
   private:
+    /**
+         * @short bits of the occupancy mask covering the pixels minX to maxX.
+         */
+    quint64 cellMask(int minX, int maxX) const;
+
+    /**
+         * @short sets the font and pen for drawing the labels of the given type.
+         */
+    void setLabelStyle(SkyLabeler::label_t type);
+
     ScreenRows screenRows;
+    /// Occupancy mask of each row of screenRows, one bit per column of m_cellWidth pixels
+    QVector<quint64> m_rowMasks;
+    int m_cellWidth { 1 };
     int m_maxX { 0 };
     int m_maxY { 0 };
     int m_size { 0 };
@@ -347,6 +378,8 @@ class SkyLabeler
     QPainter m_p;
     QPicture m_picture;
     QVector<LabelList> labelList;
+    /// Objects whose queued label was placed on this frame and on the previous one
+    QSet<const SkyObject *> m_placed, m_lastPlaced;
     const Projector *m_proj { nullptr };
     static SkyLabeler *pinstance;
 };
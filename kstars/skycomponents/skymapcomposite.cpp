@@ -37,6 +37,7 @@
 #include "supernovaecomponent.h"
 #include "targetlistcomponent.h"
 #include "projections/projector.h"
+#include "renderprofiler.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/constellationsart.h"
 
@@ -182,6 +183,7 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
 
 void SkyMapComposite::update(KSNumbers *num)
 {
+    RenderProfiler::Scope scope("Update");
     //printf("updating SkyMapComposite\n");
     //1. Milky Way
     //m_MilkyWay->update( data, num );
@@ -224,11 +226,13 @@ void SkyMapComposite::update(KSNumbers *num)
 
 void SkyMapComposite::updateSolarSystemBodies(KSNumbers *num)
 {
+    RenderProfiler::Scope scope("Update solar system");
     m_SolarSystem->updateSolarSystemBodies(num);
 }
 
 void SkyMapComposite::updateMoons(KSNumbers *num)
 {
+    RenderProfiler::Scope scope("Update moons");
     m_SolarSystem->updateMoons(num);
 }
 
@@ -245,6 +249,13 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     SkyMap *map      = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
 
+    // Draws a component, timing it for the render profile
+    auto drawComponent = [skyp](const char *section, SkyComponent * component)
+    {
+        RenderProfiler::Scope scope(section);
+        component->draw(skyp);
+    };
+
     // We delay one draw cycle before re-indexing
     // we MUST ensure CLines do not get re-indexed while we use DRAW_BUF
     // so we do it here.
@@ -305,72 +316,80 @@ void SkyMapComposite::draw(SkyPainter *skyp)
             }
     }
 
-    m_MilkyWay->draw(skyp);
+    drawComponent("Milky Way", m_MilkyWay);
 
     // Draw HIPS after milky way but before everything else
-    m_HiPS->draw(skyp);
+    drawComponent("HiPS", m_HiPS);
 
-    m_EquatorialCoordinateGrid->draw(skyp);
-    m_HorizontalCoordinateGrid->draw(skyp);
-    m_LocalMeridianComponent->draw(skyp);
+    drawComponent("Equatorial grid", m_EquatorialCoordinateGrid);
+    drawComponent("Horizontal grid", m_HorizontalCoordinateGrid);
+    drawComponent("Local meridian", m_LocalMeridianComponent);
 
     //Draw constellation boundary lines only if we draw western constellations
     if (m_Cultures->current() == "Western")
     {
-        m_CBoundLines->draw(skyp);
-        m_ConstellationArt->draw(skyp);
+        drawComponent("Constellation boundaries", m_CBoundLines);
+        drawComponent("Constellation art", m_ConstellationArt);
     }
     else if (m_Cultures->current() == "Inuit")
     {
-        m_ConstellationArt->draw(skyp);
+        drawComponent("Constellation art", m_ConstellationArt);
     }
 
-    m_CLines->draw(skyp);
-
-    m_Equator->draw(skyp);
+    drawComponent("Constellation lines", m_CLines);
 
-    m_Ecliptic->draw(skyp);
+    drawComponent("Equator", m_Equator);
 
-    m_Catalogs->draw(skyp);
+    drawComponent("Ecliptic", m_Ecliptic);
 
-    m_Stars->draw(skyp);
+    drawComponent("Deep sky catalogs", m_Catalogs);
 
-    m_SolarSystem->drawTrails(skyp);
-    m_SolarSystem->draw(skyp);
+    drawComponent("Stars", m_Stars);
 
-    m_Satellites->draw(skyp);
+    {
+        RenderProfiler::Scope scope("Trails");
+        m_SolarSystem->drawTrails(skyp);
+    }
+    drawComponent("Solar system", m_SolarSystem);
 
-    m_Supernovae->draw(skyp);
+    drawComponent("Satellites", m_Satellites);
 
-    map->drawObjectLabels(labelObjects());
+    drawComponent("Supernovae", m_Supernovae);
 
-    m_skyLabeler->drawQueuedLabels();
-    m_CNames->draw(skyp);
-    m_Stars->drawLabels();
+    {
+        RenderProfiler::Scope scope("Labels");
+        map->drawObjectLabels(labelObjects());
+        m_skyLabeler->drawQueuedLabels();
+    }
+    drawComponent("Constellation names", m_CNames);
+    {
+        RenderProfiler::Scope scope("Labels");
+        m_Stars->drawLabels();
+    }
 
     m_ObservingList->pen =
         QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
     m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
-    m_ObservingList->draw(skyp);
+    drawComponent("Observing list", m_ObservingList);
 
-    m_Flags->draw(skyp);
+    drawComponent("Flags", m_Flags);
 
     m_StarHopRouteList->pen =
         QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
-    m_StarHopRouteList->draw(skyp);
+    drawComponent("Star hop route", m_StarHopRouteList);
 
 #ifdef HAVE_INDI
-    m_Mosaic->draw(skyp);
+    drawComponent("Mosaic", m_Mosaic);
 #endif
 
-    m_ArtificialHorizon->draw(skyp);
+    drawComponent("Artificial horizon", m_ArtificialHorizon);
 
-    m_Horizon->draw(skyp);
+    drawComponent("Horizon", m_Horizon);
 
     m_skyMesh->inDraw(false);
 
     // Draw terrain at the end.
-    m_Terrain->draw(skyp);
+    drawComponent("Terrain", m_Terrain);
 
     // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
     // -jbb uncomment these to see trixel outlines:
@@ -20,6 +20,7 @@
 #include "skymesh.h"
 #ifndef KSTARS_LITE
 #include "skyqpainter.h"
+#include "renderprofiler.h"
 #endif
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
@@ -260,7 +261,8 @@ void StarComponent::draw(SkyPainter *skyp)
     UpdateID updateID     = data->updateID();
 
     bool checkSlewing = (map->isSlewing() && Options::hideOnSlew());
-    m_hideLabels      = checkSlewing || !(Options::showStarMagnitudes() || Options::showStarNames());
+    m_hideLabels      = checkSlewing || !(Options::showStarMagnitudes() || Options::showStarNames()) ||
+                        RenderProfiler::Instance()->degrade(RenderProfiler::Labels);
 
     //shortcuts to inform whether to draw different objects
     bool hideFaintStars = checkSlewing && Options::hideStars();
@@ -345,7 +347,9 @@ void StarComponent::draw(SkyPainter *skyp)
         skyp->drawPointSource(focusStar, mag, focusStar->spchar());
     }
 
-    // Now draw each of our DeepStarComponents
+    // Now draw each of our DeepStarComponents, unless the frames are over budget
+    if (RenderProfiler::Instance()->degrade(RenderProfiler::DeepStars))
+        return;
     for (auto &component : m_DeepStarComponents)
     {
         component->draw(skyp);
@@ -33,6 +33,7 @@
 #include "skyqpainter.h"
 #include "projections/projector.h"
 #include "projections/lambertprojector.h"
+#include "renderprofiler.h"
 
 #include <config-kstars.h>
 
@@ -108,6 +109,33 @@ void SkyMapDrawAbstract::drawAngleRuler(QPainter &p)
                                        1))); // FIXME: Again, AngularRuler should be something better -- maybe a class in itself. After all it's used for more than one thing after we integrate the StarHop feature.
 }
 
+void SkyMapDrawAbstract::drawRenderProfile(QPainter &p)
+{
+    if (!Options::showRenderProfile())
+        return;
+
+    const QStringList lines = RenderProfiler::Instance()->report();
+    if (lines.isEmpty())
+        return;
+
+    // Top right corner, out of the way of the info boxes
+    const QFontMetrics fm = p.fontMetrics();
+    int width = 0;
+    for (const auto &line : lines)
+        width = qMax(width, fm.horizontalAdvance(line));
+    QRect box(0, 0, width + 12, lines.size() * fm.height() + 8);
+    box.moveTopRight(QPoint(p.viewport().width() - 10, 10));
+
+    p.save();
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(0, 0, 0, 160));
+    p.drawRect(box);
+    p.setPen(m_KStarsData->colorScheme()->colorNamed("BoxTextColor"));
+    for (int i = 0; i < lines.size(); ++i)
+        p.drawText(box.left() + 6, box.top() + 4 + i * fm.height() + fm.ascent(), lines[i]);
+    p.restore();
+}
+
 void SkyMapDrawAbstract::drawZoomBox(QPainter &p)
 {
     //draw the manual zoom-box, if it exists
@@ -80,6 +80,13 @@ class SkyMapDrawAbstract
         	*/
     void drawAngleRuler(QPainter &psky);
 
+    /**
+        	*@short Draw the time spent in each part of the last frame, when ShowRenderProfile is set.
+        	*@note Only drawn on the widget, not by drawOverlays(), so that exported and printed images do not show it.
+        	*@param psky reference to the QPainter on which to draw.
+        	*/
+    void drawRenderProfile(QPainter &psky);
+
     /** @short Draw the current Sky map to a pixmap which is to be printed or exported to a file.
         	*
         	*@param pd pointer to the QPaintDevice on which to draw.
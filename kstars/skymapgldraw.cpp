@@ -60,6 +60,7 @@ void SkyMapGLDraw::paintEvent(QPaintEvent *event)
 
     p.endNativePainting();
     drawOverlays(p);
+    drawRenderProfile(p);
     p.end();
 
     setDrawLock(false);
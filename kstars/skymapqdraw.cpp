@@ -10,6 +10,7 @@
 #include "skymap.h"
 #include "projections/projector.h"
 #include "printing/legend.h"
+#include "renderprofiler.h"
 #include "kstars_debug.h"
 #include <QPainterPath>
 
@@ -51,14 +52,21 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
         p.drawLine(0, 0, 1, 1); // Dummy operation to circumvent bug. TODO: Add details
         p.drawPixmap(0, 0, *m_SkyPixmap);
         drawOverlays(p);
+        drawRenderProfile(p);
         p.end();
 
         setDrawLock(false);
         return; // exit because the pixmap is repainted and that's all what we want
     }
 
+    RenderProfiler *profiler = RenderProfiler::Instance();
+    profiler->beginFrame();
+
     m_SkyMap->updateInfoBoxes();
-    m_SkyMap->setupProjector();
+    {
+        RenderProfiler::Scope scope("Projection setup");
+        m_SkyMap->setupProjector();
+    }
 
     m_SkyPixmap->fill(Qt::black);
     m_SkyPainter->setPaintDevice(m_SkyPixmap);
@@ -67,7 +75,10 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     m_SkyPainter->begin();
 
     //Draw all sky elements
-    m_SkyPainter->drawSkyBackground();
+    {
+        RenderProfiler::Scope scope("Sky background");
+        m_SkyPainter->drawSkyBackground();
+    }
 
     // Set Clipping
     QPainterPath path;
@@ -77,13 +88,25 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
 
     m_KStarsData->skyComposite()->draw(m_SkyPainter.data());
     //Finish up
-    m_SkyPainter->end();
+    {
+        RenderProfiler::Scope scope("Painter submission");
+        m_SkyPainter->end();
+    }
 
     QPainter psky2;
     psky2.begin(this);
     psky2.drawLine(0, 0, 1, 1); // Dummy op.
-    psky2.drawPixmap(0, 0, *m_SkyPixmap);
-    drawOverlays(psky2);
+    {
+        RenderProfiler::Scope scope("Painter submission");
+        psky2.drawPixmap(0, 0, *m_SkyPixmap);
+    }
+    {
+        RenderProfiler::Scope scope("Overlays");
+        drawOverlays(psky2);
+    }
+    profiler->endFrame();
+
+    drawRenderProfile(psky2);
     psky2.end();
 
     if (m_SkyMap->m_previewLegend)
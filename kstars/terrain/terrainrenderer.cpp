@@ -11,11 +11,11 @@
 #include "skymap.h"
 #include "skyqpainter.h"
 #include "projections/projector.h"
-#include "projections/equirectangularprojector.h"
 #include "skypoint.h"
 #include "kstars.h"
 
 #include <QStatusBar>
+#include <QtConcurrent>
 
 // This is the factory that builds the one-and-only TerrainRenderer.
 TerrainRenderer * TerrainRenderer::_terrainRenderer = nullptr;
@@ -40,7 +40,7 @@ class TerrainLookup
         {
             delete[] valPtr;
         }
-        inline float get(int w, int h)
+        inline float get(int w, int h) const
         {
             return valPtr[h * valWidth + w];
         }
@@ -48,6 +48,10 @@ class TerrainLookup
         {
             valPtr[h * valWidth + w] = val;
         }
+        inline float *row(int h)
+        {
+            return valPtr + h * valWidth;
+        }
     private:
         float *valPtr;
         int valWidth = 0;
@@ -88,7 +92,7 @@ class InterpArray
 
         // Get the azimuth and altitude values from the 2D arrays.
         // Inputs are a full-image position
-        inline void get(int x, int y, float *az, float *alt)
+        inline void get(int x, int y, float *az, float *alt) const
         {
             const bool rowSampled = y % sampling == 0;
             const bool colSampled = x % sampling == 0;
@@ -197,6 +201,10 @@ TerrainRenderer::TerrainRenderer()
 {
 }
 
+TerrainRenderer::~TerrainRenderer()
+{
+}
+
 // Put degrees in the range of 0 -> 359.99999999
 double rationalizeAz(double degrees)
 {
@@ -340,6 +348,34 @@ bool TerrainRenderer::sameView(const Projector *proj, bool forceRefresh)
     return false;
 }
 
+// Checks to see if the lookup computed for the last view can be used for this view.
+// In horizontal coordinates the lookup holds azimuths relative to the focus, so a view
+// rotated in azimuth only (e.g. panning along the horizon) has the same lookup.
+// In equatorial coordinates, the view rotates with the sky and the lookup is always recomputed.
+bool TerrainRenderer::sameLookup(uint16_t w, uint16_t h, int sampling, const Projector *proj)
+{
+    const ViewParams view = proj->viewParams();
+    const double alt = view.focus->alt().Degrees();
+
+    const bool same = lookup && view.useAltAz && lookupViewParams.useAltAz &&
+                      view.width == w && lookupViewParams.width == view.width &&
+                      view.height == h && lookupViewParams.height == view.height &&
+                      view.zoomFactor == lookupViewParams.zoomFactor &&
+                      view.useRefraction == lookupViewParams.useRefraction &&
+                      proj->type() == lookupProjection &&
+                      sampling == lookupSampling &&
+                      fabs(alt - lookupAlt) < .0001;
+    if (same)
+        return true;
+
+    lookupViewParams = view;
+    lookupViewParams.focus = nullptr;
+    lookupProjection = proj->type();
+    lookupSampling = sampling;
+    lookupAlt = alt;
+    return false;
+}
+
 bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const Projector *proj)
 {
     // This is used to force a re-render, e.g. when the image is changed.
@@ -404,10 +440,17 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
     // Get the other pixel az and alt values by interpolation.
     // This saves a lot of time.
     const int sampling = Options::terrainDownsampling();
-    InterpArray interp(w, h, sampling);
     QElapsedTimer setupTimer;
     setupTimer.start();
-    setupLookup(w, h, sampling, proj, interp.azimuthLookup(), interp.altitudeLookup());
+    if (!sameLookup(w, h, sampling, proj))
+    {
+        lookup.reset(new InterpArray(w, h, sampling));
+        setupLookup(w, h, sampling, proj, lookup->azimuthLookup(), lookup->altitudeLookup());
+    }
+    const InterpArray &interp = *lookup;
+
+    // In horizontal coordinates, the lookup azimuths are relative to the focus.
+    const double azOffset = proj->viewParams().useAltAz ? proj->viewParams().focus->az().Degrees() : 0;
 
     const double setupTime = setupTimer.elapsed() / 1000.0; ///////////////////
 
@@ -418,15 +461,25 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
     // Assign transparent pixels everywhere by default.
     terrainImage->fill(0);
 
+    // The rows are rendered in parallel, directly in the image buffer.
+    uchar *bits = terrainImage->bits();
+    const int bytesPerLine = terrainImage->bytesPerLine();
+    const bool transparencySpeedup = Options::terrainTransparencySpeedup();
+    QVector<int> rows;
+    rows.reserve(h / increment + 1);
+    for (int j = 0; j < h; j += increment)
+        rows.append(j);
+
     // Go through the image, and for each pixel, using the previously computed az and alt values
     // get the corresponding pixel from the terrain image.
-    bool lastTransparent = false;
-    for (int j = 0; j < h; j += increment)
+    QtConcurrent::blockingMap(rows, [&](int j)
     {
-        bool notLastRow = j != h - 1;
+        QRgb *line = reinterpret_cast<QRgb *>(bits + j * bytesPerLine);
+        QRgb *nextLine = (j != h - 1) ? reinterpret_cast<QRgb *>(bits + (j + 1) * bytesPerLine) : nullptr;
+        bool lastTransparent = false;
         for (int i = 0; i < w; i += increment)
         {
-            if (lastTransparent && Options::terrainTransparencySpeedup())
+            if (lastTransparent && transparencySpeedup)
             {
                 // Speedup--if the last pixel was transparent, then this
                 // one is assumed transparent too (but next is calculated).
@@ -435,15 +488,12 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
             }
 
             const QPointF imgPoint(i, j);
-            bool equiRectangular = (proj->type() == Projector::Equirectangular);
-            bool usable = equiRectangular ? !dynamic_cast<const EquirectangularProjector*>(proj)->unusablePoint(imgPoint)
-                          : !proj->unusablePoint(imgPoint);
-            if (usable)
+            if (!proj->unusablePoint(imgPoint))
             {
                 float az, alt;
                 interp.get(i, j, &az, &alt);
-                const QRgb pixel = getPixel(az, alt);
-                terrainImage->setPixel(i, j, pixel);
+                const QRgb pixel = getPixel(az + azOffset, alt);
+                line[i] = pixel;
                 lastTransparent = (pixel == 0);
 
                 if (skip)
@@ -451,17 +501,17 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
                     // If we've skipped, fill in the missing pixels.
                     bool notLastCol = i != w - 1;
                     if (notLastCol)
-                        terrainImage->setPixel(i + 1, j, pixel);
-                    if (notLastRow)
-                        terrainImage->setPixel(i, j + 1, pixel);
-                    if (notLastRow && notLastCol)
-                        terrainImage->setPixel(i + 1, j + 1, pixel);
+                        line[i + 1] = pixel;
+                    if (nextLine)
+                        nextLine[i] = pixel;
+                    if (nextLine && notLastCol)
+                        nextLine[i + 1] = pixel;
                 }
             }
             // Otherwise terrainImage was already filled with transparent pixels
             // so i,j will be transparent.
         }
-    }
+    });
 
     savedImage = terrainImage->copy();
 
@@ -493,25 +543,40 @@ void TerrainRenderer::setupLookup(uint16_t w, uint16_t h, int sampling, const Pr
 {
     const auto &lst = KStarsData::Instance()->lst();
     const auto &lat = KStarsData::Instance()->geo()->lat();
-    for (int j = 0, js = 0; j < h; j += sampling, js++)
+    const bool horizontal = proj->viewParams().useAltAz;
+    const int columns = (w + sampling - 1) / sampling;
+
+    QVector<int> rows;
+    for (int js = 0; js * sampling < h; js++)
+        rows.append(js);
+
+    // The sampled rows are independent, compute them in parallel.
+    QtConcurrent::blockingMap(rows, [&](int js)
     {
+        const int j = js * sampling;
+        float *azRow = azLookup->row(js);
+        float *altRow = altLookup->row(js);
+
+        // In horizontal coordinates, the whole row is inverse projected at once.
+        if (horizontal)
+            proj->fromScreenHorizontal(j, 0, sampling, columns, azRow, altRow);
+
         for (int i = 0, is = 0; i < w; i += sampling, is++)
         {
             const QPointF imgPoint(i, j);
-            bool equiRectangular = (proj->type() == Projector::Equirectangular);
-            bool usable = equiRectangular ? !dynamic_cast<const EquirectangularProjector*>(proj)->unusablePoint(imgPoint)
-                          : !proj->unusablePoint(imgPoint);
-            if (usable)
+            if (proj->unusablePoint(imgPoint))
+            {
+                azRow[is] = 0;
+                altRow[is] = 0;
+            }
+            else if (horizontal)
+                altRow[is] = rationalizeAlt(altRow[is]);
+            else
             {
-                SkyPoint point = equiRectangular ?
-                                 dynamic_cast<const EquirectangularProjector*>(proj)->fromScreen(imgPoint, lst, lat, true)
-                                 : proj->fromScreen(imgPoint, lst, lat, true);
-                const double az = rationalizeAz(point.az().Degrees());
-                const double alt = rationalizeAlt(point.alt().Degrees());
-                azLookup->set(is, js, az);
-                altLookup->set(is, js, alt);
+                SkyPoint point = proj->fromScreen(imgPoint, lst, lat, true);
+                azRow[is] = rationalizeAz(point.az().Degrees());
+                altRow[is] = rationalizeAlt(point.alt().Degrees());
             }
         }
-    }
+    });
 }
-
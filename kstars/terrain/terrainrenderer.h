@@ -12,6 +12,7 @@
 #include "projections/projector.h"
 
 class TerrainLookup;
+class InterpArray;
 
 class TerrainRenderer : public QObject
 {
@@ -22,6 +23,8 @@ class TerrainRenderer : public QObject
 
         // Render terrainImage according to the loaded image and the projection.
         bool render(uint16_t w, uint16_t h, QImage *terrainImage, const Projector *proj);
+
+        ~TerrainRenderer();
     signals:
 
     public slots:
@@ -32,9 +35,15 @@ class TerrainRenderer : public QObject
 
         // Speed-up the image calculations by downsampling azimuth and altitude
         // computations of the pixels in the input view.
+        // In horizontal coordinates, the azimuths are relative to the focus (see Projector::fromScreenHorizontal).
         void setupLookup(uint16_t w, uint16_t h, int sampling, const Projector *proj,
                          TerrainLookup *azLookup, TerrainLookup *altLookup);
 
+        // Checks to see if the az/alt lookup of the previous render can be used for this view.
+        // In horizontal coordinates, it can be as long as the view only rotates in azimuth.
+        // If not, copies the view for the next call.
+        bool sameLookup(uint16_t w, uint16_t h, int sampling, const Projector *proj);
+
         // Returns the pixel in sourceImage for the given coordinates.
         QRgb getPixel(double az, double alt) const;
 
@@ -56,6 +65,13 @@ class TerrainRenderer : public QObject
         double savedAz, savedAlt;
         QImage savedImage;
 
+        // The az/alt lookup of the last render, and the view it was computed for.
+        std::unique_ptr<InterpArray> lookup;
+        ViewParams lookupViewParams;
+        int lookupProjection = -1;
+        int lookupSampling = 0;
+        double lookupAlt = 0;
+
         // Keep the parameters used to display the last image
         // to see if something's changed and we need to redisplay.
         QString sourceFilename;
@@ -13,6 +13,7 @@
 
 #include "geolocation.h"
 #include "ksconjunct.h"
+#include "ksconjunctbatch.h"
 #include "kstars.h"
 #include "ksnotification.h"
 #include "kstarsdata.h"
@@ -241,7 +242,6 @@ void ConjunctionsTool::slotCompute(void)
         opposition = true;
     QStringList objects; // List of sky object used as Object1
     KStarsData *data = KStarsData::Instance();
-    int progress     = 0;
 
     // Check if we have a valid angle in maxSeparationBox
     dms maxSeparation(0.0);
@@ -347,30 +347,44 @@ void ConjunctionsTool::slotCompute(void)
     if (FilterTypeComboBox->currentIndex() != 0)
     {
         // Show a progress dialog while processing
-        QProgressDialog progressDlg(i18n("Compute conjunction..."), i18n("Abort"), 0, objects.count(), this);
+        QProgressDialog progressDlg(i18n("Compute conjunction..."), i18n("Abort"), 0, 100, this);
         progressDlg.setWindowTitle(i18nc("@title:window", "Conjunction"));
         progressDlg.setWindowModality(Qt::WindowModal);
         progressDlg.setValue(0);
+        progressDlg.setLabelText(i18n("Compute conjunctions between %1 and %2 objects", Object2->name(), objects.count()));
 
+        // All objects are searched at once, on a time grid shared with object 2.
+        QList<SkyObject *> skyObjects;
         for (auto &object : objects)
+        {
+            SkyObject *skyObject = data->skyComposite()->findByName(object);
+            if (skyObject)
+                skyObjects.append(skyObject);
+        }
+
+        KSConjunctBatch batch;
+        batch.setGeoLocation(geoPlace);
+        batch.setMaxSeparation(maxSeparation);
+        batch.setObject2(Object2);
+        batch.setOpposition(opposition);
+        batch.setObjects(skyObjects);
+        connect(&batch, &KSConjunctBatch::madeProgress, [&](int value)
         {
             // If the user click on the 'cancel' button
             if (progressDlg.wasCanceled())
-                break;
-
-            // Update progress dialog
-            ++progress;
-            progressDlg.setValue(progress);
-            progressDlg.setLabelText(i18n("Compute conjunction between %1 and %2", Object2->name(), object));
-
-            // Compute conjuction
-            Object1 = std::shared_ptr<SkyObject>(data->skyComposite()->findByName(object)->clone());
-            ksc.setObject1(Object1);
-            showConjunctions(ksc.findClosestApproach(startJD, stopJD),
-                             object, Object2->name());
-        }
+                batch.abort();
+            else
+                progressDlg.setValue(value);
+        });
+
+        batch.findClosestApproaches(startJD, stopJD, [&](const SkyObject * object, long double jd, dms separation)
+        {
+            QMap<long double, dms> conjunction;
+            conjunction.insert(jd, separation);
+            showConjunctions(conjunction, object->name(), Object2->name());
+        });
 
-        progressDlg.setValue(objects.count());
+        progressDlg.setValue(100);
     }
     else
     {
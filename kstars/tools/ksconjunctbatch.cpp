@@ -0,0 +1,275 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ksconjunctbatch.h"
+
+#include "ksnumbers.h"
+#include "kstarsdata.h"
+#include "kstarsdatetime.h"
+#include "skyobjects/ksplanet.h"
+#include "skyobjects/ksplanetbase.h"
+#include "skyobjects/skyobject.h"
+
+#include <KLocalizedString>
+#include <QtConcurrent>
+
+#include <cmath>
+#include <memory>
+
+namespace
+{
+// Approaches are refined to this precision, in days.
+constexpr double PRECISION = 1.0 / (24.0 * 60.0);
+
+void updatePosition(SkyObject *object, const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                    const KSPlanetBase *earth)
+{
+    KSPlanetBase *planet = dynamic_cast<KSPlanetBase *>(object);
+    if (planet)
+        planet->findPosition(num, lat, LST, earth);
+    else
+        object->updateCoordsNow(num);
+}
+}
+
+KSConjunctBatch::KSConjunctBatch(QObject *parent) : QObject(parent)
+{
+    m_GeoPlace = KStarsData::Instance()->geo();
+}
+
+KSConjunctBatch::~KSConjunctBatch()
+{
+}
+
+void KSConjunctBatch::setGeoLocation(GeoLocation *geo)
+{
+    if (geo != nullptr)
+        m_GeoPlace = geo;
+    else
+        m_GeoPlace = KStarsData::Instance()->geo();
+}
+
+double KSConjunctBatch::rateBound(const SkyObject *object)
+{
+    // Fixed objects only move by precession and nutation.
+    if (dynamic_cast<const KSPlanetBase *>(object) == nullptr)
+        return 0.001;
+
+    // Highest geocentric rates, with a margin. The planets are fastest near inferior conjunction or opposition.
+    const QString &name = object->name();
+    if (name == i18n("Moon"))
+        return 16.0;
+    if (name == i18n("Mercury"))
+        return 2.5;
+    if (name == i18n("Sun") || name == i18n("Venus"))
+        return 1.5;
+    if (name == i18n("Mars"))
+        return 1.0;
+    if (name == i18n("Jupiter") || name == i18n("Saturn") || name == i18n("Uranus") || name == i18n("Neptune"))
+        return 0.3;
+
+    // Comets and asteroids. The few faster ones (close approaches to the Earth) raise their own bound
+    // from the observed rate, see sample().
+    return 3.0;
+}
+
+double KSConjunctBatch::distance(const SkyPoint &p1, const SkyPoint &p2) const
+{
+    const double dist = p1.angularDistanceTo(&p2).Degrees();
+    return m_Opposition ? 180 - dist : dist;
+}
+
+void KSConjunctBatch::computeTrack(long double startJD, long double stopJD)
+{
+    // The grid has to be fine enough to see the separation go through a minimum between 3 steps.
+    bool hasMoon = m_Object2->name() == i18n("Moon");
+    for (const SkyObject *object : m_Objects)
+        hasMoon |= object->name() == i18n("Moon");
+    m_Step = std::min(hasMoon ? 0.25 : 1.0, double(stopJD - startJD) / 4.0);
+
+    KSPlanet earth(i18n("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/);
+    const int steps = static_cast<int>((stopJD - startJD) / m_Step) + 1;
+    m_Track.resize(steps);
+    m_TrackRate = 0;
+    for (int k = 0; k < steps; ++k)
+    {
+        const long double jd = startJD + k * m_Step;
+        KSNumbers num(jd);
+        earth.findPosition(&num);
+        CachingDms LST(m_GeoPlace->GSTtoLST(KStarsDateTime(jd).gst()));
+        m_Object2->findPosition(&num, m_GeoPlace->lat(), &LST, &earth);
+
+        m_Track[k].jd = jd;
+        m_Track[k].position = SkyPoint(m_Object2->ra(), m_Object2->dec());
+        if (k > 0)
+            m_TrackRate = std::max(m_TrackRate,
+                                   m_Track[k].position.angularDistanceTo(&m_Track[k - 1].position).Degrees() / m_Step);
+    }
+    // The rate may be higher between two steps.
+    m_TrackRate = std::max(1.25 * m_TrackRate, rateBound(m_Object2.get()) / 4);
+}
+
+void KSConjunctBatch::findClosestApproaches(long double startJD, long double stopJD,
+        const std::function<void (const SkyObject *, long double, dms)> &callback)
+{
+    m_Abort = false;
+    if (m_Object2 == nullptr || m_Objects.isEmpty() || stopJD <= startJD)
+        return;
+
+    computeTrack(startJD, stopJD);
+
+    QVector<Candidate> candidates(m_Objects.size());
+    for (int i = 0; i < m_Objects.size(); ++i)
+    {
+        Candidate &candidate = candidates[i];
+        candidate.source = m_Objects[i];
+        candidate.object.reset(m_Objects[i]->clone());
+        candidate.rate = rateBound(m_Objects[i]);
+        // The clones must not record trails while they are propagated.
+        KSPlanetBase *planet = dynamic_cast<KSPlanetBase *>(candidate.object.get());
+        if (planet)
+            planet->clearTrail();
+    }
+
+    KSPlanet earth(i18n("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/);
+    QVector<Candidate *> active;
+    active.reserve(candidates.size());
+    int lastProgress = -1;
+
+    for (int k = 0; k < m_Track.size() && !m_Abort; ++k)
+    {
+        active.clear();
+        for (Candidate &candidate : candidates)
+        {
+            if (candidate.samples.nextStep <= k)
+                active.append(&candidate);
+        }
+        if (!active.isEmpty())
+        {
+            // The Earth and the sidereal time are shared by all objects of the step.
+            const long double jd = m_Track[k].jd;
+            KSNumbers num(jd);
+            earth.findPosition(&num);
+            const CachingDms LST(m_GeoPlace->GSTtoLST(KStarsDateTime(jd).gst()));
+
+            QtConcurrent::blockingMap(active, [&](Candidate * candidate)
+            {
+                sample(*candidate, k, &num, &LST, &earth);
+            });
+
+            for (Candidate *candidate : active)
+            {
+                for (const auto &approach : candidate->found)
+                {
+                    if (callback)
+                        callback(candidate->source, approach.first, approach.second);
+                }
+                candidate->found.clear();
+            }
+        }
+
+        const int progress = 100 * (k + 1) / m_Track.size();
+        if (progress != lastProgress)
+        {
+            lastProgress = progress;
+            emit madeProgress(progress);
+        }
+    }
+}
+
+void KSConjunctBatch::sample(Candidate &candidate, int k, const KSNumbers *num, const CachingDms *LST,
+                             const KSPlanetBase *earth)
+{
+    updatePosition(candidate.object.get(), num, m_GeoPlace->lat(), LST, earth);
+    const SkyPoint position(candidate.object->ra(), candidate.object->dec());
+    const double dist = distance(position, m_Track[k].position);
+
+    // Raise the rate bound if the object moves faster than expected, e.g. an asteroid passing close to the Earth.
+    if (candidate.samples.lastDistance >= 0)
+        candidate.rate = std::max(candidate.rate, 1.5 * position.angularDistanceTo(&candidate.lastPosition).Degrees() / m_Step);
+    const double relativeRate = m_TrackRate + candidate.rate;
+    candidate.lastPosition = position;
+
+    if (addSample(candidate.samples, k, dist, relativeRate * m_Step, m_MaxSeparation, m_Track.size()))
+    {
+        const QPair<long double, dms> approach = refine(candidate, m_Track[k - 2].jd, m_Track[k].jd);
+        if (approach.second.Degrees() < m_MaxSeparation)
+            candidate.found.append(approach);
+    }
+}
+
+bool KSConjunctBatch::addSample(Samples &samples, int k, double distance, double relativeRate, double maxSeparation,
+                                int steps)
+{
+    // The separation went through a minimum between the last 3 steps, which may be below the maximum separation.
+    const bool minimum = samples.previousDistance >= 0 && samples.lastDistance >= 0 &&
+                         samples.lastDistance <= samples.previousDistance && samples.lastDistance < distance &&
+                         samples.lastDistance - relativeRate < maxSeparation;
+
+    samples.previousDistance = samples.lastDistance;
+    samples.lastDistance = distance;
+    samples.nextStep = k + 1;
+
+    // The pair can't be closer than the maximum separation for the next steps, skip them. The first sample
+    // after the skip has no previous one, so the minimum can't be seen at that sample: two steps are kept
+    // before the pair may be within the maximum separation, and the sampled minimum of an approach always
+    // has a sample on each side.
+    const double skip = std::floor((distance - maxSeparation) / relativeRate) - 2;
+    if (skip >= 1)
+    {
+        samples.nextStep += static_cast<int>(std::min(skip, double(steps)));
+        samples.previousDistance = samples.lastDistance = -1;
+    }
+    return minimum;
+}
+
+QPair<long double, dms> KSConjunctBatch::refine(Candidate &candidate, long double jd1, long double jd2) const
+{
+    // Each refinement uses its own Earth and object 2, as the refinements run in parallel.
+    KSPlanet earth(i18n("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/);
+    std::unique_ptr<KSPlanetBase> object2(static_cast<KSPlanetBase *>(m_Object2->clone()));
+    SkyObject *object1 = candidate.object.get();
+
+    auto separation = [&](long double jd)
+    {
+        KSNumbers num(jd);
+        earth.findPosition(&num);
+        const CachingDms LST(m_GeoPlace->GSTtoLST(KStarsDateTime(jd).gst()));
+        object2->findPosition(&num, m_GeoPlace->lat(), &LST, &earth);
+        updatePosition(object1, &num, m_GeoPlace->lat(), &LST, &earth);
+        return distance(SkyPoint(object1->ra(), object1->dec()), SkyPoint(object2->ra(), object2->dec()));
+    };
+
+    // Golden section search of the minimum.
+    const double invPhi = (std::sqrt(5.0) - 1) / 2;
+    long double a = jd1, b = jd2;
+    long double c = b - invPhi * (b - a), d = a + invPhi * (b - a);
+    double fc = separation(c), fd = separation(d);
+    while (b - a > PRECISION)
+    {
+        if (fc < fd)
+        {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - invPhi * (b - a);
+            fc = separation(c);
+        }
+        else
+        {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + invPhi * (b - a);
+            fd = separation(d);
+        }
+    }
+
+    const long double jd = (a + b) / 2;
+    dms sep;
+    sep.setD(separation(jd));
+    return qMakePair(jd, sep);
+}
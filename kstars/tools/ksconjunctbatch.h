@@ -0,0 +1,149 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "dms.h"
+#include "skypoint.h"
+#include "skycomponents/typedef.h"
+
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QVector>
+
+#include <atomic>
+#include <functional>
+
+class CachingDms;
+class GeoLocation;
+class KSNumbers;
+class KSPlanetBase;
+class SkyObject;
+
+/**
+ * @class KSConjunctBatch
+ * @short Finds the conjunctions of many objects with one solar system body.
+ *
+ * KSConjunct searches the approaches of a single pair of objects, and computing both positions at every
+ * step of the search dominates the time spent. When one body is checked against a list of objects (e.g. the
+ * Moon against all asteroids), this class shares the work between the pairs:
+ * - the position of the body (and of the Earth) is computed once per step of a time grid common to all pairs,
+ * - the objects are propagated on that grid in parallel,
+ * - an object is only propagated when it may be within the maximum separation: from the separation and an
+ *   upper bound of the relative angular rate of the pair, the number of steps during which the pair certainly
+ *   stays apart is skipped,
+ * - only the local minima of the sampled separations which may be below the maximum separation are refined.
+ */
+class KSConjunctBatch : public QObject
+{
+        Q_OBJECT
+    public:
+        explicit KSConjunctBatch(QObject *parent = nullptr);
+        ~KSConjunctBatch() override;
+
+        void setGeoLocation(GeoLocation *geo);
+        void setObject2(const KSPlanetBase_s &obj)
+        {
+            m_Object2 = obj;
+        }
+        // The objects are cloned by the search, the caller keeps them unchanged.
+        void setObjects(const QList<SkyObject *> &objects)
+        {
+            m_Objects = objects;
+        }
+        void setOpposition(bool opposition)
+        {
+            m_Opposition = opposition;
+        }
+        void setMaxSeparation(const dms &sep)
+        {
+            m_MaxSeparation = sep.Degrees();
+        }
+
+        /**
+         * @brief findClosestApproaches Searches the approaches of all objects with object 2 in the given range.
+         * @param startJD Julian Day corresponding to start of the calculation period
+         * @param stopJD Julian Day corresponding to end of the calculation period
+         * @param callback Called in the calling thread for each approach, as soon as it is found.
+         */
+        void findClosestApproaches(long double startJD, long double stopJD,
+                                   const std::function<void (const SkyObject *, long double, dms)> &callback);
+
+        // Stops the search at the next step of the time grid, may be called from any thread.
+        void abort()
+        {
+            m_Abort = true;
+        }
+
+        // Separations of a pair sampled on the time grid.
+        struct Samples
+        {
+            // Separations at the last two consecutive steps, -1 if not sampled.
+            double previousDistance { -1 };
+            double lastDistance { -1 };
+            // Next step of the grid where the pair must be sampled.
+            int nextStep { 0 };
+        };
+
+        /**
+         * @brief addSample Records the separation of a pair at a step of the time grid, and schedules the next sample.
+         * @param samples separations of the pair
+         * @param k step of the grid
+         * @param distance separation at step k, in degrees
+         * @param relativeRate upper bound of the rate of change of the separation, in degrees per step
+         * @param maxSeparation maximum separation of the approaches searched, in degrees
+         * @param steps number of steps of the grid
+         * @return true if the separation went through a minimum between the steps k - 2 and k which may be below
+         * the maximum separation
+         */
+        static bool addSample(Samples &samples, int k, double distance, double relativeRate, double maxSeparation,
+                              int steps);
+
+    signals:
+        void madeProgress(int progress);
+
+    private:
+        struct Candidate
+        {
+            // The object given by the caller, and the clone propagated by the search.
+            const SkyObject *source { nullptr };
+            SkyObject_s object;
+            // Upper bound of the angular rate of the object, in degrees per day.
+            double rate { 0 };
+            Samples samples;
+            SkyPoint lastPosition;
+            // Approaches found at the current step.
+            QList<QPair<long double, dms>> found;
+        };
+
+        struct Step
+        {
+            long double jd { 0 };
+            SkyPoint position;
+        };
+
+        // Positions object 2 on the time grid, and finds an upper bound of its angular rate.
+        void computeTrack(long double startJD, long double stopJD);
+        // Propagates a candidate to the step k of the grid, and refines the approach if a minimum was passed.
+        void sample(Candidate &candidate, int k, const KSNumbers *num, const CachingDms *LST, const KSPlanetBase *earth);
+        // Finds the minimum separation of a candidate with object 2 between the two Julian days.
+        QPair<long double, dms> refine(Candidate &candidate, long double jd1, long double jd2) const;
+        double distance(const SkyPoint &p1, const SkyPoint &p2) const;
+        // Default upper bound of the angular rate of an object, in degrees per day.
+        static double rateBound(const SkyObject *object);
+
+        GeoLocation *m_GeoPlace { nullptr };
+        KSPlanetBase_s m_Object2;
+        QList<SkyObject *> m_Objects;
+        bool m_Opposition { false };
+        double m_MaxSeparation { 1 };
+
+        QVector<Step> m_Track;
+        double m_Step { 1 };
+        double m_TrackRate { 0 };
+        std::atomic<bool> m_Abort { false };
+};